@@ -91,6 +91,7 @@
 #include <mlpack/core/dists/diagonal_gaussian_distribution.hpp>
 #include <mlpack/core/data/confusion_matrix.hpp>
 #include <mlpack/core/data/one_hot_encoding.hpp>
+#include <mlpack/core/data/feature_hashing.hpp>
 
 // mlpack::backtrace only for linux
 #ifdef HAS_BFD_DL
@@ -0,0 +1,86 @@
+/**
+ * @file core/data/feature_hashing.hpp
+ *
+ * Feature hashing functions.  The purpose of these functions is to encode
+ * categorical variables into a sparse matrix with a fixed number of rows,
+ * however many categories there are.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_FEATURE_HASHING_HPP
+#define MLPACK_CORE_DATA_FEATURE_HASHING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Encode the given dimensions of the input with the hashing trick.  The
+ * dimensions that are not encoded are copied, in order, to the first rows of
+ * the output; each value v of an encoded dimension d is then hashed, together
+ * with d, to one of the numBins rows that follow, which is set to 1 (or, if
+ * alternateSigns is true, to +1 or -1 depending on another part of the hash,
+ * so that collisions cancel out in expectation in inner products).  Values
+ * that hash to the same row of the same point are summed.
+ *
+ * Unlike one-hot encoding, the number of rows of the output doesn't depend on
+ * the number of categories, and the same value always goes to the same row,
+ * so training and test data encoded separately can be used together.  For
+ * more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{weinberger2009feature,
+ *   title = {Feature hashing for large scale multitask learning},
+ *   author = {Weinberger, Kilian and Dasgupta, Anirban and Langford, John and
+ *       Smola, Alex and Attenberg, Josh},
+ *   booktitle = {Proceedings of the 26th Annual International Conference on
+ *       Machine Learning (ICML '09)},
+ *   pages = {1113--1120},
+ *   year = {2009}
+ * }
+ * @endcode
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param numBins Number of rows the encoded dimensions are hashed into.
+ * @param output Encoded sparse matrix.
+ * @param alternateSigns Whether hashed values are +1 or -1 (default true).
+ */
+template<typename eT>
+void FeatureHashing(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    const size_t numBins,
+                    arma::SpMat<eT>& output,
+                    const bool alternateSigns = true);
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a DatasetInfo object and outputs a sparse matrix.  This function
+ * encodes all the dimensions marked `Datatype::categorical` in the
+ * data::DatasetInfo.
+ *
+ * @param input Input dataset to be encoded.
+ * @param numBins Number of rows the encoded dimensions are hashed into.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ * @param alternateSigns Whether hashed values are +1 or -1 (default true).
+ */
+template<typename eT>
+void FeatureHashing(const arma::Mat<eT>& input,
+                    const size_t numBins,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo,
+                    const bool alternateSigns = true);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "feature_hashing_impl.hpp"
+
+#endif
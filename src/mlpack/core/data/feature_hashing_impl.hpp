@@ -0,0 +1,147 @@
+/**
+ * @file core/data/feature_hashing_impl.hpp
+ *
+ * Implementation of feature hashing functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_FEATURE_HASHING_IMPL_HPP
+#define MLPACK_CORE_DATA_FEATURE_HASHING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "feature_hashing.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Hash the given value of the given dimension.  The value is hashed as a
+ * double, so that the hash doesn't depend on the element type of the matrix,
+ * and the result is the same on every platform.
+ */
+inline uint64_t HashFeature(const size_t dimension, const double value)
+{
+  // The splitmix64 finalizer.
+  auto mix = [](uint64_t x)
+  {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  };
+
+  // Make sure that -0 and 0 hash the same.
+  const double v = (value == 0.0) ? 0.0 : value;
+  uint64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return mix(bits + mix((uint64_t) dimension + 0x9e3779b97f4a7c15ULL));
+}
+
+template<typename eT>
+void FeatureHashing(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    const size_t numBins,
+                    arma::SpMat<eT>& output,
+                    const bool alternateSigns)
+{
+  if (numBins == 0 && indices.n_elem > 0)
+  {
+    throw std::invalid_argument("FeatureHashing(): numBins must be positive "
+        "if any dimensions are encoded!");
+  }
+
+  // The dimensions that are not encoded keep their order at the start of the
+  // output.
+  std::vector<char> encoded(input.n_rows, 0);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    encoded[indices[i]] = 1;
+  std::vector<size_t> copiedRows(input.n_rows, 0);
+  size_t numCopied = 0;
+  for (size_t row = 0; row < input.n_rows; ++row)
+  {
+    if (!encoded[row])
+      copiedRows[row] = numCopied++;
+  }
+
+  // Write the columns in compressed sparse column form.
+  arma::uvec colPtrs(input.n_cols + 1);
+  std::vector<arma::uword> rowIndices;
+  std::vector<eT> values;
+  rowIndices.reserve(input.n_rows * input.n_cols);
+  values.reserve(input.n_rows * input.n_cols);
+  std::vector<std::pair<size_t, eT>> hashed;
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    colPtrs[col] = rowIndices.size();
+
+    hashed.clear();
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const eT value = input(row, col);
+      if (!encoded[row])
+      {
+        if (value != eT(0))
+        {
+          rowIndices.push_back(copiedRows[row]);
+          values.push_back(value);
+        }
+        continue;
+      }
+
+      const uint64_t hash = HashFeature(row, (double) value);
+      const eT sign = (alternateSigns && (hash >> 63)) ? eT(-1) : eT(1);
+      hashed.push_back(std::make_pair(numCopied + hash % numBins, sign));
+    }
+
+    // Sum the values that hash to the same row.
+    std::sort(hashed.begin(), hashed.end(),
+        [](const std::pair<size_t, eT>& a, const std::pair<size_t, eT>& b)
+        {
+          return a.first < b.first;
+        });
+    for (size_t i = 0; i < hashed.size(); )
+    {
+      const size_t row = hashed[i].first;
+      eT sum = eT(0);
+      for (; i < hashed.size() && hashed[i].first == row; ++i)
+        sum += hashed[i].second;
+
+      if (sum != eT(0))
+      {
+        rowIndices.push_back(row);
+        values.push_back(sum);
+      }
+    }
+  }
+  colPtrs[input.n_cols] = rowIndices.size();
+
+  output = arma::SpMat<eT>(arma::uvec(rowIndices), colPtrs,
+      arma::Col<eT>(values), numCopied + (indices.n_elem > 0 ? numBins : 0),
+      input.n_cols);
+}
+
+template<typename eT>
+void FeatureHashing(const arma::Mat<eT>& input,
+                    const size_t numBins,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo,
+                    const bool alternateSigns)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  FeatureHashing(input, arma::Col<size_t>(indices), numBins, output,
+      alternateSigns);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
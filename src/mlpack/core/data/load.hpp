@@ -219,6 +219,32 @@ bool Load(const std::string& filename,
           const bool fatal = false,
           const bool transpose = true);
 
+/**
+ * Loads a text-based file (CSV, TSV or TXT, as above) into a sparse matrix,
+ * mapping categorical features with a DatasetInfo object and one-hot encoding
+ * them while the file is parsed, so that the dense matrix is never created.
+ * Each point of the file is a column of the matrix.  Each numeric dimension
+ * takes one row of the matrix, and each categorical dimension d takes
+ * info.NumMappings(d) rows, one for each mapped value in the order of the
+ * mappings; for a new `info` this gives the same matrix as loading into a
+ * dense matrix and calling OneHotEncoding() with `info`.
+ *
+ * As with the overload above, `info` keeps the mappings of the original
+ * dimensions of the file, and is re-used if it has already been used to load
+ * data of the same dimensionality.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load the encoded contents of file into.
+ * @param info DatasetInfo object to populate with mappings and data types.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          DatasetInfo& info,
+          const bool fatal = false);
+
 /**
  * Load a model from a file, guessing the filetype from the extension, or,
  * optionally, loading the specified format.  If automatic extension detection
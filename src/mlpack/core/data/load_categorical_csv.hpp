@@ -30,6 +30,15 @@ void LoadCSV::LoadCategoricalCSV(arma::Mat<eT> &inout,
     NonTransposeParse(inout, infoSet);
 }
 
+template<typename eT>
+void LoadCSV::LoadCategoricalCSV(arma::SpMat<eT>& inout,
+                                 DatasetMapper<IncrementPolicy>& infoSet)
+{
+  CheckOpen();
+
+  TransposeParse(inout, infoSet);
+}
+
 inline void LoadCSV::CategoricalMatSize(
     std::stringstream& lineStream, size_t& col, const char delim)
 {
@@ -0,0 +1,566 @@
+/**
+ * @file core/data/load_categorical_csv_parallel.hpp
+ *
+ * Parallel loading of a transposed matrix that may contain categorical data
+ * into a DatasetInfo.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_CATEGORICAL_CSV_PARALLEL_HPP
+#define MLPACK_CORE_DATA_LOAD_CATEGORICAL_CSV_PARALLEL_HPP
+
+#include "load_csv.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
+namespace mlpack {
+namespace data {
+
+//! Return whether the given character is whitespace.
+inline bool IsSpace(const char c)
+{
+  return std::isspace((unsigned char) c);
+}
+
+//! Convert a null-terminated string to a float with strtof().
+inline void StringToFloat(const char* str, char** end, float& val)
+{
+  val = std::strtof(str, end);
+}
+
+//! Convert a null-terminated string to a double with strtod().
+inline void StringToFloat(const char* str, char** end, double& val)
+{
+  val = std::strtod(str, end);
+}
+
+//! Convert a null-terminated string to a long double with strtold().
+inline void StringToFloat(const char* str, char** end, long double& val)
+{
+  val = std::strtold(str, end);
+}
+
+inline void LoadCSV::SplitLine(const char* begin,
+                               const char* end,
+                               const char delim,
+                               std::vector<CSVToken>& tokens)
+{
+  tokens.clear();
+  const char* pos = begin;
+  while (true)
+  {
+    const char* pieceEnd = std::find(pos, end, delim);
+
+    // Remove whitespace from either side.
+    const char* tokenBegin = pos;
+    const char* tokenEnd = pieceEnd;
+    while (tokenBegin != tokenEnd && IsSpace(*tokenBegin))
+      ++tokenBegin;
+    while (tokenEnd != tokenBegin && IsSpace(*(tokenEnd - 1)))
+      --tokenEnd;
+
+    // A quoted token ends with the first part that ends with a quote.
+    if (tokenBegin != tokenEnd && *tokenBegin == '"' &&
+        *(tokenEnd - 1) != '"')
+    {
+      bool closed = false;
+      while (!closed && pieceEnd != end)
+      {
+        const char* pieceBegin = pieceEnd + 1;
+        pieceEnd = std::find(pieceBegin, end, delim);
+        closed = (pieceEnd != pieceBegin && *(pieceEnd - 1) == '"');
+      }
+      tokenEnd = pieceEnd;
+    }
+
+    const CSVToken token = { tokenBegin, (size_t) (tokenEnd - tokenBegin) };
+    tokens.push_back(token);
+
+    if (pieceEnd == end)
+      break;
+    pos = pieceEnd + 1;
+  }
+}
+
+template<typename T>
+bool LoadCSV::ParseNumber(const CSVToken& token, T& val)
+{
+  // Stream extraction only accepts a sign, digits, a decimal point and an
+  // exponent; in particular, it doesn't accept "inf", "nan" or hexadecimal
+  // numbers, which strtod() would.
+  if (token.size == 0)
+    return false;
+  for (size_t i = 0; i < token.size; ++i)
+  {
+    const char c = token.begin[i];
+    if (!std::isdigit((unsigned char) c) && c != '+' && c != '-' &&
+        c != '.' && c != 'e' && c != 'E')
+      return false;
+  }
+
+  // The token is not null-terminated, so copy it first.  Numbers are short, so
+  // this needs no allocation.
+  char buffer[64];
+  std::string longToken;
+  const char* str = buffer;
+  if (token.size < sizeof(buffer))
+  {
+    std::memcpy(buffer, token.begin, token.size);
+    buffer[token.size] = '\0';
+  }
+  else
+  {
+    longToken.assign(token.begin, token.size);
+    str = longToken.c_str();
+  }
+
+  char* end;
+  StringToFloat(str, &end, val);
+
+  // Stream extraction fails on overflow.
+  return (end == str + token.size) && !std::isinf(val);
+}
+
+inline size_t LoadCSV::SplitFile(const MappedFile& file,
+                                std::vector<size_t>& chunkStarts) const
+{
+  const char* data = file.Data();
+  const size_t size = file.Size();
+
+  // Find the first non-empty line, which gives the dimensionality.
+  std::vector<CSVToken> tokens;
+  size_t rows = 0;
+  const char* pos = data;
+  while (pos != data + size)
+  {
+    const char* lineEnd = std::find(pos, data + size, '\n');
+    const char* lineBegin = pos;
+    while (lineBegin != lineEnd && IsSpace(*lineBegin))
+      ++lineBegin;
+    if (lineBegin != lineEnd)
+    {
+      SplitLine(lineBegin, lineEnd, delim, tokens);
+      rows = tokens.size();
+      break;
+    }
+    pos = (lineEnd == data + size) ? lineEnd : lineEnd + 1;
+  }
+
+  // Split the file into chunks of whole lines.  There are several chunks per
+  // thread, so that threads that finish early can take more work.
+  size_t numChunks = 1;
+  #ifdef HAS_OPENMP
+    numChunks = 4 * omp_get_max_threads();
+  #endif
+  numChunks = std::max((size_t) 1, std::min(numChunks, size / 4096));
+  chunkStarts.assign(numChunks + 1, size);
+  chunkStarts[0] = 0;
+  for (size_t c = 1; c < numChunks; ++c)
+  {
+    const size_t start = std::max(c * size / numChunks, chunkStarts[c - 1]);
+    const char* lineEnd = std::find(data + start, data + size, '\n');
+    chunkStarts[c] = (lineEnd == data + size) ? size :
+        (size_t) (lineEnd - data) + 1;
+  }
+
+  return rows;
+}
+
+inline void LoadCSV::ForEachLine(
+    const MappedFile& file,
+    const std::vector<size_t>& chunkStarts,
+    const size_t chunk,
+    const std::function<bool(const char*, const char*)>& function)
+{
+  const char* pos = file.Data() + chunkStarts[chunk];
+  const char* chunkEnd = file.Data() + chunkStarts[chunk + 1];
+  while (pos != chunkEnd)
+  {
+    const char* lineEnd = std::find(pos, chunkEnd, '\n');
+    const char* lineBegin = pos;
+    const char* trimmedEnd = lineEnd;
+    while (lineBegin != trimmedEnd && IsSpace(*lineBegin))
+      ++lineBegin;
+    while (trimmedEnd != lineBegin && IsSpace(*(trimmedEnd - 1)))
+      --trimmedEnd;
+
+    // Like the serial parser, pass blank lines on too, so that they are
+    // rejected as lines with the wrong number of dimensions.
+    if (!function(lineBegin, trimmedEnd))
+      return;
+    pos = (lineEnd == chunkEnd) ? lineEnd : lineEnd + 1;
+  }
+}
+
+template<typename T>
+void LoadCSV::ParallelFirstPass(const MappedFile& file,
+                                const std::vector<size_t>& chunkStarts,
+                                const size_t rows,
+                                DatasetMapper<IncrementPolicy>& infoSet,
+                                std::vector<size_t>& chunkOffsets,
+                                std::vector<size_t>& categoricalDims,
+                                std::vector<size_t>& chunkNonzeros)
+{
+  if (infoSet.Dimensionality() == 0)
+  {
+    infoSet.SetDimensionality(rows);
+  }
+  else if (infoSet.Dimensionality() != rows)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
+        << infoSet.Dimensionality() << ", but data has dimensionality "
+        << rows;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // As with the serial parser, dimensions that are already categorical stay
+  // categorical.
+  const size_t numChunks = chunkStarts.size() - 1;
+  std::vector<char> categorical(rows, 0);
+  for (size_t d = 0; d < rows; ++d)
+  {
+    if (infoSet.Type(d) == Datatype::categorical ||
+        infoSet.Policy().ForceAllMappings())
+      categorical[d] = 1;
+  }
+
+  std::vector<size_t> chunkLines(numChunks, 0);
+  std::vector<std::vector<char>> chunkCategorical(numChunks,
+      std::vector<char>(rows, 0));
+  std::vector<std::vector<size_t>> chunkDimNonzeros(numChunks,
+      std::vector<size_t>(rows, 0));
+  // The first line of each chunk with the wrong number of tokens, if any.
+  std::vector<size_t> badLines(numChunks, size_t(-1));
+  std::vector<size_t> badLineTokens(numChunks, 0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    std::vector<CSVToken> tokens;
+    std::vector<char>& localCategorical = chunkCategorical[c];
+    std::vector<size_t>& localNonzeros = chunkDimNonzeros[c];
+    ForEachLine(file, chunkStarts, c, [&](const char* begin, const char* end)
+    {
+      SplitLine(begin, end, delim, tokens);
+      if (tokens.size() != rows)
+      {
+        badLines[c] = chunkLines[c];
+        badLineTokens[c] = tokens.size();
+        return false;
+      }
+
+      for (size_t d = 0; d < rows; ++d)
+      {
+        if (categorical[d] || localCategorical[d])
+          continue;
+
+        T val;
+        if (!ParseNumber(tokens[d], val))
+          localCategorical[d] = 1;
+        else if (val != T(0))
+          ++localNonzeros[d];
+      }
+
+      ++chunkLines[c];
+      return true;
+    });
+  }
+
+  // Find the column of the first line of each chunk.
+  chunkOffsets.assign(numChunks + 1, 0);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (badLines[c] != size_t(-1))
+    {
+      std::ostringstream oss;
+      oss << "LoadCSV::TransposeParse(): wrong number of dimensions ("
+          << badLineTokens[c] << ") on line " << chunkOffsets[c] + badLines[c]
+          << "; should be " << rows << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+
+    chunkOffsets[c + 1] = chunkOffsets[c] + chunkLines[c];
+    for (size_t d = 0; d < rows; ++d)
+      categorical[d] |= chunkCategorical[c][d];
+  }
+
+  categoricalDims.clear();
+  for (size_t d = 0; d < rows; ++d)
+  {
+    if (categorical[d])
+    {
+      infoSet.Type(d) = Datatype::categorical;
+      categoricalDims.push_back(d);
+    }
+  }
+
+  // Every line of a chunk holds one token of each categorical dimension, and
+  // the counted nonzero values of the numeric dimensions.
+  chunkNonzeros.assign(numChunks, 0);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    chunkNonzeros[c] = chunkLines[c] * categoricalDims.size();
+    for (size_t d = 0; d < rows; ++d)
+    {
+      if (!categorical[d])
+        chunkNonzeros[c] += chunkDimNonzeros[c][d];
+    }
+  }
+}
+
+inline void LoadCSV::ParallelSecondPass(
+    const MappedFile& file,
+    const std::vector<size_t>& chunkStarts,
+    const std::vector<size_t>& categoricalDims,
+    std::vector<std::vector<std::vector<CSVToken>>>& chunkTokens,
+    const std::function<void(const size_t, const std::vector<CSVToken>&,
+        const std::vector<size_t>&)>& function)
+{
+  typedef std::unordered_map<CSVToken, size_t, CSVTokenHash> DictionaryType;
+
+  const size_t numChunks = chunkStarts.size() - 1;
+  chunkTokens.assign(numChunks,
+      std::vector<std::vector<CSVToken>>(categoricalDims.size()));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    std::vector<CSVToken> tokens;
+    std::vector<size_t> localIds(categoricalDims.size());
+    std::vector<DictionaryType> dictionaries(categoricalDims.size());
+    ForEachLine(file, chunkStarts, c, [&](const char* begin, const char* end)
+    {
+      SplitLine(begin, end, delim, tokens);
+      for (size_t i = 0; i < categoricalDims.size(); ++i)
+      {
+        const CSVToken& token = tokens[categoricalDims[i]];
+        std::vector<CSVToken>& localTokens = chunkTokens[c][i];
+        const std::pair<DictionaryType::iterator, bool> result =
+            dictionaries[i].insert(std::make_pair(token, localTokens.size()));
+        if (result.second)
+          localTokens.push_back(token);
+        localIds[i] = result.first->second;
+      }
+
+      function(c, tokens, localIds);
+      return true;
+    });
+  }
+}
+
+template<typename T>
+void LoadCSV::MergeMappings(
+    const std::vector<size_t>& categoricalDims,
+    const std::vector<std::vector<std::vector<CSVToken>>>& chunkTokens,
+    DatasetMapper<IncrementPolicy>& infoSet,
+    std::vector<std::vector<std::vector<T>>>& chunkMappings)
+{
+  // Mapping the distinct tokens of each chunk in the order they appear, chunk
+  // by chunk, gives every string the mapping it would get from the serial
+  // parser.
+  chunkMappings.assign(chunkTokens.size(),
+      std::vector<std::vector<T>>(categoricalDims.size()));
+  std::string token;
+  for (size_t i = 0; i < categoricalDims.size(); ++i)
+  {
+    for (size_t c = 0; c < chunkTokens.size(); ++c)
+    {
+      const std::vector<CSVToken>& localTokens = chunkTokens[c][i];
+      std::vector<T>& mappings = chunkMappings[c][i];
+      mappings.resize(localTokens.size());
+      for (size_t j = 0; j < localTokens.size(); ++j)
+      {
+        token.assign(localTokens[j].begin, localTokens[j].size);
+        mappings[j] = infoSet.template MapString<T>(token,
+            categoricalDims[i]);
+      }
+    }
+  }
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+LoadCSV::TransposeParse(arma::Mat<T>& inout,
+                        DatasetMapper<IncrementPolicy>& infoSet)
+{
+  const MappedFile file(filename);
+  std::vector<size_t> chunkStarts;
+  const size_t rows = SplitFile(file, chunkStarts);
+  if (rows == 0)
+  {
+    inout.set_size(0, 0);
+    return;
+  }
+
+  // First pass: count the lines of each chunk and find the dimensions that
+  // have tokens that aren't numbers.
+  std::vector<size_t> chunkOffsets, categoricalDims, chunkNonzeros;
+  ParallelFirstPass<T>(file, chunkStarts, rows, infoSet, chunkOffsets,
+      categoricalDims, chunkNonzeros);
+  std::vector<char> categorical(rows, 0);
+  for (size_t i = 0; i < categoricalDims.size(); ++i)
+    categorical[categoricalDims[i]] = 1;
+
+  inout.set_size(rows, chunkOffsets.back());
+
+  // Second pass: write the numeric values, and keep the identifiers of the
+  // categorical tokens local to each chunk aside.  (They can't be stored in
+  // the matrix: a float can't hold every identifier above 2^24.)
+  const size_t numCategorical = categoricalDims.size();
+  std::vector<size_t> chunkColumns(chunkOffsets.begin(), chunkOffsets.end());
+  std::vector<size_t> columnIds(numCategorical * chunkOffsets.back());
+  std::vector<std::vector<std::vector<CSVToken>>> chunkTokens;
+  ParallelSecondPass(file, chunkStarts, categoricalDims, chunkTokens,
+      [&](const size_t c, const std::vector<CSVToken>& tokens,
+          const std::vector<size_t>& localIds)
+  {
+    const size_t col = chunkColumns[c]++;
+    T* column = inout.colptr(col);
+    for (size_t d = 0; d < rows; ++d)
+    {
+      if (!categorical[d])
+        ParseNumber(tokens[d], column[d]);
+    }
+    std::copy(localIds.begin(), localIds.end(),
+        columnIds.begin() + col * numCategorical);
+  });
+
+  std::vector<std::vector<std::vector<size_t>>> chunkMappings;
+  MergeMappings(categoricalDims, chunkTokens, infoSet, chunkMappings);
+  chunkTokens.clear();
+
+  // Replace the local identifiers with the mappings.
+  if (categoricalDims.empty())
+    return;
+
+  const size_t numChunks = chunkStarts.size() - 1;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    for (size_t col = chunkOffsets[c]; col < chunkOffsets[c + 1]; ++col)
+    {
+      T* column = inout.colptr(col);
+      const size_t* ids = columnIds.data() + col * numCategorical;
+      for (size_t i = 0; i < numCategorical; ++i)
+        column[categoricalDims[i]] = T(chunkMappings[c][i][ids[i]]);
+    }
+  }
+}
+
+template<typename T>
+void LoadCSV::TransposeParse(arma::SpMat<T>& inout,
+                             DatasetMapper<IncrementPolicy>& infoSet)
+{
+  static_assert(std::is_floating_point<T>::value, "LoadCSV::TransposeParse(): "
+      "categorical data can only be encoded into floating-point matrices.");
+
+  const MappedFile file(filename);
+  std::vector<size_t> chunkStarts;
+  const size_t rows = SplitFile(file, chunkStarts);
+  if (rows == 0)
+  {
+    inout.set_size(0, 0);
+    return;
+  }
+
+  // The first pass also counts the nonzero values of each chunk, so the
+  // arrays of the sparse matrix can be allocated before the second pass.
+  std::vector<size_t> chunkOffsets, categoricalDims, chunkNonzeros;
+  ParallelFirstPass<T>(file, chunkStarts, rows, infoSet, chunkOffsets,
+      categoricalDims, chunkNonzeros);
+  std::vector<size_t> categoricalIndex(rows, size_t(-1));
+  for (size_t i = 0; i < categoricalDims.size(); ++i)
+    categoricalIndex[categoricalDims[i]] = i;
+
+  const size_t numChunks = chunkStarts.size() - 1;
+  std::vector<size_t> chunkValueStarts(numChunks + 1, 0);
+  std::partial_sum(chunkNonzeros.begin(), chunkNonzeros.end(),
+      chunkValueStarts.begin() + 1);
+
+  const size_t cols = chunkOffsets.back();
+  arma::uvec rowIndices(chunkValueStarts.back());
+  arma::uvec colPtrs(cols + 1);
+  arma::Col<T> values(chunkValueStarts.back());
+  colPtrs[cols] = chunkValueStarts.back();
+
+  // Second pass: write the columns in compressed sparse column form.  Until
+  // the mappings are known, each entry holds its dimension as the row index,
+  // and the identifiers of the categorical tokens local to each chunk are kept
+  // aside, as for dense matrices.
+  const size_t numCategorical = categoricalDims.size();
+  std::vector<size_t> chunkColumns(chunkOffsets.begin(), chunkOffsets.end());
+  std::vector<size_t> chunkPositions(chunkValueStarts.begin(),
+      chunkValueStarts.end());
+  std::vector<size_t> columnIds(numCategorical * cols);
+  std::vector<std::vector<std::vector<CSVToken>>> chunkTokens;
+  ParallelSecondPass(file, chunkStarts, categoricalDims, chunkTokens,
+      [&](const size_t c, const std::vector<CSVToken>& tokens,
+          const std::vector<size_t>& localIds)
+  {
+    const size_t col = chunkColumns[c]++;
+    size_t& pos = chunkPositions[c];
+    colPtrs[col] = pos;
+    for (size_t d = 0; d < rows; ++d)
+    {
+      // Each categorical token is one-hot encoded.
+      T val = T(1);
+      if (categoricalIndex[d] == size_t(-1) &&
+          (!ParseNumber(tokens[d], val) || val == T(0)))
+        continue;
+
+      rowIndices[pos] = d;
+      values[pos++] = val;
+    }
+    std::copy(localIds.begin(), localIds.end(),
+        columnIds.begin() + col * numCategorical);
+  });
+
+  std::vector<std::vector<std::vector<size_t>>> chunkMappings;
+  MergeMappings(categoricalDims, chunkTokens, infoSet, chunkMappings);
+  chunkTokens.clear();
+
+  // Each categorical dimension takes one row for each of its mappings.
+  std::vector<size_t> rowOffsets(rows + 1, 0);
+  for (size_t d = 0; d < rows; ++d)
+  {
+    rowOffsets[d + 1] = rowOffsets[d] + ((categoricalIndex[d] == size_t(-1)) ?
+        1 : infoSet.NumMappings(d));
+  }
+
+  // Replace the dimensions with the encoded rows, using the local identifiers
+  // of the categorical entries.  The dimensions of each column are in order,
+  // so the rows stay sorted.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    for (size_t col = chunkOffsets[c]; col < chunkOffsets[c + 1]; ++col)
+    {
+      const size_t* ids = columnIds.data() + col * numCategorical;
+      for (size_t k = colPtrs[col]; k < colPtrs[col + 1]; ++k)
+      {
+        const size_t d = rowIndices[k];
+        rowIndices[k] = rowOffsets[d];
+        if (categoricalIndex[d] != size_t(-1))
+        {
+          rowIndices[k] +=
+              chunkMappings[c][categoricalIndex[d]][ids[categoricalIndex[d]]];
+        }
+      }
+    }
+  }
+
+  inout = arma::SpMat<T>(rowIndices, colPtrs, values, rowOffsets[rows], cols);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
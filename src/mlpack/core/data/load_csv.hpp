@@ -43,6 +43,7 @@
 #define MLPACK_CORE_DATA_LOAD_CSV_HPP
 
 #include <mlpack/core/util/log.hpp>
+#include <functional>
 #include <set>
 #include <string>
 
@@ -50,11 +51,44 @@
 #include "extension.hpp"
 #include "format.hpp"
 #include "dataset_mapper.hpp"
+#include "mapped_file.hpp"
 #include "types.hpp"
 
 namespace mlpack {
 namespace data {
 
+/**
+ * A token of a CSV file: a view of part of the buffer the file is held in.
+ */
+struct CSVToken
+{
+  //! The first character of the token.
+  const char* begin;
+  //! The number of characters of the token.
+  size_t size;
+
+  //! Compare the characters of two tokens.
+  bool operator==(const CSVToken& other) const
+  {
+    return size == other.size && std::memcmp(begin, other.begin, size) == 0;
+  }
+};
+
+//! FNV-1a hash of the characters of a CSVToken.
+struct CSVTokenHash
+{
+  size_t operator()(const CSVToken& token) const
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < token.size; ++i)
+    {
+      hash ^= (unsigned char) token.begin[i];
+      hash *= 1099511628211ULL;
+    }
+    return (size_t) hash;
+  }
+};
+
 /**
  * Load the csv file. This class contains functions
  * to load numeric and categorical data.
@@ -146,6 +180,11 @@ class LoadCSV
   * Load the file into the given matrix with the given DatasetMapper object.
   * Throws exceptions on errors.
   *
+  * When a transposed DatasetInfo (that is, a DatasetMapper with the default
+  * IncrementPolicy) is loaded into a floating-point matrix, the file is parsed
+  * by several threads; the mappings are the same as those of the serial parser
+  * used otherwise.
+  *
   * @param inout Matrix to load into.
   * @param infoSet DatasetMapper to use while loading.
   * @param transpose If true, the matrix should be transposed on loading(default).
@@ -155,6 +194,21 @@ class LoadCSV
                           DatasetMapper<PolicyType> &infoSet,
                           const bool transpose = true);
 
+  /**
+  * Load the file into the given sparse matrix with the given DatasetInfo,
+  * one-hot encoding the categorical dimensions as the file is parsed, so that
+  * no dense matrix is ever created.  Each numeric dimension takes one row of
+  * the matrix, and each categorical dimension takes one row for each of its
+  * mappings, in the order of the mappings; the file is always transposed.
+  * Throws exceptions on errors.
+  *
+  * @param inout Sparse matrix to load into.
+  * @param infoSet DatasetInfo to use while loading.
+  */
+  template<typename eT>
+  void LoadCategoricalCSV(arma::SpMat<eT>& inout,
+                          DatasetMapper<IncrementPolicy>& infoSet);
+
   /**
   * Peek at the file to determine the number of rows and columns in the matrix,
   * assuming a non-transposed matrix.  This will also take a first pass over
@@ -297,6 +351,147 @@ class LoadCSV
   template<typename T, typename PolicyType>
   void TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet);
 
+  /**
+  * Parse a transposed matrix into a DatasetInfo in parallel.  The file is
+  * memory-mapped and split into chunks of lines, and each line is split into
+  * CSVTokens that point into the mapped file, so that no strings are created
+  * for the tokens.  The first pass over the chunks counts the lines and finds
+  * the categorical dimensions.  The second pass writes the numeric values
+  * directly into the matrix, and maps the categorical tokens of each chunk to
+  * identifiers local to that chunk.  The local dictionaries are then merged
+  * in file order, so that every string gets the same mapping as with the
+  * serial parser, and the local identifiers are replaced by the final ones.
+  *
+  * @param input Matrix to load into.
+  * @param infoSet DatasetInfo to load with.
+  */
+  template<typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type
+  TransposeParse(arma::Mat<T>& inout, DatasetMapper<IncrementPolicy>& infoSet);
+
+  /**
+  * Parse a transposed matrix into a DatasetInfo in parallel, as above, and
+  * one-hot encode it into a sparse matrix.  The columns are written directly
+  * in compressed sparse column form during the second pass.
+  *
+  * @param input Sparse matrix to load into.
+  * @param infoSet DatasetInfo to load with.
+  */
+  template<typename T>
+  void TransposeParse(arma::SpMat<T>& inout,
+                      DatasetMapper<IncrementPolicy>& infoSet);
+
+  /**
+  * Map the file and split it into chunks of whole lines for the parallel
+  * parser.  Return the dimensionality, which is the number of tokens of the
+  * first non-empty line (or 0 if there are none).
+  *
+  * @param file Mapped file.
+  * @param chunkStarts Vector to store the offset of each chunk in, followed
+  *     by the size of the file.
+  */
+  inline size_t SplitFile(const MappedFile& file,
+                          std::vector<size_t>& chunkStarts) const;
+
+  /**
+  * Call the given function with the bounds of every line of the given chunk,
+  * with whitespace trimmed from either side; stop early if it returns false.
+  * Blank lines are passed as empty ranges.
+  */
+  static inline void ForEachLine(
+      const MappedFile& file,
+      const std::vector<size_t>& chunkStarts,
+      const size_t chunk,
+      const std::function<bool(const char*, const char*)>& function);
+
+  /**
+  * First pass of the parallel parser: count the lines of each chunk, find the
+  * categorical dimensions (and mark them in the DatasetInfo), and count the
+  * nonzero values of each chunk.
+  *
+  * @param file Mapped file.
+  * @param chunkStarts Offsets of the chunks.
+  * @param rows Dimensionality of the data.
+  * @param infoSet DatasetInfo to load with.
+  * @param chunkOffsets Vector to store the column of the first line of each
+  *     chunk in, followed by the number of columns.
+  * @param categoricalDims Vector to store the categorical dimensions in.
+  * @param chunkNonzeros Vector to store the number of nonzero values of each
+  *     chunk in, counting each categorical token as nonzero.
+  */
+  template<typename T>
+  void ParallelFirstPass(const MappedFile& file,
+                         const std::vector<size_t>& chunkStarts,
+                         const size_t rows,
+                         DatasetMapper<IncrementPolicy>& infoSet,
+                         std::vector<size_t>& chunkOffsets,
+                         std::vector<size_t>& categoricalDims,
+                         std::vector<size_t>& chunkNonzeros);
+
+  /**
+  * Second pass of the parallel parser: give the categorical tokens of each
+  * chunk identifiers local to the chunk, in order of appearance, and call the
+  * given function with the chunk, the tokens and the local identifiers of
+  * every line, in the order of the lines of each chunk.
+  *
+  * @param file Mapped file.
+  * @param chunkStarts Offsets of the chunks.
+  * @param categoricalDims Categorical dimensions.
+  * @param chunkTokens Vector to store the distinct tokens of each categorical
+  *     dimension of each chunk in, in order of their local identifiers.
+  * @param function Function to call for every line.
+  */
+  inline void ParallelSecondPass(
+      const MappedFile& file,
+      const std::vector<size_t>& chunkStarts,
+      const std::vector<size_t>& categoricalDims,
+      std::vector<std::vector<std::vector<CSVToken>>>& chunkTokens,
+      const std::function<void(const size_t, const std::vector<CSVToken>&,
+          const std::vector<size_t>&)>& function);
+
+  /**
+  * Merge the local identifiers of the parallel parser into the DatasetInfo,
+  * in file order.
+  *
+  * @param categoricalDims Categorical dimensions.
+  * @param chunkTokens Distinct tokens of each chunk, from the second pass.
+  * @param infoSet DatasetInfo to map the tokens with.
+  * @param chunkMappings Vector to store the mapping of each local identifier
+  *     of each chunk in.
+  */
+  template<typename T>
+  static void MergeMappings(
+      const std::vector<size_t>& categoricalDims,
+      const std::vector<std::vector<std::vector<CSVToken>>>& chunkTokens,
+      DatasetMapper<IncrementPolicy>& infoSet,
+      std::vector<std::vector<std::vector<T>>>& chunkMappings);
+
+  /**
+  * Split a line into tokens, trimming whitespace from either side of each
+  * token.  A token that starts with a quote continues past delimiters until
+  * a part of it ends with a quote.
+  *
+  * @param begin First character of the line.
+  * @param end End of the line.
+  * @param delim Delimiter character.
+  * @param tokens Vector to store the tokens in (its memory is reused).
+  */
+  static inline void SplitLine(const char* begin,
+                               const char* end,
+                               const char delim,
+                               std::vector<CSVToken>& tokens);
+
+  /**
+  * Convert the given token to a number, with the same result as extracting
+  * it from a std::stringstream: return false if the stream extraction would
+  * fail or would not consume the whole token.
+  *
+  * @param token Token to convert.
+  * @param val Variable to store the number in.
+  */
+  template<typename T>
+  static bool ParseNumber(const CSVToken& token, T& val);
+
   //! Extension (type) of file.
   std::string extension;
   //! Name of file.
@@ -312,5 +507,6 @@ class LoadCSV
 
 #include "load_numeric_csv.hpp"
 #include "load_categorical_csv.hpp"
+#include "load_categorical_csv_parallel.hpp"
 
 #endif
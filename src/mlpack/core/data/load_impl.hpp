@@ -295,6 +295,57 @@ bool Load(const std::string& filename,
   return true;
 }
 
+// Load with mappings into a sparse matrix, one-hot encoding the categorical
+// dimensions.
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          DatasetInfo& info,
+          const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  const std::string extension = Extension(filename);
+  if (extension != "csv" && extension != "tsv" && extension != "txt")
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Unable to load '" << filename << "' with one-hot "
+          << "encoding; only CSV, TSV and TXT files are supported."
+          << std::endl;
+    else
+      Log::Warn << "Unable to load '" << filename << "' with one-hot "
+          << "encoding; only CSV, TSV and TXT files are supported."
+          << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Loading '" << filename << "' as one-hot encoded CSV dataset.  "
+      << std::flush;
+  try
+  {
+    LoadCSV loader(filename);
+    loader.LoadCategoricalCSV(matrix, info);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Size is " << matrix.n_cols << " x " << matrix.n_rows << ".\n";
+
+  Timer::Stop("loading_data");
+
+  return true;
+}
+
 // For loading data into sparse matrix
 template <typename eT>
 bool Load(const std::string& filename,
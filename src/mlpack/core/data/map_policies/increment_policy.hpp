@@ -39,6 +39,9 @@ class IncrementPolicy
   // typedef of MappedType
   using MappedType = size_t;
 
+  //! Get whether every input is mapped, even if it is numeric.
+  bool ForceAllMappings() const { return forceAllMappings; }
+
   //! We do need a first pass over the data to set the dimension types right.
   static const bool NeedsFirstPass = true;
 
@@ -0,0 +1,130 @@
+/**
+ * @file core/data/mapped_file.hpp
+ *
+ * Definition of MappedFile, a read-only view of the contents of a file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_FILE_HPP
+#define MLPACK_CORE_DATA_MAPPED_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <fstream>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A MappedFile gives read-only access to the whole contents of a file as one
+ * contiguous buffer.  The file is memory-mapped where mmap() is available, so
+ * that it is paged in on demand and can be scanned by several threads at once
+ * without copying; elsewhere it is read into memory in one piece.  The buffer
+ * is not null-terminated.
+ */
+class MappedFile
+{
+ public:
+  /**
+   * Map the given file.  Throws std::runtime_error if the file cannot be
+   * opened or mapped.
+   *
+   * @param filename File to map.
+   */
+  MappedFile(const std::string& filename) :
+      data(NULL),
+      size(0),
+      mapped(false)
+  {
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error("MappedFile::MappedFile(): cannot open '" +
+          filename + "'!");
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("MappedFile::MappedFile(): cannot read '" +
+          filename + "'!");
+    }
+    size = fileStat.st_size;
+
+    // An empty file can't be mapped, but there is nothing to map anyway.
+    if (size > 0)
+    {
+      void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED)
+      {
+        close(fd);
+        throw std::runtime_error("MappedFile::MappedFile(): cannot map '" +
+            filename + "'!");
+      }
+
+      // The file is read front to back.
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      data = static_cast<const char*>(mapping);
+      mapped = true;
+    }
+    close(fd);
+#else
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in.is_open())
+    {
+      throw std::runtime_error("MappedFile::MappedFile(): cannot open '" +
+          filename + "'!");
+    }
+    size = (size_t) in.tellg();
+    char* buffer = new char[size];
+    in.seekg(0);
+    in.read(buffer, size);
+    data = buffer;
+#endif
+  }
+
+  //! Unmap the file.
+  ~MappedFile()
+  {
+#ifndef _WIN32
+    if (mapped)
+      munmap(const_cast<char*>(data), size);
+#else
+    delete[] data;
+#endif
+  }
+
+  //! The mapping can't be copied.
+  MappedFile(const MappedFile& other) = delete;
+  //! The mapping can't be copied.
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  //! Get the contents of the file.
+  const char* Data() const { return data; }
+  //! Get the size of the file, in bytes.
+  size_t Size() const { return size; }
+
+ private:
+  //! The contents of the file.
+  const char* data;
+  //! The size of the file, in bytes.
+  size_t size;
+  //! Whether the file is memory-mapped (otherwise data was read into memory).
+  bool mapped;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
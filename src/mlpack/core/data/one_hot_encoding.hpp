@@ -62,6 +62,40 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a sparse matrix, with
+ * the same layout as the dense overload.  The output is built directly in
+ * compressed sparse column form in a single pass over the input, so the dense
+ * encoded matrix never exists; zeros in dimensions that are not encoded are
+ * not stored.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a DatasetInfo object and outputs a sparse matrix.  This function
+ * encodes all the dimensions marked `Datatype::categorical` in the
+ * data::DatasetInfo.  To encode a file without loading it into a dense matrix
+ * first, use the data::Load() overload that takes a sparse matrix and a
+ * DatasetInfo.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
 } // namespace data
 } // namespace mlpack
 
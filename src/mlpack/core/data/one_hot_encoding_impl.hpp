@@ -169,6 +169,105 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  std::vector<char> encoded(input.n_rows, 0);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    encoded[indices[i]] = 1;
+
+  // Write the columns in compressed sparse column form.  The number of
+  // categories of each dimension isn't known until the end, so for now the
+  // row index of each element is its dimension, and the category of each
+  // encoded element is stored separately.
+  std::vector<std::unordered_map<eT, size_t>> mappings(input.n_rows);
+  arma::uvec colPtrs(input.n_cols + 1);
+  std::vector<arma::uword> rowIndices;
+  std::vector<eT> values;
+  std::vector<size_t> categories;
+  rowIndices.reserve(indices.n_elem * input.n_cols);
+  values.reserve(indices.n_elem * input.n_cols);
+  categories.reserve(indices.n_elem * input.n_cols);
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    colPtrs[col] = rowIndices.size();
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const eT value = input(row, col);
+      if (encoded[row])
+      {
+        // New values get the next category of the dimension.
+        categories.push_back(mappings[row].insert(std::make_pair(value,
+            mappings[row].size())).first->second);
+        rowIndices.push_back(row);
+        values.push_back(eT(1));
+      }
+      else if (value != eT(0))
+      {
+        rowIndices.push_back(row);
+        values.push_back(value);
+      }
+    }
+  }
+  colPtrs[input.n_cols] = rowIndices.size();
+
+  // Compute the first row of each dimension in the output.
+  std::vector<size_t> dimensionOffsets(input.n_rows + 1, 0);
+  for (size_t row = 0; row < input.n_rows; ++row)
+  {
+    dimensionOffsets[row + 1] = dimensionOffsets[row] +
+        (encoded[row] ? mappings[row].size() : 1);
+  }
+
+  // Now turn the dimensions into rows.  The dimensions of each column are in
+  // order, so the rows stay sorted.
+  size_t category = 0;
+  for (size_t i = 0; i < rowIndices.size(); ++i)
+  {
+    const size_t row = rowIndices[i];
+    rowIndices[i] = dimensionOffsets[row];
+    if (encoded[row])
+      rowIndices[i] += categories[category++];
+  }
+
+  output = arma::SpMat<eT>(arma::uvec(rowIndices), colPtrs,
+      arma::Col<eT>(values), dimensionOffsets[input.n_rows], input.n_cols);
+}
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a DatasetInfo object and outputs a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+}
+
 } // namespace data
 } // namespace mlpack
 
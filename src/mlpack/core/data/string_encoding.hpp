@@ -98,6 +98,11 @@ class StringEncoding
    * writes it in the column-major order. If the output type is 2D std::vector
    * then the function writes it in the row major order.
    *
+   * If the output type is arma::SpMat and the policy computes the values
+   * from token counts only (bag of words and tf-idf), the strings are
+   * tokenized and counted in parallel and the output is built directly in
+   * compressed sparse column form; see EncodeHelper() for details.
+   *
    * @tparam OutputType Type of the output container. The function supports
    *                    the following types: arma::mat, arma::sp_mat,
    *                    std::vector<std::vector<>>.
@@ -201,6 +206,44 @@ class StringEncoding
                     typename std::enable_if<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>::type* = 0);
 
+  /**
+   * A helper function to encode the given text into a sparse matrix in
+   * parallel. This is an optimized overload for policies that compute the
+   * values from token counts only. The encoder writes data in the
+   * column-major order.
+   *
+   * The strings are split into contiguous chunks that are tokenized and
+   * counted by different threads, each with its own local dictionary.  The
+   * local dictionaries are then merged into the dictionary chunk by chunk, in
+   * the order of the strings, so the labels are the same as the labels given
+   * by the serial encoder.  If the dictionary has a fixed mapping (for
+   * instance, HashingStringEncodingDictionary), the threads use it directly
+   * and there is nothing to merge.  The tokens must stay valid while the
+   * input does; this holds for the tokens of SplitByAnyOf and CharExtract.
+   *
+   * Instead of PreprocessToken(), the policy's PreprocessCounts() is given
+   * the distinct tokens of each string with their counts, so that statistics
+   * such as the token frequencies of TfIdfEncodingPolicy are filled in as by
+   * the serial encoder.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output sparse matrix to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    arma::SpMat<ElemType>& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::countEncoding>::type* = 0);
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -19,6 +19,7 @@
 #include <deque>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace mlpack {
 namespace data {
@@ -343,6 +344,314 @@ class StringEncodingDictionary<int>
   size_t size;
 };
 
+/**
+ * FlatStringEncodingDictionary is a dictionary of STRING_VIEW tokens that is
+ * laid out for speed and for low memory use on large corpora.  The tokens are
+ * copied one after another into a single character arena, and the labels are
+ * held in a flat open-addressing hash table with linear probing, so adding a
+ * token allocates nothing apart from the occasional growth of the arena or of
+ * the table, and a lookup touches one or two cache lines.  Unlike
+ * StringEncodingDictionary<STRING_VIEW>, the dictionary can be copied and
+ * moved by value, and the token of a label can be retrieved with Token().
+ */
+class FlatStringEncodingDictionary
+{
+ public:
+  //! The type of the token that the dictionary stores.
+  using TokenType = STRING_VIEW;
+
+  //! Construct an empty dictionary.
+  FlatStringEncodingDictionary() :
+      offsets(1, 0)
+  { }
+
+  /**
+   * The function returns true if the dictionary contains the given token.
+   *
+   * @param token The given token.
+   */
+  bool HasToken(const STRING_VIEW token) const
+  {
+    return Find(token, Hash(token)) != 0;
+  }
+
+  /**
+   * The function adds the given token to the dictionary and assigns a label
+   * to the token. The label is equal to the resulting size of the dictionary.
+   * The function returns the assigned label. The token must not be in the
+   * dictionary already.
+   *
+   * @param token The given token.
+   */
+  size_t AddToken(const STRING_VIEW token)
+  {
+    // Keep the load factor of the table under one half.
+    if (2 * (Size() + 1) > slots.size())
+      Rehash(std::max((size_t) 16, 2 * slots.size()));
+
+    arena.insert(arena.end(), token.data(), token.data() + token.size());
+    offsets.push_back(arena.size());
+
+    const size_t label = Size();
+    Insert(Hash(token), label);
+    return label;
+  }
+
+  /**
+   * The function returns the label assigned to the given token. The function
+   * throws std::out_of_range if no such token is found.
+   *
+   * @param token The given token.
+   */
+  size_t Value(const STRING_VIEW token) const
+  {
+    const size_t label = Find(token, Hash(token));
+    if (label == 0)
+    {
+      throw std::out_of_range("FlatStringEncodingDictionary::Value(): no such "
+          "token in the dictionary!");
+    }
+
+    return label;
+  }
+
+  /**
+   * Get the token with the given label.  The label must belong to
+   * [1, Size()].  The returned view is invalidated by AddToken().
+   *
+   * @param label The label of the token.
+   */
+  STRING_VIEW Token(const size_t label) const
+  {
+    return STRING_VIEW(arena.data() + offsets[label - 1],
+        offsets[label] - offsets[label - 1]);
+  }
+
+  //! Get the size of the dictionary.
+  size_t Size() const { return offsets.size() - 1; }
+
+  //! Clear the dictionary.
+  void Clear()
+  {
+    arena.clear();
+    offsets.assign(1, 0);
+    slots.clear();
+  }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    size_t numTokens = Size();
+
+    ar(CEREAL_NVP(numTokens));
+
+    if (cereal::is_loading<Archive>())
+    {
+      Clear();
+
+      for (size_t i = 0; i < numTokens; ++i)
+      {
+        std::string token;
+        ar(CEREAL_NVP(token));
+        AddToken(STRING_VIEW(token.data(), token.size()));
+      }
+    }
+    if (cereal::is_saving<Archive>())
+    {
+      for (size_t label = 1; label <= numTokens; ++label)
+      {
+        std::string token(Token(label).data(), Token(label).size());
+        ar(CEREAL_NVP(token));
+      }
+    }
+  }
+
+ private:
+  //! A slot of the hash table.
+  struct Slot
+  {
+    //! The hash of the token.
+    uint64_t hash;
+    //! The label of the token, or 0 if the slot is empty.
+    size_t label;
+  };
+
+  //! Compute the 64-bit FNV-1a hash of the given token.
+  static uint64_t Hash(const STRING_VIEW token)
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < token.size(); ++i)
+    {
+      hash ^= static_cast<unsigned char>(token[i]);
+      hash *= 0x100000001b3ULL;
+    }
+
+    // The low bits select the slot, so mix the high bits into them.
+    return hash ^ (hash >> 32);
+  }
+
+  //! Find the label of the given token, or return 0 if there is none.
+  size_t Find(const STRING_VIEW token, const uint64_t hash) const
+  {
+    if (slots.empty())
+      return 0;
+
+    const size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+      if (slots[i].label == 0)
+        return 0;
+      if (slots[i].hash == hash && Token(slots[i].label) == token)
+        return slots[i].label;
+    }
+  }
+
+  //! Put the given label into the first free slot for the given hash.
+  void Insert(const uint64_t hash, const size_t label)
+  {
+    const size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    while (slots[i].label != 0)
+      i = (i + 1) & mask;
+
+    slots[i].hash = hash;
+    slots[i].label = label;
+  }
+
+  //! Resize the table to the given number of slots (a power of two).
+  void Rehash(const size_t numSlots)
+  {
+    std::vector<Slot> oldSlots(numSlots, Slot{0, 0});
+    oldSlots.swap(slots);
+
+    for (const Slot& slot : oldSlots)
+    {
+      if (slot.label != 0)
+        Insert(slot.hash, slot.label);
+    }
+  }
+
+  //! The characters of all tokens, one after another.
+  std::vector<char> arena;
+  //! The token with label l is arena[offsets[l - 1]] to arena[offsets[l]].
+  std::vector<size_t> offsets;
+  //! The hash table.
+  std::vector<Slot> slots;
+};
+
+/**
+ * HashingStringEncodingDictionary implements the hashing trick: instead of
+ * storing the tokens, it hashes each STRING_VIEW token to one of a fixed
+ * number of labels.  Every token is considered to be in the dictionary, the
+ * dictionary never grows, and it holds no state apart from the number of
+ * labels, so it can be shared by any number of threads and by independent
+ * runs of the encoder.  Different tokens may get the same label.
+ */
+class HashingStringEncodingDictionary
+{
+ public:
+  //! The type of the token that the dictionary stores.
+  using TokenType = STRING_VIEW;
+
+  /**
+   * Construct the dictionary with the given number of labels.
+   *
+   * @param numBins The number of labels that tokens are hashed to.
+   */
+  HashingStringEncodingDictionary(const size_t numBins = 1 << 20) :
+      numBins(numBins)
+  {
+    if (numBins == 0)
+    {
+      throw std::invalid_argument("HashingStringEncodingDictionary: the "
+          "number of bins must be positive!");
+    }
+  }
+
+  //! Every token has a label.
+  static bool HasToken(const STRING_VIEW /* token */) { return true; }
+
+  //! Tokens are not stored; the function returns the label of the token.
+  size_t AddToken(const STRING_VIEW token) const { return Value(token); }
+
+  /**
+   * The function returns the label of the given token, which belongs to
+   * [1, NumBins()].
+   *
+   * @param token The given token.
+   */
+  size_t Value(const STRING_VIEW token) const
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < token.size(); ++i)
+    {
+      hash ^= static_cast<unsigned char>(token[i]);
+      hash *= 0x100000001b3ULL;
+    }
+
+    // The splitmix64 finalizer, so that every bit of the hash is used.
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+
+    return hash % numBins + 1;
+  }
+
+  //! Get the size of the dictionary, that is, the number of labels.
+  size_t Size() const { return numBins; }
+
+  //! There is nothing to clear.
+  void Clear() { }
+
+  //! Get the number of labels.
+  size_t NumBins() const { return numBins; }
+  //! Modify the number of labels.
+  size_t& NumBins() { return numBins; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numBins));
+  }
+
+ private:
+  //! The number of labels.
+  size_t numBins;
+};
+
+/**
+ * This is a template struct that provides some information about various
+ * dictionaries.
+ */
+template<typename DictionaryType>
+struct StringEncodingDictionaryTraits
+{
+  /**
+   * Indicates if the label of a token is fixed in advance, so that the
+   * dictionary doesn't depend on the order in which the tokens are seen.
+   */
+  static const bool fixedMapping = false;
+};
+
+/**
+ * The specialization provides some information about the hashing dictionary.
+ */
+template<>
+struct StringEncodingDictionaryTraits<HashingStringEncodingDictionary>
+{
+  /**
+   * Indicates if the label of a token is fixed in advance, so that the
+   * dictionary doesn't depend on the order in which the tokens are seen.
+   */
+  static const bool fixedMapping = true;
+};
+
 } // namespace data
 } // namespace mlpack
 
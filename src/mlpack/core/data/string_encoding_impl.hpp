@@ -16,6 +16,7 @@
 // In case it hasn't been included yet.
 #include "string_encoding.hpp"
 #include <type_traits>
+#include <algorithm>
 
 namespace mlpack {
 namespace data {
@@ -196,6 +197,192 @@ EncodeHelper(const std::vector<std::string>& input,
   }
 }
 
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             arma::SpMat<ElemType>& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::countEncoding>::type*)
+{
+  typedef typename std::remove_reference<typename DictionaryType::TokenType>::
+      type TokenType;
+  const bool fixedMapping =
+      StringEncodingDictionaryTraits<DictionaryType>::fixedMapping;
+
+  policy.Reset();
+
+  const size_t numLines = input.size();
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+  const size_t numChunks = std::max((size_t) 1,
+      std::min(numLines, 4 * numThreads));
+
+  // The labels and counts of the distinct tokens of each string, string by
+  // string; the entries of string i are in chunkEntries[c] from
+  // lineEnds[i - 1] (or 0 for the first string of the chunk) to lineEnds[i].
+  std::vector<std::vector<std::pair<size_t, size_t>>> chunkEntries(numChunks);
+  std::vector<size_t> lineEnds(numLines);
+  std::vector<size_t> lineSizes(numLines);
+  // The tokens of each chunk in the order of their local labels.
+  std::vector<std::vector<TokenType>> chunkTokens(numChunks);
+
+  // First pass: tokenize and count each chunk with a local dictionary.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    DictionaryType localDictionary;
+    std::vector<size_t> counts;
+    std::vector<size_t> touched;
+    std::vector<std::pair<size_t, size_t>>& entries = chunkEntries[c];
+
+    for (size_t i = c * numLines / numChunks;
+        i < (c + 1) * numLines / numChunks; ++i)
+    {
+      STRING_VIEW strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       TokenType>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      size_t numTokens = 0;
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        size_t label;
+        if (fixedMapping)
+        {
+          label = dictionary.Value(token);
+        }
+        else if (localDictionary.HasToken(token))
+        {
+          label = localDictionary.Value(token);
+        }
+        else
+        {
+          chunkTokens[c].push_back(token);
+          label = localDictionary.AddToken(token);
+        }
+
+        if (label >= counts.size())
+          counts.resize(std::max(label + 1, 2 * counts.size()), 0);
+        if (counts[label]++ == 0)
+          touched.push_back(label);
+
+        token = tokenizer(strView);
+        numTokens++;
+      }
+
+      for (const size_t label : touched)
+      {
+        entries.push_back(std::make_pair(label, counts[label]));
+        counts[label] = 0;
+      }
+      touched.clear();
+
+      lineEnds[i] = entries.size();
+      lineSizes[i] = numTokens;
+    }
+  }
+
+  // Merge the local dictionaries chunk by chunk, so that the tokens are added
+  // to the dictionary in the same order as by the serial encoder.
+  std::vector<std::vector<size_t>> chunkLabels(numChunks);
+  if (!fixedMapping)
+  {
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      chunkLabels[c].resize(chunkTokens[c].size() + 1);
+      for (size_t k = 0; k < chunkTokens[c].size(); ++k)
+      {
+        const TokenType& token = chunkTokens[c][k];
+        chunkLabels[c][k + 1] = dictionary.HasToken(token) ?
+            dictionary.Value(token) : dictionary.AddToken(token);
+      }
+      chunkTokens[c].clear();
+      chunkTokens[c].shrink_to_fit();
+    }
+  }
+
+  // Replace the local labels and sort the entries of each string by label.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    std::vector<std::pair<size_t, size_t>>& entries = chunkEntries[c];
+    if (!fixedMapping)
+    {
+      for (std::pair<size_t, size_t>& entry : entries)
+        entry.first = chunkLabels[c][entry.first];
+    }
+
+    size_t start = 0;
+    for (size_t i = c * numLines / numChunks;
+        i < (c + 1) * numLines / numChunks; ++i)
+    {
+      std::sort(entries.begin() + start, entries.begin() + lineEnds[i]);
+      start = lineEnds[i];
+    }
+  }
+
+  // Count the strings that contain each token, and pass the counts of each
+  // string on to the policy.
+  const size_t dictionarySize = dictionary.Size();
+  std::vector<size_t> numContainingStrings(dictionarySize + 1, 0);
+  std::vector<size_t> chunkStarts(numChunks + 1, 0);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    const std::vector<std::pair<size_t, size_t>>& entries = chunkEntries[c];
+    for (const std::pair<size_t, size_t>& entry : entries)
+      ++numContainingStrings[entry.first];
+    chunkStarts[c + 1] = chunkStarts[c] + entries.size();
+
+    size_t start = 0;
+    for (size_t i = c * numLines / numChunks;
+        i < (c + 1) * numLines / numChunks; ++i)
+    {
+      policy.PreprocessCounts(i, lineSizes[i], entries.begin() + start,
+          entries.begin() + lineEnds[i]);
+      start = lineEnds[i];
+    }
+  }
+
+  // Second pass: write the output in compressed sparse column form.
+  arma::uvec rowIndices(chunkStarts[numChunks]);
+  arma::uvec colPtrs(numLines + 1);
+  arma::Col<ElemType> values(chunkStarts[numChunks]);
+  colPtrs[numLines] = chunkStarts[numChunks];
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const std::vector<std::pair<size_t, size_t>>& entries = chunkEntries[c];
+    size_t k = 0;
+    for (size_t i = c * numLines / numChunks;
+        i < (c + 1) * numLines / numChunks; ++i)
+    {
+      colPtrs[i] = chunkStarts[c] + k;
+      for (; k < lineEnds[i]; ++k)
+      {
+        const size_t label = entries[k].first;
+        // The labels are assigned sequentially starting from one.
+        rowIndices[chunkStarts[c] + k] = label - 1;
+        values[chunkStarts[c] + k] = policy.template EncodeCount<ElemType>(
+            entries[k].second, lineSizes[i], numLines,
+            numContainingStrings[label]);
+      }
+    }
+  }
+
+  output = arma::SpMat<ElemType>(rowIndices, colPtrs, values, dictionarySize,
+      numLines);
+}
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename Archive>
 void StringEncoding<EncodingPolicyType, DictionaryType>::serialize(
@@ -134,6 +134,29 @@ class BagOfWordsEncodingPolicy
     output[line][value - 1] += 1;
   }
 
+  /**
+   * The function computes the value of a token of a string, given the number
+   * of times when the token occurs in the string.  It is used when encoding
+   * into sparse matrices in parallel.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of times when the token occurs in the
+   *                       string.
+   * @param * (numTokens) The total number of tokens in the string (not used).
+   * @param * (numLines) The number of strings in the input dataset (not used).
+   * @param * (numContainingStrings) The number of strings which contain the
+   *                     token (not used).
+   */
+  template<typename ElemType>
+  static ElemType EncodeCount(const size_t numOccurrences,
+                              const size_t /* numTokens */,
+                              const size_t /* numLines */,
+                              const size_t /* numContainingStrings */)
+  {
+    return ElemType(numOccurrences);
+  }
+
   /**
    * The function is not used by the bag of words encoding policy.
    *
@@ -146,6 +169,21 @@ class BagOfWordsEncodingPolicy
                               size_t /* value */)
   { }
 
+  /**
+   * The function is not used by the bag of words encoding policy.
+   *
+   * @param * (line) The line number of the string.
+   * @param * (numTokens) The total number of tokens in the string.
+   * @param * (begin) Iterator to the first distinct token of the string.
+   * @param * (end) Iterator past the last distinct token of the string.
+   */
+  template<typename IteratorType>
+  static void PreprocessCounts(const size_t /* line */,
+                               const size_t /* numTokens */,
+                               IteratorType /* begin */,
+                               IteratorType /* end */)
+  { }
+
   /**
    * Serialize the class to the given archive.
    */
@@ -156,6 +194,28 @@ class BagOfWordsEncodingPolicy
   }
 };
 
+/**
+ * The specialization provides some information about the bag of words encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<BagOfWordsEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy computes the value of each token of a string from
+   * the number of times when the token occurs in the string, the number of
+   * tokens in the string and the number of strings that contain the token
+   * only.
+   */
+  static const bool countEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
  * and the default dictionary for the given token type.
@@ -133,6 +133,14 @@ struct StringEncodingPolicyTraits<DictionaryEncodingPolicy>
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the policy computes the value of each token of a string from
+   * the number of times when the token occurs in the string, the number of
+   * tokens in the string and the number of strings that contain the token
+   * only.
+   */
+  static const bool countEncoding = false;
 };
 
 /**
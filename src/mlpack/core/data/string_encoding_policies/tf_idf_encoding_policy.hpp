@@ -191,6 +191,30 @@ class TfIdfEncodingPolicy
     output[line][value - 1] =  tf * idf;
   }
 
+  /**
+   * The function computes the tf-idf value of a token of a string from the
+   * given statistics.  It is used when encoding into sparse matrices in
+   * parallel, where the statistics are gathered by the encoder rather than by
+   * PreprocessToken().
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of times when the token occurs in the
+   *                       string.
+   * @param numTokens The total number of tokens in the string.
+   * @param numLines The number of strings in the input dataset.
+   * @param numContainingStrings The number of strings which contain the token.
+   */
+  template<typename ElemType>
+  ElemType EncodeCount(const size_t numOccurrences,
+                       const size_t numTokens,
+                       const size_t numLines,
+                       const size_t numContainingStrings)
+  {
+    return TermFrequency<ElemType>(numOccurrences, numTokens) *
+        InverseDocumentFrequency<ElemType>(numLines, numContainingStrings);
+  }
+
   /*
    * The function calculates the necessary statistics for the purpose
    * of the tf-idf algorithm during the first pass through the dataset.
@@ -217,6 +241,45 @@ class TfIdfEncodingPolicy
     linesSizes[line]++;
   }
 
+  /**
+   * The function stores the statistics of a string that were counted by the
+   * parallel sparse encoder, which calls it instead of PreprocessToken() for
+   * each string in order.  Afterwards, the statistics are the same as if
+   * PreprocessToken() had been called for each token.
+   *
+   * @tparam IteratorType Type of an iterator over pairs of a token and the
+   *                      number of times when the token occurs in the string.
+   *
+   * @param line The line number of the string.
+   * @param numTokens The total number of tokens in the string.
+   * @param begin Iterator to the first distinct token of the string.
+   * @param end Iterator past the last distinct token of the string.
+   */
+  template<typename IteratorType>
+  void PreprocessCounts(const size_t line,
+                        const size_t numTokens,
+                        IteratorType begin,
+                        IteratorType end)
+  {
+    // PreprocessToken() never sees strings without tokens.
+    if (numTokens == 0)
+      return;
+
+    if (line >= tokensFrequences.size())
+    {
+      linesSizes.resize(line + 1);
+      tokensFrequences.resize(line + 1);
+    }
+
+    for (IteratorType it = begin; it != end; ++it)
+    {
+      tokensFrequences[line][it->first] += it->second;
+      numContainingStrings[it->first]++;
+    }
+
+    linesSizes[line] += numTokens;
+  }
+
   //! Return token frequencies.
   const std::vector<std::unordered_map<size_t, size_t>>&
       TokensFrequences() const { return tokensFrequences; }
@@ -334,6 +397,28 @@ class TfIdfEncodingPolicy
   bool smoothIdf;
 };
 
+/**
+ * The specialization provides some information about the tf-idf encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<TfIdfEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy computes the value of each token of a string from
+   * the number of times when the token occurs in the string, the number of
+   * tokens in the string and the number of strings that contain the token
+   * only.
+   */
+  static const bool countEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
  * and the default dictionary for the given token type.
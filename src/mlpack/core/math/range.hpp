@@ -57,6 +57,15 @@ class RangeType
    */
   inline RangeType(const T lo, const T hi);
 
+  /**
+   * Convert a range with another element type, such as the double-precision
+   * range of a bound that holds single-precision points.
+   *
+   * @param other Range to convert.
+   */
+  template<typename U>
+  inline RangeType(const RangeType<U>& other);
+
   //! Get the lower bound.
   inline T Lo() const { return lo; }
   //! Modify the lower bound.
@@ -40,6 +40,14 @@ template<typename T>
 inline RangeType<T>::RangeType(const T lo, const T hi) :
     lo(lo), hi(hi) { /* nothing else to do */ }
 
+/**
+ * Converts a range with another element type.
+ */
+template<typename T>
+template<typename U>
+inline RangeType<T>::RangeType(const RangeType<U>& other) :
+    lo(T(other.Lo())), hi(T(other.Hi())) { /* nothing else to do */ }
+
 /**
  * Gets the span of the range, hi - lo.  Returns 0 if the range is negative.
  */
@@ -20,6 +20,28 @@
 namespace mlpack {
 namespace metric {
 
+/**
+ * AccumulationType<ElemType, AccumType>::type is the type in which LMetric sums
+ * the terms of the distance between two dense points with the given element
+ * type, when the metric was given AccumType as its accumulation type.  With
+ * the default (void), this is the element type itself.  Otherwise it is the
+ * wider of the two types, so that, for instance, LMetric<2, true, double> sums
+ * the terms of the distance between single-precision points in double
+ * precision, but never sums double-precision points in float.
+ */
+template<typename ElemType, typename AccumType>
+struct AccumulationType
+{
+  typedef typename std::common_type<ElemType, AccumType>::type type;
+};
+
+//! By default, sums are done in the element type.
+template<typename ElemType>
+struct AccumulationType<ElemType, void>
+{
+  typedef ElemType type;
+};
+
 /**
  * The L_p metric for arbitrary integer p, with an option to take the root.
  *
@@ -58,8 +80,14 @@ namespace metric {
  * @tparam TakeRoot If true, the Power'th root of the result is taken before it
  *    is returned.  Setting this to false causes the metric to not satisfy the
  *    Triangle Inequality (be careful!).
+ * @tparam AccumulationType Type in which the terms of distances between dense
+ *    points are summed, if it is wider than the element type of the points
+ *    (see AccumulationType).  The default (void) sums in the element type.
+ *    Summing single-precision points in double costs little, since the points
+ *    are still read as floats, but it avoids most of the rounding error of
+ *    long sums in float.
  */
-template<int TPower, bool TTakeRoot = true>
+template<int TPower, bool TTakeRoot = true, typename TAccumulationType = void>
 class LMetric
 {
  public:
@@ -83,6 +111,37 @@ class LMetric
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the distance between every column of a and every column of b at
+   * once, so that distances(i, j) holds the distance between a.col(i) and
+   * b.col(j).  The differences are accumulated one dimension at a time over
+   * all columns of a, which the compiler can vectorize; identical points get a
+   * distance of exactly zero.
+   *
+   * If expandNorms is true and the (squared) Euclidean distance is used, the
+   * block is instead computed with the expansion
+   * ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a^T b, so that most of the work is done
+   * by a single matrix multiplication.  This is much faster on
+   * high-dimensional data, but the distances are only approximate: the
+   * rounding error is relative to the norms of the points, so for instance
+   * identical points may get a small nonzero distance.
+   *
+   * @tparam MatTypeA Type of the first matrix (must be dense).
+   * @tparam MatTypeB Type of the second matrix (must be dense).
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param distances Matrix to store the distances in; it is resized to
+   *     a.n_cols x b.n_cols.
+   * @param expandNorms If true, use the norm expansion for the (squared)
+   *     Euclidean distance.
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static void EvaluateBlock(
+      const MatTypeA& a,
+      const MatTypeB& b,
+      arma::Mat<typename MatTypeA::elem_type>& distances,
+      const bool expandNorms = false);
+
   //! Serialize the metric (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -91,6 +150,62 @@ class LMetric
   static const int Power = TPower;
   //! Whether or not the root is taken.
   static const bool TakeRoot = TTakeRoot;
+
+ private:
+  //! Compute the distance with Armadillo expressions, summing in the element
+  //! type.
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateDirect(const VecTypeA& a,
+                                                     const VecTypeB& b);
+
+  //! Compute the distance between two dense points, summing in the
+  //! accumulation type of the metric.
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateAccumulated(const VecTypeA& a,
+                                                          const VecTypeB& b);
+
+  //! Use EvaluateDirect() when no wider accumulation type is needed.
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateImpl(const VecTypeA& a,
+                                                   const VecTypeB& b,
+                                                   std::false_type /* wider */)
+  {
+    return EvaluateDirect(a, b);
+  }
+
+  //! Use EvaluateAccumulated() when a wider accumulation type is needed.
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateImpl(const VecTypeA& a,
+                                                   const VecTypeB& b,
+                                                   std::true_type /* wider */)
+  {
+    return EvaluateAccumulated(a, b);
+  }
+
+  //! Add the contribution of one dimension, with absolute difference diff, to
+  //! the given partial sum.
+  template<typename ElemType>
+  static ElemType Accumulate(const ElemType sum, const ElemType diff);
+
+  //! Take the root of a sum of terms, if the metric takes roots.
+  template<typename ElemType>
+  static ElemType Root(const ElemType sum);
+
+  //! Store block sums that were accumulated in the element type itself.
+  template<typename ElemType>
+  static void StoreSums(arma::Mat<ElemType>& sums,
+                        arma::Mat<ElemType>& distances)
+  {
+    distances.swap(sums);
+  }
+
+  //! Store block sums that were accumulated in a wider type.
+  template<typename AccumType, typename ElemType>
+  static void StoreSums(arma::Mat<AccumType>& sums,
+                        arma::Mat<ElemType>& distances)
+  {
+    distances = arma::conv_to<arma::Mat<ElemType>>::from(sums);
+  }
 };
 
 // Convenience typedefs.
@@ -18,13 +18,57 @@
 namespace mlpack {
 namespace metric {
 
+// Choose whether the distance must be summed in a wider type.
+template<int Power, bool TakeRoot, typename TAccumulationType>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type
+LMetric<Power, TakeRoot, TAccumulationType>::Evaluate(
+    const VecTypeA& a,
+    const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  // Sparse points are always handled by Armadillo.
+  typedef std::integral_constant<bool, !std::is_same<typename
+      AccumulationType<ElemType, TAccumulationType>::type, ElemType>::value &&
+      !arma::is_arma_sparse_type<VecTypeA>::value &&
+      !arma::is_arma_sparse_type<VecTypeB>::value> Wider;
+
+  return EvaluateImpl(a, b, Wider());
+}
+
+// Sum the terms of the distance in the accumulation type.
+template<int Power, bool TakeRoot, typename TAccumulationType>
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type
+LMetric<Power, TakeRoot, TAccumulationType>::EvaluateAccumulated(
+    const VecTypeA& a,
+    const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+  typedef typename AccumulationType<ElemType, TAccumulationType>::type
+      AccumType;
+
+  AccumType sum = 0;
+  for (size_t i = 0; i < a.n_elem; ++i)
+    sum = Accumulate(sum, AccumType(std::abs(AccumType(a[i]) - b[i])));
+
+  return ElemType(Root(sum));
+}
+
 // Unspecialized implementation.  This should almost never be used...
-template<int Power, bool TakeRoot>
+template<int Power, bool TakeRoot, typename TAccumulationType>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
+typename VecTypeA::elem_type
+LMetric<Power, TakeRoot, TAccumulationType>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  // If the accumulation type is no wider than the element type, the distance
+  // is the same as for the default metric, which is specialized below.
+  if (!std::is_void<TAccumulationType>::value)
+    return LMetric<Power, TakeRoot>::Evaluate(a, b);
+
   typename VecTypeA::elem_type sum = 0;
   for (size_t i = 0; i < a.n_elem; ++i)
     sum += std::pow(fabs(a[i] - b[i]), Power);
@@ -38,7 +82,7 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
 // L1-metric specializations; the root doesn't matter.
 template<>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
+typename VecTypeA::elem_type LMetric<1, true>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
@@ -47,7 +91,7 @@ typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
 
 template<>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
+typename VecTypeA::elem_type LMetric<1, false>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
@@ -57,7 +101,7 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
 // L2-metric specializations.
 template<>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
+typename VecTypeA::elem_type LMetric<2, true>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
@@ -66,7 +110,7 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
 
 template<>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
+typename VecTypeA::elem_type LMetric<2, false>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
@@ -76,7 +120,7 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
 // L3-metric specialization (not very likely to be used, but just in case).
 template<>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<3, true>::Evaluate(
+typename VecTypeA::elem_type LMetric<3, true>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
@@ -89,7 +133,7 @@ typename VecTypeA::elem_type LMetric<3, true>::Evaluate(
 
 template<>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<3, false>::Evaluate(
+typename VecTypeA::elem_type LMetric<3, false>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
@@ -99,13 +143,106 @@ typename VecTypeA::elem_type LMetric<3, false>::Evaluate(
 // L-infinity (Chebyshev distance) specialization
 template<>
 template<typename VecTypeA, typename VecTypeB>
-typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
+typename VecTypeA::elem_type LMetric<INT_MAX, false>::EvaluateDirect(
     const VecTypeA& a,
     const VecTypeB& b)
 {
   return arma::as_scalar(arma::max(arma::abs(a - b)));
 }
 
+// Block evaluation, which is shared by every power.
+template<int TPower, bool TTakeRoot, typename TAccumulationType>
+template<typename MatTypeA, typename MatTypeB>
+void LMetric<TPower, TTakeRoot, TAccumulationType>::EvaluateBlock(
+    const MatTypeA& a,
+    const MatTypeB& b,
+    arma::Mat<typename MatTypeA::elem_type>& distances,
+    const bool expandNorms)
+{
+  typedef typename MatTypeA::elem_type ElemType;
+  typedef typename AccumulationType<ElemType, TAccumulationType>::type
+      AccumType;
+
+  // The matrix multiplication is done in the element type, so it is only used
+  // when sums don't need a wider type.
+  if (expandNorms && TPower == 2 && std::is_same<AccumType, ElemType>::value)
+  {
+    // Center both sets on the mean of a first; this keeps the norms small, so
+    // that less precision is lost in the subtraction.
+    const arma::Col<ElemType> center = arma::mean(a, 1);
+    const arma::Mat<ElemType> ac = a.each_col() - center;
+    const arma::Mat<ElemType> bc = b.each_col() - center;
+
+    distances = -2 * ac.t() * bc;
+    distances.each_col() += arma::sum(arma::square(ac), 0).t();
+    distances.each_row() += arma::sum(arma::square(bc), 0);
+
+    // Rounding may leave tiny negative values for (nearly) identical points.
+    distances.elem(arma::find(distances < 0)).zeros();
+
+    if (TTakeRoot)
+      distances = arma::sqrt(distances);
+  }
+  else
+  {
+    // Store the points of a row-wise, so that each dimension is contiguous and
+    // the inner loop runs over every point of a.
+    const arma::Mat<ElemType> at = arma::trans(a);
+    arma::Mat<AccumType> sums(a.n_cols, b.n_cols, arma::fill::zeros);
+    for (size_t j = 0; j < b.n_cols; ++j)
+    {
+      AccumType* out = sums.colptr(j);
+      for (size_t d = 0; d < a.n_rows; ++d)
+      {
+        const ElemType* dim = at.colptr(d);
+        const AccumType value = b(d, j);
+        for (size_t i = 0; i < a.n_cols; ++i)
+          out[i] = Accumulate(out[i], AccumType(std::abs(dim[i] - value)));
+      }
+    }
+
+    // The root makes no difference for the L1 and L-infinity distances.
+    if (TTakeRoot && TPower == 2)
+      sums = arma::sqrt(sums);
+    else if (TTakeRoot && TPower != 1 && TPower != INT_MAX)
+      sums = arma::pow(sums, 1.0 / TPower);
+
+    StoreSums(sums, distances);
+  }
+}
+
+template<int TPower, bool TTakeRoot, typename TAccumulationType>
+template<typename ElemType>
+inline ElemType LMetric<TPower, TTakeRoot, TAccumulationType>::Accumulate(
+    const ElemType sum,
+    const ElemType diff)
+{
+  if (TPower == INT_MAX)
+    return std::max(sum, diff);
+
+  // Integer powers are much cheaper by repeated multiplication than with
+  // std::pow(); the loop is unrolled at compile-time.
+  ElemType result = diff;
+  for (int i = 1; i < TPower; ++i)
+    result *= diff;
+
+  return sum + result;
+}
+
+template<int TPower, bool TTakeRoot, typename TAccumulationType>
+template<typename ElemType>
+inline ElemType LMetric<TPower, TTakeRoot, TAccumulationType>::Root(
+    const ElemType sum)
+{
+  // The root makes no difference for the L1 and L-infinity distances.
+  if (!TTakeRoot || TPower == 1 || TPower == INT_MAX)
+    return sum;
+  else if (TPower == 2)
+    return std::sqrt(sum);
+  else
+    return std::pow(sum, ElemType(1.0 / TPower));
+}
+
 } // namespace metric
 } // namespace mlpack
 
@@ -279,16 +279,19 @@ template<typename MatType>
 const BallBound<MetricType, VecType>&
 BallBound<MetricType, VecType>::operator|=(const MatType& data)
 {
+  // The points may have a different element type than the center (for
+  // instance, a tree built on single-precision data).
   if (radius < 0)
   {
-    center = data.col(0);
+    center = arma::conv_to<VecType>::from(data.col(0));
     radius = 0;
   }
 
   // Now iteratively add points.
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    const ElemType dist = metric->Evaluate(center, (VecType) data.col(i));
+    const ElemType dist = metric->Evaluate(center,
+        arma::conv_to<VecType>::from(data.col(i)));
 
     // See if the new point lies outside the bound.
     if (dist > radius)
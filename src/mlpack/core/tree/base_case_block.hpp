@@ -0,0 +1,200 @@
+/**
+ * @file core/tree/base_case_block.hpp
+ *
+ * The BaseCaseBlock class, which holds the distances between all points of a
+ * query leaf and a reference leaf, so that dual-tree rules can compute them in
+ * a single batched call instead of one pair at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BASE_CASE_BLOCK_HPP
+#define MLPACK_CORE_TREE_BASE_CASE_BLOCK_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * BaseCaseBlock holds the distances between a contiguous range of query points
+ * and a contiguous range of reference points.  A RuleType class can hold one
+ * of these and provide a PrepareBaseCases() method:
+ *
+ * @code
+ * void PrepareBaseCases(const size_t queryBegin,
+ *                       const size_t queryCount,
+ *                       const size_t referenceBegin,
+ *                       const size_t referenceCount);
+ * @endcode
+ *
+ * Traversals for trees whose leaves hold contiguous ranges of points call this
+ * method before they call BaseCase() on the points of a pair of leaves (see
+ * PrepareBaseCases() below), and BaseCase() can then take the distance from
+ * the block with Distance() instead of evaluating the metric.
+ *
+ * The block is only computed when the metric is an LMetric, the data is a
+ * dense matrix, and the block is large enough that batching is worthwhile; in
+ * every other case Distance() returns false and the rules should evaluate the
+ * metric themselves.  The block only holds distances for the datasets it was
+ * computed on, so it must not outlive them.
+ *
+ * @tparam MetricType Metric type of the rules.
+ * @tparam MatType Matrix type of the query and reference sets.
+ */
+template<typename MetricType, typename MatType>
+class BaseCaseBlock
+{
+ public:
+  //! The element type of the data.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Create an empty block.
+  BaseCaseBlock() : queryBegin(0), referenceBegin(0) { }
+
+  /**
+   * Compute the distances between the query points [queryBegin, queryBegin +
+   * queryCount) and the reference points [referenceBegin, referenceBegin +
+   * referenceCount), if possible.
+   *
+   * @param querySet Set of query points.
+   * @param queryBegin Index of the first query point.
+   * @param queryCount Number of query points.
+   * @param referenceSet Set of reference points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void Compute(const MatType& querySet,
+               const size_t queryBegin,
+               const size_t queryCount,
+               const MatType& referenceSet,
+               const size_t referenceBegin,
+               const size_t referenceCount)
+  {
+    this->queryBegin = queryBegin;
+    this->referenceBegin = referenceBegin;
+
+    // Small blocks aren't worth it, and very large blocks take too much
+    // memory.
+    const size_t size = queryCount * referenceCount;
+    if (queryCount == 0 || referenceCount == 0 || size < MinimumSize ||
+        size > MaximumSize)
+    {
+      distances.reset();
+      return;
+    }
+
+    ComputeBlock(querySet, queryCount, referenceSet, referenceCount);
+  }
+
+  /**
+   * Get the distance between the given query and reference point from the
+   * block.  If the pair is not in the block, false is returned and distance is
+   * not modified.
+   *
+   * @param queryIndex Index of the query point.
+   * @param referenceIndex Index of the reference point.
+   * @param distance Set to the distance between the points.
+   */
+  bool Distance(const size_t queryIndex,
+                const size_t referenceIndex,
+                double& distance) const
+  {
+    // Indices below the beginning of the block wrap around to large values.
+    const size_t q = queryIndex - queryBegin;
+    const size_t r = referenceIndex - referenceBegin;
+    if (q >= distances.n_cols || r >= distances.n_rows)
+      return false;
+
+    distance = distances(r, q);
+    return true;
+  }
+
+  //! Forget the block.
+  void Reset() { distances.reset(); }
+
+  //! The minimum number of pairs for which a block is computed.
+  static const size_t MinimumSize = 64;
+  //! The maximum number of pairs for which a block is computed.
+  static const size_t MaximumSize = 1048576;
+
+ private:
+  //! Compute the block with the batched LMetric kernel.
+  template<typename M = MetricType>
+  void ComputeBlock(
+      const MatType& querySet,
+      const size_t queryCount,
+      const MatType& referenceSet,
+      const size_t referenceCount,
+      const typename std::enable_if<bound::meta::IsLMetric<M>::Value &&
+          arma::is_Mat<MatType>::value>::type* = 0)
+  {
+    M::EvaluateBlock(
+        referenceSet.cols(referenceBegin, referenceBegin + referenceCount - 1),
+        querySet.cols(queryBegin, queryBegin + queryCount - 1), distances);
+  }
+
+  //! Other metrics and sparse data have no batched kernel.
+  template<typename M = MetricType>
+  void ComputeBlock(
+      const MatType& /* querySet */,
+      const size_t /* queryCount */,
+      const MatType& /* referenceSet */,
+      const size_t /* referenceCount */,
+      const typename std::enable_if<!(bound::meta::IsLMetric<M>::Value &&
+          arma::is_Mat<MatType>::value)>::type* = 0)
+  {
+    distances.reset();
+  }
+
+  //! The distances; column i holds the distances of query point queryBegin + i.
+  arma::Mat<ElemType> distances;
+  //! The index of the first query point of the block.
+  size_t queryBegin;
+  //! The index of the first reference point of the block.
+  size_t referenceBegin;
+};
+
+// SFINAE check for rules that can prepare the base cases of a pair of leaves.
+HAS_MEM_FUNC(PrepareBaseCases, HasPrepareBaseCases);
+
+/**
+ * Let the rules prepare the base cases between the query points [queryBegin,
+ * queryBegin + queryCount) and the reference points [referenceBegin,
+ * referenceBegin + referenceCount), if the rules provide PrepareBaseCases().
+ */
+template<typename RuleType>
+inline void PrepareBaseCases(
+    RuleType& rule,
+    const size_t queryBegin,
+    const size_t queryCount,
+    const size_t referenceBegin,
+    const size_t referenceCount,
+    const typename std::enable_if<HasPrepareBaseCases<RuleType,
+        void(RuleType::*)(size_t, size_t, size_t, size_t)>::value>::type* = 0)
+{
+  rule.PrepareBaseCases(queryBegin, queryCount, referenceBegin,
+      referenceCount);
+}
+
+//! Rules without PrepareBaseCases() evaluate every base case themselves.
+template<typename RuleType>
+inline void PrepareBaseCases(
+    RuleType& /* rule */,
+    const size_t /* queryBegin */,
+    const size_t /* queryCount */,
+    const size_t /* referenceBegin */,
+    const size_t /* referenceCount */,
+    const typename std::enable_if<!HasPrepareBaseCases<RuleType,
+        void(RuleType::*)(size_t, size_t, size_t, size_t)>::value>::type* = 0)
+{
+  // Nothing to do.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
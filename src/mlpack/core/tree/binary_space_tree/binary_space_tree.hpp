@@ -14,6 +14,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "../statistic.hpp"
+#include "../split_traits.hpp"
 #include "midpoint_split.hpp"
 
 namespace mlpack {
@@ -529,6 +530,41 @@ class BinarySpaceTree
                  const size_t maxLeafSize,
                  SplitType<BoundType<MetricType>, MatType>& splitter);
 
+  /**
+   * Create the left and right children of this node, holding the points in
+   * [begin, splitCol) and [splitCol, begin + count).  If the split type is
+   * deterministic and the node is large enough, the children are built in
+   * parallel as OpenMP tasks; the resulting tree is the same as a serial
+   * build.
+   *
+   * @param splitCol The first point of the right child.
+   * @param oldFromNew Vector holding permuted indices, or NULL if indices are
+   *     not being tracked.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void CreateChildren(const size_t splitCol,
+                      std::vector<size_t>* oldFromNew,
+                      const size_t maxLeafSize,
+                      SplitType<BoundType<MetricType>, MatType>& splitter);
+
+  /**
+   * Create one child of this node.
+   *
+   * @param childBegin The first point of the child.
+   * @param childCount The number of points in the child.
+   * @param oldFromNew Vector holding permuted indices, or NULL if indices are
+   *     not being tracked.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  BinarySpaceTree* CreateChild(
+      const size_t childBegin,
+      const size_t childCount,
+      std::vector<size_t>* oldFromNew,
+      const size_t maxLeafSize,
+      SplitType<BoundType<MetricType>, MatType>& splitter);
+
   /**
    * Update the bound of the current node. This method does not take into
    * account bound-specific properties.
@@ -558,6 +594,10 @@ class BinarySpaceTree
   //! Friend access is given for the default constructor.
   friend class cereal::access;
 
+  //! Index files create the nodes of a tree directly.
+  template<typename TreeType>
+  friend class TreeIndexFile;
+
  public:
   /**
    * Serialize the tree.
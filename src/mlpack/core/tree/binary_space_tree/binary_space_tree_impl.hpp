@@ -17,6 +17,10 @@
 #include <mlpack/core/util/log.hpp>
 #include <queue>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -904,10 +908,7 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  CreateChildren(splitCol, NULL, maxLeafSize, splitter);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -972,10 +973,7 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  CreateChildren(splitCol, &oldFromNew, maxLeafSize, splitter);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -992,6 +990,95 @@ SplitNode(std::vector<size_t>& oldFromNew,
   right->ParentDistance() = rightParentDistance;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+CreateChildren(const size_t splitCol,
+               std::vector<size_t>* oldFromNew,
+               const size_t maxLeafSize,
+               SplitType<BoundType<MetricType>, MatType>& splitter)
+{
+  // Subtrees can only be built at the same time if splitting a node doesn't
+  // depend on anything outside of the node.  (HollowBallBound also looks at
+  // the sibling of a node.)
+  const bool deterministic = SplitTraits<Split>::IsDeterministic &&
+      !std::is_same<BoundType<MetricType>,
+                    bound::HollowBallBound<MetricType>>::value;
+
+  // Below this size, tasks cost more than they save.
+  const size_t parallelBuildThreshold = 16384;
+
+  #ifdef HAS_OPENMP
+  if (deterministic && count >= parallelBuildThreshold)
+  {
+    // The children own disjoint ranges of the dataset (and of oldFromNew), so
+    // the left child can be built in a task while this thread builds the
+    // right child.  If this is the root, start a team for the tasks.
+    if (omp_in_parallel())
+    {
+      #pragma omp task shared(splitter)
+      left = CreateChild(begin, splitCol - begin, oldFromNew, maxLeafSize,
+          splitter);
+      right = CreateChild(splitCol, begin + count - splitCol, oldFromNew,
+          maxLeafSize, splitter);
+      #pragma omp taskwait
+    }
+    else
+    {
+      #pragma omp parallel
+      {
+        #pragma omp single
+        {
+          #pragma omp task shared(splitter)
+          left = CreateChild(begin, splitCol - begin, oldFromNew, maxLeafSize,
+              splitter);
+          right = CreateChild(splitCol, begin + count - splitCol, oldFromNew,
+              maxLeafSize, splitter);
+          #pragma omp taskwait
+        }
+      }
+    }
+
+    return;
+  }
+  #endif
+
+  left = CreateChild(begin, splitCol - begin, oldFromNew, maxLeafSize,
+      splitter);
+  right = CreateChild(splitCol, begin + count - splitCol, oldFromNew,
+      maxLeafSize, splitter);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+CreateChild(const size_t childBegin,
+            const size_t childCount,
+            std::vector<size_t>* oldFromNew,
+            const size_t maxLeafSize,
+            SplitType<BoundType<MetricType>, MatType>& splitter)
+{
+  if (oldFromNew)
+  {
+    return new BinarySpaceTree(this, childBegin, childCount, *oldFromNew,
+        splitter, maxLeafSize);
+  }
+  else
+  {
+    return new BinarySpaceTree(this, childBegin, childCount, splitter,
+        maxLeafSize);
+  }
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -17,6 +17,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <queue>
+#include <mlpack/core/tree/base_case_block.hpp>
 
 #include "../binary_space_tree.hpp"
 
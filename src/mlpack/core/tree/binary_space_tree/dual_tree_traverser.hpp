@@ -16,6 +16,7 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_DUAL_TREE_TRAVERSER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/base_case_block.hpp>
 
 #include "binary_space_tree.hpp"
 
@@ -74,6 +74,12 @@ DualTreeTraverser<RuleType>::Traverse(
     // Loop through each of the points in each node.
     const size_t queryEnd = queryNode.Begin() + queryNode.Count();
     const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+
+    // The points of each leaf are contiguous, so the rules may compute all of
+    // the base cases between the two leaves at once.
+    PrepareBaseCases(rule, queryNode.Begin(), queryNode.Count(),
+        referenceNode.Begin(), referenceNode.Count());
+
     for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
     {
       // See if we need to investigate this point (this function should be
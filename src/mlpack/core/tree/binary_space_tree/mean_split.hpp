@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include <mlpack/core/tree/split_traits.hpp>
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -117,6 +118,14 @@ class MeanSplit
   }
 };
 
+// A specialization of SplitTraits for this class.
+template<typename BoundType, typename MatType>
+struct SplitTraits<MeanSplit<BoundType, MatType>>
+{
+  //! The split only depends on the bound and the mean of the node's points.
+  static const bool IsDeterministic = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -17,6 +17,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include <mlpack/core/tree/split_traits.hpp>
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -117,6 +118,14 @@ class MidpointSplit
   }
 };
 
+// A specialization of SplitTraits for this class.
+template<typename BoundType, typename MatType>
+struct SplitTraits<MidpointSplit<BoundType, MatType>>
+{
+  //! The split only depends on the bound of the node.
+  static const bool IsDeterministic = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,276 @@
+/**
+ * @file core/tree/binary_space_tree/tree_index_file.hpp
+ *
+ * Definition of TreeIndexFile, a flat file format for prebuilt
+ * BinarySpaceTrees that can be memory-mapped and used without deserializing
+ * the tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_TREE_INDEX_FILE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_TREE_INDEX_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+#include <mlpack/core/tree/ballbound.hpp>
+#include <cstdint>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * IndexBound describes how a bound type is stored in a TreeIndexFile: each
+ * bound is written as Elements(dimensionality) values of the element type of
+ * the bound, which need not be the element type of the dataset.  Only bounds
+ * with a specialization can be stored.
+ */
+template<typename BoundType>
+struct IndexBound
+{
+  //! Whether the bound type can be stored in an index file.
+  static const bool Supported = false;
+};
+
+//! HRectBounds are stored as the lo and hi values of each dimension, followed
+//! by the minimum width.
+template<typename MetricType, typename BoundElemType>
+struct IndexBound<bound::HRectBound<MetricType, BoundElemType>>
+{
+  typedef BoundElemType ElemType;
+
+  static const bool Supported = true;
+  static const uint32_t Kind = 1;
+
+  static size_t Elements(const size_t dimensionality)
+  {
+    return 2 * dimensionality + 1;
+  }
+
+  static void Save(const bound::HRectBound<MetricType, BoundElemType>& bound,
+                   ElemType* values)
+  {
+    for (size_t d = 0; d < bound.Dim(); ++d)
+    {
+      values[2 * d] = bound[d].Lo();
+      values[2 * d + 1] = bound[d].Hi();
+    }
+    values[2 * bound.Dim()] = bound.MinWidth();
+  }
+
+  static void Load(const ElemType* values,
+                   const size_t dimensionality,
+                   bound::HRectBound<MetricType, BoundElemType>& bound)
+  {
+    bound = bound::HRectBound<MetricType, BoundElemType>(dimensionality);
+    for (size_t d = 0; d < dimensionality; ++d)
+    {
+      bound[d].Lo() = values[2 * d];
+      bound[d].Hi() = values[2 * d + 1];
+    }
+    bound.MinWidth() = values[2 * dimensionality];
+  }
+};
+
+//! BallBounds are stored as the center followed by the radius.
+template<typename MetricType, typename VecType>
+struct IndexBound<bound::BallBound<MetricType, VecType>>
+{
+  typedef typename VecType::elem_type ElemType;
+
+  static const bool Supported = true;
+  static const uint32_t Kind = 2;
+
+  static size_t Elements(const size_t dimensionality)
+  {
+    return dimensionality + 1;
+  }
+
+  static void Save(const bound::BallBound<MetricType, VecType>& bound,
+                   ElemType* values)
+  {
+    for (size_t d = 0; d < bound.Dim(); ++d)
+      values[d] = bound.Center()[d];
+    values[bound.Dim()] = bound.Radius();
+  }
+
+  static void Load(const ElemType* values,
+                   const size_t dimensionality,
+                   bound::BallBound<MetricType, VecType>& bound)
+  {
+    bound.Center().set_size(dimensionality);
+    for (size_t d = 0; d < dimensionality; ++d)
+      bound.Center()[d] = values[d];
+    bound.Radius() = values[dimensionality];
+  }
+};
+
+/**
+ * A TreeIndexFile is a prebuilt BinarySpaceTree stored in a single flat file.
+ * The file holds the points of the dataset in the order of the tree (that is,
+ * permuted as described by oldFromNew), the oldFromNew mapping itself, and a
+ * table with the structure, distances and bound of every node, laid out
+ * contiguously in depth-first order.
+ *
+ * Opening the file memory-maps it (or reads it in one piece where mmap() is
+ * not available).  LoadTree() then creates the tree nodes directly from the
+ * node table, without deserializing anything and without copying the points:
+ * the dataset of the returned tree is a read-only view of the mapped file.
+ * Because node statistics are not stored but created fresh, the tree can be
+ * loaded with any statistic type, so that one index file can be used by
+ * NeighborSearch, RangeSearch and KDE alike:
+ *
+ * @code
+ * // Build and save the index once.
+ * std::vector<size_t> oldFromNew;
+ * KDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(data, oldFromNew);
+ * TreeIndexFile<decltype(tree)>::Save("index.bin", tree, oldFromNew);
+ *
+ * // Later, load it and use it for range search.
+ * typedef RangeSearch<>::Tree TreeType;
+ * TreeIndexFile<TreeType> index("index.bin");
+ * std::unique_ptr<TreeType> referenceTree(index.LoadTree());
+ * RangeSearch<> rs(referenceTree.get());
+ * @endcode
+ *
+ * The TreeIndexFile must outlive every tree loaded from it.  Results computed
+ * with a loaded tree refer to the points in tree order; use OldFromNew() to
+ * map them back to the original dataset.  The file format uses the native
+ * byte order and element size of the machine that saved it.
+ *
+ * Only trees whose bound has an IndexBound specialization (HRectBound and
+ * BallBound) and whose dataset is a dense Armadillo matrix can be stored.
+ *
+ * @tparam TreeType Type of BinarySpaceTree to load.
+ */
+template<typename TreeType>
+class TreeIndexFile
+{
+ public:
+  //! The type of element held in the dataset.
+  typedef typename TreeType::ElemType ElemType;
+  //! The type of the bound of each node.
+  typedef typename std::decay<decltype(
+      std::declval<const TreeType&>().Bound())>::type BoundType;
+
+  static_assert(IndexBound<BoundType>::Supported,
+      "TreeIndexFile can only store trees with HRectBound or BallBound.");
+  static_assert(arma::is_Mat<typename TreeType::Mat>::value,
+      "TreeIndexFile can only store trees built on dense matrices.");
+
+  //! The type of element held in the bounds.
+  typedef typename IndexBound<BoundType>::ElemType BoundElemType;
+
+  /**
+   * Save the given tree, its dataset and the given mapping to an index file.
+   * Throws std::runtime_error if the file cannot be written.
+   *
+   * @param filename File to save to.
+   * @param tree Root of the tree to save.
+   * @param oldFromNew Mapping from the points of the tree to the original
+   *     dataset, as given when building the tree.  May be empty.
+   */
+  template<typename SaveTreeType>
+  static void Save(const std::string& filename,
+                   const SaveTreeType& tree,
+                   const std::vector<size_t>& oldFromNew);
+
+  /**
+   * Open the given index file.  Throws std::runtime_error if the file cannot
+   * be opened or was not saved with a compatible tree type.
+   *
+   * @param filename File to open.
+   */
+  TreeIndexFile(const std::string& filename);
+
+  //! Unmap the file.  Every tree loaded from it must be destroyed first.
+  ~TreeIndexFile();
+
+  //! The mapping can't be copied.
+  TreeIndexFile(const TreeIndexFile& other) = delete;
+  //! The mapping can't be copied.
+  TreeIndexFile& operator=(const TreeIndexFile& other) = delete;
+
+  /**
+   * Create the tree stored in the file.  The caller owns the returned tree,
+   * which must be destroyed before this object.  The dataset of the tree
+   * points into the mapped file and must not be modified.
+   */
+  TreeType* LoadTree() const;
+
+  //! Get the mapping from the points of the tree to the original dataset.
+  std::vector<size_t> OldFromNew() const;
+
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return header->dimensionality; }
+  //! Get the number of points.
+  size_t NumPoints() const { return header->numPoints; }
+  //! Get the number of nodes of the tree.
+  size_t NumNodes() const { return header->numNodes; }
+
+ private:
+  //! The header at the start of every index file.
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t elemSize;
+    uint32_t boundKind;
+    uint32_t boundElements;
+    uint64_t dimensionality;
+    uint64_t numPoints;
+    uint64_t numNodes;
+    uint64_t numOldFromNew;
+    uint64_t pointsOffset;
+    uint64_t oldFromNewOffset;
+    uint64_t nodesOffset;
+    uint64_t distancesOffset;
+    uint64_t boundsOffset;
+    uint64_t fileSize;
+  };
+
+  //! The magic string at the start of every index file.
+  static const char* Magic() { return "MLPKTIDX"; }
+  //! The current version of the file format.
+  static const uint32_t Version = 1;
+  //! The alignment of each section of the file, in bytes.
+  static const size_t Alignment = 64;
+
+  //! Round the given offset up to the alignment of the sections.
+  static size_t Align(const size_t offset)
+  {
+    return (offset + Alignment - 1) / Alignment * Alignment;
+  }
+
+  //! Get a section of the file.
+  template<typename T>
+  const T* Section(const uint64_t offset) const
+  {
+    return reinterpret_cast<const T*>(data + offset);
+  }
+
+  //! Check that the file is a valid index file for this tree type.
+  void Validate(const std::string& filename) const;
+
+  //! Unmap (or free) the file.
+  void Close();
+
+  //! The contents of the file.
+  const char* data;
+  //! The size of the file, in bytes.
+  size_t size;
+  //! The header of the file.
+  const Header* header;
+  //! Whether the file is memory-mapped (otherwise data was read into memory).
+  bool mapped;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "tree_index_file_impl.hpp"
+
+#endif
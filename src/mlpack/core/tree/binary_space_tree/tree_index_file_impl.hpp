@@ -0,0 +1,394 @@
+/**
+ * @file core/tree/binary_space_tree/tree_index_file_impl.hpp
+ *
+ * Implementation of TreeIndexFile.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_TREE_INDEX_FILE_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_TREE_INDEX_FILE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "tree_index_file.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+template<typename SaveTreeType>
+void TreeIndexFile<TreeType>::Save(const std::string& filename,
+                                   const SaveTreeType& tree,
+                                   const std::vector<size_t>& oldFromNew)
+{
+  static_assert(std::is_same<typename SaveTreeType::ElemType,
+      ElemType>::value, "TreeIndexFile::Save(): element types must match.");
+  static_assert(std::is_same<typename std::decay<decltype(
+      tree.Bound())>::type, BoundType>::value,
+      "TreeIndexFile::Save(): bound types must match.");
+
+  if (tree.Parent() != NULL)
+  {
+    throw std::invalid_argument("TreeIndexFile::Save(): the given node is not "
+        "the root of its tree!");
+  }
+
+  const typename SaveTreeType::Mat& dataset = tree.Dataset();
+  if (!oldFromNew.empty() && oldFromNew.size() != dataset.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "TreeIndexFile::Save(): oldFromNew has " << oldFromNew.size()
+        << " elements, but the dataset has " << dataset.n_cols << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Number the nodes in depth-first order, so that each node comes before its
+  // children.
+  std::vector<const SaveTreeType*> nodes;
+  std::vector<const SaveTreeType*> stack(1, &tree);
+  while (!stack.empty())
+  {
+    const SaveTreeType* node = stack.back();
+    stack.pop_back();
+    nodes.push_back(node);
+    if (node->Right())
+      stack.push_back(node->Right());
+    if (node->Left())
+      stack.push_back(node->Left());
+  }
+
+  std::unordered_map<const SaveTreeType*, uint64_t> indices;
+  for (size_t i = 0; i < nodes.size(); ++i)
+    indices[nodes[i]] = i;
+
+  const size_t dim = dataset.n_rows;
+  const size_t boundElements = IndexBound<BoundType>::Elements(dim);
+
+  Header h;
+  std::memset(&h, 0, sizeof(Header));
+  std::memcpy(h.magic, Magic(), sizeof(h.magic));
+  h.version = Version;
+  h.elemSize = sizeof(ElemType);
+  h.boundKind = IndexBound<BoundType>::Kind;
+  h.boundElements = boundElements;
+  h.dimensionality = dim;
+  h.numPoints = dataset.n_cols;
+  h.numNodes = nodes.size();
+  h.numOldFromNew = oldFromNew.size();
+  h.pointsOffset = Align(sizeof(Header));
+  h.oldFromNewOffset = Align(h.pointsOffset + dataset.n_elem *
+      sizeof(ElemType));
+  h.nodesOffset = Align(h.oldFromNewOffset + oldFromNew.size() *
+      sizeof(uint64_t));
+  h.distancesOffset = Align(h.nodesOffset + 4 * nodes.size() *
+      sizeof(uint64_t));
+  h.boundsOffset = Align(h.distancesOffset + 3 * nodes.size() *
+      sizeof(ElemType));
+  h.fileSize = h.boundsOffset + boundElements * nodes.size() *
+      sizeof(BoundElemType);
+
+  // Build the node sections.
+  std::vector<uint64_t> structure(4 * nodes.size());
+  std::vector<ElemType> distances(3 * nodes.size());
+  std::vector<BoundElemType> bounds(boundElements * nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const SaveTreeType& node = *nodes[i];
+    structure[4 * i] = node.Begin();
+    structure[4 * i + 1] = node.Count();
+    structure[4 * i + 2] = node.Left() ? indices[node.Left()] : 0;
+    structure[4 * i + 3] = node.Right() ? indices[node.Right()] : 0;
+
+    distances[3 * i] = node.ParentDistance();
+    distances[3 * i + 1] = node.FurthestDescendantDistance();
+    distances[3 * i + 2] = node.MinimumBoundDistance();
+
+    IndexBound<BoundType>::Save(node.Bound(), bounds.data() +
+        boundElements * i);
+  }
+
+  std::vector<uint64_t> mapping(oldFromNew.begin(), oldFromNew.end());
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+  {
+    throw std::runtime_error("TreeIndexFile::Save(): cannot open '" +
+        filename + "' for writing!");
+  }
+
+  // Write each section at its offset, padding with zeros in between.
+  size_t position = 0;
+  const char padding[Alignment] = { 0 };
+  auto write = [&](const uint64_t offset, const void* section,
+      const size_t bytes)
+  {
+    out.write(padding, offset - position);
+    out.write(reinterpret_cast<const char*>(section), bytes);
+    position = offset + bytes;
+  };
+
+  write(0, &h, sizeof(Header));
+  write(h.pointsOffset, dataset.memptr(), dataset.n_elem * sizeof(ElemType));
+  write(h.oldFromNewOffset, mapping.data(), mapping.size() * sizeof(uint64_t));
+  write(h.nodesOffset, structure.data(), structure.size() * sizeof(uint64_t));
+  write(h.distancesOffset, distances.data(),
+      distances.size() * sizeof(ElemType));
+  write(h.boundsOffset, bounds.data(),
+      bounds.size() * sizeof(BoundElemType));
+
+  if (!out.good())
+  {
+    throw std::runtime_error("TreeIndexFile::Save(): error while writing '" +
+        filename + "'!");
+  }
+}
+
+template<typename TreeType>
+TreeIndexFile<TreeType>::TreeIndexFile(const std::string& filename) :
+    data(NULL),
+    size(0),
+    header(NULL),
+    mapped(false)
+{
+#ifndef _WIN32
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("TreeIndexFile::TreeIndexFile(): cannot open '" +
+        filename + "'!");
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+  {
+    close(fd);
+    throw std::runtime_error("TreeIndexFile::TreeIndexFile(): cannot read '" +
+        filename + "'!");
+  }
+  size = fileStat.st_size;
+
+  void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    throw std::runtime_error("TreeIndexFile::TreeIndexFile(): cannot map '" +
+        filename + "'!");
+  }
+  data = static_cast<const char*>(mapping);
+  mapped = true;
+#else
+  // Without mmap(), read the whole file at once.  Allocating uint64_t keeps
+  // every section aligned.
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  if (!in.is_open())
+  {
+    throw std::runtime_error("TreeIndexFile::TreeIndexFile(): cannot open '" +
+        filename + "'!");
+  }
+  size = (size_t) in.tellg();
+  uint64_t* buffer = new uint64_t[(size + sizeof(uint64_t) - 1) /
+      sizeof(uint64_t)];
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(buffer), size);
+  data = reinterpret_cast<const char*>(buffer);
+#endif
+
+  header = Section<Header>(0);
+  try
+  {
+    Validate(filename);
+  }
+  catch (...)
+  {
+    Close();
+    throw;
+  }
+}
+
+template<typename TreeType>
+TreeIndexFile<TreeType>::~TreeIndexFile()
+{
+  Close();
+}
+
+template<typename TreeType>
+void TreeIndexFile<TreeType>::Close()
+{
+#ifndef _WIN32
+  if (mapped)
+    munmap(const_cast<char*>(data), size);
+#else
+  delete[] reinterpret_cast<const uint64_t*>(data);
+#endif
+  data = NULL;
+  mapped = false;
+}
+
+template<typename TreeType>
+void TreeIndexFile<TreeType>::Validate(const std::string& filename) const
+{
+  const std::string error = "TreeIndexFile::TreeIndexFile(): '" + filename +
+      "' ";
+  if (size < sizeof(Header) ||
+      std::memcmp(header->magic, Magic(), sizeof(header->magic)) != 0)
+    throw std::runtime_error(error + "is not a tree index file!");
+
+  if (header->version != Version)
+    throw std::runtime_error(error + "has an unsupported version!");
+
+  if (header->elemSize != sizeof(ElemType) ||
+      header->boundKind != IndexBound<BoundType>::Kind ||
+      header->boundElements !=
+          IndexBound<BoundType>::Elements(header->dimensionality))
+  {
+    throw std::runtime_error(error + "was saved with an incompatible tree "
+        "type!");
+  }
+
+  // Check that each section lies inside the file, without overflowing.
+  auto fits = [&](const uint64_t offset, const uint64_t elements,
+      const size_t elemSize)
+  {
+    return (offset % Alignment == 0) && (offset <= size) &&
+        (elements <= (size - offset) / elemSize);
+  };
+
+  const uint64_t numNodes = header->numNodes;
+  const bool valid = (header->fileSize == size) && (numNodes > 0) &&
+      (numNodes <= size) && (header->dimensionality <= size) &&
+      (header->numPoints <= size) &&
+      (header->numOldFromNew == 0 ||
+       header->numOldFromNew == header->numPoints) &&
+      fits(header->pointsOffset, header->dimensionality * header->numPoints,
+          sizeof(ElemType)) &&
+      fits(header->oldFromNewOffset, header->numOldFromNew, sizeof(uint64_t)) &&
+      fits(header->nodesOffset, 4 * numNodes, sizeof(uint64_t)) &&
+      fits(header->distancesOffset, 3 * numNodes, sizeof(ElemType)) &&
+      fits(header->boundsOffset, header->boundElements * numNodes,
+          sizeof(BoundElemType));
+  if (!valid)
+    throw std::runtime_error(error + "is truncated or corrupt!");
+
+  // Make sure the node table describes a tree over the points.
+  const uint64_t* structure = Section<uint64_t>(header->nodesOffset);
+  std::vector<bool> hasParent(header->numNodes, false);
+  for (size_t i = 0; i < header->numNodes; ++i)
+  {
+    const uint64_t begin = structure[4 * i];
+    const uint64_t count = structure[4 * i + 1];
+    const uint64_t left = structure[4 * i + 2];
+    const uint64_t right = structure[4 * i + 3];
+    // A node has either no children or two, and the root holds every point.
+    bool valid = (begin <= header->numPoints) &&
+        (count <= header->numPoints - begin) && ((left == 0) == (right == 0)) &&
+        (i != 0 || (begin == 0 && count == header->numPoints));
+    for (const uint64_t child : { left, right })
+    {
+      if (child == 0)
+        continue;
+
+      // Children always come after their parent.
+      valid &= (child > i) && (child < header->numNodes) && !hasParent[child];
+      if (valid)
+        hasParent[child] = true;
+    }
+
+    // The children must split the points of their parent in two, in order.
+    if (valid && left != 0)
+    {
+      const uint64_t leftBegin = structure[4 * left];
+      const uint64_t leftCount = structure[4 * left + 1];
+      const uint64_t rightBegin = structure[4 * right];
+      const uint64_t rightCount = structure[4 * right + 1];
+      valid = (leftBegin == begin) && (leftCount <= count) &&
+          (rightBegin == begin + leftCount) &&
+          (rightCount == count - leftCount);
+    }
+
+    if (!valid)
+      throw std::runtime_error(error + "has an invalid node table!");
+  }
+
+  // Every node but the root must be a child of another node.
+  if (std::count(hasParent.begin(), hasParent.end(), true) !=
+      (std::ptrdiff_t) header->numNodes - 1)
+    throw std::runtime_error(error + "has an invalid node table!");
+}
+
+template<typename TreeType>
+TreeType* TreeIndexFile<TreeType>::LoadTree() const
+{
+  typedef typename TreeType::Mat MatType;
+  typedef typename std::decay<decltype(
+      std::declval<TreeType&>().Stat())>::type StatisticType;
+
+  const size_t numNodes = header->numNodes;
+  const size_t dim = header->dimensionality;
+  const size_t boundElements = header->boundElements;
+  const uint64_t* structure = Section<uint64_t>(header->nodesOffset);
+  const ElemType* distances = Section<ElemType>(header->distancesOffset);
+  const BoundElemType* bounds =
+      Section<BoundElemType>(header->boundsOffset);
+
+  // The points are used in place; Armadillo won't write to them unless the
+  // matrix is modified.
+  MatType* dataset = new MatType(const_cast<ElemType*>(
+      Section<ElemType>(header->pointsOffset)), dim, header->numPoints, false,
+      true);
+
+  std::vector<TreeType*> nodes(numNodes);
+  for (size_t i = 0; i < numNodes; ++i)
+    nodes[i] = new TreeType();
+
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    TreeType& node = *nodes[i];
+    node.begin = structure[4 * i];
+    node.count = structure[4 * i + 1];
+    node.left = (structure[4 * i + 2] == 0) ? NULL :
+        nodes[structure[4 * i + 2]];
+    node.right = (structure[4 * i + 3] == 0) ? NULL :
+        nodes[structure[4 * i + 3]];
+    if (node.left)
+      node.left->parent = &node;
+    if (node.right)
+      node.right->parent = &node;
+
+    node.dataset = dataset;
+    node.parentDistance = distances[3 * i];
+    node.furthestDescendantDistance = distances[3 * i + 1];
+    node.minimumBoundDistance = distances[3 * i + 2];
+    IndexBound<BoundType>::Load(bounds + boundElements * i, dim, node.bound);
+  }
+
+  // Statistics may depend on the children, so create them bottom-up.
+  for (size_t i = numNodes; i > 0; --i)
+    nodes[i - 1]->stat = StatisticType(*nodes[i - 1]);
+
+  return nodes[0];
+}
+
+template<typename TreeType>
+std::vector<size_t> TreeIndexFile<TreeType>::OldFromNew() const
+{
+  const uint64_t* mapping = Section<uint64_t>(header->oldFromNewOffset);
+  return std::vector<size_t>(mapping, mapping + header->numOldFromNew);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
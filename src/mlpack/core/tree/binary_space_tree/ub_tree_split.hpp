@@ -29,11 +29,13 @@ template<typename BoundType, typename MatType = arma::mat>
 class UBTreeSplit
 {
  public:
-  //! The type of an address element.
-  typedef typename std::conditional<
-      sizeof(typename MatType::elem_type) * CHAR_BIT <= 32,
-      uint32_t,
-      uint64_t>::type AddressElemType;
+  //! The element type of the bound, which may differ from that of the data.
+  typedef typename std::decay<decltype(
+      std::declval<const BoundType&>().MinWidth())>::type BoundElemType;
+
+  //! The type of an address element.  Addresses are computed with the
+  //! precision of the bound, so that they match the addresses it holds.
+  typedef typename BoundType::AddressElemType AddressElemType;
 
   //! An information about the partition.
   struct SplitInfo
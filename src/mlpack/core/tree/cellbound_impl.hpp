@@ -877,8 +877,9 @@ CellBound<MetricType, ElemType>::operator|=(const MatType& data)
 {
   Log::Assert(data.n_rows == dim);
 
-  arma::Col<ElemType> mins(arma::min(data, 1));
-  arma::Col<ElemType> maxs(arma::max(data, 1));
+  // The data may have a different element type than the bound.
+  arma::Col<typename MatType::elem_type> mins(arma::min(data, 1));
+  arma::Col<typename MatType::elem_type> maxs(arma::max(data, 1));
 
   minWidth = std::numeric_limits<ElemType>::max();
   for (size_t i = 0; i < dim; ++i)
@@ -954,7 +955,9 @@ inline bool CellBound<MetricType, ElemType>::Contains(
 
   arma::Col<AddressElemType> address(dim);
 
-  addr::PointToAddress(address, point);
+  // The address must be computed in the precision of the bound.
+  addr::PointToAddress(address,
+      arma::conv_to<arma::Col<ElemType>>::from(point));
 
   return addr::Contains(address, loAddress, hiAddress);
 }
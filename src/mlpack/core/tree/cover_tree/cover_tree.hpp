@@ -364,11 +364,12 @@ class CoverTree
   ElemType MinDistance(const CoverTree& other, const ElemType distance) const;
 
   //! Return the minimum distance to another point.
-  ElemType MinDistance(const arma::vec& other) const;
+  ElemType MinDistance(const arma::Col<ElemType>& other) const;
 
   //! Return the minimum distance to another point given that the distance from
   //! the center to the point has already been calculated.
-  ElemType MinDistance(const arma::vec& other, const ElemType distance) const;
+  ElemType MinDistance(const arma::Col<ElemType>& other,
+                       const ElemType distance) const;
 
   //! Return the maximum distance to another node.
   ElemType MaxDistance(const CoverTree& other) const;
@@ -378,11 +379,12 @@ class CoverTree
   ElemType MaxDistance(const CoverTree& other, const ElemType distance) const;
 
   //! Return the maximum distance to another point.
-  ElemType MaxDistance(const arma::vec& other) const;
+  ElemType MaxDistance(const arma::Col<ElemType>& other) const;
 
   //! Return the maximum distance to another point given that the distance from
   //! the center to the point has already been calculated.
-  ElemType MaxDistance(const arma::vec& other, const ElemType distance) const;
+  ElemType MaxDistance(const arma::Col<ElemType>& other,
+                       const ElemType distance) const;
 
   //! Return the minimum and maximum distance to another node.
   math::RangeType<ElemType> RangeDistance(const CoverTree& other) const;
@@ -393,11 +395,12 @@ class CoverTree
                                           const ElemType distance) const;
 
   //! Return the minimum and maximum distance to another point.
-  math::RangeType<ElemType> RangeDistance(const arma::vec& other) const;
+  math::RangeType<ElemType> RangeDistance(const arma::Col<ElemType>& other)
+      const;
 
   //! Return the minimum and maximum distance to another point given that the
   //! point-to-point distance has already been calculated.
-  math::RangeType<ElemType> RangeDistance(const arma::vec& other,
+  math::RangeType<ElemType> RangeDistance(const arma::Col<ElemType>& other,
                                           const ElemType distance) const;
 
   //! Get the parent node.
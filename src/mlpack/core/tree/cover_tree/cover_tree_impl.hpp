@@ -959,7 +959,7 @@ template<
 typename CoverTree<MetricType, StatisticType, MatType,
     RootPointPolicy>::ElemType
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
-    MinDistance(const arma::vec& other) const
+    MinDistance(const arma::Col<ElemType>& other) const
 {
   return std::max(metric->Evaluate(dataset->col(point), other) -
       furthestDescendantDistance, 0.0);
@@ -974,7 +974,8 @@ template<
 typename CoverTree<MetricType, StatisticType, MatType,
     RootPointPolicy>::ElemType
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
-    MinDistance(const arma::vec& /* other */, const ElemType distance) const
+    MinDistance(const arma::Col<ElemType>& /* other */,
+                const ElemType distance) const
 {
   return std::max(distance - furthestDescendantDistance, 0.0);
 }
@@ -1020,7 +1021,7 @@ template<
 typename CoverTree<MetricType, StatisticType, MatType,
     RootPointPolicy>::ElemType
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
-    MaxDistance(const arma::vec& other) const
+    MaxDistance(const arma::Col<ElemType>& other) const
 {
   return metric->Evaluate(dataset->col(point), other) +
       furthestDescendantDistance;
@@ -1035,7 +1036,8 @@ template<
 typename CoverTree<MetricType, StatisticType, MatType,
     RootPointPolicy>::ElemType
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
-    MaxDistance(const arma::vec& /* other */, const ElemType distance) const
+    MaxDistance(const arma::Col<ElemType>& /* other */,
+                const ElemType distance) const
 {
   return distance + furthestDescendantDistance;
 }
@@ -1097,7 +1099,7 @@ template<
 math::RangeType<typename
     CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::ElemType>
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
-    RangeDistance(const arma::vec& other) const
+    RangeDistance(const arma::Col<ElemType>& other) const
 {
   const ElemType distance = metric->Evaluate(dataset->col(point), other);
 
@@ -1117,7 +1119,7 @@ template<
 math::RangeType<typename
     CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::ElemType>
 CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
-    RangeDistance(const arma::vec& /* other */,
+    RangeDistance(const arma::Col<ElemType>& /* other */,
                   const ElemType distance) const
 {
   return math::RangeType<ElemType>(
@@ -1392,9 +1394,11 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  The distances near the top of the tree are to most of the
+  // dataset, so large sets are computed in parallel.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  #pragma omp parallel for if (pointSetSize >= 4096)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
@@ -383,14 +383,15 @@ template<typename MatType>
 const HollowBallBound<TMetricType, ElemType>&
 HollowBallBound<TMetricType, ElemType>::operator|=(const MatType& data)
 {
+  // The points may have a different element type than the bound.
   if (radii.Hi() < 0)
   {
-    center = data.col(0);
+    center = arma::conv_to<arma::Col<ElemType>>::from(data.col(0));
     radii.Hi() = 0;
   }
   if (radii.Lo() < 0)
   {
-    hollowCenter = data.col(0);
+    hollowCenter = arma::conv_to<arma::Col<ElemType>>::from(data.col(0));
     radii.Lo() = 0;
   }
   // Now iteratively add points.
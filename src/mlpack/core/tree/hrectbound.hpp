@@ -33,8 +33,8 @@ struct IsLMetric
 };
 
 //! Specialization for IsLMetric when the argument is of type LMetric.
-template<int Power, bool TakeRoot>
-struct IsLMetric<metric::LMetric<Power, TakeRoot>>
+template<int Power, bool TakeRoot, typename AccumType>
+struct IsLMetric<metric::LMetric<Power, TakeRoot, AccumType>>
 {
   static const bool Value = true;
 };
@@ -244,6 +244,28 @@ class HRectBound
   ElemType minWidth;
   //! Instantiated metric (likely has size 0).
   MetricType metric;
+
+  /**
+   * Combine the distances in each dimension, as given by distance(d), into the
+   * distance of the metric.  The loop over dimensions is vectorized.
+   */
+  template<typename DimensionFunction>
+  ElemType Reduce(const DimensionFunction& distance) const;
+
+  /**
+   * Combine the minimum and maximum distances in each dimension, as given by
+   * loDistance(d) and hiDistance(d), into the range of distances of the
+   * metric.  The loop over dimensions is vectorized.
+   */
+  template<typename LoFunction, typename HiFunction>
+  math::RangeType<ElemType> ReduceRange(const LoFunction& loDistance,
+                                        const HiFunction& hiDistance) const;
+
+  //! Raise a nonnegative distance in one dimension to the power of the metric.
+  static ElemType DimensionPower(const ElemType v);
+
+  //! Take the root of a sum of powers, if the metric takes the root.
+  static ElemType Root(const ElemType sum);
 };
 
 // A specialization of BoundTraits for this class.
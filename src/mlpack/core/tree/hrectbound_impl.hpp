@@ -182,7 +182,7 @@ inline ElemType HRectBound<MetricType, ElemType>::Volume() const
 }
 
 /**
- * Calculates minimum bound-to-point squared distance.
+ * Calculates minimum bound-to-point distance.
  */
 template<typename MetricType, typename ElemType>
 template<typename VecType>
@@ -192,117 +192,34 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
 {
   Log::Assert(point.n_elem == dim);
 
-  ElemType sum = 0;
-
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
+  // Only one of the two terms can be positive (unless the bound is empty).
+  return Reduce([&](const size_t d)
   {
-    lower = bounds[d].Lo() - point[d];
-    higher = point[d] - bounds[d].Hi();
-
-    // Since only one of 'lower' or 'higher' is negative, if we add each's
-    // absolute value to itself and then sum those two, our result is the
-    // nonnegative half of the equation times two; then we raise to power Power.
-    if (MetricType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-    else if (MetricType::Power == 2)
-    {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-      sum += dist * dist;
-    }
-    else
-    {
-      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
-          (ElemType) MetricType::Power);
-    }
-  }
-
-  // Now take the Power'th root (but make sure our result is squared if it needs
-  // to be); then cancel out the constant of 2 (which may have been squared now)
-  // that was introduced earlier.  The compiler should optimize out the if
-  // statement entirely.
-  if (MetricType::Power == 1)
-    return sum * 0.5;
-  else if (MetricType::Power == 2)
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
-  else
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) pow((double) sum,
-          1.0 / (double) MetricType::Power) / 2.0;
-    else
-      return sum / pow(2.0, MetricType::Power);
-  }
+    const ElemType p = point[d];
+    return std::max(bounds[d].Lo() - p, ElemType(0)) +
+        std::max(p - bounds[d].Hi(), ElemType(0));
+  });
 }
 
 /**
- * Calculates minimum bound-to-bound squared distance.
+ * Calculates minimum bound-to-bound distance.
  */
 template<typename MetricType, typename ElemType>
-ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
-    const
+inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
+    const HRectBound& other) const
 {
   Log::Assert(dim == other.dim);
 
-  ElemType sum = 0;
-  const math::RangeType<ElemType>* mbound = bounds;
-  const math::RangeType<ElemType>* obound = other.bounds;
-
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
-  {
-    lower = obound->Lo() - mbound->Hi();
-    higher = mbound->Lo() - obound->Hi();
-    // We invoke the following:
-    //   x + fabs(x) = max(x * 2, 0)
-    //   (x * 2)^2 / 4 = x^2
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-    else if (MetricType::Power == 2)
-    {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-      sum += dist * dist;
-    }
-    else
-    {
-      sum += pow((lower + fabs(lower)) + (higher + fabs(higher)),
-          (ElemType) MetricType::Power);
-    }
-
-    // Move bound pointers.
-    mbound++;
-    obound++;
-  }
-
-  // The compiler should optimize out this if statement entirely.
-  if (MetricType::Power == 1)
-    return sum * 0.5;
-  else if (MetricType::Power == 2)
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
-  else
+  const math::RangeType<ElemType>* obounds = other.bounds;
+  return Reduce([&](const size_t d)
   {
-    if (MetricType::TakeRoot)
-      return (ElemType) pow((double) sum,
-          1.0 / (double) MetricType::Power) / 2.0;
-    else
-      return sum / pow(2.0, MetricType::Power);
-  }
+    return std::max(obounds[d].Lo() - bounds[d].Hi(), ElemType(0)) +
+        std::max(bounds[d].Lo() - obounds[d].Hi(), ElemType(0));
+  });
 }
 
 /**
- * Calculates maximum bound-to-point squared distance.
+ * Calculates maximum bound-to-point distance.
  */
 template<typename MetricType, typename ElemType>
 template<typename VecType>
@@ -310,36 +227,14 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
-  ElemType sum = 0;
-
   Log::Assert(point.n_elem == dim);
 
-  for (size_t d = 0; d < dim; d++)
+  return Reduce([&](const size_t d)
   {
-    ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - point[d]));
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (MetricType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) MetricType::Power);
-  }
-
-  // The compiler should optimize out this if statement entirely.
-  if (MetricType::TakeRoot)
-  {
-    if (MetricType::Power == 1)
-      return sum;
-    else if (MetricType::Power == 2)
-      return (ElemType) std::sqrt(sum);
-    else
-      return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
-  }
-  else
-    return sum;
+    const ElemType p = point[d];
+    return std::max(std::abs(p - bounds[d].Lo()),
+        std::abs(bounds[d].Hi() - p));
+  });
 }
 
 /**
@@ -347,110 +242,46 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
  */
 template<typename MetricType, typename ElemType>
 inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
-    const HRectBound& other)
-    const
+    const HRectBound& other) const
 {
-  ElemType sum = 0;
-
   Log::Assert(dim == other.dim);
 
-  ElemType v;
-  for (size_t d = 0; d < dim; d++)
-  {
-    v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (MetricType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) MetricType::Power);
-  }
-
-  // The compiler should optimize out this if statement entirely.
-  if (MetricType::TakeRoot)
+  const math::RangeType<ElemType>* obounds = other.bounds;
+  return Reduce([&](const size_t d)
   {
-    if (MetricType::Power == 1)
-      return sum;
-    else if (MetricType::Power == 2)
-      return (ElemType) std::sqrt(sum);
-    else
-      return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
-  }
-  else
-    return sum;
+    return std::max(std::abs(obounds[d].Hi() - bounds[d].Lo()),
+        std::abs(bounds[d].Hi() - obounds[d].Lo()));
+  });
 }
 
 /**
- * Calculates minimum and maximum bound-to-bound squared distance.
+ * Calculates minimum and maximum bound-to-bound distance.
  */
 template<typename MetricType, typename ElemType>
 inline math::RangeType<ElemType>
 HRectBound<MetricType, ElemType>::RangeDistance(
     const HRectBound& other) const
 {
-  ElemType loSum = 0;
-  ElemType hiSum = 0;
-
   Log::Assert(dim == other.dim);
 
-  ElemType v1, v2, vLo, vHi;
-  for (size_t d = 0; d < dim; d++)
+  // For each dimension, one of v1 = other.lo - hi and v2 = lo - other.hi is
+  // negative.  The larger one (or zero) is the minimum distance, and the
+  // smaller one, negated, is the maximum distance.
+  const math::RangeType<ElemType>* obounds = other.bounds;
+  return ReduceRange([&](const size_t d)
   {
-    v1 = other.bounds[d].Lo() - bounds[d].Hi();
-    v2 = bounds[d].Lo() - other.bounds[d].Hi();
-    // One of v1 or v2 is negative.
-    if (v1 >= v2)
-    {
-      vHi = -v2; // Make it nonnegative.
-      vLo = (v1 > 0) ? v1 : 0; // Force to be 0 if negative.
-    }
-    else
-    {
-      vHi = -v1; // Make it nonnegative.
-      vLo = (v2 > 0) ? v2 : 0; // Force to be 0 if negative.
-    }
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-    {
-      loSum += vLo; // vLo is non-negative.
-      hiSum += vHi; // vHi is non-negative.
-    }
-    else if (MetricType::Power == 2)
-    {
-      loSum += vLo * vLo;
-      hiSum += vHi * vHi;
-    }
-    else
-    {
-      loSum += std::pow(vLo, (ElemType) MetricType::Power);
-      hiSum += std::pow(vHi, (ElemType) MetricType::Power);
-    }
-  }
-
-  if (MetricType::TakeRoot)
+    return std::max(std::max(obounds[d].Lo() - bounds[d].Hi(),
+        bounds[d].Lo() - obounds[d].Hi()), ElemType(0));
+  },
+  [&](const size_t d)
   {
-    if (MetricType::Power == 1)
-      return math::RangeType<ElemType>(loSum, hiSum);
-    else if (MetricType::Power == 2)
-      return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
-                                       (ElemType) std::sqrt(hiSum));
-    else
-    {
-      return math::RangeType<ElemType>(
-          (ElemType) pow((double) loSum, 1.0 / (double) MetricType::Power),
-          (ElemType) pow((double) hiSum, 1.0 / (double) MetricType::Power));
-    }
-  }
-  else
-    return math::RangeType<ElemType>(loSum, hiSum);
+    return -std::min(obounds[d].Lo() - bounds[d].Hi(),
+        bounds[d].Lo() - obounds[d].Hi());
+  });
 }
 
 /**
- * Calculates minimum and maximum bound-to-point squared distance.
+ * Calculates minimum and maximum bound-to-point distance.
  */
 template<typename MetricType, typename ElemType>
 template<typename VecType>
@@ -458,71 +289,112 @@ inline math::RangeType<ElemType>
 HRectBound<MetricType, ElemType>::RangeDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  // Same as above, with v1 = lo - point and v2 = point - hi.
+  return ReduceRange([&](const size_t d)
+  {
+    const ElemType p = point[d];
+    return std::max(std::max(bounds[d].Lo() - p, p - bounds[d].Hi()),
+        ElemType(0));
+  },
+  [&](const size_t d)
+  {
+    const ElemType p = point[d];
+    return -std::min(bounds[d].Lo() - p, p - bounds[d].Hi());
+  });
+}
+
+/**
+ * Combine the per-dimension distances given by the function into the distance
+ * of the metric.
+ */
+template<typename MetricType, typename ElemType>
+template<typename DimensionFunction>
+inline ElemType HRectBound<MetricType, ElemType>::Reduce(
+    const DimensionFunction& distance) const
+{
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::Power == INT_MAX)
+  {
+    ElemType result = 0;
+    #pragma omp simd reduction(max:result)
+    for (omp_size_t d = 0; d < (omp_size_t) dim; ++d)
+      result = std::max(result, distance(d));
+
+    return result;
+  }
+
+  ElemType sum = 0;
+  #pragma omp simd reduction(+:sum)
+  for (omp_size_t d = 0; d < (omp_size_t) dim; ++d)
+    sum += DimensionPower(distance(d));
+
+  return Root(sum);
+}
+
+/**
+ * Combine the per-dimension minimum and maximum distances given by the
+ * functions into the range of distances of the metric.
+ */
+template<typename MetricType, typename ElemType>
+template<typename LoFunction, typename HiFunction>
+inline math::RangeType<ElemType> HRectBound<MetricType, ElemType>::ReduceRange(
+    const LoFunction& loDistance,
+    const HiFunction& hiDistance) const
 {
   ElemType loSum = 0;
   ElemType hiSum = 0;
 
-  Log::Assert(point.n_elem == dim);
-
-  ElemType v1, v2, vLo, vHi;
-  for (size_t d = 0; d < dim; d++)
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::Power == INT_MAX)
   {
-    v1 = bounds[d].Lo() - point[d]; // Negative if point[d] > lo.
-    v2 = point[d] - bounds[d].Hi(); // Negative if point[d] < hi.
-    // One of v1 or v2 (or both) is negative.
-    if (v1 >= 0) // point[d] <= bounds_[d].Lo().
-    {
-      vHi = -v2; // v2 will be larger but must be negated.
-      vLo = v1;
-    }
-    else // point[d] is between lo and hi, or greater than hi.
+    #pragma omp simd reduction(max:loSum, hiSum)
+    for (omp_size_t d = 0; d < (omp_size_t) dim; ++d)
     {
-      if (v2 >= 0)
-      {
-        vHi = -v1; // v1 will be larger, but must be negated.
-        vLo = v2;
-      }
-      else
-      {
-        vHi = -std::min(v1, v2); // Both are negative, but we need the larger.
-        vLo = 0;
-      }
+      loSum = std::max(loSum, loDistance(d));
+      hiSum = std::max(hiSum, hiDistance(d));
     }
 
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-    {
-      loSum += vLo; // vLo is non-negative.
-      hiSum += vHi; // vHi is non-negative.
-    }
-    else if (MetricType::Power == 2)
-    {
-      loSum += vLo * vLo;
-      hiSum += vHi * vHi;
-    }
-    else
-    {
-      loSum += std::pow(vLo, (ElemType) MetricType::Power);
-      hiSum += std::pow(vHi, (ElemType) MetricType::Power);
-    }
+    return math::RangeType<ElemType>(loSum, hiSum);
   }
 
-  if (MetricType::TakeRoot)
+  #pragma omp simd reduction(+:loSum, hiSum)
+  for (omp_size_t d = 0; d < (omp_size_t) dim; ++d)
   {
-    if (MetricType::Power == 1)
-      return math::RangeType<ElemType>(loSum, hiSum);
-    else if (MetricType::Power == 2)
-      return math::RangeType<ElemType>((ElemType) std::sqrt(loSum),
-                                       (ElemType) std::sqrt(hiSum));
-    else
-    {
-      return math::RangeType<ElemType>(
-          (ElemType) pow((double) loSum, 1.0 / (double) MetricType::Power),
-          (ElemType) pow((double) hiSum, 1.0 / (double) MetricType::Power));
-    }
+    loSum += DimensionPower(loDistance(d));
+    hiSum += DimensionPower(hiDistance(d));
   }
+
+  return math::RangeType<ElemType>(Root(loSum), Root(hiSum));
+}
+
+//! Raise a nonnegative distance in one dimension to the power of the metric.
+template<typename MetricType, typename ElemType>
+inline ElemType HRectBound<MetricType, ElemType>::DimensionPower(
+    const ElemType v)
+{
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::Power == 1)
+    return v;
+  else if (MetricType::Power == 2)
+    return v * v;
   else
-    return math::RangeType<ElemType>(loSum, hiSum);
+    return std::pow(v, (ElemType) MetricType::Power);
+}
+
+//! Take the root of a sum of powers, if the metric takes the root.
+template<typename MetricType, typename ElemType>
+inline ElemType HRectBound<MetricType, ElemType>::Root(const ElemType sum)
+{
+  // The compiler should optimize out this if statement entirely.
+  if (!MetricType::TakeRoot || MetricType::Power == 1)
+    return sum;
+  else if (MetricType::Power == 2)
+    return (ElemType) std::sqrt(sum);
+  else
+    return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
 }
 
 /**
@@ -535,8 +407,9 @@ HRectBound<MetricType, ElemType>::operator|=(const MatType& data)
 {
   Log::Assert(data.n_rows == dim);
 
-  arma::Col<ElemType> mins(min(data, 1));
-  arma::Col<ElemType> maxs(max(data, 1));
+  // The data may have a different element type than the bound.
+  arma::Col<typename MatType::elem_type> mins(min(data, 1));
+  arma::Col<typename MatType::elem_type> maxs(max(data, 1));
 
   minWidth = std::numeric_limits<ElemType>::max();
   for (size_t i = 0; i < dim; ++i)
@@ -668,15 +541,10 @@ inline ElemType HRectBound<MetricType, ElemType>::Overlap(
 template<typename MetricType, typename ElemType>
 inline ElemType HRectBound<MetricType, ElemType>::Diameter() const
 {
-  ElemType d = 0;
-  for (size_t i = 0; i < dim; ++i)
-    d += std::pow(bounds[i].Hi() - bounds[i].Lo(),
-        (ElemType) MetricType::Power);
-
-  if (MetricType::TakeRoot)
-    return (ElemType) std::pow((double) d, 1.0 / (double) MetricType::Power);
-  else
-    return d;
+  return Reduce([&](const size_t d)
+  {
+    return bounds[d].Hi() - bounds[d].Lo();
+  });
 }
 
 //! Serialize the bound object.
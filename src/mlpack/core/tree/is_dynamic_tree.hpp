@@ -0,0 +1,51 @@
+/**
+ * @file core/tree/is_dynamic_tree.hpp
+ *
+ * Definition of IsDynamicTree, which determines whether points can be inserted
+ * into and deleted from a tree after it has been built.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_IS_DYNAMIC_TREE_HPP
+#define MLPACK_CORE_TREE_IS_DYNAMIC_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+// SFINAE checks for the methods that dynamic trees must provide.
+HAS_MEM_FUNC(InsertPoint, HasInsertPoint);
+HAS_MEM_FUNC(DeletePoint, HasDeletePoint);
+
+/**
+ * IsDynamicTree::value is true if points of the dataset can be inserted into
+ * and deleted from a built tree of the given type, which is the case if the
+ * tree provides the following methods:
+ *
+ * @code
+ * // Insert the point with the given index in the dataset.
+ * void InsertPoint(const size_t point);
+ * // Delete the point with the given index; return false if it is not held.
+ * bool DeletePoint(const size_t point);
+ * @endcode
+ *
+ * The dataset of the tree may be appended to before points are inserted, but
+ * the indices of the points already held by the tree must not change.
+ */
+template<typename TreeType>
+struct IsDynamicTree
+{
+  static const bool value =
+      HasInsertPoint<TreeType, void(TreeType::*)(const size_t)>::value &&
+      HasDeletePoint<TreeType, bool(TreeType::*)(const size_t)>::value;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
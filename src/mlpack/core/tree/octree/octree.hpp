@@ -439,6 +439,45 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Create the children of this node, after the dataset has been reordered so
+   * that child i holds the points in [childBegins[i], childBegins[i + 1]).
+   * Children with no points are not created.  Large nodes build their children
+   * in parallel as OpenMP tasks; the resulting tree is the same as a serial
+   * build.
+   *
+   * @param center Center of the node.
+   * @param width Width of the current node.
+   * @param childBegins The first point of each child.
+   * @param oldFromNew Mappings from old to new, or NULL if mappings are not
+   *     being tracked.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void CreateChildren(const arma::vec& center,
+                      const double width,
+                      const arma::Col<size_t>& childBegins,
+                      std::vector<size_t>* oldFromNew,
+                      const size_t maxLeafSize);
+
+  /**
+   * Create child i of this node.
+   *
+   * @param i Index of the child (its bits give the side of the center in each
+   *     dimension).
+   * @param center Center of the node.
+   * @param width Width of the current node.
+   * @param childBegins The first point of each child.
+   * @param oldFromNew Mappings from old to new, or NULL if mappings are not
+   *     being tracked.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  Octree* CreateChild(const size_t i,
+                      const arma::vec& center,
+                      const double width,
+                      const arma::Col<size_t>& childBegins,
+                      std::vector<size_t>* oldFromNew,
+                      const size_t maxLeafSize);
+
   /**
    * This is used for sorting points while splitting.
    */
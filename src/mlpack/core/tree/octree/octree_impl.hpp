@@ -16,6 +16,10 @@
 #include <mlpack/core/tree/perform_split.hpp>
 #include <stack>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -847,28 +851,7 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 
   // Now that the dataset is reordered, we can create the children.
-  arma::vec childCenter(center.n_elem);
-  const double childWidth = width / 2.0;
-  for (size_t i = 0; i < childBegins.n_elem - 1; ++i)
-  {
-    // If the child has no points, don't create it.
-    if (childBegins[i + 1] - childBegins[i] == 0)
-      continue;
-
-    // Create the correct center.
-    for (size_t d = 0; d < center.n_elem; ++d)
-    {
-      // Is the dimension "right" (1) or "left" (0)?
-      if (((i >> d) & 1) == 0)
-        childCenter[d] = center[d] - childWidth;
-      else
-        childCenter[d] = center[d] + childWidth;
-    }
-
-    children.push_back(new Octree(this, childBegins[i],
-        childBegins[i + 1] - childBegins[i], childCenter, childWidth,
-        maxLeafSize));
-  }
+  CreateChildren(center, width, childBegins, NULL, maxLeafSize);
 }
 
 //! Split the node, and store mappings.
@@ -949,27 +932,105 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 
   // Now that the dataset is reordered, we can create the children.
-  arma::vec childCenter(center.n_elem);
-  const double childWidth = width / 2.0;
+  CreateChildren(center, width, childBegins, &oldFromNew, maxLeafSize);
+}
+
+//! Create the children of a node.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::CreateChildren(
+    const arma::vec& center,
+    const double width,
+    const arma::Col<size_t>& childBegins,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  // If a child has no points, we don't create it.
+  std::vector<size_t> nonEmpty;
   for (size_t i = 0; i < childBegins.n_elem - 1; ++i)
-  {
-    // If the child has no points, don't create it.
-    if (childBegins[i + 1] - childBegins[i] == 0)
-      continue;
+    if (childBegins[i + 1] - childBegins[i] > 0)
+      nonEmpty.push_back(i);
+
+  children.resize(nonEmpty.size(), NULL);
+
+  // Below this size, tasks cost more than they save.
+  const size_t parallelBuildThreshold = 16384;
 
-    // Create the correct center.
-    for (size_t d = 0; d < center.n_elem; ++d)
+  #ifdef HAS_OPENMP
+  if (count >= parallelBuildThreshold)
+  {
+    // The children own disjoint ranges of the dataset (and of oldFromNew), and
+    // only read the bound of this node, so they can be built at the same time.
+    // If this is the root, start a team for the tasks.
+    if (omp_in_parallel())
     {
-      // Is the dimension "right" (1) or "left" (0)?
-      if (((i >> d) & 1) == 0)
-        childCenter[d] = center[d] - childWidth;
-      else
-        childCenter[d] = center[d] + childWidth;
+      for (size_t c = 0; c < nonEmpty.size(); ++c)
+      {
+        #pragma omp task shared(center, childBegins, nonEmpty)
+        children[c] = CreateChild(nonEmpty[c], center, width, childBegins,
+            oldFromNew, maxLeafSize);
+      }
+      #pragma omp taskwait
     }
+    else
+    {
+      #pragma omp parallel
+      {
+        #pragma omp single
+        {
+          for (size_t c = 0; c < nonEmpty.size(); ++c)
+          {
+            #pragma omp task shared(center, childBegins, nonEmpty)
+            children[c] = CreateChild(nonEmpty[c], center, width, childBegins,
+                oldFromNew, maxLeafSize);
+          }
+          #pragma omp taskwait
+        }
+      }
+    }
+
+    return;
+  }
+  #endif
+
+  for (size_t c = 0; c < nonEmpty.size(); ++c)
+  {
+    children[c] = CreateChild(nonEmpty[c], center, width, childBegins,
+        oldFromNew, maxLeafSize);
+  }
+}
+
+//! Create a child of a node.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>*
+Octree<MetricType, StatisticType, MatType>::CreateChild(
+    const size_t i,
+    const arma::vec& center,
+    const double width,
+    const arma::Col<size_t>& childBegins,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  // Create the correct center.
+  arma::vec childCenter(center.n_elem);
+  const double childWidth = width / 2.0;
+  for (size_t d = 0; d < center.n_elem; ++d)
+  {
+    // Is the dimension "right" (1) or "left" (0)?
+    if (((i >> d) & 1) == 0)
+      childCenter[d] = center[d] - childWidth;
+    else
+      childCenter[d] = center[d] + childWidth;
+  }
 
-    children.push_back(new Octree(this, childBegins[i],
-        childBegins[i + 1] - childBegins[i], oldFromNew, childCenter,
-        childWidth, maxLeafSize));
+  if (oldFromNew)
+  {
+    return new Octree(this, childBegins[i], childBegins[i + 1] - childBegins[i],
+        *oldFromNew, childCenter, childWidth, maxLeafSize);
+  }
+  else
+  {
+    return new Octree(this, childBegins[i], childBegins[i + 1] - childBegins[i],
+        childCenter, childWidth, maxLeafSize);
   }
 }
 
@@ -20,6 +20,64 @@ namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
 namespace split {
 
+//! The number of points above which PerformSplit() partitions in parallel.
+const size_t ParallelSplitThreshold = 65536;
+
+/**
+ * Rearrange the points of a node in parallel, with exactly the same result as
+ * the serial PerformSplit().  The serial algorithm swaps the k'th point
+ * (from the left) that is left of the split column but belongs to the right
+ * with the k'th point (from the right) that is right of the split column but
+ * belongs to the left; here every side is computed first, and then all of
+ * those swaps are done at once.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ * @param oldFromNew If not NULL, the old positions of each new point, which
+ *    are swapped along with the points.
+ */
+template<typename MatType, typename SplitType>
+size_t ParallelPerformSplit(MatType& data,
+                            const size_t begin,
+                            const size_t count,
+                            const typename SplitType::SplitInfo& splitInfo,
+                            std::vector<size_t>* oldFromNew)
+{
+  // Find the side of every point.
+  std::vector<char> toLeft(count);
+  size_t numLeft = 0;
+  #pragma omp parallel for reduction(+:numLeft)
+  for (omp_size_t i = 0; i < (omp_size_t) count; ++i)
+  {
+    toLeft[i] = SplitType::AssignToLeftNode(data.col(begin + i), splitInfo);
+    numLeft += (toLeft[i] ? 1 : 0);
+  }
+
+  // Collect the points on the wrong side of the split column.
+  std::vector<size_t> wrongLeft, wrongRight;
+  for (size_t i = 0; i < numLeft; ++i)
+    if (!toLeft[i])
+      wrongLeft.push_back(begin + i);
+  for (size_t i = count; i > numLeft; --i)
+    if (toLeft[i - 1])
+      wrongRight.push_back(begin + i - 1);
+
+  Log::Assert(wrongLeft.size() == wrongRight.size());
+
+  #pragma omp parallel for
+  for (omp_size_t k = 0; k < (omp_size_t) wrongLeft.size(); ++k)
+  {
+    data.swap_cols(wrongLeft[k], wrongRight[k]);
+    if (oldFromNew)
+      std::swap((*oldFromNew)[wrongLeft[k]], (*oldFromNew)[wrongRight[k]]);
+  }
+
+  return begin + numLeft;
+}
+
 /**
  * This function implements the default split behavior i.e. it rearranges
  * points according to the split information. The SplitType::AssignToLeftNode()
@@ -38,6 +96,15 @@ size_t PerformSplit(MatType& data,
                     const size_t count,
                     const typename SplitType::SplitInfo& splitInfo)
 {
+  #ifdef HAS_OPENMP
+  // Large dense nodes are partitioned in parallel.
+  if (count >= ParallelSplitThreshold && arma::is_Mat<MatType>::value)
+  {
+    return ParallelPerformSplit<MatType, SplitType>(data, begin, count,
+        splitInfo, NULL);
+  }
+  #endif
+
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
   size_t left = begin;
@@ -104,6 +171,15 @@ size_t PerformSplit(MatType& data,
                     const typename SplitType::SplitInfo& splitInfo,
                     std::vector<size_t>& oldFromNew)
 {
+  #ifdef HAS_OPENMP
+  // Large dense nodes are partitioned in parallel.
+  if (count >= ParallelSplitThreshold && arma::is_Mat<MatType>::value)
+  {
+    return ParallelPerformSplit<MatType, SplitType>(data, begin, count,
+        splitInfo, &oldFromNew);
+  }
+  #endif
+
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
   size_t left = begin;
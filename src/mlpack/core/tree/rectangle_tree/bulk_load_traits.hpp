@@ -0,0 +1,45 @@
+/**
+ * @file core/tree/rectangle_tree/bulk_load_traits.hpp
+ *
+ * This file defines the BulkLoadTraits class, which holds compile-time
+ * information about how a RectangleTree with a given split type may be
+ * bulk-loaded.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_TRAITS_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_TRAITS_HPP
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A class to obtain compile-time traits about how RectangleTrees that use the
+ * given SplitType are bulk-loaded.  By default, the points are packed into
+ * leaves with Sort-Tile-Recursive packing, and the nodes of each level are
+ * packed into their parents the same way.  If you are writing your own
+ * SplitType class whose trees need other invariants, you should make a
+ * template specialization in order to set the values correctly.
+ *
+ * @see SplitTraits, TreeTraits
+ */
+template<typename SplitType>
+struct BulkLoadTraits
+{
+  //! If true, the tree can be bulk-loaded.  Otherwise the tree is always
+  //! built by inserting the points one at a time.
+  static const bool SupportsBulkLoad = true;
+
+  //! If true, the points are packed in the order of their Hilbert values
+  //! instead of with Sort-Tile-Recursive packing.  The auxiliary information
+  //! of the tree must then hold a DiscreteHilbertValue.
+  static const bool HilbertOrder = false;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
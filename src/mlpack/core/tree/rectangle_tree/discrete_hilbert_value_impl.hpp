@@ -50,9 +50,11 @@ DiscreteHilbertValue<TreeElemType>::DiscreteHilbertValue(const TreeType* tree) :
   // Calculate the Hilbert value for all points.
   if (!tree->Parent()) // This is the root node.
     ownsLocalHilbertValues = true;
-  else if (tree->Parent()->Child(0).IsLeaf())
+  else if (tree->Parent()->NumChildren() > 0 &&
+           tree->Parent()->Child(0).IsLeaf())
   {
-    // This is a leaf node.
+    // This is a leaf node.  (If the parent has no children yet, as during bulk
+    // loading, the caller sets up the local Hilbert values.)
     assert(tree->Parent()->NumChildren() > 0);
     ownsLocalHilbertValues = true;
   }
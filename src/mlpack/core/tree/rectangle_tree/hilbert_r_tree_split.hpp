@@ -14,6 +14,7 @@
 #define MLPACK_CORE_TREE_RECTANGLE_TREE_HILBERT_R_TREE_SPLIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "bulk_load_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -90,6 +91,16 @@ class HilbertRTreeSplit
                                        const size_t lastSibling);
 };
 
+// A specialization of BulkLoadTraits for this class.
+template<size_t splitOrder>
+struct BulkLoadTraits<HilbertRTreeSplit<splitOrder>>
+{
+  //! Hilbert R trees can be bulk-loaded.
+  static const bool SupportsBulkLoad = true;
+  //! The points and children of every node must be sorted by Hilbert value.
+  static const bool HilbertOrder = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -14,6 +14,7 @@
 #define MLPACK_CORE_TREE_RECTANGLE_TREE_R_PLUS_TREE_SPLIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "bulk_load_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -125,6 +126,18 @@ class RPlusTreeSplit
   static void InsertNodeIntoTree(TreeType* destTree, TreeType* srcNode);
 };
 
+// A specialization of BulkLoadTraits for this class.
+template<typename SplitPolicyType,
+         template<typename> class SweepType>
+struct BulkLoadTraits<RPlusTreeSplit<SplitPolicyType, SweepType>>
+{
+  //! Packing does not keep the children of a node from overlapping, so R+ and
+  //! R++ trees are always built by insertion.
+  static const bool SupportsBulkLoad = false;
+  //! Not used.
+  static const bool HilbertOrder = false;
+};
+
 } // namespace tree
 } // namespace mlpack
 
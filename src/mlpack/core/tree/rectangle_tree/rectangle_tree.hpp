@@ -20,6 +20,7 @@
 #include "r_tree_split.hpp"
 #include "r_tree_descent_heuristic.hpp"
 #include "no_auxiliary_information.hpp"
+#include "bulk_load_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -127,13 +128,16 @@ class RectangleTree
    *      have.
    * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
    *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   * @param bulkLoad If true, build the tree by packing the points into full
+   *      leaves (see BulkLoadTraits) instead of inserting them one at a time.
    */
   RectangleTree(const MatType& data,
                 const size_t maxLeafSize = 20,
                 const size_t minLeafSize = 8,
                 const size_t maxNumChildren = 5,
                 const size_t minNumChildren = 2,
-                const size_t firstDataIndex = 0);
+                const size_t firstDataIndex = 0,
+                const bool bulkLoad = false);
 
   /**
    * Construct this as the root node of a rectangle tree type using the given
@@ -148,13 +152,16 @@ class RectangleTree
    *      have.
    * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
    *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   * @param bulkLoad If true, build the tree by packing the points into full
+   *      leaves (see BulkLoadTraits) instead of inserting them one at a time.
    */
   RectangleTree(MatType&& data,
                 const size_t maxLeafSize = 20,
                 const size_t minLeafSize = 8,
                 const size_t maxNumChildren = 5,
                 const size_t minNumChildren = 2,
-                const size_t firstDataIndex = 0);
+                const size_t firstDataIndex = 0,
+                const bool bulkLoad = false);
 
   /**
    * Construct this as an empty node with the specified parent.  Copying the
@@ -312,9 +319,9 @@ class RectangleTree
   RectangleTree* FindByBeginCount(size_t begin, size_t count);
 
   //! Return the bound object for this node.
-  const bound::HRectBound<MetricType>& Bound() const { return bound; }
+  const bound::HRectBound<MetricType, ElemType>& Bound() const { return bound; }
   //! Modify the bound object for this node.
-  bound::HRectBound<MetricType>& Bound() { return bound; }
+  bound::HRectBound<MetricType, ElemType>& Bound() { return bound; }
 
   //! Return the statistic object for this node.
   const StatisticType& Stat() const { return stat; }
@@ -365,7 +372,7 @@ class RectangleTree
   MetricType Metric() const { return MetricType(); }
 
   //! Get the centroid of the node and store it in the given vector.
-  void Center(arma::vec& center) { bound.Center(center); }
+  void Center(arma::Col<ElemType>& center) { bound.Center(center); }
 
   //! Return the number of child nodes.  (One level beneath this one only.)
   size_t NumChildren() const { return numChildren; }
@@ -564,6 +571,86 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Build the tree under this (root) node from the points from firstDataIndex
+   * on, with Sort-Tile-Recursive packing.  The points are packed into full
+   * leaves, and each level of nodes is packed into the level above it the same
+   * way, so the whole tree is built in a few sorting passes.
+   *
+   * @param firstDataIndex The index of the first point to put in the tree.
+   */
+  void BulkLoad(const size_t firstDataIndex, std::false_type /* hilbert */);
+
+  /**
+   * Build the tree under this (root) node from the points from firstDataIndex
+   * on, packing the points into full leaves in the order of their Hilbert
+   * values.  The nodes of each level keep that order, and the Hilbert values
+   * held by the auxiliary information of each node are set accordingly.
+   *
+   * @param firstDataIndex The index of the first point to put in the tree.
+   */
+  void BulkLoad(const size_t firstDataIndex, std::true_type /* hilbert */);
+
+  /**
+   * Pack the given points (in order) into leaves, and then pack each level of
+   * nodes into the level above it, until the remaining nodes fit into this
+   * node.
+   *
+   * @param order Indices of the points to pack, in packing order.
+   * @param tileNodes If true, the nodes of each level are ordered with
+   *      Sort-Tile-Recursive before they are packed; otherwise they keep the
+   *      order of their points.
+   */
+  void PackTree(const std::vector<size_t>& order, const bool tileNodes);
+
+  /**
+   * Set the Hilbert values held by the given node and its descendants after
+   * the points were packed in Hilbert order.
+   *
+   * @param node Node to set the Hilbert values of.
+   * @param values The Hilbert value of each point (column i holds the value of
+   *      point firstDataIndex + i).
+   * @param firstDataIndex The index of the first point in the tree.
+   */
+  template<typename ValuesType>
+  static void PackHilbertValues(RectangleTree* node,
+                                const ValuesType& values,
+                                const size_t firstDataIndex);
+
+  /**
+   * Order the items order[begin, end) for Sort-Tile-Recursive packing into
+   * groups of the given capacity: sort them by the given dimension, cut them
+   * into slabs of whole groups, and order each slab by the next dimension.
+   *
+   * @param coordinates Coordinates of each item (one column per item).
+   * @param order Indices of the items; this is reordered.
+   * @param begin First position of order to sort.
+   * @param end One past the last position of order to sort.
+   * @param dim Dimension to sort by.
+   * @param capacity Number of items in each group.
+   */
+  template<typename CoordinatesType>
+  static void SortTileRecursive(const CoordinatesType& coordinates,
+                                std::vector<size_t>& order,
+                                const size_t begin,
+                                const size_t end,
+                                const size_t dim,
+                                const size_t capacity);
+
+  /**
+   * Split the given number of items into consecutive groups of at most
+   * maxSize items.  Every group is full except the last ones, which are
+   * balanced so that each holds at least minSize items (if possible).
+   *
+   * @param numItems Number of items to split.
+   * @param maxSize Maximum number of items in a group.
+   * @param minSize Minimum number of items in a group.
+   * @return The first item of each group, followed by numItems.
+   */
+  static std::vector<size_t> PackingGroups(const size_t numItems,
+                                           const size_t maxSize,
+                                           const size_t minSize);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -599,7 +686,7 @@ class RectangleTree
    * @param relevels The levels that have been reinserted to on this top level
    *      insertion.
    */
-  void CondenseTree(const arma::vec& point,
+  void CondenseTree(const arma::Col<ElemType>& point,
                     std::vector<bool>& relevels,
                     const bool usePoint);
 
@@ -610,7 +697,7 @@ class RectangleTree
    *      shrinking.
    * @return true if the bound needed to be changed, false if it did not.
    */
-  bool ShrinkBoundForPoint(const arma::vec& point);
+  bool ShrinkBoundForPoint(const arma::Col<ElemType>& point);
 
   /**
    * Shrink the bound object of this node for the removal of a child node.
@@ -619,7 +706,8 @@ class RectangleTree
    *      shrinking.
    * @return true if the bound needed to be changed, false if it did not.
    */
-  bool ShrinkBoundForBound(const bound::HRectBound<MetricType>& changedBound);
+  bool ShrinkBoundForBound(
+      const bound::HRectBound<MetricType, ElemType>& changedBound);
 
   /**
    * Make an exact copy of this node, pointers and everything.
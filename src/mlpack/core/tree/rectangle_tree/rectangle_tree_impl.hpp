@@ -39,6 +39,265 @@ BuildStatistics(RectangleTree* node)
   node->Stat() = StatisticType(*node);
 }
 
+// Bulk-load the tree with Sort-Tile-Recursive packing.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoad(const size_t firstDataIndex, std::false_type /* hilbert */)
+{
+  std::vector<size_t> order(dataset->n_cols - firstDataIndex);
+  std::iota(order.begin(), order.end(), firstDataIndex);
+
+  SortTileRecursive(*dataset, order, 0, order.size(), 0, maxLeafSize);
+  PackTree(order, true);
+}
+
+// Bulk-load the tree in the order of the Hilbert values of the points.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoad(const size_t firstDataIndex, std::true_type /* hilbert */)
+{
+  typedef typename std::remove_reference<
+      decltype(auxiliaryInfo.HilbertValue())>::type HilbertValueType;
+  typedef typename HilbertValueType::HilbertElemType HilbertElemType;
+
+  // Compute the Hilbert value of every point once.
+  const size_t numPoints = dataset->n_cols - firstDataIndex;
+  arma::Mat<HilbertElemType> values(dataset->n_rows, numPoints);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+  {
+    values.col(i) =
+        HilbertValueType::CalculateValue(dataset->col(firstDataIndex + i));
+  }
+
+  // Sort the points by Hilbert value; the bits of each value are arranged so
+  // that values compare lexicographically.  Ties keep the order of the points.
+  std::vector<size_t> order(numPoints);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+      [&values](const size_t a, const size_t b)
+      {
+        return std::lexicographical_compare(values.colptr(a),
+            values.colptr(a) + values.n_rows, values.colptr(b),
+            values.colptr(b) + values.n_rows);
+      });
+
+  for (size_t i = 0; i < numPoints; ++i)
+    order[i] += firstDataIndex;
+
+  // Consecutive leaves (and nodes) keep increasing Hilbert values, so nodes are
+  // packed in order.
+  PackTree(order, false);
+  PackHilbertValues(this, values, firstDataIndex);
+}
+
+// Pack the points into leaves and the leaves into the levels above them.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+PackTree(const std::vector<size_t>& order, const bool tileNodes)
+{
+  // All nodes are created as children of the root, so that they take their
+  // parameters from it, and are moved under their real parents afterwards.
+  std::vector<size_t> groups = PackingGroups(order.size(), maxLeafSize,
+      minLeafSize);
+  std::vector<RectangleTree*> nodes(groups.size() - 1);
+  for (size_t g = 0; g < nodes.size(); ++g)
+  {
+    RectangleTree* leaf = new RectangleTree(this);
+    for (size_t i = groups[g]; i < groups[g + 1]; ++i)
+    {
+      leaf->points[leaf->count++] = order[i];
+      leaf->bound |= dataset->col(order[i]);
+    }
+    leaf->numDescendants = leaf->count;
+    nodes[g] = leaf;
+  }
+
+  // Now pack each level into the level above it, until the nodes fit into the
+  // root.
+  while (true)
+  {
+    const bool lastLevel = (nodes.size() <= maxNumChildren);
+
+    std::vector<size_t> nodeOrder(nodes.size());
+    std::iota(nodeOrder.begin(), nodeOrder.end(), 0);
+    if (lastLevel)
+    {
+      groups = { 0, nodes.size() };
+    }
+    else
+    {
+      if (tileNodes)
+      {
+        // Tile the nodes by the centers of their bounds.
+        arma::Mat<ElemType> centers(bound.Dim(), nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i)
+          for (size_t d = 0; d < bound.Dim(); ++d)
+            centers(d, i) = nodes[i]->bound[d].Mid();
+
+        SortTileRecursive(centers, nodeOrder, 0, nodes.size(), 0,
+            maxNumChildren);
+      }
+
+      groups = PackingGroups(nodes.size(), maxNumChildren, minNumChildren);
+    }
+
+    std::vector<RectangleTree*> parents(groups.size() - 1);
+    for (size_t g = 0; g < parents.size(); ++g)
+    {
+      RectangleTree* node = lastLevel ? this : new RectangleTree(this);
+      for (size_t i = groups[g]; i < groups[g + 1]; ++i)
+      {
+        RectangleTree* child = nodes[nodeOrder[i]];
+        node->children[node->numChildren++] = child;
+        child->parent = node;
+        node->bound |= child->bound;
+        node->numDescendants += child->numDescendants;
+      }
+      parents[g] = node;
+    }
+
+    if (lastLevel)
+      break;
+
+    nodes.swap(parents);
+  }
+}
+
+// Set the Hilbert values of every node after packing in Hilbert order.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename ValuesType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+PackHilbertValues(RectangleTree* node,
+                  const ValuesType& values,
+                  const size_t firstDataIndex)
+{
+  auto& value = node->AuxiliaryInfo().HilbertValue();
+
+  if (node->IsLeaf())
+  {
+    // Leaves own the Hilbert values of their points, sorted like the points.
+    if (!value.OwnsLocalHilbertValues())
+    {
+      value.LocalHilbertValues() = new arma::Mat<typename ValuesType::elem_type>(
+          values.n_rows, node->MaxLeafSize() + 1);
+      value.OwnsLocalHilbertValues() = true;
+    }
+
+    for (size_t i = 0; i < node->Count(); ++i)
+    {
+      value.LocalHilbertValues()->col(i) =
+          values.col(node->Point(i) - firstDataIndex);
+    }
+    value.NumValues() = node->Count();
+    return;
+  }
+
+  for (size_t i = 0; i < node->NumChildren(); ++i)
+    PackHilbertValues(node->children[i], values, firstDataIndex);
+
+  // Intermediate nodes refer to the values of their last child.
+  value = node->Child(node->NumChildren() - 1).AuxiliaryInfo().HilbertValue();
+}
+
+// Order items for Sort-Tile-Recursive packing.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename CoordinatesType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+SortTileRecursive(const CoordinatesType& coordinates,
+                  std::vector<size_t>& order,
+                  const size_t begin,
+                  const size_t end,
+                  const size_t dim,
+                  const size_t capacity)
+{
+  const size_t numItems = end - begin;
+  if (numItems <= capacity)
+    return;
+
+  std::sort(order.begin() + begin, order.begin() + end,
+      [&coordinates, dim](const size_t a, const size_t b)
+      {
+        return coordinates(dim, a) < coordinates(dim, b);
+      });
+
+  if (dim + 1 == coordinates.n_rows)
+    return;
+
+  // Cut the items into about numGroups^(1 / remaining dimensions) slabs, each
+  // holding a whole number of groups.
+  const size_t numGroups = (numItems + capacity - 1) / capacity;
+  const size_t numSlabs = (size_t) std::ceil(std::pow((double) numGroups,
+      1.0 / (coordinates.n_rows - dim)));
+  const size_t slabSize = capacity * ((numGroups + numSlabs - 1) / numSlabs);
+
+  for (size_t slab = begin; slab < end; slab += slabSize)
+  {
+    SortTileRecursive(coordinates, order, slab, std::min(slab + slabSize, end),
+        dim + 1, capacity);
+  }
+}
+
+// Split items into consecutive groups for packing.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+std::vector<size_t>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+PackingGroups(const size_t numItems,
+              const size_t maxSize,
+              const size_t minSize)
+{
+  const size_t numGroups = (numItems + maxSize - 1) / maxSize;
+  std::vector<size_t> groups(numGroups + 1);
+  for (size_t g = 0; g < numGroups; ++g)
+    groups[g] = g * maxSize;
+  groups[numGroups] = numItems;
+
+  // If the last group is too small, split the last two groups evenly.
+  if (numGroups > 1 && numItems - groups[numGroups - 1] < minSize)
+  {
+    const size_t lastTwo = numItems - groups[numGroups - 2];
+    groups[numGroups - 1] = groups[numGroups - 2] + (lastTwo + 1) / 2;
+  }
+
+  return groups;
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -52,7 +311,8 @@ RectangleTree(const MatType& data,
               const size_t minLeafSize,
               const size_t maxNumChildren,
               const size_t minNumChildren,
-              const size_t firstDataIndex) :
+              const size_t firstDataIndex,
+              const bool bulkLoad) :
     maxNumChildren(maxNumChildren),
     minNumChildren(minNumChildren),
     numChildren(0),
@@ -70,11 +330,20 @@ RectangleTree(const MatType& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  if (bulkLoad && BulkLoadTraits<SplitType>::SupportsBulkLoad &&
+      data.n_cols > firstDataIndex + maxLeafSize)
+  {
+    BulkLoad(firstDataIndex, std::integral_constant<bool,
+        BulkLoadTraits<SplitType>::HilbertOrder>());
+  }
+  else
+  {
+    // Insert the points in order.
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < data.n_cols; ++i)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < data.n_cols; ++i)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -93,7 +362,8 @@ RectangleTree(MatType&& data,
               const size_t minLeafSize,
               const size_t maxNumChildren,
               const size_t minNumChildren,
-              const size_t firstDataIndex) :
+              const size_t firstDataIndex,
+              const bool bulkLoad) :
     maxNumChildren(maxNumChildren),
     minNumChildren(minNumChildren),
     numChildren(0),
@@ -111,11 +381,20 @@ RectangleTree(MatType&& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  if (bulkLoad && BulkLoadTraits<SplitType>::SupportsBulkLoad &&
+      dataset->n_cols > firstDataIndex + maxLeafSize)
+  {
+    BulkLoad(firstDataIndex, std::integral_constant<bool,
+        BulkLoadTraits<SplitType>::HilbertOrder>());
+  }
+  else
+  {
+    // Insert the points in order.
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -697,7 +976,7 @@ bool RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
         tree->numDescendants -= node->numDescendants;
         tree = tree->Parent();
       }
-      CondenseTree(arma::vec(), relevels, false);
+      CondenseTree(arma::Col<ElemType>(), relevels, false);
       return true;
     }
 
@@ -1074,7 +1353,7 @@ template<typename MetricType,
          template<typename> class AuxiliaryInformationType>
 void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
                    AuxiliaryInformationType>::
-    CondenseTree(const arma::vec& point,
+    CondenseTree(const arma::Col<ElemType>& point,
                  std::vector<bool>& relevels,
                  const bool usePoint)
 {
@@ -1258,7 +1537,7 @@ template<typename MetricType,
          template<typename> class AuxiliaryInformationType>
 bool RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
                    AuxiliaryInformationType>::
-    ShrinkBoundForPoint(const arma::vec& point)
+    ShrinkBoundForPoint(const arma::Col<ElemType>& point)
 {
   bool shrunk = false;
   if (IsLeaf())
@@ -1356,7 +1635,7 @@ template<typename MetricType,
          template<typename> class AuxiliaryInformationType>
 bool RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
                    AuxiliaryInformationType>::
-    ShrinkBoundForBound(const bound::HRectBound<MetricType>& /* b */)
+    ShrinkBoundForBound(const bound::HRectBound<MetricType, ElemType>& /* b */)
 {
   // Using the sum is safe since none of the dimensions can increase.
   ElemType sum = 0;
@@ -92,10 +92,13 @@ bool SpaceSplit<MetricType, MatType>::GetProjVector(
   if (max == 0) // All these points are the same.
     return false;
 
-  // Calculate the normalized projection vector.
-  projVector = ProjVector(data.col(snd) - data.col(fst));
+  // Calculate the normalized projection vector.  The projection vector is held
+  // in double precision regardless of the element type of the data.
+  const arma::vec fstPoint = arma::conv_to<arma::vec>::from(data.col(fst));
+  const arma::vec sndPoint = arma::conv_to<arma::vec>::from(data.col(snd));
+  projVector = ProjVector(sndPoint - fstPoint);
 
-  arma::vec midPoint = (data.col(snd) + data.col(fst)) / 2;
+  arma::vec midPoint = (sndPoint + fstPoint) / 2;
 
   midValue = projVector.Project(midPoint);
 
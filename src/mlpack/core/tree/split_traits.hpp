@@ -0,0 +1,38 @@
+/**
+ * @file core/tree/split_traits.hpp
+ *
+ * This file defines the SplitTraits class, which holds compile-time
+ * information about the split types used by space trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPLIT_TRAITS_HPP
+#define MLPACK_CORE_TREE_SPLIT_TRAITS_HPP
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A class to obtain compile-time traits about SplitType classes.  If you are
+ * writing your own SplitType class, you should make a template specialization
+ * in order to set the values correctly.
+ *
+ * @see TreeTraits, BoundTraits
+ */
+template<typename SplitType>
+struct SplitTraits
+{
+  //! If true, then the split of a node depends only on the points in that
+  //! node: the split uses no random numbers and no state shared between
+  //! nodes.  Trees may then build separate subtrees at the same time and get
+  //! the same result as a serial build.  This defaults to false.
+  static const bool IsDeterministic = false;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -31,6 +31,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/perceptron/perceptron.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/decision_tree/presorted_decision_stump.hpp>
 
 namespace mlpack {
 namespace adaboost {
@@ -71,7 +72,9 @@ namespace adaboost {
  * @endcode
  *
  * For more information on and examples of weak learners, see
- * perceptron::Perceptron<> and tree::ID3DecisionStump.
+ * perceptron::Perceptron<>, tree::ID3DecisionStump, and
+ * tree::PresortedDecisionStump (which sorts the data only once for all boosting
+ * rounds).
  *
  * @tparam MatType Data matrix type (i.e. arma::mat or arma::sp_mat).
  * @tparam WeakLearnerType Type of weak learner to use.
@@ -90,10 +90,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // Use tempData to modify input data for incorporating weights.
   MatType tempData(data);
 
-  // This matrix is a helper matrix used to calculate the final hypothesis.
-  arma::mat sumFinalH = arma::zeros<arma::mat>(numClasses,
-      predictedLabels.n_cols);
-
   // Load the initial weights into a 2-D matrix.
   const double initWeight = 1.0 / double(data.n_cols * numClasses);
   arma::mat D(numClasses, data.n_cols);
@@ -102,8 +98,10 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // Weights are stored in this row vector.
   arma::rowvec weights(predictedLabels.n_cols);
 
-  // This is the final hypothesis.
-  arma::Row<size_t> finalH(predictedLabels.n_cols);
+  // The weak learners are trained from a local copy of the given one, so that
+  // any state that is built up for the training set (such as the sort cache of
+  // PresortedDecisionStump) is released when training finishes.
+  const WeakLearnerType weakLearner(other);
 
   // Now, start the boosting rounds.
   for (size_t i = 0; i < iterations; ++i)
@@ -131,7 +129,7 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // This trains the new WeakLearnerType using the hyperparameters from the
     // given WeakLearnerType.
 
-    WeakLearnerType w(other, tempData, labels, numClasses, weights);
+    WeakLearnerType w(weakLearner, tempData, labels, numClasses, weights);
     // There is a bug with Adaboost!  It will not use the specified
     // hyperparameters for the decision tree because they are not properly
     // passed to the new weak learners!  (And: it's a hard bug, because the
@@ -141,16 +139,16 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // DecisionTree(DecisionTree&, MatType&, LabelsType&, size_t, WeightsType&, double = 0.0, double = 0.0, ...);
     w.Classify(tempData, predictedLabels);
 
-    // Now from predictedLabels, build ht, the weak hypothesis
-    // buildClassificationMatrix(ht, predictedLabels);
-
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
+    // Now, calculate alpha(t) using ht.  The column sums of D are already
+    // available in weights, so rt is a weighted sum of +1 for each correctly
+    // classified point and -1 for each misclassified point.  This is summed
+    // serially, so that the result does not depend on the number of threads.
+    for (size_t j = 0; j < D.n_cols; ++j)
     {
-      if (predictedLabels(j) == labels(j))
-        rt += arma::accu(D.col(j));
+      if (predictedLabels[j] == labels[j])
+        rt += weights[j];
       else
-        rt -= arma::accu(D.col(j));
+        rt -= weights[j];
     }
 
     if ((i > 0) && (std::abs(rt - crt) < tolerance))
@@ -174,43 +172,23 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
+    // Now start modifying the weights.  Correctly classified points are
+    // down-weighted and misclassified points are up-weighted; each column of D
+    // is independent, so this is done in parallel.
+    const double expo = exp(alphat);
+    #pragma omp parallel for
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j)
     {
-      const double expo = exp(alphat);
-      if (predictedLabels(j) == labels(j))
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) /= expo;
-          zt += D(k, j); // * exp(-1 * alphat * yt(j,k) * ht(j,k));
-
-          // Add to the final hypothesis matrix.
-          // sumFinalH(k, j) += (alphat * ht(k, j));
-          if (k == labels(j))
-            sumFinalH(k, j) += (alphat); // * ht(k, j));
-          else
-            sumFinalH(k, j) -= (alphat);
-        }
-      }
+      if (predictedLabels[j] == labels[j])
+        D.col(j) /= expo;
       else
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) *= expo;
-          zt += D(k, j);
-
-          // Add to the final hypothesis matrix.
-          if (k == labels(j))
-            sumFinalH(k, j) += alphat; // * ht(k, j));
-          else
-            sumFinalH(k, j) -= alphat;
-        }
-      }
+        D.col(j) *= expo;
     }
 
+    // Calculate zt, the normalization constant, independently of the number
+    // of threads.
+    zt = arma::accu(D);
+
     // Normalize D.
     D /= zt;
 
@@ -243,29 +221,31 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     arma::Row<size_t>& predictedLabels,
     arma::mat& probabilities)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
-
-  probabilities.zeros(numClasses, test.n_cols);
-  predictedLabels.set_size(test.n_cols);
-
-  for (size_t i = 0; i < wl.size(); ++i)
+  // Collect the predictions of every weak learner as a (learners x points)
+  // matrix.  The weak learners are independent, so they are evaluated in
+  // parallel.
+  arma::Mat<size_t> learnerPredictions(wl.size(), test.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) wl.size(); ++i)
   {
+    arma::Row<size_t> tempPredictedLabels(test.n_cols);
     wl[i].Classify(test, tempPredictedLabels);
-
-    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
-      probabilities(tempPredictedLabels(j), j) += alpha[i];
+    learnerPredictions.row(i) = tempPredictedLabels;
   }
 
-  arma::colvec pRow;
-  arma::uword maxIndex = 0;
-
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
+  // Now accumulate the weighted votes for each point.  Each thread handles a
+  // separate set of points, so no synchronization is needed.
+  probabilities.zeros(numClasses, test.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) test.n_cols; ++j)
   {
-    probabilities.col(i) /= arma::accu(probabilities.col(i));
-    pRow = probabilities.unsafe_col(i);
-    pRow.max(maxIndex);
-    predictedLabels(i) = maxIndex;
+    for (size_t i = 0; i < wl.size(); ++i)
+      probabilities(learnerPredictions(i, j), j) += alpha[i];
   }
+
+  probabilities.each_row() /= arma::sum(probabilities, 0);
+  predictedLabels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(probabilities, 0));
 }
 
 /**
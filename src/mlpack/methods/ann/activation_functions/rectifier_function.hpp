@@ -65,8 +65,8 @@ class RectifierFunction
   template<typename eT>
   static void Fn(const arma::Mat<eT>& x, arma::Mat<eT>& y)
   {
-    y.zeros(x.n_rows, x.n_cols);
-    y = arma::max(y, x);
+    // This is safe to call with x and y being the same matrix.
+    y = arma::clamp(x, 0, std::numeric_limits<eT>::max());
   }
 
   /**
@@ -78,8 +78,7 @@ class RectifierFunction
   template<typename eT>
   static void Fn(const arma::Cube<eT>& x, arma::Cube<eT>& y)
   {
-    y.zeros(x.n_rows, x.n_cols, x.n_slices);
-    y = arma::max(y, x);
+    y = arma::clamp(x, 0, std::numeric_limits<eT>::max());
   }
 
   /**
@@ -93,6 +93,7 @@ class FFN
   {
     network.template Add<LayerType>(args...);
     inputDimensionsAreSet = false;
+    replicasAreSet = false;
   }
 
   /**
@@ -105,6 +106,7 @@ class FFN
   {
     network.Add(layer);
     inputDimensionsAreSet = false;
+    replicasAreSet = false;
   }
 
   //! Get the layers of the network.
@@ -125,6 +127,7 @@ class FFN
     // We can no longer make any assumptions... the user may change anything.
     inputDimensionsAreSet = false;
     layerMemoryIsSet = false;
+    replicasAreSet = false;
 
     return network.Network();
   }
@@ -191,6 +194,11 @@ class FFN
    * the output of the output layer when `predictors` is passed through the
    * whole network (`OutputLayerType`).
    *
+   * Since no backward pass follows, the outputs of the intermediate layers are
+   * not kept: only two activation buffers are used, and element-wise
+   * activation layers are applied in place on the output of the layer before
+   * them.  Use `Forward()` if the outputs of each layer are needed.
+   *
    * @param predictors Input predictors.
    * @param results Matrix to put output predictions of responses into.
    * @param batchSize Batch size to use for prediction.
@@ -226,6 +234,31 @@ class FFN
   //! Get the logical dimensions of the input.
   const std::vector<size_t>& InputDimensions() const { return inputDimensions; }
 
+  /**
+   * Get the number of replicas of the network that each mini-batch is split
+   * across during training.  Each replica holds its own intermediate results
+   * but shares the weights in `Parameters()`; the replicas run in parallel
+   * with OpenMP, and their gradients are summed with a fixed binary tree, so
+   * for a fixed number of replicas the results do not depend on the number of
+   * threads.  The default, 1, processes each mini-batch in one pass.
+   *
+   * The objective and the gradient are the same as for a single pass: the
+   * weight regularizers of the layers are counted once.  Replicas cannot be
+   * used with layers that keep state between batches (see
+   * `Layer::HasTrainingState()`), since each replica would update its own copy
+   * of that state, and the output layer must have a `Reduction()` method that
+   * says whether it sums or averages over the batch (so that the parts of the
+   * batch can be combined); otherwise `EvaluateWithGradient()` throws
+   * `std::invalid_argument`.
+   */
+  size_t Replicas() const { return replicas; }
+  //! Modify the number of replicas used during training.
+  size_t& Replicas()
+  {
+    replicasAreSet = false;
+    return replicas;
+  }
+
   //! Return the current set of weights.  These are linearized: this contains
   //! the weights of every layer.
   const MatType& Parameters() const { return parameters; }
@@ -442,6 +475,44 @@ class FFN
   //! SetWeightPtr() on each layer.
   void SetLayerMemory();
 
+  //! Create the replicas of the network used for data-parallel training, and
+  //! point their weights at `parameters`.
+  void SetReplicaMemory();
+
+  /**
+   * Evaluate the network and its gradient on the given batch of the training
+   * data, by splitting the batch across the replicas of the network.
+   *
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix to output gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  typename MatType::elem_type ReplicaEvaluateWithGradient(
+      const size_t begin,
+      MatType& gradient,
+      const size_t batchSize);
+
+  // SFINAE check for loss functions that can reduce with the mean.
+  HAS_MEM_FUNC(Reduction, HasReductionCheck);
+
+  //! Return whether the output layer takes the mean over the batch.
+  template<typename T = OutputLayerType>
+  typename std::enable_if<
+      HasReductionCheck<T, bool(T::*)() const>::value, bool>::type
+  MeanReduction() const { return !outputLayer.Reduction(); }
+
+  //! Output layers without Reduction() may not sum or average over the
+  //! batch, so the batch cannot be split across replicas.
+  template<typename T = OutputLayerType>
+  typename std::enable_if<
+      !HasReductionCheck<T, bool(T::*)() const>::value, bool>::type
+  MeanReduction() const
+  {
+    throw std::invalid_argument("FFN::EvaluateWithGradient(): the output "
+        "layer has no Reduction() method, so the batch cannot be split across "
+        "replicas; set Replicas() to 1!");
+  }
+
   /**
    * Ensure that all the locally-cached information about the network is valid,
    * all parameter memory is initialized, and we can make forward and backward
@@ -547,6 +618,24 @@ class FFN
   //! `totalInputSize` and `totalOutputSize` are valid.
   bool inputDimensionsAreSet;
 
+  //! The number of replicas each mini-batch is split across during training.
+  size_t replicas;
+  //! Copies of `network` used as replicas 1, ..., `replicas - 1` (replica 0 is
+  //! `network` itself).  Their weights point at `parameters`.
+  std::vector<MultiLayer<MatType>> replicaNetworks;
+  //! Copies of `outputLayer` for replicas 1, ..., `replicas - 1`.
+  std::vector<OutputLayerType> replicaOutputLayers;
+  //! The output of the forward pass of each replica.
+  std::vector<MatType> replicaOutputs;
+  //! The error of the output layer of each replica.
+  std::vector<MatType> replicaErrors;
+  //! The output of the backward pass of each replica.
+  std::vector<MatType> replicaDeltas;
+  //! The gradient of each replica (replica 0 uses the caller's gradient).
+  std::vector<MatType> replicaGradients;
+  //! If true, `replicaNetworks` match `network` and point at `parameters`.
+  bool replicasAreSet;
+
   // RNN will call `CheckNetwork()`, which is private.
   friend class RNN<OutputLayerType, InitializationRuleType, MatType>;
 }; // class FFN
@@ -31,7 +31,9 @@ FFN<
     outputLayer(std::move(outputLayer)),
     initializeRule(std::move(initializeRule)),
     layerMemoryIsSet(false),
-    inputDimensionsAreSet(false)
+    inputDimensionsAreSet(false),
+    replicas(1),
+    replicasAreSet(false)
 {
   /* Nothing to do here. */
 }
@@ -53,7 +55,9 @@ FFN<
     responses(network.responses),
     // These will be set correctly in the first Forward() call.
     layerMemoryIsSet(false),
-    inputDimensionsAreSet(false)
+    inputDimensionsAreSet(false),
+    replicas(network.replicas),
+    replicasAreSet(false)
 {
   // Nothing to do.
 };
@@ -76,7 +80,9 @@ FFN<
     // Aliases will not be correct after a std::move(), so we will manually
     // reset them.
     layerMemoryIsSet(false),
-    inputDimensionsAreSet(std::move(network.inputDimensionsAreSet))
+    inputDimensionsAreSet(std::move(network.inputDimensionsAreSet)),
+    replicas(network.replicas),
+    replicasAreSet(false)
 {
   // Nothing to do.
 };
@@ -103,10 +109,12 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     networkDelta = other.networkDelta;
     error = other.error;
     inputDimensionsAreSet = other.inputDimensionsAreSet;
+    replicas = other.replicas;
 
     // Copying will not preserve Armadillo aliases correctly, so we will reset
     // those.
     layerMemoryIsSet = false;
+    replicasAreSet = false;
   }
 
   return *this;
@@ -135,6 +143,10 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     error = std::move(other.error);
     inputDimensionsAreSet = std::move(other.inputDimensionsAreSet);
     layerMemoryIsSet = std::move(other.layerMemoryIsSet);
+    replicas = other.replicas;
+    // The replicas point at the memory of the other network's layers, so they
+    // will be rebuilt when needed.
+    replicasAreSet = false;
   }
 
   return *this;
@@ -212,7 +224,9 @@ void FFN<
     MatType resultAlias(results.colptr(i), results.n_rows,
         effectiveBatchSize, false, true);
 
-    network.Forward(predictorAlias, resultAlias);
+    // No backward pass will follow, so we don't need to keep the outputs of
+    // every layer.
+    network.Infer(predictorAlias, resultAlias);
   }
 }
 
@@ -392,6 +406,7 @@ void FFN<
 
     layerMemoryIsSet = false;
     inputDimensionsAreSet = false;
+    replicasAreSet = false;
 
     // The weights in `parameters` will be correctly set for each layer in the
     // first call to Forward().
@@ -471,6 +486,9 @@ typename MatType::elem_type FFN<
 {
   CheckNetwork("FFN::EvaluateWithGradient()", predictors.n_rows);
 
+  if (replicas > 1 && batchSize > 1)
+    return ReplicaEvaluateWithGradient(begin, gradient, batchSize);
+
   // Set networkOutput to the right size if needed, then perform the forward
   // pass.
   networkOutput.set_size(network.OutputSize(), batchSize);
@@ -555,6 +573,7 @@ void FFN<
   // Reset the network parameters with the given initialization rule.
   NetworkInitialization<InitializationRuleType> networkInit(initializeRule);
   networkInit.Initialize(network.Network(), parameters);
+  replicasAreSet = false;
 }
 
 template<typename OutputLayerType,
@@ -574,6 +593,138 @@ void FFN<
 
   network.SetWeights(parameters.memptr());
   layerMemoryIsSet = true;
+  replicasAreSet = false;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SetReplicaMemory()
+{
+  if (network.HasTrainingState())
+  {
+    throw std::invalid_argument("FFN::EvaluateWithGradient(): the network "
+        "has layers that keep state between batches, so it cannot be split "
+        "across replicas; set Replicas() to 1!");
+  }
+
+  replicaNetworks.clear();
+  replicaNetworks.reserve(replicas - 1);
+  for (size_t r = 1; r < replicas; ++r)
+  {
+    replicaNetworks.push_back(network);
+    replicaNetworks.back().SetWeights(parameters.memptr());
+  }
+
+  replicaOutputLayers.assign(replicas - 1, outputLayer);
+  replicaOutputs.resize(replicas);
+  replicaErrors.resize(replicas);
+  replicaDeltas.resize(replicas);
+  replicaGradients.resize(replicas);
+  replicasAreSet = true;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ReplicaEvaluateWithGradient(const size_t begin,
+                               MatType& gradient,
+                               const size_t batchSize)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // If the loss is a mean over the batch, then each replica's mean must be
+  // weighted by the size of its part of the batch.
+  const bool meanReduction = MeanReduction();
+
+  if (!replicasAreSet)
+    SetReplicaMemory();
+
+  const size_t numReplicas = std::min(replicas, batchSize);
+  for (size_t r = 0; r < replicaNetworks.size(); ++r)
+    replicaNetworks[r].Training() = network.Training();
+
+  std::vector<ElemType> objectives(numReplicas);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t r = 0; r < (omp_size_t) numReplicas; ++r)
+  {
+    // Each replica takes a contiguous part of the batch.
+    const size_t first = begin + (r * batchSize) / numReplicas;
+    const size_t last = begin + ((r + 1) * batchSize) / numReplicas;
+    const size_t points = last - first;
+
+    MultiLayer<MatType>& replica = (r == 0) ? network :
+        replicaNetworks[r - 1];
+    OutputLayerType& replicaOutputLayer = (r == 0) ? outputLayer :
+        replicaOutputLayers[r - 1];
+    MatType& replicaGradient = (r == 0) ? gradient : replicaGradients[r];
+
+    const MatType predictorsAlias(predictors.colptr(first), predictors.n_rows,
+        points, false, true);
+    const MatType responsesAlias(responses.colptr(first), responses.n_rows,
+        points, false, true);
+
+    replicaOutputs[r].set_size(replica.OutputSize(), points);
+    replica.Forward(predictorsAlias, replicaOutputs[r]);
+
+    objectives[r] = replicaOutputLayer.Forward(replicaOutputs[r],
+        responsesAlias);
+    replicaOutputLayer.Backward(replicaOutputs[r], responsesAlias,
+        replicaErrors[r]);
+
+    replicaDeltas[r].set_size(predictors.n_rows, points);
+    replica.Backward(replicaOutputs[r], replicaErrors[r], replicaDeltas[r]);
+
+    replicaGradient.set_size(parameters.n_rows, parameters.n_cols);
+    replica.Gradient(predictorsAlias, replicaErrors[r], replicaGradient);
+
+    if (meanReduction)
+    {
+      const ElemType weight = ElemType(points) / ElemType(batchSize);
+      objectives[r] *= weight;
+      replicaGradient *= weight;
+    }
+  }
+
+  // Sum the gradients with a binary tree: at each level, replica r takes the
+  // sum of replica r + step.  The order of the sums depends only on the
+  // number of replicas.
+  for (size_t step = 1; step < numReplicas; step *= 2)
+  {
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t r = 0; r < (omp_size_t) numReplicas; r += 2 * step)
+    {
+      if (r + step < numReplicas)
+      {
+        MatType& replicaGradient = (r == 0) ? gradient : replicaGradients[r];
+        replicaGradient += replicaGradients[r + step];
+        objectives[r] += objectives[r + step];
+      }
+    }
+  }
+
+  // Each replica's gradient includes the gradient of the layer regularizers,
+  // which only depends on the weights.  With mean reduction the weights of the
+  // replicas sum to one, so it is counted once already; otherwise, the extra
+  // copies are removed.
+  if (!meanReduction && numReplicas > 1)
+  {
+    MatType& regularizerGradient = replicaGradients[0];
+    regularizerGradient.zeros(parameters.n_rows, parameters.n_cols);
+    network.RegularizerGradient(regularizerGradient);
+    gradient -= ElemType(numReplicas - 1) * regularizerGradient;
+  }
+
+  // The layer losses are added once, from the master network.
+  return objectives[0] + network.Loss();
 }
 
 template<typename OutputLayerType,
@@ -109,6 +109,9 @@ class BaseLayer : public Layer<MatType>
     g = gy % derivative;
   }
 
+  //! The activation is applied element-wise, so it can be done in place.
+  bool ElementWise() const { return true; }
+
   /**
    * Serialize the layer.
    */
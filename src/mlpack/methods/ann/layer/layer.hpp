@@ -175,6 +175,16 @@ class Layer
                         MatType& /* gradient */)
   { /* Nothing to do here */ }
 
+  /**
+   * Add the gradient of the weight regularizer of the layer (if it has one) to
+   * the given gradient.  This is the part of the result of `Gradient()` that
+   * only depends on the weights.
+   *
+   * @param * (gradient) The gradient to add the regularizer gradient to.
+   */
+  virtual void RegularizerGradient(MatType& /* gradient */)
+  { /* Nothing to do here */ }
+
   /**
    * Reset the layer parameter. The method is called to assigned the allocated
    * memory to the internal layer parameters like weights and biases. The method
@@ -214,6 +224,23 @@ class Layer
    */
   virtual bool& Training() { return training; }
 
+  /**
+   * Return whether the layer is element-wise: each output element depends only
+   * on the input element in the same position, so `Forward()` may be called
+   * with the same matrix as both input and output.  Inference passes use this
+   * to apply such layers in place on the output of the previous layer.
+   */
+  virtual bool ElementWise() const { return false; }
+
+  /**
+   * Return whether a forward pass in training mode updates state of the layer
+   * other than its weights (for instance running statistics or recurrent
+   * state).  Such state would diverge between copies of the layer, so networks
+   * that contain these layers cannot be split across replicas (see
+   * `FFN::Replicas()`).
+   */
+  virtual bool HasTrainingState() const { return false; }
+
   //! Get the layer loss.  Overload this if the layer should add any extra loss
   //! to the loss function when computing the objective.  (TODO: better comment)
   virtual double Loss() { return 0; }
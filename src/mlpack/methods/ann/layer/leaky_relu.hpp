@@ -85,6 +85,9 @@ class LeakyReLUType : public Layer<MatType>
    */
   void Backward(const MatType& input, const MatType& gy, MatType& g);
 
+  //! The activation is applied element-wise, so it can be done in place.
+  bool ElementWise() const { return true; }
+
   //! Get the non zero gradient.
   double const& Alpha() const { return alpha; }
   //! Modify the non zero gradient.
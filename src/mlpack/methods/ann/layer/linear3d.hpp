@@ -104,6 +104,13 @@ class Linear3DType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient);
 
+  /**
+   * Add the gradient of the weight regularizer to the given gradient.
+   *
+   * @param gradient The gradient to add the regularizer gradient to.
+   */
+  void RegularizerGradient(MatType& gradient);
+
   //! Get the parameters.
   MatType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -181,6 +181,14 @@ void Linear3DType<MatType, RegularizerType>::Gradient(
   regularizer.Evaluate(weights, gradient);
 }
 
+template<typename MatType, typename RegularizerType>
+void Linear3DType<
+    MatType, RegularizerType
+>::RegularizerGradient(MatType& gradient)
+{
+  regularizer.Evaluate(weights, gradient);
+}
+
 template<typename MatType, typename RegularizerType>
 void Linear3DType<
     MatType, RegularizerType
@@ -131,6 +131,13 @@ void LinearType<MatType, RegularizerType>::Gradient(
   regularizer.Evaluate(weights, gradient);
 }
 
+template<typename MatType, typename RegularizerType>
+void LinearType<MatType, RegularizerType>::RegularizerGradient(
+    MatType& gradient)
+{
+  regularizer.Evaluate(weights, gradient);
+}
+
 template<typename MatType, typename RegularizerType>
 void LinearType<MatType, RegularizerType>::ComputeOutputDimensions()
 {
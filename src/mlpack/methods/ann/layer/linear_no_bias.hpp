@@ -103,6 +103,13 @@ class LinearNoBiasType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient);
 
+  /**
+   * Add the gradient of the weight regularizer to the given gradient.
+   *
+   * @param gradient The gradient to add the regularizer gradient to.
+   */
+  void RegularizerGradient(MatType& gradient);
+
   //! Get the parameters.
   const MatType& Parameters() const { return weight; }
   //! Modify the parameters.
@@ -126,6 +126,13 @@ void LinearNoBiasType<MatType, RegularizerType>::Gradient(
   regularizer.Evaluate(weight, gradient);
 }
 
+template<typename MatType, typename RegularizerType>
+void LinearNoBiasType<MatType, RegularizerType>::RegularizerGradient(
+    MatType& gradient)
+{
+  regularizer.Evaluate(weight, gradient);
+}
+
 template<typename MatType, typename RegularizerType>
 void LinearNoBiasType<MatType, RegularizerType>::ComputeOutputDimensions()
 {
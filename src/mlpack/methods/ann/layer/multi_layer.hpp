@@ -85,6 +85,19 @@ class MultiLayer : public Layer<MatType>
                const size_t start,
                const size_t end);
 
+  /**
+   * Perform a forward pass for inference only.  The result is the same as
+   * `Forward()`, but the outputs of the intermediate layers are not kept (so
+   * `Backward()` cannot be called afterwards).  Only two intermediate buffers
+   * are used, alternating between layers, and element-wise layers (see
+   * `Layer::ElementWise()`) are applied in place on the output of the layer
+   * before them.  `output` is expected to have the correct size.
+   *
+   * @param input Input data to pass through the MultiLayer.
+   * @param output Matrix to store output in.
+   */
+  void Infer(const MatType& input, MatType& output);
+
   /**
    * Perform a backward pass with the given data.  `gy` is expected to be the
    * propagated error from the subsequent layer (or output), `input` is expected
@@ -125,6 +138,14 @@ class MultiLayer : public Layer<MatType>
                         const MatType& error,
                         MatType& gradient);
 
+  /**
+   * Add the gradients of the weight regularizers of each layer to the given
+   * gradient.  `gradient` is expected to have the correct size already.
+   *
+   * @param gradient Matrix to add the regularizer gradients to.
+   */
+  virtual void RegularizerGradient(MatType& gradient);
+
   /**
    * Set the weights of the layer to use the memory given as `weightsPtr`.
    */
@@ -148,6 +169,12 @@ class MultiLayer : public Layer<MatType>
    */
   virtual double Loss() const;
 
+  /**
+   * Return whether any of the layers held by the MultiLayer updates state
+   * other than its weights during a forward pass in training mode.
+   */
+  virtual bool HasTrainingState() const;
+
   /*
    * Add a new module to the model.
    *
@@ -207,6 +234,14 @@ class MultiLayer : public Layer<MatType>
    */
   void InitializeBackwardPassMemory(const size_t batchSize);
 
+  /**
+   * Initialize the two buffers that `Infer()` alternates between, assuming that
+   * the input will have the given `batchSize`.  Only the outputs of the first
+   * `numLayers` layers are ever stored in the buffers.
+   */
+  void InitializeInferenceMemory(const size_t batchSize,
+                                 const size_t numLayers);
+
   /**
    * Initialize memory for the gradient pass.  This sets the internal aliases
    * `layerGradients` appropriately using the memory from the given `gradient`,
@@ -237,6 +272,15 @@ class MultiLayer : public Layer<MatType>
   //! These are aliases of `layerDeltaMatrix` for each layer.
   std::vector<MatType> layerDeltas;
 
+  //! This matrix holds the two buffers used by Infer().  See
+  //! `InitializeInferenceMemory()`.
+  MatType inferenceMatrix;
+  //! The size (in elements) of each of the buffers in `inferenceMatrix`.
+  size_t inferenceBufferSize;
+  //! Aliases of the two halves of `inferenceMatrix`, reshaped for the layer
+  //! currently writing into them.
+  MatType inferenceBuffers[2];
+
   //! Gradient aliases for each layer.  Note that this is *only* valid in the
   //! context of `Gradient()`!  We have it as a class member to avoid
   //! reallocating the `MatType`s each call to `Gradient()`.
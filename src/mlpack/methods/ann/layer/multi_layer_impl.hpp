@@ -22,7 +22,8 @@ template<typename MatType>
 MultiLayer<MatType>::MultiLayer() :
     inSize(0),
     totalInputSize(0),
-    totalOutputSize(0)
+    totalOutputSize(0),
+    inferenceBufferSize(0)
 {
   // Nothing to do.
 }
@@ -34,7 +35,8 @@ MultiLayer<MatType>::MultiLayer(const MultiLayer& other) :
     totalInputSize(other.totalInputSize),
     totalOutputSize(other.totalOutputSize),
     layerOutputMatrix(other.layerOutputMatrix),
-    layerDeltaMatrix(other.layerDeltaMatrix)
+    layerDeltaMatrix(other.layerDeltaMatrix),
+    inferenceBufferSize(0)
 {
   // Copy each layer.
   for (size_t i = 0; i < other.network.size(); ++i)
@@ -57,7 +59,8 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
     totalInputSize(std::move(other.totalInputSize)),
     totalOutputSize(std::move(other.totalOutputSize)),
     layerOutputMatrix(std::move(other.layerOutputMatrix)),
-    layerDeltaMatrix(std::move(other.layerDeltaMatrix))
+    layerDeltaMatrix(std::move(other.layerDeltaMatrix)),
+    inferenceBufferSize(0)
 {
   // Ensure that the aliases for layers during passes have the right size.
   layerOutputs.resize(network.size(), MatType());
@@ -173,6 +176,55 @@ void MultiLayer<MatType>::Forward(
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::Infer(const MatType& input, MatType& output)
+{
+  if (network.size() == 0)
+  {
+    // Empty network?
+    output = input;
+    return;
+  }
+
+  // Make sure training/testing mode is set right in each layer.
+  for (size_t i = 0; i < network.size(); ++i)
+    network[i]->Training() = this->training;
+
+  // The last layer that is not element-wise writes directly into `output`, and
+  // any element-wise layers after it are applied to `output` in place.  (The
+  // first layer can't be applied in place, since `input` is const.)
+  size_t lastLayer = network.size() - 1;
+  while (lastLayer > 0 && network[lastLayer]->ElementWise())
+    --lastLayer;
+
+  InitializeInferenceMemory(input.n_cols, lastLayer);
+
+  MatType* previousOutput = NULL;
+  size_t buffer = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    if (i > 0 && network[i]->ElementWise())
+    {
+      network[i]->Forward(*previousOutput, *previousOutput);
+      continue;
+    }
+
+    MatType* layerOutput = &output;
+    if (i < lastLayer)
+    {
+      // The output of this layer is only needed by the next layers, so it can
+      // overwrite whatever was in this buffer two layers ago.
+      MakeAlias(inferenceBuffers[buffer], inferenceMatrix.colptr(buffer *
+          inferenceBufferSize), network[i]->OutputSize(), input.n_cols);
+      layerOutput = &inferenceBuffers[buffer];
+      buffer = 1 - buffer;
+    }
+
+    network[i]->Forward((i == 0) ? input : *previousOutput, *layerOutput);
+    previousOutput = layerOutput;
+  }
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::Backward(
     const MatType& input, const MatType& gy, MatType& g)
@@ -229,6 +281,21 @@ void MultiLayer<MatType>::Gradient(
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::RegularizerGradient(MatType& gradient)
+{
+  if (network.size() > 1)
+  {
+    InitializeGradientPassMemory(gradient);
+    for (size_t i = 0; i < network.size(); ++i)
+      network[i]->RegularizerGradient(layerGradients[i]);
+  }
+  else if (network.size() == 1)
+  {
+    network[0]->RegularizerGradient(gradient);
+  }
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::SetWeights(typename MatType::elem_type* weightsPtr)
 {
@@ -308,6 +375,16 @@ double MultiLayer<MatType>::Loss() const
   return loss;
 }
 
+template<typename MatType>
+bool MultiLayer<MatType>::HasTrainingState() const
+{
+  for (size_t i = 0; i < network.size(); ++i)
+    if (network[i]->HasTrainingState())
+      return true;
+
+  return false;
+}
+
 template<typename MatType>
 template<typename Archive>
 void MultiLayer<MatType>::serialize(
@@ -324,6 +401,8 @@ void MultiLayer<MatType>::serialize(
   {
     layerOutputMatrix.clear();
     layerDeltaMatrix.clear();
+    inferenceMatrix.clear();
+    inferenceBufferSize = 0;
     layerGradients.clear();
     layerOutputs.resize(network.size(), MatType());
     layerDeltas.resize(network.size(), MatType());
@@ -393,6 +472,30 @@ void MultiLayer<MatType>::InitializeBackwardPassMemory(
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::InitializeInferenceMemory(const size_t batchSize,
+                                                    const size_t numLayers)
+{
+  // Each buffer must be able to hold the largest output of any layer that
+  // writes into a buffer.
+  size_t maxOutputSize = 0;
+  for (size_t i = 0; i < numLayers; ++i)
+  {
+    if (i == 0 || !network[i]->ElementWise())
+      maxOutputSize = std::max(maxOutputSize, network[i]->OutputSize());
+  }
+
+  inferenceBufferSize = batchSize * maxOutputSize;
+
+  // As in InitializeForwardPassMemory(), we avoid resizing the matrix down,
+  // unless we only need 10% or less of it.
+  if (2 * inferenceBufferSize > inferenceMatrix.n_elem ||
+      2 * inferenceBufferSize < std::floor(0.1 * inferenceMatrix.n_elem))
+  {
+    inferenceMatrix = MatType(1, 2 * inferenceBufferSize);
+  }
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::InitializeGradientPassMemory(MatType& gradient)
 {
@@ -65,6 +65,9 @@ class RecurrentLayer : public Layer<MatType>
       const size_t bpttSteps,
       const size_t batchSize) = 0;
 
+  //! A recurrent layer keeps the state of previous steps.
+  bool HasTrainingState() const { return true; }
+
   //! Get the current step index to use in a forward or backward pass.
   size_t CurrentStep() const { return currentStep; }
   //! Modify the current step index to use in a forward or backward pass.
@@ -100,6 +100,62 @@ class BiasSVDFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Take a step of the given size along the negative gradient of the cost of
+   * one rating, in place.  Only the columns of the user and the item of the
+   * rating are modified, without allocating any memory.  This is used by
+   * StratifiedSGD.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param i Index of the rating.
+   * @param stepSize Step size.
+   * @param sharedUpdate Unused, since every parameter belongs to a user or
+   *     an item.
+   */
+  void UpdateRating(arma::mat& parameters,
+                    const size_t i,
+                    const double stepSize,
+                    arma::mat& sharedUpdate) const;
+
+  /**
+   * Evaluate the gradient of the cost function over a batch of ratings as a
+   * list of column updates: deltas.col(k) is the gradient of column
+   * columns[k], including the bias in its last row.  Each rating gives one
+   * delta for its user and one for its item, so the cost is proportional to
+   * the rank and not to the number of parameters.  A column may appear more
+   * than once.  This is used by SparseSGD.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param start The first index of the training examples to use.
+   * @param columns Indices of the parameter columns to update.
+   * @param deltas Gradient of each of the given columns.
+   * @param batchSize Size of batch to calculate gradient for.
+   */
+  void SparseGradient(const arma::mat& parameters,
+                      const size_t start,
+                      arma::uvec& columns,
+                      arma::mat& deltas,
+                      const size_t batchSize = 1) const;
+
+  /**
+   * Store the parameter columns that the gradient of a batch of ratings
+   * depends on: the user and the item column of each rating.
+   *
+   * @param start The first index of the training examples to use.
+   * @param columns Indices of the parameter columns.
+   * @param batchSize Size of the batch.
+   */
+  void GradientColumns(const size_t start,
+                       arma::uvec& columns,
+                       const size_t batchSize = 1) const;
+
+  /**
+   * Return the weight decay that applies to every parameter at every step.
+   * This is 0, since the regularization of a column is only part of the
+   * gradients of the ratings of its user or item.
+   */
+  double WeightDecay() const { return 0.0; }
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
@@ -121,6 +177,9 @@ class BiasSVDFunction
   //! Return the rank used for the factorization.
   size_t Rank() const { return rank; }
 
+  //! Return the number of parameter columns that any rating may update.
+  size_t NumSharedColumns() const { return 0; }
+
  private:
   //! Rating data.  This will be an alias until Shuffle() is called.
   MatType data;
@@ -25,6 +25,7 @@
 #include <mlpack/methods/cf/decomposition_policies/nmf_method.hpp>
 #include <mlpack/methods/cf/neighbor_search_policies/lmetric_search.hpp>
 #include <mlpack/methods/cf/interpolation_policies/average_interpolation.hpp>
+#include <mlpack/methods/cf/neighborhood_index.hpp>
 #include <set>
 #include <map>
 #include <iostream>
@@ -182,6 +183,22 @@ class CFType
   //! Get the normalization object.
   const NormalizationType& Normalization() const { return normalization; }
 
+  //! Get the index used to find the neighborhood of users.
+  const NeighborhoodIndex& UserIndex() const { return neighborhoodIndex; }
+
+  /**
+   * Update the neighborhood index after the factors of the given users in the
+   * decomposition have changed (or users have been added).  The index is
+   * built by Train(), so this is only needed if the decomposition is modified
+   * afterwards.
+   *
+   * @param users Users whose factors have changed.
+   */
+  void UpdateUserIndex(const arma::Col<size_t>& users)
+  {
+    neighborhoodIndex.Update(decomposition, users);
+  }
+
   /**
    * Generates the given number of recommendations for all users.
    *
@@ -263,6 +280,44 @@ class CFType
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users,
+   * using the neighborhood index if the decomposition supports it.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const;
+
+  // SFINAE check for decompositions that can compute weighted sums of user
+  // ratings in one batch.
+  HAS_MEM_FUNC(GetWeightedRatings, HasGetWeightedRatings);
+
+  /**
+   * Compute the weighted sums of user ratings given by userWeights (column i
+   * of ratings is the sum over users u of userWeights(u, i) times the ratings
+   * of user u), with a single batch call to the decomposition.
+   */
+  template<typename PolicyType = DecompositionPolicy>
+  void GetWeightedRatings(
+      const arma::sp_mat& userWeights,
+      arma::mat& ratings,
+      const typename std::enable_if<HasGetWeightedRatings<PolicyType,
+          void(PolicyType::*)(const arma::sp_mat&, arma::mat&) const>::value
+          >::type* = 0) const;
+
+  /**
+   * Compute the weighted sums of user ratings given by userWeights, for
+   * decompositions that only give the ratings of one user at a time.
+   */
+  template<typename PolicyType = DecompositionPolicy>
+  void GetWeightedRatings(
+      const arma::sp_mat& userWeights,
+      arma::mat& ratings,
+      const typename std::enable_if<!HasGetWeightedRatings<PolicyType,
+          void(PolicyType::*)(const arma::sp_mat&, arma::mat&) const>::value
+          >::type* = 0) const;
+
   //! Number of users for similarity.
   size_t numUsersForSimilarity;
   //! Rank used for matrix factorization.
@@ -273,15 +328,19 @@ class CFType
   arma::sp_mat cleanedData;
   //! Data normalization object.
   NormalizationType normalization;
+  //! Index of the user factors, used to find neighborhoods.
+  NeighborhoodIndex neighborhoodIndex;
 
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
 
-  //! Compare two candidates based on the value.
+  //! Compare two candidates; returns true if c1 is a better recommendation
+  //! than c2.  Ties are broken towards the lower item.
   struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
+    bool operator()(const Candidate& c1, const Candidate& c2) const
     {
-      return c1.first > c2.first;
+      return (c1.first > c2.first) ||
+          (c1.first == c2.first && c1.second < c2.second);
     };
   };
 }; // class CFType
@@ -109,6 +109,9 @@ Train(const arma::mat& data,
   // data matrices.
   this->decomposition.Apply(
       normalizedData, cleanedData, rank, maxIterations, minResidue, mit);
+
+  // Index the new user factors, so that neighborhoods can be found quickly.
+  neighborhoodIndex.Build(this->decomposition);
 }
 
 // Train when data is given as sparse matrix of user item table.
@@ -148,6 +151,9 @@ Train(const arma::sp_mat& data,
   // data matrices.
   this->decomposition.Apply(
       data, cleanedData, rank, maxIterations, minResidue, mit);
+
+  // Index the new user factors, so that neighborhoods can be found quickly.
+  neighborhoodIndex.Build(this->decomposition);
 }
 
 template<typename DecompositionPolicy,
@@ -191,78 +197,119 @@ GetRecommendations(const size_t numRecs,
   // weighted sum of both the query user and the local neighborhood of the
   // query user.
   // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  GetNeighborhood<NeighborSearchPolicy>(users, neighborhood, similarities);
 
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the ratings vector.
   recommendations.set_size(numRecs, users.n_elem);
-  arma::mat values(numRecs, users.n_elem);
-  recommendations.fill(SIZE_MAX);
-  values.fill(DBL_MAX);
 
   // Initialization of an InterpolationPolicy object should be put ahead of the
   // following loop, because the initialization may takes a relatively long
   // time and we don't want to repeat the initialization process in each loop.
+  // Interpolation policies may also cache results between calls, so the
+  // weights are all computed here, before any parallel work.
   InterpolationPolicy interpolation(cleanedData);
-
+  arma::mat weights(numUsersForSimilarity, users.n_elem);
   for (size_t i = 0; i < users.n_elem; ++i)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
-
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
+    interpolation.GetWeights(weights.col(i), decomposition, users(i),
         neighborhood.col(i), similarities.col(i), cleanedData);
+  }
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+  // Users are scored in blocks: the weighted sums of the neighborhood ratings
+  // of every user in a block are computed with one batch call to the
+  // decomposition, which is a single matrix multiplication for the
+  // factorization-based policies.  The ratings of a block are a dense
+  // (items x block size) matrix, so the block size is chosen to keep it under
+  // about 64MB.
+  const size_t maxBlockElements = (64 << 20) / sizeof(double);
+  const size_t blockSize = std::max((size_t) 1,
+      maxBlockElements / std::max((size_t) cleanedData.n_rows, (size_t) 1));
+  const size_t defaultItem = cleanedData.n_rows;
+  std::vector<char> incomplete(users.n_elem, false);
+  for (size_t begin = 0; begin < users.n_elem; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, (size_t) users.n_elem);
+
+    // Column i of userWeights holds the interpolation weights of the
+    // neighborhood of user (begin + i).
+    arma::umat locations(2, neighborhood.n_rows * (end - begin));
+    arma::vec values(locations.n_cols);
+    for (size_t i = begin; i < end; ++i)
     {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      {
+        const size_t index = (i - begin) * neighborhood.n_rows + j;
+        locations(0, index) = neighborhood(j, i);
+        locations(1, index) = i - begin;
+        values[index] = weights(j, i);
+      }
     }
+    const arma::sp_mat userWeights(true, locations, values, cleanedData.n_cols,
+        end - begin);
 
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+    arma::mat ratings;
+    GetWeightedRatings(userWeights, ratings);
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
+    #pragma omp parallel for
+    for (omp_size_t b = 0; b < (omp_size_t) (end - begin); ++b)
     {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      const size_t i = begin + b;
+      const size_t user = users(i);
+
+      // Keep the best numRecs candidate recommendations for the given user in
+      // a heap whose front is the worst of them.  The items that the user
+      // already rated are the nonzero rows of its column of cleanedData, which
+      // are sorted, so they can be skipped in one merged pass.  (The algorithm
+      // omits ratings of zero; thus, when normalizing original ratings in
+      // Normalize(), if a normalized rating equals zero, it is set to the
+      // smallest positive double value.)
+      std::vector<Candidate> candidates;
+      candidates.reserve(numRecs);
+      size_t rated = cleanedData.col_ptrs[user];
+      const size_t ratedEnd = cleanedData.col_ptrs[user + 1];
+      for (size_t j = 0; j < cleanedData.n_rows; ++j)
       {
-        Candidate c = std::make_pair(realRating, j);
-        pqueue.pop();
-        pqueue.push(c);
+        if (rated < ratedEnd && cleanedData.row_indices[rated] == j)
+        {
+          ++rated;
+          continue; // The user already rated the item.
+        }
+
+        // Denormalize rating before comparison.
+        const Candidate c = std::make_pair(
+            normalization.Denormalize(user, j, ratings(j, b)), j);
+        if (candidates.size() < numRecs)
+        {
+          candidates.push_back(c);
+          std::push_heap(candidates.begin(), candidates.end(), CandidateCmp());
+        }
+        else if (numRecs > 0 && CandidateCmp()(c, candidates.front()))
+        {
+          std::pop_heap(candidates.begin(), candidates.end(), CandidateCmp());
+          candidates.back() = c;
+          std::push_heap(candidates.begin(), candidates.end(), CandidateCmp());
+        }
       }
-    }
 
-    for (size_t p = 1; p <= numRecs; p++)
-    {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
+      // Order the kept candidates from best to worst.
+      std::sort_heap(candidates.begin(), candidates.end(), CandidateCmp());
+      const size_t numFound = candidates.size();
+
+      for (size_t p = 0; p < numFound; ++p)
+        recommendations(p, i) = candidates[p].second;
+      for (size_t p = numFound; p < numRecs; ++p)
+        recommendations(p, i) = defaultItem;
+
+      incomplete[i] = (numFound < numRecs);
     }
+  }
 
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (incomplete[i])
       Log::Warn << "Could not provide " << numRecs << " recommendations "
           << "for user " << users(i) << " (not enough un-rated items)!"
           << std::endl;
@@ -293,8 +340,7 @@ Predict(const size_t user, const size_t item) const
   // Calculate the neighborhood of the queried users.
   arma::Col<size_t> users(1);
   users(0) = user;
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  GetNeighborhood<NeighborSearchPolicy>(users, neighborhood, similarities);
 
   arma::vec weights(numUsersForSimilarity);
 
@@ -344,8 +390,7 @@ Predict(const arma::Mat<size_t>& combinations,
   // weighted sum of both the query user and the local neighborhood of the
   // query user.
   // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  GetNeighborhood<NeighborSearchPolicy>(users, neighborhood, similarities);
 
   arma::mat weights(numUsersForSimilarity, users.n_elem);
 
@@ -384,6 +429,71 @@ Predict(const arma::Mat<size_t>& combinations,
   normalization.Denormalize(combinations, predictions);
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetNeighborhood(const arma::Col<size_t>& users,
+                arma::Mat<size_t>& neighborhood,
+                arma::mat& similarities) const
+{
+  // If the decomposition can't provide its user factors, it has to do the
+  // search itself.
+  if (neighborhoodIndex.IsEmpty())
+  {
+    decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
+  else
+  {
+    neighborhoodIndex.template Search<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename PolicyType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetWeightedRatings(
+    const arma::sp_mat& userWeights,
+    arma::mat& ratings,
+    const typename std::enable_if<HasGetWeightedRatings<PolicyType,
+        void(PolicyType::*)(const arma::sp_mat&, arma::mat&) const>::value
+        >::type*) const
+{
+  decomposition.GetWeightedRatings(userWeights, ratings);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename PolicyType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetWeightedRatings(
+    const arma::sp_mat& userWeights,
+    arma::mat& ratings,
+    const typename std::enable_if<!HasGetWeightedRatings<PolicyType,
+        void(PolicyType::*)(const arma::sp_mat&, arma::mat&) const>::value
+        >::type*) const
+{
+  ratings.zeros(cleanedData.n_rows, userWeights.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) userWeights.n_cols; ++i)
+  {
+    arma::vec userRatings;
+    for (size_t k = userWeights.col_ptrs[i]; k < userWeights.col_ptrs[i + 1];
+         ++k)
+    {
+      decomposition.GetRatingOfUser(userWeights.row_indices[k], userRatings);
+      ratings.col(i) += userWeights.values[k] * userRatings;
+    }
+  }
+}
+
 template<typename DecompositionPolicy,
          typename NormalizationType>
 void CFType<DecompositionPolicy,
@@ -432,6 +542,11 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(decomposition));
   ar(CEREAL_NVP(cleanedData));
   ar(CEREAL_NVP(normalization));
+
+  // The neighborhood index only holds the user factors of the decomposition,
+  // so it is rebuilt instead of being saved.
+  if (cereal::is_loading<Archive>())
+    neighborhoodIndex.Build(decomposition);
 }
 
 } // namespace cf
@@ -30,6 +30,7 @@
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svdplusplus_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/implicit_als_method.hpp>
 
 #include <mlpack/methods/cf/interpolation_policies/average_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/regression_interpolation.hpp>
@@ -96,6 +97,8 @@ BINDING_LONG_DESC(
     " - 'SVDCompleteIncremental' -- SVD complete incremental learning\n"
     " - 'BiasSVD' -- Bias SVD using a SGD optimizer\n"
     " - 'SVDPP' -- SVD++ using a SGD optimizer\n"
+    " - 'ImplicitALS' -- Alternating least squares for implicit feedback "
+    "(such as click or view counts), with conjugate gradient updates\n"
     "\n\n"
     "The following neighbor search algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("neighbor_search") + " parameter:"
@@ -221,7 +224,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
   RequireParamInSet<string>(params, "algorithm", { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "RandSVD", "BiasSVD", "SVDPP" }, true, "unknown algorithm");
+      "RandSVD", "BiasSVD", "SVDPP", "ImplicitALS" }, true,
+      "unknown algorithm");
 
   ReportIgnoredParam(params, {{ "iteration_only_termination", true }},
       "min_residue");
@@ -307,6 +311,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
           "when max_iterations is reached");
       cf->DecompositionType() = CFModel::SVD_PLUS_PLUS;
     }
+    else if (algo == "ImplicitALS")
+    {
+      cf->DecompositionType() = CFModel::IMPLICIT_ALS;
+    }
 
     // Perform the factorization and do whatever the user wanted.
     const size_t neighborhood = (size_t) params.Get<int>("neighborhood");
@@ -166,6 +166,11 @@ void CFModel::Train(const arma::mat& data,
       cf = TrainHelper(SVDPlusPlusPolicy(), normalizationType, data,
           numUsersForSimilarity, rank, maxIterations, minResidue, mit);
       break;
+
+    case IMPLICIT_ALS:
+      cf = TrainHelper(ImplicitALSPolicy(), normalizationType, data,
+          numUsersForSimilarity, rank, maxIterations, minResidue, mit);
+      break;
   }
 }
 
@@ -171,7 +171,8 @@ class CFModel
     SVD_COMPLETE,
     SVD_INCOMPLETE,
     BIAS_SVD,
-    SVD_PLUS_PLUS
+    SVD_PLUS_PLUS,
+    IMPLICIT_ALS
   };
 
   enum NormalizationTypes
@@ -24,6 +24,7 @@
 
 #include "decomposition_policies/batch_svd_method.hpp"
 #include "decomposition_policies/bias_svd_method.hpp"
+#include "decomposition_policies/implicit_als_method.hpp"
 #include "decomposition_policies/nmf_method.hpp"
 #include "decomposition_policies/randomized_svd_method.hpp"
 #include "decomposition_policies/regularized_svd_method.hpp"
@@ -261,6 +262,9 @@ inline CFWrapperBase* InitializeModel(
 
     case CFModel::SVD_PLUS_PLUS:
       return InitializeModelHelper<SVDPlusPlusPolicy>(normalizationType);
+
+    case CFModel::IMPLICIT_ALS:
+      return InitializeModelHelper<ImplicitALSPolicy>(normalizationType);
   }
 
   // This shouldn't ever happen.
@@ -368,6 +372,10 @@ void CFModel::serialize(Archive& ar, const uint32_t /* version */)
     case SVD_PLUS_PLUS:
       SerializeHelper<SVDPlusPlusPolicy>(ar, cf, normalizationType);
       break;
+
+    case IMPLICIT_ALS:
+      SerializeHelper<ImplicitALSPolicy>(ar, cf, normalizationType);
+      break;
   }
 }
 
@@ -18,6 +18,7 @@
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/termination_policies/simple_residue_termination.hpp>
 #include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
+#include "stretched_user_factors.hpp"
 
 namespace mlpack {
 namespace cf {
@@ -107,6 +108,32 @@ class BatchSVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of users.  Column i of the
+   * result holds the sum over all users u of userWeights(u, i) times the
+   * predicted ratings of user u, so that the ratings of a whole block of
+   * neighborhoods are computed with a single matrix multiplication.
+   *
+   * @param userWeights Weight of each user (rows) in each sum (columns).
+   * @param ratings Resulting ratings; column i holds sum i.
+   */
+  void GetWeightedRatings(const arma::sp_mat& userWeights,
+                          arma::mat& ratings) const
+  {
+    ratings = w * arma::mat(h * userWeights);
+  }
+
+  /**
+   * Get the factors of every user that neighbor search is done on (column i
+   * holds user i); see StretchedUserFactors().
+   *
+   * @param factors Matrix to store the user factors in.
+   */
+  void GetUserFactors(arma::mat& factors) const
+  {
+    StretchedUserFactors(w, h, factors);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
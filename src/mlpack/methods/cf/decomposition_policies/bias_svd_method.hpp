@@ -106,6 +106,34 @@ class BiasSVDPolicy
     rating = w * h.col(user) + p + q(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of users.  Column i of the
+   * result holds the sum over all users u of userWeights(u, i) times the
+   * predicted ratings of user u, so that the ratings of a whole block of
+   * neighborhoods are computed with a single matrix multiplication.
+   *
+   * @param userWeights Weight of each user (rows) in each sum (columns).
+   * @param ratings Resulting ratings; column i holds sum i.
+   */
+  void GetWeightedRatings(const arma::sp_mat& userWeights,
+                          arma::mat& ratings) const
+  {
+    ratings = w * arma::mat(h * userWeights);
+    const arma::rowvec weightSums(
+        arma::ones<arma::rowvec>(userWeights.n_rows) * userWeights);
+    const arma::rowvec userBiases(q.t() * userWeights);
+    ratings += p * weightSums;
+    ratings.each_row() += userBiases;
+  }
+
+  /**
+   * Get the factors of every user that neighbor search is done on (column i
+   * holds user i).
+   *
+   * @param factors Matrix to store the user factors in.
+   */
+  void GetUserFactors(arma::mat& factors) const { factors = h; }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
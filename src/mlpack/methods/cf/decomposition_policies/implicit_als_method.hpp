@@ -0,0 +1,380 @@
+/**
+ * @file methods/cf/decomposition_policies/implicit_als_method.hpp
+ *
+ * Implementation of alternating least squares for implicit feedback, for use
+ * in Collaborative Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_ALS_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_ALS_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "stretched_user_factors.hpp"
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Implementation of alternating least squares for implicit feedback (such as
+ * clicks, views or purchase counts) as a decomposition policy for CFType.
+ * Following Hu, Koren and Volinsky, every observed entry r_ui of the data is
+ * turned into a preference p_ui = 1 with confidence c_ui = 1 + alpha * r_ui,
+ * and every unobserved entry into a preference of 0 with confidence 1.  The
+ * user factors X and the item factors Y then minimize
+ *
+ *   sum_{u, i} c_ui (p_ui - x_u^T y_i)^2 + lambda (|X|^2 + |Y|^2)
+ *
+ * over all entries, observed or not.  The factors are updated alternately;
+ * each user solves
+ *
+ *   (Y^T Y + Y^T (C_u - I) Y + lambda I) x_u = Y^T C_u p_u,
+ *
+ * where Y^T Y is shared by all users, and Y^T (C_u - I) Y and Y^T C_u p_u only
+ * involve the items the user interacted with.  Instead of solving the system
+ * exactly, a few conjugate gradient steps are taken from the current factors,
+ * as proposed by Takacs, Pilaszy and Tikk; this never forms the rank x rank
+ * matrix of a user.  The items are solved in the same way, and the users (and
+ * then the items) are solved in parallel with OpenMP.
+ *
+ * For more information, see the following papers:
+ *
+ * @code
+ * @inproceedings{hu2008collaborative,
+ *   title = {Collaborative filtering for implicit feedback datasets},
+ *   author = {Hu, Yifan and Koren, Yehuda and Volinsky, Chris},
+ *   booktitle = {Proceedings of the 8th IEEE International Conference on Data
+ *       Mining (ICDM '08)},
+ *   pages = {263--272},
+ *   year = {2008}
+ * }
+ *
+ * @inproceedings{takacs2011applications,
+ *   title = {Applications of the conjugate gradient method for implicit
+ *       feedback collaborative filtering},
+ *   author = {Tak{\'a}cs, G{\'a}bor and Pil{\'a}szy, Istv{\'a}n and Tikk,
+ *       Domonkos},
+ *   booktitle = {Proceedings of the Fifth ACM Conference on Recommender
+ *       Systems (RecSys '11)},
+ *   pages = {297--300},
+ *   year = {2011}
+ * }
+ * @endcode
+ *
+ * The ratings given to CFType are the implicit feedback counts r_ui, so they
+ * should not be normalized (use NoNormalization, the default).  The predicted
+ * ratings are preferences, which are close to 1 for items the user is likely
+ * to interact with.
+ *
+ * An example of how to use ImplicitALSPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, count) table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ImplicitALSPolicy> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class ImplicitALSPolicy
+{
+ public:
+  /**
+   * Use alternating least squares for implicit feedback to perform
+   * collaborative filtering.
+   *
+   * @param alpha Scale of the confidence in the observed entries.
+   * @param lambda Regularization parameter.
+   * @param cgSteps Number of conjugate gradient steps of each solve.
+   */
+  ImplicitALSPolicy(const double alpha = 40.0,
+                    const double lambda = 0.1,
+                    const size_t cgSteps = 3) :
+      alpha(alpha),
+      lambda(lambda),
+      cgSteps(cgSteps)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided data set using alternating
+   * least squares for implicit feedback.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix (cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of iterations.
+   * @param minResidue Residue required to terminate.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    // The columns of cleanedData hold the items of each user; the columns of
+    // its transpose hold the users of each item.
+    const arma::sp_mat itemData = cleanedData.t();
+
+    arma::mat userFactors(rank, cleanedData.n_cols);
+    arma::mat itemFactors(rank, cleanedData.n_rows);
+    userFactors.randu();
+    itemFactors.randu();
+    userFactors *= 0.01;
+    itemFactors *= 0.01;
+
+    arma::mat oldUserFactors, oldItemFactors;
+    for (size_t i = 0; i != maxIterations; ++i)
+    {
+      if (!mit)
+      {
+        oldUserFactors = userFactors;
+        oldItemFactors = itemFactors;
+      }
+
+      Solve(cleanedData, itemFactors, userFactors);
+      Solve(itemData, userFactors, itemFactors);
+
+      if (!mit)
+      {
+        // The residue is the relative change of the factors.
+        const double change = arma::accu(arma::square(userFactors -
+            oldUserFactors)) + arma::accu(arma::square(itemFactors -
+            oldItemFactors));
+        const double norm = arma::accu(arma::square(oldUserFactors)) +
+            arma::accu(arma::square(oldItemFactors));
+        const double residue = std::sqrt(change / norm);
+
+        Log::Info << "Implicit ALS: iteration " << i + 1 << ", residue "
+            << residue << "." << std::endl;
+        if (residue < minResidue)
+          break;
+      }
+    }
+
+    w = itemFactors.t();
+    h = std::move(userFactors);
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the weighted sums of the predicted ratings of users.  Column i of the
+   * result holds the sum over all users u of userWeights(u, i) times the
+   * predicted ratings of user u, so that the ratings of a whole block of
+   * neighborhoods are computed with a single matrix multiplication.
+   *
+   * @param userWeights Weight of each user (rows) in each sum (columns).
+   * @param ratings Resulting ratings; column i holds sum i.
+   */
+  void GetWeightedRatings(const arma::sp_mat& userWeights,
+                          arma::mat& ratings) const
+  {
+    ratings = w * arma::mat(h * userWeights);
+  }
+
+  /**
+   * Get the factors of every user that neighbor search is done on (column i
+   * holds user i); see StretchedUserFactors().
+   *
+   * @param factors Matrix to store the user factors in.
+   */
+  void GetUserFactors(arma::mat& factors) const
+  {
+    StretchedUserFactors(w, h, factors);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+
+  //! Get the confidence scale.
+  double Alpha() const { return alpha; }
+  //! Modify the confidence scale.
+  double& Alpha() { return alpha; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the number of conjugate gradient steps of each solve.
+  size_t CGSteps() const { return cgSteps; }
+  //! Modify the number of conjugate gradient steps of each solve.
+  size_t& CGSteps() { return cgSteps; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(alpha));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(cgSteps));
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  /**
+   * Update the factors of every column of the data (the users or the items),
+   * with the factors of the other side fixed, by taking cgSteps conjugate
+   * gradient steps on the system of each column.
+   *
+   * @param data Observations; column j holds the observations of factor j,
+   *     and its rows index the columns of fixed.
+   * @param fixed Factors of the other side.
+   * @param factors Factors to update.
+   */
+  void Solve(const arma::sp_mat& data,
+             const arma::mat& fixed,
+             arma::mat& factors) const
+  {
+    const size_t rank = fixed.n_rows;
+
+    // Y^T Y + lambda I is shared by all solves.
+    arma::mat gram = fixed * fixed.t();
+    gram.diag() += lambda;
+
+    #pragma omp parallel
+    {
+      // The residual, the search direction and its product with the system
+      // matrix, reused for every solve of this thread.
+      arma::vec r(rank), p(rank), ap(rank);
+
+      #pragma omp for schedule(dynamic, 256)
+      for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+      {
+        arma::vec x(factors.colptr(j), rank, false, true);
+
+        // r = b - A x, where A = Y^T Y + lambda I + sum_i (c_i - 1) y_i y_i^T
+        // and b = sum_i c_i y_i, over the observations i of column j.
+        r = gram * x;
+        r *= -1.0;
+        arma::sp_mat::const_iterator it = data.begin_col(j);
+        arma::sp_mat::const_iterator itEnd = data.end_col(j);
+        for (; it != itEnd; ++it)
+        {
+          const double confidence = 1.0 + alpha * (*it);
+          r += (confidence - (confidence - 1.0) *
+              arma::dot(fixed.col(it.row()), x)) * fixed.col(it.row());
+        }
+
+        p = r;
+        double rsOld = arma::dot(r, r);
+        for (size_t step = 0; step < cgSteps; ++step)
+        {
+          // The system is solved exactly.
+          if (rsOld < 1e-20)
+            break;
+
+          ap = gram * p;
+          for (it = data.begin_col(j); it != itEnd; ++it)
+          {
+            ap += (alpha * (*it) * arma::dot(fixed.col(it.row()), p)) *
+                fixed.col(it.row());
+          }
+
+          const double stepSize = rsOld / arma::dot(p, ap);
+          x += stepSize * p;
+          r -= stepSize * ap;
+
+          const double rsNew = arma::dot(r, r);
+          p = r + (rsNew / rsOld) * p;
+          rsOld = rsNew;
+        }
+      }
+    }
+  }
+
+  //! Scale of the confidence in the observed entries.
+  double alpha;
+  //! Regularization parameter.
+  double lambda;
+  //! Number of conjugate gradient steps of each solve.
+  size_t cgSteps;
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
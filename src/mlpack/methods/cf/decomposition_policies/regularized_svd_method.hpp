@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/regularized_svd/regularized_svd.hpp>
+#include "stretched_user_factors.hpp"
 
 namespace mlpack {
 namespace cf {
@@ -100,6 +101,32 @@ class RegSVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of users.  Column i of the
+   * result holds the sum over all users u of userWeights(u, i) times the
+   * predicted ratings of user u, so that the ratings of a whole block of
+   * neighborhoods are computed with a single matrix multiplication.
+   *
+   * @param userWeights Weight of each user (rows) in each sum (columns).
+   * @param ratings Resulting ratings; column i holds sum i.
+   */
+  void GetWeightedRatings(const arma::sp_mat& userWeights,
+                          arma::mat& ratings) const
+  {
+    ratings = w * arma::mat(h * userWeights);
+  }
+
+  /**
+   * Get the factors of every user that neighbor search is done on (column i
+   * holds user i); see StretchedUserFactors().
+   *
+   * @param factors Matrix to store the user factors in.
+   */
+  void GetUserFactors(arma::mat& factors) const
+  {
+    StretchedUserFactors(w, h, factors);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -0,0 +1,44 @@
+/**
+ * @file methods/cf/decomposition_policies/stretched_user_factors.hpp
+ *
+ * Computation of the user factors that neighbor search is done on, for
+ * decompositions that predict the rating matrix as W * H.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_STRETCHED_USER_FACTORS_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_STRETCHED_USER_FACTORS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Get the factors of every user that neighbor search is done on (column i
+ * holds user i), for a decomposition that predicts the rating matrix as
+ * X = W * H.  Since d(X.col(i), X.col(j)) = d(W H.col(i), W H.col(j)), this is
+ * nearest neighbor search on H with the Mahalanobis distance where
+ * M^{-1} = W^T W.  With the Cholesky decomposition M^{-1} = L L^T, the user
+ * factors are L^T H, so that distances between columns are the same as
+ * distances between the users' predicted ratings.
+ *
+ * @param w Item matrix of the decomposition.
+ * @param h User matrix of the decomposition.
+ * @param factors Matrix to store the user factors in.
+ */
+inline void StretchedUserFactors(const arma::mat& w,
+                                 const arma::mat& h,
+                                 arma::mat& factors)
+{
+  arma::mat l = arma::chol(w.t() * w);
+  factors = l * h; // Due to the Armadillo API, l is L^T.
+}
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
@@ -141,6 +141,57 @@ class SVDPlusPlusPolicy
     rating = w * userVec + p + q(user);
   }
 
+  /**
+   * Get the weighted sums of the predicted ratings of users.  Column i of the
+   * result holds the sum over all users u of userWeights(u, i) times the
+   * predicted ratings of user u, so that the ratings of a whole block of
+   * neighborhoods are computed with a single matrix multiplication.
+   *
+   * @param userWeights Weight of each user (rows) in each sum (columns).
+   * @param ratings Resulting ratings; column i holds sum i.
+   */
+  void GetWeightedRatings(const arma::sp_mat& userWeights,
+                          arma::mat& ratings) const
+  {
+    // Combine the user vectors (including implicit feedback) of each weighted
+    // user, so that only one multiplication by the item matrix is needed.
+    arma::mat userVecs(h.n_rows, userWeights.n_cols, arma::fill::zeros);
+    arma::rowvec weightSums(userWeights.n_cols, arma::fill::zeros);
+    arma::rowvec userBiases(userWeights.n_cols, arma::fill::zeros);
+    for (arma::sp_mat::const_iterator it = userWeights.begin();
+         it != userWeights.end(); ++it)
+    {
+      const size_t user = it.row();
+      arma::vec userVec(h.n_rows, arma::fill::zeros);
+      arma::sp_mat::const_iterator imp = implicitData.begin_col(user);
+      arma::sp_mat::const_iterator impEnd = implicitData.end_col(user);
+      size_t implicitCount = 0;
+      for (; imp != impEnd; ++imp)
+      {
+        userVec += y.col(imp.row());
+        implicitCount += 1;
+      }
+      if (implicitCount != 0)
+        userVec /= std::sqrt(implicitCount);
+      userVec += h.col(user);
+
+      userVecs.col(it.col()) += (*it) * userVec;
+      weightSums[it.col()] += (*it);
+      userBiases[it.col()] += (*it) * q(user);
+    }
+
+    ratings = w * userVecs + p * weightSums;
+    ratings.each_row() += userBiases;
+  }
+
+  /**
+   * Get the factors of every user that neighbor search is done on (column i
+   * holds user i).
+   *
+   * @param factors Matrix to store the user factors in.
+   */
+  void GetUserFactors(arma::mat& factors) const { factors = h; }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -0,0 +1,365 @@
+/**
+ * @file methods/cf/neighborhood_index.hpp
+ *
+ * A cached index over the factors of every user, used by CFType to find the
+ * neighborhood of users without rebuilding a neighbor search structure for
+ * every query.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_NEIGHBORHOOD_INDEX_HPP
+#define MLPACK_METHODS_CF_NEIGHBORHOOD_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <memory>
+#include <mutex>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * NeighborhoodIndex holds the factors of every user of a decomposition (as
+ * given by the decomposition's `GetUserFactors()`), and the neighbor search
+ * structure built on them.  The search structure is built the first time a
+ * given NeighborSearchPolicy is used, and kept for later searches with the
+ * same policy.
+ *
+ * When the factors of some users change, or users are added, `Update()` only
+ * replaces the factors of those users.  The search structure is not rebuilt;
+ * instead, searches skip the changed users in the search structure and search
+ * them separately.  Once more than 10% of the users have changed, the search
+ * structure is rebuilt on the next search.
+ *
+ * `Search()` may be called from multiple threads at once.  The index is only
+ * locked to rebuild the search structure and to take a snapshot of the search
+ * structure and the changed users; the queries themselves run without the
+ * lock.  The neighbor search policies update statistics in the nodes of their
+ * tree during a search, so searches of the same search structure take turns,
+ * but the separate search of the changed users and the merge of the results
+ * run concurrently.  The index is not serialized, since the decomposition
+ * already holds the user factors; CFType rebuilds it when a model is loaded.
+ */
+class NeighborhoodIndex
+{
+ public:
+  //! Create an empty index.
+  NeighborhoodIndex() :
+      indexedUsers(0),
+      searchMutex(new std::mutex())
+  {
+    // Nothing to do.
+  }
+
+  //! Copy the given index.  The search structure is not copied.
+  NeighborhoodIndex(const NeighborhoodIndex& other) :
+      referenceSet(other.referenceSet),
+      indexedUsers(0),
+      searchMutex(new std::mutex())
+  {
+    // Nothing to do.
+  }
+
+  //! Copy the given index.  The search structure is not copied.
+  NeighborhoodIndex& operator=(const NeighborhoodIndex& other)
+  {
+    if (this != &other)
+    {
+      referenceSet = other.referenceSet;
+      pendingUsers.clear();
+      indexedUsers = 0;
+      searchCache.reset();
+    }
+
+    return *this;
+  }
+
+  /**
+   * Build the index from the user factors of the given decomposition.  If the
+   * decomposition does not provide `GetUserFactors()`, the index is left
+   * empty.
+   *
+   * @param decomposition Decomposition to take the user factors from.
+   */
+  template<typename DecompositionPolicy>
+  void Build(const DecompositionPolicy& decomposition);
+
+  /**
+   * Update the factors of the given users from the given decomposition.  Any
+   * users that the decomposition has but the index does not are added too.
+   * If the item factors of the decomposition have changed (so that the factors
+   * of every user change), call `Build()` instead.
+   *
+   * @param decomposition Decomposition to take the user factors from.
+   * @param users Users whose factors have changed.
+   */
+  template<typename DecompositionPolicy>
+  void Update(const DecompositionPolicy& decomposition,
+              const arma::Col<size_t>& users);
+
+  /**
+   * Find the neighborhood of each of the given users, and the similarity of
+   * each neighbor.  As with the decomposition policies' `GetNeighborhood()`,
+   * each user is part of its own neighborhood.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param k The number of neighbors returned for each user.  This must not
+   *     be greater than NumUsers().
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void Search(const arma::Col<size_t>& users,
+              const size_t k,
+              arma::Mat<size_t>& neighborhood,
+              arma::mat& similarities) const;
+
+  //! Return whether the index holds no users.
+  bool IsEmpty() const { return referenceSet.is_empty(); }
+  //! Get the number of users in the index.
+  size_t NumUsers() const { return referenceSet.n_cols; }
+  //! Get the factors of every user.
+  const arma::mat& ReferenceSet() const { return referenceSet; }
+
+ private:
+  // SFINAE check for decompositions that provide their user factors.
+  HAS_MEM_FUNC(GetUserFactors, HasGetUserFactors);
+
+  //! Get the user factors of a decomposition that provides them.
+  template<typename DecompositionPolicy>
+  static bool GetUserFactors(
+      const DecompositionPolicy& decomposition,
+      arma::mat& factors,
+      const typename std::enable_if<HasGetUserFactors<DecompositionPolicy,
+          void(DecompositionPolicy::*)(arma::mat&) const>::value>::type* = 0)
+  {
+    decomposition.GetUserFactors(factors);
+    return true;
+  }
+
+  //! Decompositions without user factors can't be indexed.
+  template<typename DecompositionPolicy>
+  static bool GetUserFactors(
+      const DecompositionPolicy& /* decomposition */,
+      arma::mat& factors,
+      const typename std::enable_if<!HasGetUserFactors<DecompositionPolicy,
+          void(DecompositionPolicy::*)(arma::mat&) const>::value>::type* = 0)
+  {
+    factors.clear();
+    return false;
+  }
+
+  //! Type-erased holder for the search structure.
+  struct SearchCacheBase
+  {
+    virtual ~SearchCacheBase() { }
+  };
+
+  //! The search structure for a specific NeighborSearchPolicy.
+  template<typename NeighborSearchPolicy>
+  struct SearchCache : public SearchCacheBase
+  {
+    SearchCache(const arma::mat& referenceSet) : search(referenceSet) { }
+
+    NeighborSearchPolicy search;
+    //! Searches modify the tree, so they must take turns.
+    std::mutex searchMutex;
+  };
+
+  //! The factors of every user; column i holds the factors of user i.
+  arma::mat referenceSet;
+  //! Users whose factors changed since the search structure was built, in
+  //! increasing order.
+  mutable std::vector<size_t> pendingUsers;
+  //! The number of users in the search structure.
+  mutable size_t indexedUsers;
+  //! The search structure (if it has been built).  This is shared with the
+  //! searches in progress, so that it can be replaced while they run.
+  mutable std::shared_ptr<SearchCacheBase> searchCache;
+  //! Mutex that protects the members above.
+  std::unique_ptr<std::mutex> searchMutex;
+};
+
+template<typename DecompositionPolicy>
+void NeighborhoodIndex::Build(const DecompositionPolicy& decomposition)
+{
+  std::lock_guard<std::mutex> lock(*searchMutex);
+
+  GetUserFactors(decomposition, referenceSet);
+  pendingUsers.clear();
+  indexedUsers = 0;
+  searchCache.reset();
+}
+
+template<typename DecompositionPolicy>
+void NeighborhoodIndex::Update(const DecompositionPolicy& decomposition,
+                               const arma::Col<size_t>& users)
+{
+  arma::mat factors;
+  if (!GetUserFactors(decomposition, factors))
+    return;
+
+  // If the rank changed, everything must be rebuilt.
+  if (factors.n_rows != referenceSet.n_rows ||
+      factors.n_cols < referenceSet.n_cols)
+  {
+    Build(decomposition);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(*searchMutex);
+
+  // Add any new users.
+  const size_t oldUsers = referenceSet.n_cols;
+  if (factors.n_cols > oldUsers)
+  {
+    referenceSet.resize(factors.n_rows, factors.n_cols);
+    referenceSet.cols(oldUsers, factors.n_cols - 1) =
+        factors.cols(oldUsers, factors.n_cols - 1);
+    for (size_t i = oldUsers; i < factors.n_cols; ++i)
+      pendingUsers.push_back(i);
+  }
+
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (users[i] >= factors.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "NeighborhoodIndex::Update(): user " << users[i] << " is out of "
+          << "range (there are " << factors.n_cols << " users)!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    referenceSet.col(users[i]) = factors.col(users[i]);
+    pendingUsers.push_back(users[i]);
+  }
+
+  std::sort(pendingUsers.begin(), pendingUsers.end());
+  pendingUsers.erase(std::unique(pendingUsers.begin(), pendingUsers.end()),
+      pendingUsers.end());
+}
+
+template<typename NeighborSearchPolicy>
+void NeighborhoodIndex::Search(const arma::Col<size_t>& users,
+                               const size_t k,
+                               arma::Mat<size_t>& neighborhood,
+                               arma::mat& similarities) const
+{
+  typedef SearchCache<NeighborSearchPolicy> CacheType;
+
+  // Take a snapshot of everything the search needs while holding the lock.
+  std::shared_ptr<CacheType> cache;
+  std::vector<size_t> pending;
+  size_t numUsers, numIndexed;
+  arma::mat query, pendingSet;
+  {
+    std::lock_guard<std::mutex> lock(*searchMutex);
+
+    if (k > referenceSet.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "NeighborhoodIndex::Search(): requested value of k (" << k
+          << ") is greater than the number of users (" << referenceSet.n_cols
+          << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    // Build the search structure if we don't have one for this policy, or if
+    // too many users have changed since it was built.
+    cache = std::dynamic_pointer_cast<CacheType>(searchCache);
+    if (!cache || pendingUsers.size() > 0.1 * referenceSet.n_cols)
+    {
+      cache = std::make_shared<CacheType>(referenceSet);
+      searchCache = cache;
+      indexedUsers = referenceSet.n_cols;
+      pendingUsers.clear();
+    }
+
+    // Select feature vectors of queried users.
+    query.set_size(referenceSet.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = referenceSet.col(users(i));
+
+    pending = pendingUsers;
+    numUsers = referenceSet.n_cols;
+    numIndexed = indexedUsers;
+    pendingSet.set_size(referenceSet.n_rows, pending.size());
+    for (size_t i = 0; i < pending.size(); ++i)
+      pendingSet.col(i) = referenceSet.col(pending[i]);
+  }
+
+  if (pending.empty())
+  {
+    std::lock_guard<std::mutex> lock(cache->searchMutex);
+    cache->search.Search(query, k, neighborhood, similarities);
+    return;
+  }
+
+  // The search structure has out-of-date factors for the pending users, so we
+  // search for enough extra neighbors that we can drop them, and search the
+  // pending users with their new factors separately.  Since k is at most the
+  // number of users, the two searches together always find k neighbors.
+  std::vector<bool> isPending(numUsers, false);
+  size_t pendingIndexed = 0;
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    isPending[pending[i]] = true;
+    if (pending[i] < numIndexed)
+      ++pendingIndexed;
+  }
+
+  arma::Mat<size_t> indexedNeighbors;
+  arma::mat indexedSimilarities;
+  {
+    std::lock_guard<std::mutex> lock(cache->searchMutex);
+    cache->search.Search(query, std::min(k + pendingIndexed, numIndexed),
+        indexedNeighbors, indexedSimilarities);
+  }
+
+  NeighborSearchPolicy pendingSearch(pendingSet);
+  arma::Mat<size_t> pendingNeighbors;
+  arma::mat pendingSimilarities;
+  pendingSearch.Search(query, std::min(k, pending.size()),
+      pendingNeighbors, pendingSimilarities);
+
+  // Merge the two lists, which are both sorted by decreasing similarity.
+  neighborhood.set_size(k, users.n_elem);
+  similarities.set_size(k, users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    size_t a = 0, b = 0;
+    for (size_t j = 0; j < k; ++j)
+    {
+      while (a < indexedNeighbors.n_rows && isPending[indexedNeighbors(a, i)])
+        ++a;
+
+      const bool takeIndexed = (a < indexedNeighbors.n_rows) &&
+          (b == pendingNeighbors.n_rows ||
+           indexedSimilarities(a, i) >= pendingSimilarities(b, i));
+      if (takeIndexed)
+      {
+        neighborhood(j, i) = indexedNeighbors(a, i);
+        similarities(j, i) = indexedSimilarities(a, i);
+        ++a;
+      }
+      else
+      {
+        Log::Assert(b < pendingNeighbors.n_rows, "NeighborhoodIndex::Search(): "
+            "ran out of neighbors!");
+        neighborhood(j, i) = pending[pendingNeighbors(b, i)];
+        similarities(j, i) = pendingSimilarities(b, i);
+        ++b;
+      }
+    }
+  }
+}
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,254 @@
+/**
+ * @file methods/decision_tree/presorted_decision_stump.hpp
+ *
+ * A decision stump (a single-level decision tree on numeric features) that
+ * sorts each feature of its training set only once.  The sorted order is
+ * shared between all copies of the stump, so that a boosting algorithm such as
+ * AdaBoost, which trains many stumps on the same data with different instance
+ * weights, does not re-sort every dimension in every round.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_PRESORTED_DECISION_STUMP_HPP
+#define MLPACK_METHODS_DECISION_TREE_PRESORTED_DECISION_STUMP_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <memory>
+#include "gini_gain.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * PresortedDecisionStump is a decision stump for numeric data that splits on
+ * the single threshold of a single dimension that maximizes the (weighted)
+ * gain given by FitnessFunction.  It is meant to be used as a weak learner for
+ * boosting:
+ *
+ * @code
+ * extern arma::mat data;
+ * extern arma::Row<size_t> labels;
+ *
+ * PresortedDecisionStump<> stump(data, labels, 3);
+ * AdaBoost<PresortedDecisionStump<>> a(data, labels, 3, stump);
+ * @endcode
+ *
+ * The first time a stump is trained on a dataset, the sorted order of every
+ * dimension is computed and stored in a cache that is shared with every stump
+ * created from it with the boosting constructor.  Later stumps that are
+ * trained on the same dataset object reuse this sorted order, so each boosting
+ * round costs only a linear scan over each dimension.  The search over
+ * dimensions is done in parallel when OpenMP is available.
+ *
+ * The cache is not copied (a copy of a stump starts with an empty cache) and
+ * not serialized, so trained stumps that are stored, for instance by AdaBoost,
+ * do not keep the sorted order of the training set alive.  It is not safe to
+ * train stumps that share a cache on different datasets from multiple threads
+ * at once.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction = GiniGain>
+class PresortedDecisionStump
+{
+ public:
+  /**
+   * Create the stump without training it.  Be sure to call Train() before
+   * calling Classify().
+   *
+   * @param minimumLeafSize Minimum number of points on each side of the split.
+   */
+  PresortedDecisionStump(const size_t minimumLeafSize = 1);
+
+  /**
+   * Train the stump on the given data and labels, with uniform weights.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each point in the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points on each side of the split.
+   */
+  template<typename MatType>
+  PresortedDecisionStump(const MatType& data,
+                         const arma::Row<size_t>& labels,
+                         const size_t numClasses,
+                         const size_t minimumLeafSize = 1);
+
+  /**
+   * Copy the given stump.  The sort cache is not shared with the copy.
+   *
+   * @param other Stump to copy.
+   */
+  PresortedDecisionStump(const PresortedDecisionStump& other);
+
+  /**
+   * Take ownership of the given stump, including its sort cache.  The other
+   * stump is left with a new, empty cache, so it can still be trained.
+   *
+   * @param other Stump to take ownership of.
+   */
+  PresortedDecisionStump(PresortedDecisionStump&& other);
+
+  /**
+   * Copy the given stump.  The sort cache is not shared with the copy.
+   *
+   * @param other Stump to copy.
+   */
+  PresortedDecisionStump& operator=(const PresortedDecisionStump& other);
+
+  /**
+   * Take ownership of the given stump, including its sort cache.  The other
+   * stump is left with a new, empty cache, so it can still be trained.
+   *
+   * @param other Stump to take ownership of.
+   */
+  PresortedDecisionStump& operator=(PresortedDecisionStump&& other);
+
+  /**
+   * Boosting constructor: train the stump on the given data, labels, and
+   * instance weights, with the hyperparameters (and the sort cache) of the
+   * given other stump.
+   *
+   * @param other Stump to take hyperparameters and the sort cache from.
+   * @param data Dataset to train on.
+   * @param labels Labels for each point in the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weight of each point in the dataset.
+   */
+  template<typename MatType, typename WeightsType>
+  PresortedDecisionStump(const PresortedDecisionStump& other,
+                         const MatType& data,
+                         const arma::Row<size_t>& labels,
+                         const size_t numClasses,
+                         const WeightsType& weights);
+
+  /**
+   * Train the stump on the given data, labels, and instance weights.  If the
+   * sort cache was built for this dataset object already, it is reused.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each point in the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weight of each point in the dataset.
+   * @return The weighted gain of the chosen split.
+   */
+  template<typename MatType, typename WeightsType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const WeightsType& weights);
+
+  /**
+   * Classify the given point.
+   *
+   * @param point Point to classify.
+   * @return Predicted class of the point.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given points.
+   *
+   * @param data Points to classify.
+   * @param predictions Vector to store the predicted classes in.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  //! Get the dimension that the stump splits on.
+  size_t SplitDimension() const { return splitDimension; }
+  //! Get the split threshold; values <= the threshold go to the left.
+  double SplitValue() const { return splitValue; }
+  //! Get the class predicted for points on the left of the split.
+  size_t LeftClass() const { return leftClass; }
+  //! Get the class predicted for points on the right of the split.
+  size_t RightClass() const { return rightClass; }
+
+  //! Get the minimum number of points on each side of the split.
+  size_t MinimumLeafSize() const { return minimumLeafSize; }
+  //! Modify the minimum number of points on each side of the split.
+  size_t& MinimumLeafSize() { return minimumLeafSize; }
+
+  //! Serialize the stump.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * The sorted order of every dimension of a dataset.  This is shared between
+   * all copies of a stump.
+   */
+  struct SortCache
+  {
+    //! The dataset the sort was computed for.
+    const void* dataset;
+    //! The number of dimensions of the dataset.
+    size_t nRows;
+    //! The number of points in the dataset.
+    size_t nCols;
+    //! Sorted indices of the points; column i is the order of dimension i.
+    arma::Mat<arma::uword> sortedIndices;
+  };
+
+  /**
+   * Make sure the sort cache holds the sorted order of the given dataset.
+   *
+   * @param data Dataset to sort.
+   */
+  template<typename MatType>
+  void Presort(const MatType& data);
+
+  /**
+   * Find the best split on one dimension, using the presorted indices.
+   *
+   * @param data Dataset to train on.
+   * @param dim Dimension to search.
+   * @param labels Labels for each point in the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weight of each point in the dataset.
+   * @param bestValue Set to the best threshold if a split is found.
+   * @param bestLeftClass Set to the majority class on the left of the split.
+   * @param bestRightClass Set to the majority class on the right of the
+   *     split.
+   * @param sorted Set to false if the cached order of this dimension is not
+   *     sorted for the given data.
+   * @return The weighted gain of the best split, or -DBL_MAX if there is no
+   *     valid split in this dimension.
+   */
+  template<typename MatType, typename WeightsType>
+  double BestSplit(const MatType& data,
+                   const size_t dim,
+                   const arma::Row<size_t>& labels,
+                   const size_t numClasses,
+                   const WeightsType& weights,
+                   double& bestValue,
+                   size_t& bestLeftClass,
+                   size_t& bestRightClass,
+                   bool& sorted) const;
+
+  //! The minimum number of points on each side of the split.
+  size_t minimumLeafSize;
+  //! The dimension to split on.
+  size_t splitDimension;
+  //! The threshold to split on.
+  double splitValue;
+  //! The class predicted for points with values <= splitValue.
+  size_t leftClass;
+  //! The class predicted for points with values > splitValue.
+  size_t rightClass;
+
+  //! The sort cache shared between copies of this stump.
+  std::shared_ptr<SortCache> cache;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "presorted_decision_stump_impl.hpp"
+
+#endif
@@ -0,0 +1,345 @@
+/**
+ * @file methods/decision_tree/presorted_decision_stump_impl.hpp
+ *
+ * Implementation of the PresortedDecisionStump class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_PRESORTED_DECISION_STUMP_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_PRESORTED_DECISION_STUMP_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "presorted_decision_stump.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+PresortedDecisionStump<FitnessFunction>::PresortedDecisionStump(
+    const size_t minimumLeafSize) :
+    minimumLeafSize(minimumLeafSize),
+    splitDimension(0),
+    splitValue(DBL_MAX),
+    leftClass(0),
+    rightClass(0),
+    cache(std::make_shared<SortCache>())
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction>
+template<typename MatType>
+PresortedDecisionStump<FitnessFunction>::PresortedDecisionStump(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t minimumLeafSize) :
+    minimumLeafSize(minimumLeafSize),
+    splitDimension(0),
+    splitValue(DBL_MAX),
+    leftClass(0),
+    rightClass(0),
+    cache(std::make_shared<SortCache>())
+{
+  Train(data, labels, numClasses,
+      arma::rowvec(data.n_cols, arma::fill::ones));
+}
+
+template<typename FitnessFunction>
+PresortedDecisionStump<FitnessFunction>::PresortedDecisionStump(
+    const PresortedDecisionStump& other) :
+    minimumLeafSize(other.minimumLeafSize),
+    splitDimension(other.splitDimension),
+    splitValue(other.splitValue),
+    leftClass(other.leftClass),
+    rightClass(other.rightClass),
+    cache(std::make_shared<SortCache>())
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction>
+PresortedDecisionStump<FitnessFunction>&
+PresortedDecisionStump<FitnessFunction>::operator=(
+    const PresortedDecisionStump& other)
+{
+  if (this != &other)
+  {
+    minimumLeafSize = other.minimumLeafSize;
+    splitDimension = other.splitDimension;
+    splitValue = other.splitValue;
+    leftClass = other.leftClass;
+    rightClass = other.rightClass;
+    cache = std::make_shared<SortCache>();
+  }
+
+  return *this;
+}
+
+template<typename FitnessFunction>
+PresortedDecisionStump<FitnessFunction>::PresortedDecisionStump(
+    PresortedDecisionStump&& other) :
+    minimumLeafSize(other.minimumLeafSize),
+    splitDimension(other.splitDimension),
+    splitValue(other.splitValue),
+    leftClass(other.leftClass),
+    rightClass(other.rightClass),
+    cache(std::move(other.cache))
+{
+  other.cache = std::make_shared<SortCache>();
+}
+
+template<typename FitnessFunction>
+PresortedDecisionStump<FitnessFunction>&
+PresortedDecisionStump<FitnessFunction>::operator=(
+    PresortedDecisionStump&& other)
+{
+  if (this != &other)
+  {
+    minimumLeafSize = other.minimumLeafSize;
+    splitDimension = other.splitDimension;
+    splitValue = other.splitValue;
+    leftClass = other.leftClass;
+    rightClass = other.rightClass;
+    cache = std::move(other.cache);
+    other.cache = std::make_shared<SortCache>();
+  }
+
+  return *this;
+}
+
+template<typename FitnessFunction>
+template<typename MatType, typename WeightsType>
+PresortedDecisionStump<FitnessFunction>::PresortedDecisionStump(
+    const PresortedDecisionStump& other,
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightsType& weights) :
+    minimumLeafSize(other.minimumLeafSize),
+    splitDimension(0),
+    splitValue(DBL_MAX),
+    leftClass(0),
+    rightClass(0),
+    cache(other.cache ? other.cache : std::make_shared<SortCache>())
+{
+  Train(data, labels, numClasses, weights);
+}
+
+template<typename FitnessFunction>
+template<typename MatType, typename WeightsType>
+double PresortedDecisionStump<FitnessFunction>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightsType& weights)
+{
+  util::CheckSameSizes(data, labels, "PresortedDecisionStump::Train()");
+
+  Presort(data);
+
+  // If no split is possible, predict the (weighted) majority class everywhere.
+  arma::vec classWeights(numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    classWeights[labels[i]] += weights[i];
+
+  splitDimension = 0;
+  splitValue = DBL_MAX;
+  leftClass = rightClass = classWeights.index_max();
+
+  // Search every dimension in parallel.  The cache is matched to the dataset
+  // by address only, so if any cached order turns out not to be sorted for
+  // this data, the cache is stale: rebuild it and search again.
+  std::vector<double> gains(data.n_rows);
+  std::vector<double> values(data.n_rows);
+  std::vector<size_t> leftClasses(data.n_rows), rightClasses(data.n_rows);
+  std::vector<char> sorted(data.n_rows);
+  for (size_t attempt = 0; attempt < 2; ++attempt)
+  {
+    #pragma omp parallel for
+    for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+    {
+      bool dimSorted = true;
+      gains[d] = BestSplit(data, d, labels, numClasses, weights, values[d],
+          leftClasses[d], rightClasses[d], dimSorted);
+      sorted[d] = dimSorted;
+    }
+
+    if (std::find(sorted.begin(), sorted.end(), false) == sorted.end())
+      break;
+
+    cache->dataset = NULL;
+    Presort(data);
+  }
+
+  // Take the best dimension; on ties the lowest dimension wins, so the result
+  // does not depend on the number of threads.
+  double bestGain = -DBL_MAX;
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    if (gains[d] > bestGain)
+    {
+      bestGain = gains[d];
+      splitDimension = d;
+      splitValue = values[d];
+      leftClass = leftClasses[d];
+      rightClass = rightClasses[d];
+    }
+  }
+
+  return bestGain;
+}
+
+template<typename FitnessFunction>
+template<typename MatType>
+void PresortedDecisionStump<FitnessFunction>::Presort(const MatType& data)
+{
+  if (cache->dataset == (const void*) &data &&
+      cache->nRows == data.n_rows &&
+      cache->nCols == data.n_cols)
+    return; // We have already sorted this dataset.
+
+  typedef typename MatType::elem_type ElemType;
+
+  cache->sortedIndices.set_size(data.n_cols, data.n_rows);
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+  {
+    const arma::Row<ElemType> dimension(data.row(d));
+    cache->sortedIndices.col(d) = arma::sort_index(dimension);
+  }
+
+  cache->dataset = (const void*) &data;
+  cache->nRows = data.n_rows;
+  cache->nCols = data.n_cols;
+}
+
+template<typename FitnessFunction>
+template<typename MatType, typename WeightsType>
+double PresortedDecisionStump<FitnessFunction>::BestSplit(
+    const MatType& data,
+    const size_t dim,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightsType& weights,
+    double& bestValue,
+    size_t& bestLeftClass,
+    size_t& bestRightClass,
+    bool& sorted) const
+{
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  const size_t n = data.n_cols;
+  if (n < 2 * minimum)
+    return -DBL_MAX;
+
+  const arma::uword* order = cache->sortedIndices.colptr(dim);
+
+  // Column 0 holds the class weights on the left of the split, and column 1
+  // holds the class weights on the right.  Initially every point is on the
+  // right.
+  arma::mat classWeights(numClasses, 2, arma::fill::zeros);
+  double leftWeight = 0.0;
+  double rightWeight = 0.0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    classWeights(labels[i], 1) += weights[i];
+    rightWeight += weights[i];
+  }
+  const double totalWeight = rightWeight;
+  if (totalWeight <= 0.0)
+    return -DBL_MAX;
+
+  double bestGain = -DBL_MAX;
+  for (size_t index = 1; index < n; ++index)
+  {
+    const size_t moved = order[index - 1];
+    const double value = data(dim, moved);
+    const double nextValue = data(dim, order[index]);
+
+    // If the cached order is not sorted, it was computed for different data.
+    if (nextValue < value)
+    {
+      sorted = false;
+      return -DBL_MAX;
+    }
+
+    if (index > n - minimum)
+      continue;
+
+    // Move the point to the left.
+    classWeights(labels[moved], 0) += weights[moved];
+    classWeights(labels[moved], 1) -= weights[moved];
+    leftWeight += weights[moved];
+    rightWeight -= weights[moved];
+
+    // We can only split between distinct values.
+    if (index < minimum || value == nextValue)
+      continue;
+
+    const double gain = leftWeight *
+        FitnessFunction::template EvaluatePtr<true>(classWeights.colptr(0),
+            numClasses, leftWeight) + std::max(rightWeight, 0.0) *
+        FitnessFunction::template EvaluatePtr<true>(classWeights.colptr(1),
+            numClasses, std::max(rightWeight, 0.0));
+
+    if (gain > bestGain)
+    {
+      bestGain = gain;
+      bestValue = (value + nextValue) / 2.0;
+      bestLeftClass = classWeights.unsafe_col(0).index_max();
+      bestRightClass = classWeights.unsafe_col(1).index_max();
+    }
+  }
+
+  return (bestGain == -DBL_MAX) ? bestGain : bestGain / totalWeight;
+}
+
+template<typename FitnessFunction>
+template<typename VecType>
+size_t PresortedDecisionStump<FitnessFunction>::Classify(
+    const VecType& point) const
+{
+  return (point[splitDimension] <= splitValue) ? leftClass : rightClass;
+}
+
+template<typename FitnessFunction>
+template<typename MatType>
+void PresortedDecisionStump<FitnessFunction>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions) const
+{
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    predictions[i] = (data(splitDimension, i) <= splitValue) ? leftClass :
+        rightClass;
+  }
+}
+
+template<typename FitnessFunction>
+template<typename Archive>
+void PresortedDecisionStump<FitnessFunction>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(minimumLeafSize));
+  ar(CEREAL_NVP(splitDimension));
+  ar(CEREAL_NVP(splitValue));
+  ar(CEREAL_NVP(leftClass));
+  ar(CEREAL_NVP(rightClass));
+
+  // The sort cache only belongs to the training set, so it is not saved.
+  if (cereal::is_loading<Archive>())
+    cache = std::make_shared<SortCache>();
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
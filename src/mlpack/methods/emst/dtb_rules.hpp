@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/base_case_block.hpp>
 
 namespace mlpack {
 namespace emst {
@@ -32,6 +33,21 @@ class DTBRules
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the distances between the query points [queryBegin, queryBegin +
+   * queryCount) and the reference points [referenceBegin, referenceBegin +
+   * referenceCount) at once, for the base cases of a pair of leaves.
+   *
+   * @param queryBegin Index of the first query point.
+   * @param queryCount Number of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void PrepareBaseCases(const size_t queryBegin,
+                        const size_t queryCount,
+                        const size_t referenceBegin,
+                        const size_t referenceCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -118,6 +134,9 @@ class DTBRules
   //! The instantiated metric.
   MetricType& metric;
 
+  //! Distances between the points of the current pair of leaves.
+  tree::BaseCaseBlock<MetricType, arma::mat> block;
+
   /**
    * Update the bound for the given query node.
    */
@@ -54,8 +54,12 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
   if (queryComponentIndex != referenceComponentIndex)
   {
     ++baseCases;
-    double distance = metric.Evaluate(dataSet.col(queryIndex),
-                                      dataSet.col(referenceIndex));
+    double distance;
+    if (!block.Distance(queryIndex, referenceIndex, distance))
+    {
+      distance = metric.Evaluate(dataSet.col(queryIndex),
+                                 dataSet.col(referenceIndex));
+    }
 
     if (distance < neighborsDistances[queryComponentIndex])
     {
@@ -75,6 +79,17 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
   return newUpperBound;
 }
 
+template<typename MetricType, typename TreeType>
+void DTBRules<MetricType, TreeType>::PrepareBaseCases(
+    const size_t queryBegin,
+    const size_t queryCount,
+    const size_t referenceBegin,
+    const size_t referenceCount)
+{
+  block.Compute(dataSet, queryBegin, queryCount, dataSet, referenceBegin,
+      referenceCount);
+}
+
 template<typename MetricType, typename TreeType>
 double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
                                              TreeType& referenceNode)
@@ -186,6 +186,12 @@ class HoeffdingTree
    * the given labels.  If `resetTree` is set to `true`, then reset the state of
    * the tree to an empty tree before training.
    *
+   * In streaming mode, the statistics of each dimension are collected in
+   * parallel for all the points a leaf sees before its next split check, and
+   * points that reach different leaves are trained in parallel.  The points
+   * that reach each leaf are still seen in order, so the resulting tree is the
+   * same as if each point was passed to `Train()` one at a time.
+   *
    * Note that the tree will be automatically reset if the dimensionality of
    * `data` does not match the dimensionality that the tree was currently
    * trained with.  The tree will also be reset if `numClasses` is passed.
@@ -325,7 +331,8 @@ class HoeffdingTree
 
   /**
    * Classify the given points, using this node and the entire (sub)tree beneath
-   * it.  The predicted labels for each point are returned.
+   * it.  The predicted labels for each point are returned.  Blocks of points
+   * are routed down the tree together, and blocks are classified in parallel.
    *
    * @param data Points to classify.
    * @param predictions Predicted labels for each point.
@@ -413,6 +420,49 @@ class HoeffdingTree
                      const arma::Row<size_t>& labels,
                      const bool batchTraining);
 
+  /**
+   * Train on the given points (in the given order) in streaming mode.  This
+   * gives the same result as calling Train() on each point, but trains each
+   * dimension in parallel between split checks, and trains the children of a
+   * node in parallel once it has split.
+   *
+   * @param data Dataset holding the points.
+   * @param labels Labels of the points in the dataset.
+   * @param points Indices of the points to train on, in order.
+   */
+  template<typename MatType>
+  void TrainPoints(const MatType& data,
+                   const arma::Row<size_t>& labels,
+                   const arma::uvec& points);
+
+  /**
+   * Find the leaf of each of the given points, by routing them down the tree
+   * together.  The points in indices[begin, end) are reordered by leaf.
+   *
+   * @param data Dataset holding the points.
+   * @param indices Indices of points in the dataset.
+   * @param begin First position in indices to route.
+   * @param end One past the last position in indices to route.
+   * @param leaves Set to the leaf of each point (indexed by point).
+   */
+  template<typename MatType>
+  void RouteToLeaves(const MatType& data,
+                     arma::uvec& indices,
+                     const size_t begin,
+                     const size_t end,
+                     std::vector<const HoeffdingTree*>& leaves) const;
+
+  /**
+   * Find the leaf of every point in the given dataset, in parallel over blocks
+   * of points.
+   *
+   * @param data Points to find the leaves of.
+   * @param leaves Set to the leaf of each point.
+   */
+  template<typename MatType>
+  void FindLeaves(const MatType& data,
+                  std::vector<const HoeffdingTree*>& leaves) const;
+
   /**
    * Reset the tree.  This assumes datasetInfo is set correctly.
    */
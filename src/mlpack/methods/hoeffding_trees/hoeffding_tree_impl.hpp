@@ -16,6 +16,10 @@
 #include "hoeffding_tree.hpp"
 #include <stack>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -722,9 +726,12 @@ void HoeffdingTree<
     CategoricalSplitType
 >::Classify(const MatType& data, arma::Row<size_t>& predictions) const
 {
+  std::vector<const HoeffdingTree*> leaves;
+  FindLeaves(data, leaves);
+
   predictions.set_size(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+    predictions[i] = leaves[i]->majorityClass;
 }
 
 //! Batch classification with probabilities.
@@ -742,10 +749,98 @@ void HoeffdingTree<
             arma::Row<size_t>& predictions,
             arma::rowvec& probabilities) const
 {
+  std::vector<const HoeffdingTree*> leaves;
+  FindLeaves(data, leaves);
+
   predictions.set_size(data.n_cols);
   probabilities.set_size(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
-    Classify(data.col(i), predictions[i], probabilities[i]);
+  {
+    predictions[i] = leaves[i]->majorityClass;
+    probabilities[i] = leaves[i]->majorityProbability;
+  }
+}
+
+//! Find the leaves of a block of points.
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::RouteToLeaves(const MatType& data,
+                 arma::uvec& indices,
+                 const size_t begin,
+                 const size_t end,
+                 std::vector<const HoeffdingTree*>& leaves) const
+{
+  if (children.size() == 0)
+  {
+    for (size_t i = begin; i < end; ++i)
+      leaves[indices[i]] = this;
+    return;
+  }
+
+  // Sort the points by the child they go to (keeping their order otherwise),
+  // and then pass each group of points to its child.
+  std::vector<size_t> directions(end - begin);
+  std::vector<size_t> offsets(children.size() + 1, 0);
+  for (size_t i = begin; i < end; ++i)
+  {
+    directions[i - begin] = CalculateDirection(data.col(indices[i]));
+    ++offsets[directions[i - begin] + 1];
+  }
+  for (size_t c = 1; c <= children.size(); ++c)
+    offsets[c] += offsets[c - 1];
+
+  const arma::uvec oldIndices = indices.subvec(begin, end - 1);
+  std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < oldIndices.n_elem; ++i)
+    indices[begin + positions[directions[i]]++] = oldIndices[i];
+
+  for (size_t c = 0; c < children.size(); ++c)
+  {
+    if (offsets[c + 1] > offsets[c])
+    {
+      children[c]->RouteToLeaves(data, indices, begin + offsets[c],
+          begin + offsets[c + 1], leaves);
+    }
+  }
+}
+
+//! Find the leaves of every point.
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::FindLeaves(const MatType& data,
+              std::vector<const HoeffdingTree*>& leaves) const
+{
+  leaves.resize(data.n_cols);
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
+
+  // Each block of points is routed down the tree together, so the split
+  // information of each node is used for many points in a row.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+    RouteToLeaves(data, indices, begin, end, leaves);
+  }
 }
 
 template<
@@ -955,8 +1050,8 @@ void HoeffdingTree<
     // Don't split if there are fewer than five points.
     size_t oldMaxSamples = maxSamples;
     maxSamples = std::max(size_t(data.n_cols - 1), size_t(5));
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    TrainPoints(data, labels, arma::linspace<arma::uvec>(0, data.n_cols - 1,
+        data.n_cols));
     maxSamples = oldMaxSamples;
 
     // Now, if we did split, find out which points go to which child, and
@@ -1007,9 +1102,105 @@ void HoeffdingTree<
   }
   else
   {
-    // We aren't training in batch mode; loop through the points.
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    // We aren't training in batch mode; stream the points in order.
+    TrainPoints(data, labels, arma::linspace<arma::uvec>(0, data.n_cols - 1,
+        data.n_cols));
+  }
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainPoints(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const arma::uvec& points)
+{
+  size_t start = 0;
+  while (start < points.n_elem && splitDimension == size_t(-1))
+  {
+    // Take all the points up to the next split check.  The statistics of each
+    // dimension do not depend on each other, so each dimension can be trained
+    // on all of these points independently.
+    const size_t end = std::min((size_t) points.n_elem,
+        start + checkInterval - (numSamples % checkInterval));
+
+    #pragma omp parallel for
+    for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+    {
+      const size_t index = dimensionMappings->at(d).second;
+      if (datasetInfo->Type(d) == data::Datatype::categorical)
+      {
+        for (size_t i = start; i < end; ++i)
+        {
+          categoricalSplits[index].Train(data(d, points[i]),
+              labels[points[i]]);
+        }
+      }
+      else if (datasetInfo->Type(d) == data::Datatype::numeric)
+      {
+        for (size_t i = start; i < end; ++i)
+          numericSplits[index].Train(data(d, points[i]), labels[points[i]]);
+      }
+    }
+    numSamples += (end - start);
+    start = end;
+
+    // Grab majority class from splits.
+    if (categoricalSplits.size() > 0)
+    {
+      majorityClass = categoricalSplits[0].MajorityClass();
+      majorityProbability = categoricalSplits[0].MajorityProbability();
+    }
+    else
+    {
+      majorityClass = numericSplits[0].MajorityClass();
+      majorityProbability = numericSplits[0].MajorityProbability();
+    }
+
+    // Check for a split, if we should.
+    if (numSamples % checkInterval == 0)
+    {
+      const size_t numChildren = SplitCheck();
+      if (numChildren > 0)
+      {
+        // We need to add a bunch of children.
+        // Delete children, if we have them.
+        children.clear();
+        CreateChildren();
+      }
+    }
+  }
+
+  if (start == points.n_elem)
+    return;
+
+  // We have split, so the rest of the points go to the children.  Each child
+  // gets its points in the original order.
+  std::vector<std::vector<arma::uword>> childPoints(children.size());
+  for (size_t i = start; i < points.n_elem; ++i)
+    childPoints[CalculateDirection(data.col(points[i]))].push_back(points[i]);
+
+  // If there are fewer dimensions than threads, it is better to train the
+  // children in parallel than the dimensions of each child.
+  #ifdef HAS_OPENMP
+    const bool parallelChildren =
+        (data.n_rows < (size_t) omp_get_max_threads());
+  #else
+    const bool parallelChildren = false;
+  #endif
+
+  #pragma omp parallel for schedule(dynamic) if (parallelChildren)
+  for (omp_size_t c = 0; c < (omp_size_t) children.size(); ++c)
+  {
+    if (!childPoints[c].empty())
+      children[c]->TrainPoints(data, labels, arma::uvec(childPoints[c]));
   }
 }
 
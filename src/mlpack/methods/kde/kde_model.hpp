@@ -67,7 +67,10 @@ class KernelNormalizer
  * KDEWrapperBase is a base wrapper class for holding all KDE types supported by
  * KDEModel.  All KDE type wrappers inheirt from this class, allowing a simple
  * interface via inheritance for all the different types we want to support.
+ *
+ * @tparam MatType Type of data held by the wrapped KDE object.
  */
+template<typename MatType>
 class KDEWrapperBase
 {
  public:
@@ -116,11 +119,11 @@ class KDEWrapperBase
   virtual KDEMode& Mode() = 0;
 
   //! Train the model (build the tree).
-  virtual void Train(util::Timers& timers, arma::mat&& referenceSet) = 0;
+  virtual void Train(util::Timers& timers, MatType&& referenceSet) = 0;
 
   //! Perform bichromatic KDE (i.e. KDE with a separate query set).
   virtual void Evaluate(util::Timers& timers,
-                        arma::mat&& querySet,
+                        MatType&& querySet,
                         arma::vec& estimates) = 0;
 
   //! Perform monochromatic KDE (i.e. with the reference set as the query set).
@@ -135,8 +138,9 @@ class KDEWrapperBase
 template<typename KernelType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-class KDEWrapper : public KDEWrapperBase
+                  typename TreeMatType> class TreeType,
+         typename MatType = arma::mat>
+class KDEWrapper : public KDEWrapperBase<MatType>
 {
  public:
   //! Create the KDEWrapper object, initializing the internally-held KDE object.
@@ -195,11 +199,11 @@ class KDEWrapper : public KDEWrapperBase
   virtual KDEMode& Mode() { return kde.Mode(); }
 
   //! Train the model (build the tree).
-  virtual void Train(util::Timers& timers, arma::mat&& referenceSet);
+  virtual void Train(util::Timers& timers, MatType&& referenceSet);
 
   //! Perform bichromatic KDE (i.e. KDE with a separate query set).
   virtual void Evaluate(util::Timers& timers,
-                        arma::mat&& querySet,
+                        MatType&& querySet,
                         arma::vec& estimates);
 
   //! Perform monochromatic KDE (i.e. with the reference set as the query set).
@@ -215,7 +219,7 @@ class KDEWrapper : public KDEWrapperBase
  protected:
   typedef KDE<KernelType,
               metric::EuclideanDistance,
-              arma::mat,
+              MatType,
               TreeType> KDEType;
 
   //! The instantiated KDE object that we are wrapping.
@@ -227,8 +231,16 @@ class KDEWrapper : public KDEWrapperBase
  * KernelType and TreeType parameters and allowing those to be specified at
  * runtime.  This class is written for the sake of the `kde` binding, but it is
  * not necessarily restricted to that usage.
+ *
+ * The model can hold either double-precision (arma::mat) or single-precision
+ * (arma::fmat) data; the KDEModel typedef below is the double-precision model
+ * used by the binding.  Density estimates are always computed and returned in
+ * double precision.
+ *
+ * @tparam MatType Type of data to use; arma::mat or arma::fmat.
  */
-class KDEModel
+template<typename MatType = arma::mat>
+class KDEModelType
 {
  public:
   enum TreeTypes
@@ -285,7 +297,7 @@ class KDEModel
    * kdeModel holds whatever KDE type we are using.  It is initialized using the
    * `BuildModel()` method.
    */
-  KDEWrapperBase* kdeModel;
+  KDEWrapperBase<MatType>* kdeModel;
 
  public:
   /**
@@ -312,39 +324,40 @@ class KDEModel
    *                    descendants evaluated is the limit before Monte Carlo
    *                    estimation recurses.
    */
-  KDEModel(const double bandwidth = 1.0,
-           const double relError = KDEDefaultParams::relError,
-           const double absError = KDEDefaultParams::absError,
-           const KernelTypes kernelType = KernelTypes::GAUSSIAN_KERNEL,
-           const TreeTypes treeType = TreeTypes::KD_TREE,
-           const bool monteCarlo = KDEDefaultParams::mode,
-           const double mcProb = KDEDefaultParams::mcProb,
-           const size_t initialSampleSize = KDEDefaultParams::initialSampleSize,
-           const double mcEntryCoef = KDEDefaultParams::mcEntryCoef,
-           const double mcBreakCoef = KDEDefaultParams::mcBreakCoef);
+  KDEModelType(
+      const double bandwidth = 1.0,
+      const double relError = KDEDefaultParams::relError,
+      const double absError = KDEDefaultParams::absError,
+      const KernelTypes kernelType = KernelTypes::GAUSSIAN_KERNEL,
+      const TreeTypes treeType = TreeTypes::KD_TREE,
+      const bool monteCarlo = KDEDefaultParams::mode,
+      const double mcProb = KDEDefaultParams::mcProb,
+      const size_t initialSampleSize = KDEDefaultParams::initialSampleSize,
+      const double mcEntryCoef = KDEDefaultParams::mcEntryCoef,
+      const double mcBreakCoef = KDEDefaultParams::mcBreakCoef);
 
   //! Copy constructor of the given model.
-  KDEModel(const KDEModel& other);
+  KDEModelType(const KDEModelType& other);
 
   //! Move constructor of the given model. Takes ownership of the model.
-  KDEModel(KDEModel&& other);
+  KDEModelType(KDEModelType&& other);
 
   /**
    * Copy the given model.
    *
    * @param other KDEModel to copy.
    */
-  KDEModel& operator=(const KDEModel& other);
+  KDEModelType& operator=(const KDEModelType& other);
 
   /**
    * Take ownership of the contents of the given model.
    *
    * @param other KDEModel to take ownership of.
    */
-  KDEModel& operator=(KDEModel&& other);
+  KDEModelType& operator=(KDEModelType&& other);
 
   //! Destroy the KDEModel object.
-  ~KDEModel();
+  ~KDEModelType();
 
   //! Serialize the KDE model.
   template<typename Archive>
@@ -430,7 +443,7 @@ class KDEModel
    * @param timers Object to hold timing information in.
    * @param referenceSet Set of reference points.
    */
-  void BuildModel(util::Timers& timers, arma::mat&& referenceSet);
+  void BuildModel(util::Timers& timers, MatType&& referenceSet);
 
   /**
    * Perform kernel density estimation on the given query set.
@@ -445,7 +458,7 @@ class KDEModel
    *                    order as the query points.
    */
   void Evaluate(util::Timers& timers,
-                arma::mat&& querySet,
+                MatType&& querySet,
                 arma::vec& estimations);
 
   /**
@@ -465,6 +478,9 @@ class KDEModel
   void CleanMemory();
 };
 
+//! The double-precision KDE model used by the binding.
+typedef KDEModelType<arma::mat> KDEModel;
+
 } // namespace kde
 } // namespace mlpack
 
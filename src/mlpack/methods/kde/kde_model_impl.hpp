@@ -22,9 +22,10 @@ namespace kde {
 template<typename KernelType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void KDEWrapper<KernelType, TreeType>::Train(util::Timers& timers,
-                                             arma::mat&& referenceSet)
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void KDEWrapper<KernelType, TreeType, MatType>::Train(util::Timers& timers,
+                                                      MatType&& referenceSet)
 {
   timers.Start("tree_building");
   kde.Train(std::move(referenceSet));
@@ -35,10 +36,11 @@ void KDEWrapper<KernelType, TreeType>::Train(util::Timers& timers,
 template<typename KernelType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void KDEWrapper<KernelType, TreeType>::Evaluate(util::Timers& timers,
-                                                arma::mat&& querySet,
-                                                arma::vec& estimates)
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void KDEWrapper<KernelType, TreeType, MatType>::Evaluate(util::Timers& timers,
+                                                         MatType&& querySet,
+                                                         arma::vec& estimates)
 {
   const size_t dimension = querySet.n_rows;
   if (kde.Mode() == DUAL_TREE_MODE)
@@ -74,9 +76,10 @@ void KDEWrapper<KernelType, TreeType>::Evaluate(util::Timers& timers,
 template<typename KernelType,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void KDEWrapper<KernelType, TreeType>::Evaluate(util::Timers& timers,
-                                                arma::vec& estimates)
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void KDEWrapper<KernelType, TreeType, MatType>::Evaluate(util::Timers& timers,
+                                                         arma::vec& estimates)
 {
   timers.Start("computing_kde");
   kde.Evaluate(estimates);
@@ -93,50 +96,52 @@ void KDEWrapper<KernelType, TreeType>::Evaluate(util::Timers& timers,
 template<template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename MatType,
          typename Archive>
-void SerializationHelper(Archive& ar,
-                         KDEWrapperBase* kdeModel,
-                         const KDEModel::KernelTypes kernelType)
+void SerializationHelper(
+    Archive& ar,
+    KDEWrapperBase<MatType>* kdeModel,
+    const typename KDEModelType<MatType>::KernelTypes kernelType)
 {
   switch (kernelType)
   {
-    case KDEModel::GAUSSIAN_KERNEL:
+    case KDEModelType<MatType>::GAUSSIAN_KERNEL:
       {
-        KDEWrapper<kernel::GaussianKernel, TreeType>& typedModel =
+        KDEWrapper<kernel::GaussianKernel, TreeType, MatType>& typedModel =
             dynamic_cast<KDEWrapper<kernel::GaussianKernel,
-                                    TreeType>&>(*kdeModel);
+                                    TreeType, MatType>&>(*kdeModel);
         ar(CEREAL_NVP(typedModel));
         break;
       }
-    case KDEModel::EPANECHNIKOV_KERNEL:
+    case KDEModelType<MatType>::EPANECHNIKOV_KERNEL:
       {
-        KDEWrapper<kernel::EpanechnikovKernel, TreeType>& typedModel =
+        KDEWrapper<kernel::EpanechnikovKernel, TreeType, MatType>& typedModel =
             dynamic_cast<KDEWrapper<kernel::EpanechnikovKernel,
-                                    TreeType>&>(*kdeModel);
+                                    TreeType, MatType>&>(*kdeModel);
         ar(CEREAL_NVP(typedModel));
         break;
       }
-    case KDEModel::LAPLACIAN_KERNEL:
+    case KDEModelType<MatType>::LAPLACIAN_KERNEL:
       {
-        KDEWrapper<kernel::LaplacianKernel, TreeType>& typedModel =
+        KDEWrapper<kernel::LaplacianKernel, TreeType, MatType>& typedModel =
             dynamic_cast<KDEWrapper<kernel::LaplacianKernel,
-                                    TreeType>&>(*kdeModel);
+                                    TreeType, MatType>&>(*kdeModel);
         ar(CEREAL_NVP(typedModel));
         break;
       }
-    case KDEModel::SPHERICAL_KERNEL:
+    case KDEModelType<MatType>::SPHERICAL_KERNEL:
       {
-        KDEWrapper<kernel::SphericalKernel, TreeType>& typedModel =
+        KDEWrapper<kernel::SphericalKernel, TreeType, MatType>& typedModel =
             dynamic_cast<KDEWrapper<kernel::SphericalKernel,
-                                    TreeType>&>(*kdeModel);
+                                    TreeType, MatType>&>(*kdeModel);
         ar(CEREAL_NVP(typedModel));
         break;
       }
-    case KDEModel::TRIANGULAR_KERNEL:
+    case KDEModelType<MatType>::TRIANGULAR_KERNEL:
       {
-        KDEWrapper<kernel::TriangularKernel, TreeType>& typedModel =
+        KDEWrapper<kernel::TriangularKernel, TreeType, MatType>& typedModel =
             dynamic_cast<KDEWrapper<kernel::TriangularKernel,
-                                    TreeType>&>(*kdeModel);
+                                    TreeType, MatType>&>(*kdeModel);
         ar(CEREAL_NVP(typedModel));
         break;
       }
@@ -144,8 +149,9 @@ void SerializationHelper(Archive& ar,
 }
 
 // Serialize the model.
+template<typename MatType>
 template<typename Archive>
-void KDEModel::serialize(Archive& ar, const uint32_t /* version */)
+void KDEModelType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
 {
   ar(CEREAL_NVP(bandwidth));
   ar(CEREAL_NVP(relError));
@@ -195,6 +201,332 @@ void KDEModel::serialize(Archive& ar, const uint32_t /* version */)
   }
 }
 
+//! Initialize the KDEModel with the given parameters.
+template<typename MatType>
+KDEModelType<MatType>::KDEModelType(const double bandwidth,
+                   const double relError,
+                   const double absError,
+                   const KernelTypes kernelType,
+                   const TreeTypes treeType,
+                   const bool monteCarlo,
+                   const double mcProb,
+                   const size_t initialSampleSize,
+                   const double mcEntryCoef,
+                   const double mcBreakCoef) :
+    bandwidth(bandwidth),
+    relError(relError),
+    absError(absError),
+    kernelType(kernelType),
+    treeType(treeType),
+    monteCarlo(monteCarlo),
+    mcProb(mcProb),
+    initialSampleSize(initialSampleSize),
+    mcEntryCoef(mcEntryCoef),
+    mcBreakCoef(mcBreakCoef),
+    kdeModel(NULL)
+{
+  // Nothing to do.
+}
+
+// Copy constructor.
+template<typename MatType>
+KDEModelType<MatType>::KDEModelType(const KDEModelType& other) :
+    bandwidth(other.bandwidth),
+    relError(other.relError),
+    absError(other.absError),
+    kernelType(other.kernelType),
+    treeType(other.treeType),
+    monteCarlo(other.monteCarlo),
+    mcProb(other.mcProb),
+    initialSampleSize(other.initialSampleSize),
+    mcEntryCoef(other.mcEntryCoef),
+    mcBreakCoef(other.mcBreakCoef),
+    kdeModel(other.kdeModel->Clone())
+{
+  // Nothing to do.
+}
+
+// Move constructor.
+template<typename MatType>
+KDEModelType<MatType>::KDEModelType(KDEModelType&& other) :
+    bandwidth(other.bandwidth),
+    relError(other.relError),
+    absError(other.absError),
+    kernelType(other.kernelType),
+    treeType(other.treeType),
+    monteCarlo(other.monteCarlo),
+    mcProb(other.mcProb),
+    initialSampleSize(other.initialSampleSize),
+    mcEntryCoef(other.mcEntryCoef),
+    mcBreakCoef(other.mcBreakCoef),
+    kdeModel(std::move(other.kdeModel))
+{
+  // Reset other model.
+  other.bandwidth = 1.0;
+  other.relError = KDEDefaultParams::relError;
+  other.absError = KDEDefaultParams::absError;
+  other.kernelType = KernelTypes::GAUSSIAN_KERNEL;
+  other.treeType = TreeTypes::KD_TREE;
+  other.monteCarlo = KDEDefaultParams::monteCarlo;
+  other.mcProb = KDEDefaultParams::mcProb;
+  other.initialSampleSize = KDEDefaultParams::initialSampleSize;
+  other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
+  other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.kdeModel = NULL;
+}
+
+template<typename MatType>
+KDEModelType<MatType>& KDEModelType<MatType>::operator=(
+    const KDEModelType& other)
+{
+  if (this != &other)
+  {
+    delete kdeModel;
+
+    bandwidth = other.bandwidth;
+    relError = other.relError;
+    absError = other.absError;
+    kernelType = other.kernelType;
+    treeType = other.treeType;
+    monteCarlo = other.monteCarlo;
+    mcProb = other.mcProb;
+    initialSampleSize = other.initialSampleSize;
+    mcEntryCoef = other.mcEntryCoef;
+    mcBreakCoef = other.mcBreakCoef;
+    kdeModel = other.kdeModel->Clone();
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+KDEModelType<MatType>& KDEModelType<MatType>::operator=(KDEModelType&& other)
+{
+  if (this != &other)
+  {
+    delete kdeModel;
+
+    bandwidth = other.bandwidth;
+    relError = other.relError;
+    absError = other.absError;
+    kernelType = other.kernelType;
+    treeType = other.treeType;
+    monteCarlo = other.monteCarlo;
+    mcProb = other.mcProb;
+    initialSampleSize = other.initialSampleSize;
+    mcEntryCoef = other.mcEntryCoef;
+    mcBreakCoef = other.mcBreakCoef;
+    kdeModel = std::move(other.kdeModel);
+
+    // Reset other model.
+    other.bandwidth = 1.0;
+    other.relError = KDEDefaultParams::relError;
+    other.absError = KDEDefaultParams::absError;
+    other.kernelType = KernelTypes::GAUSSIAN_KERNEL;
+    other.treeType = TreeTypes::KD_TREE;
+    other.monteCarlo = KDEDefaultParams::monteCarlo;
+    other.mcProb = KDEDefaultParams::mcProb;
+    other.initialSampleSize = KDEDefaultParams::initialSampleSize;
+    other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
+    other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+    other.kdeModel = NULL;
+  }
+
+  return *this;
+}
+
+// Clean memory.
+template<typename MatType>
+KDEModelType<MatType>::~KDEModelType()
+{
+  delete kdeModel;
+}
+
+template<template<typename TreeMetricType,
+                  typename TreeMatType,
+                  typename TreeStatType> class TreeType,
+         typename MatType>
+KDEWrapperBase<MatType>* InitializeModelHelper(
+    const typename KDEModelType<MatType>::KernelTypes kernelType,
+    const double relError,
+    const double absError,
+    const double bandwidth)
+{
+  switch (kernelType)
+  {
+    case KDEModelType<MatType>::GAUSSIAN_KERNEL:
+      return new KDEWrapper<kernel::GaussianKernel, TreeType, MatType>(
+          relError, absError, kernel::GaussianKernel(bandwidth));
+
+    case KDEModelType<MatType>::EPANECHNIKOV_KERNEL:
+      return new KDEWrapper<kernel::EpanechnikovKernel, TreeType, MatType>(
+          relError, absError, kernel::EpanechnikovKernel(bandwidth));
+
+    case KDEModelType<MatType>::LAPLACIAN_KERNEL:
+      return new KDEWrapper<kernel::LaplacianKernel, TreeType, MatType>(
+          relError, absError, kernel::LaplacianKernel(bandwidth));
+
+    case KDEModelType<MatType>::SPHERICAL_KERNEL:
+      return new KDEWrapper<kernel::SphericalKernel, TreeType, MatType>(
+          relError, absError, kernel::SphericalKernel(bandwidth));
+
+    case KDEModelType<MatType>::TRIANGULAR_KERNEL:
+      return new KDEWrapper<kernel::TriangularKernel, TreeType, MatType>(
+          relError, absError, kernel::TriangularKernel(bandwidth));
+  }
+
+  // This should never happen.
+  return NULL;
+}
+
+template<typename MatType>
+void KDEModelType<MatType>::InitializeModel()
+{
+  // Clean memory, if necessary.
+  delete kdeModel;
+
+  // Build the actual model.
+  switch (treeType)
+  {
+    case KD_TREE:
+      kdeModel = InitializeModelHelper<tree::KDTree, MatType>(kernelType,
+          relError, absError, bandwidth);
+      break;
+
+    case BALL_TREE:
+      kdeModel = InitializeModelHelper<tree::BallTree, MatType>(kernelType,
+          relError, absError, bandwidth);
+      break;
+
+    case COVER_TREE:
+      kdeModel = InitializeModelHelper<tree::StandardCoverTree, MatType>(
+          kernelType, relError, absError, bandwidth);
+      break;
+
+    case OCTREE:
+      kdeModel = InitializeModelHelper<tree::Octree, MatType>(kernelType,
+          relError, absError, bandwidth);
+      break;
+
+    case R_TREE:
+      kdeModel = InitializeModelHelper<tree::RTree, MatType>(kernelType,
+          relError, absError, bandwidth);
+      break;
+  }
+}
+
+template<typename MatType>
+void KDEModelType<MatType>::BuildModel(util::Timers& timers,
+                                       MatType&& referenceSet)
+{
+  InitializeModel();
+
+  // Set whether to use Monte Carlo estimations or not.
+  kdeModel->MonteCarlo() = monteCarlo;
+
+  // Set Monte Carlo probability.
+  kdeModel->MCProb(mcProb);
+
+  // Set Monte Carlo initial sample size.
+  kdeModel->MCInitialSampleSize() = initialSampleSize;
+
+  // Set Monte Carlo entry coefficient.
+  kdeModel->MCEntryCoef(mcEntryCoef);
+
+  // Set Monte Carlo break coefficient.
+  kdeModel->MCBreakCoef(mcBreakCoef);
+
+  // Train the model.
+  kdeModel->Train(timers, std::move(referenceSet));
+}
+
+// Perform bichromatic evaluation.
+template<typename MatType>
+void KDEModelType<MatType>::Evaluate(util::Timers& timers,
+                                     MatType&& querySet,
+                                     arma::vec& estimates)
+{
+  kdeModel->Evaluate(timers, std::move(querySet), estimates);
+}
+
+// Perform monochromatic evaluation.
+template<typename MatType>
+void KDEModelType<MatType>::Evaluate(util::Timers& timers, arma::vec& estimates)
+{
+  kdeModel->Evaluate(timers, estimates);
+}
+
+// Clean memory.
+template<typename MatType>
+void KDEModelType<MatType>::CleanMemory()
+{
+  delete kdeModel;
+}
+
+// Modify model kernel bandwidth.
+template<typename MatType>
+void KDEModelType<MatType>::Bandwidth(const double newBandwidth)
+{
+  bandwidth = newBandwidth;
+  kdeModel->Bandwidth(bandwidth);
+}
+
+// Modify model relative error tolerance.
+template<typename MatType>
+void KDEModelType<MatType>::RelativeError(const double newRelError)
+{
+  relError = newRelError;
+  kdeModel->RelativeError(relError);
+}
+
+// Modify model absolute error tolerance.
+template<typename MatType>
+void KDEModelType<MatType>::AbsoluteError(const double newAbsError)
+{
+  absError = newAbsError;
+  kdeModel->AbsoluteError(absError);
+}
+
+// Modify whether Monte Carlo estimations will be used.
+template<typename MatType>
+void KDEModelType<MatType>::MonteCarlo(const bool newMonteCarlo)
+{
+  monteCarlo = newMonteCarlo;
+  kdeModel->MonteCarlo() = monteCarlo;
+}
+
+// Modify model Monte Carlo probability.
+template<typename MatType>
+void KDEModelType<MatType>::MCProbability(const double newMCProb)
+{
+  mcProb = newMCProb;
+  kdeModel->MCProb(mcProb);
+}
+
+// Modify model Monte Carlo initial sample size.
+template<typename MatType>
+void KDEModelType<MatType>::MCInitialSampleSize(const size_t newSampleSize)
+{
+  initialSampleSize = newSampleSize;
+  kdeModel->MCInitialSampleSize() = initialSampleSize;
+}
+
+// Modify model Monte Carlo entry coefficient.
+template<typename MatType>
+void KDEModelType<MatType>::MCEntryCoefficient(const double newEntryCoef)
+{
+  mcEntryCoef = newEntryCoef;
+  kdeModel->MCEntryCoef(mcEntryCoef);
+}
+
+// Modify model Monte Carlo break coefficient.
+template<typename MatType>
+void KDEModelType<MatType>::MCBreakCoefficient(const double newBreakCoef)
+{
+  mcBreakCoef = newBreakCoef;
+  kdeModel->MCBreakCoef(mcBreakCoef);
+}
+
 } // namespace kde
 } // namespace mlpack
 
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_KDE_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/base_case_block.hpp>
 
 namespace mlpack {
 namespace kde {
@@ -46,8 +47,8 @@ class KDERules
    * @param sameSet True if query and reference sets are the same
    *                (monochromatic evaluation).
    */
-  KDERules(const arma::mat& referenceSet,
-           const arma::mat& querySet,
+  KDERules(const typename TreeType::Mat& referenceSet,
+           const typename TreeType::Mat& querySet,
            arma::vec& densities,
            const double relError,
            const double absError,
@@ -63,6 +64,14 @@ class KDERules
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  //! Compute the distances between the query points [queryBegin, queryBegin +
+  //! queryCount) and the reference points [referenceBegin, referenceBegin +
+  //! referenceCount) at once, for the base cases of a pair of leaves.
+  void PrepareBaseCases(const size_t queryBegin,
+                        const size_t queryCount,
+                        const size_t referenceBegin,
+                        const size_t referenceCount);
+
   //! SingleTree Rescore.
   double Score(const size_t queryIndex, TreeType& referenceNode);
 
@@ -103,17 +112,18 @@ class KDERules
                         const size_t referenceIndex) const;
 
   //! Evaluate kernel value of 2 points.
-  double EvaluateKernel(const arma::vec& query,
-                        const arma::vec& reference) const;
+  double EvaluateKernel(const arma::Col<typename TreeType::ElemType>& query,
+                        const arma::Col<typename TreeType::ElemType>& reference)
+      const;
 
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
   //! The reference set.
-  const arma::mat& referenceSet;
+  const typename TreeType::Mat& referenceSet;
 
   //! The query set.
-  const arma::mat& querySet;
+  const typename TreeType::Mat& querySet;
 
   //! Density values.
   arma::vec& densities;
@@ -171,6 +181,9 @@ class KDERules
   //! The last reference index.
   size_t lastReferenceIndex;
 
+  //! Distances between the points of the current pair of leaves.
+  tree::BaseCaseBlock<MetricType, typename TreeType::Mat> block;
+
   //! Traversal information.
   TraversalInfoType traversalInfo;
 
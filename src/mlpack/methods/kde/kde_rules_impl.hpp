@@ -24,8 +24,8 @@ namespace kde {
 
 template<typename MetricType, typename KernelType, typename TreeType>
 KDERules<MetricType, KernelType, TreeType>::KDERules(
-    const arma::mat& referenceSet,
-    const arma::mat& querySet,
+    const typename TreeType::Mat& referenceSet,
+    const typename TreeType::Mat& querySet,
     arma::vec& densities,
     const double relError,
     const double absError,
@@ -81,8 +81,12 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
     return 0.0;
 
   // Calculations.
-  const double distance = metric.Evaluate(querySet.col(queryIndex),
-                                          referenceSet.col(referenceIndex));
+  double distance;
+  if (!block.Distance(queryIndex, referenceIndex, distance))
+  {
+    distance = metric.Evaluate(querySet.col(queryIndex),
+                               referenceSet.col(referenceIndex));
+  }
   const double kernelValue = kernel.Evaluate(distance);
   densities(queryIndex) += kernelValue;
 
@@ -96,13 +100,25 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+inline void KDERules<MetricType, KernelType, TreeType>::PrepareBaseCases(
+    const size_t queryBegin,
+    const size_t queryCount,
+    const size_t referenceBegin,
+    const size_t referenceCount)
+{
+  block.Compute(querySet, queryBegin, queryCount, referenceSet, referenceBegin,
+      referenceCount);
+}
+
 //! Single-tree scoring function.
 template<typename MetricType, typename KernelType, typename TreeType>
 inline double KDERules<MetricType, KernelType, TreeType>::
 Score(const size_t queryIndex, TreeType& referenceNode)
 {
   // Auxiliary variables.
-  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const arma::Col<typename TreeType::ElemType> queryPoint =
+      querySet.unsafe_col(queryIndex);
   const size_t refNumDesc = referenceNode.NumDescendants();
   double score, minDistance, maxDistance, depthAlpha;
   // Calculations are not duplicated.
@@ -535,7 +551,8 @@ EvaluateKernel(const size_t queryIndex,
 
 template<typename MetricType, typename KernelType, typename TreeType>
 inline force_inline double KDERules<MetricType, KernelType, TreeType>::
-EvaluateKernel(const arma::vec& query, const arma::vec& reference) const
+EvaluateKernel(const arma::Col<typename TreeType::ElemType>& query,
+               const arma::Col<typename TreeType::ElemType>& reference) const
 {
   return kernel.Evaluate(metric.Evaluate(query, reference));
 }
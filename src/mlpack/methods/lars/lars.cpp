@@ -162,10 +162,35 @@ LARS& LARS::operator=(LARS&& other)
   return *this;
 }
 
-double LARS::Train(const arma::mat& matX,
-                   const arma::rowvec& y,
-                   arma::vec& beta,
-                   const bool transposeData)
+template<typename MatType>
+double LARS::GramColumn(const MatType& matX,
+                        const size_t varInd,
+                        arma::vec& newGramCol) const
+{
+  newGramCol.set_size(activeSet.size());
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) activeSet.size(); ++i)
+    newGramCol[i] = arma::dot(matX.col(activeSet[i]), matX.col(varInd));
+
+  return arma::dot(matX.col(varInd), matX.col(varInd));
+}
+
+template<typename MatType>
+void LARS::ComputeYHatDirection(const MatType& matX,
+                                const arma::vec& betaDirection,
+                                arma::vec& yHatDirection)
+{
+  yHatDirection.zeros(matX.n_rows);
+  for (size_t i = 0; i < activeSet.size(); ++i)
+    yHatDirection += betaDirection(i) * matX.col(activeSet[i]);
+}
+
+template<typename MatType>
+double LARS::TrainInternal(const MatType& matX,
+                           const arma::rowvec& y,
+                           arma::vec& beta,
+                           const bool transposeData)
 {
   // Clear any previous solution information.
   betaPath.clear();
@@ -181,9 +206,9 @@ double LARS::Train(const arma::mat& matX,
   elasticNet = (lambda1 != 0 && lambda2 != 0);
 
   // This matrix may end up holding the transpose -- if necessary.
-  arma::mat dataTrans;
+  MatType dataTrans;
   // dataRef is row-major.
-  const arma::mat& dataRef = (transposeData ? dataTrans : matX);
+  const MatType& dataRef = (transposeData ? dataTrans : matX);
   if (transposeData)
     dataTrans = trans(matX);
 
@@ -227,14 +252,21 @@ double LARS::Train(const arma::mat& matX,
     return maxCorr;
   }
 
+  // For sparse data, we never form the Gram matrix (unless the user gave us
+  // one); instead we only keep the Cholesky factorization of the Gram matrix
+  // of the active set up to date.
+  const bool covarianceFree = std::is_same<MatType, arma::sp_mat>::value &&
+      (matGram == &matGramInternal);
+  const bool cholesky = useCholesky || covarianceFree;
+
   // Compute the Gram matrix.  If this is the elastic net problem, we will add
   // lambda2 * I_n to the matrix.
-  if (matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
+  if (!covarianceFree && matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
   {
     // In this case, matGram should reference matGramInternal.
     matGramInternal = trans(dataRef) * dataRef;
 
-    if (elasticNet && !useCholesky)
+    if (elasticNet && !cholesky)
       matGramInternal += lambda2 * arma::eye(dataRef.n_cols, dataRef.n_cols);
   }
 
@@ -242,20 +274,51 @@ double LARS::Train(const arma::mat& matX,
   while (((activeSet.size() + ignoreSet.size()) < dataRef.n_cols) &&
          (maxCorr > tolerance))
   {
-    // Compute the maximum correlation among inactive dimensions.
+    // Compute the maximum correlation among inactive dimensions.  Each thread
+    // scans a part of the dimensions, and ties are broken towards the lowest
+    // index, as in a serial scan.
     maxCorr = 0;
-    for (size_t i = 0; i < dataRef.n_cols; ++i)
+    size_t maxInd = dataRef.n_cols;
+    #pragma omp parallel
     {
-      if ((!isActive[i]) && (!isIgnored[i]) && (fabs(corr(i)) > maxCorr))
+      double localMaxCorr = 0;
+      size_t localMaxInd = dataRef.n_cols;
+
+      #pragma omp for nowait
+      for (omp_size_t i = 0; i < (omp_size_t) dataRef.n_cols; ++i)
       {
-        maxCorr = fabs(corr(i));
-        changeInd = i;
+        if ((!isActive[i]) && (!isIgnored[i]) &&
+            (fabs(corr(i)) > localMaxCorr))
+        {
+          localMaxCorr = fabs(corr(i));
+          localMaxInd = i;
+        }
+      }
+
+      #pragma omp critical
+      {
+        if ((localMaxCorr > maxCorr) ||
+            (localMaxCorr == maxCorr && localMaxInd < maxInd))
+        {
+          maxCorr = localMaxCorr;
+          maxInd = localMaxInd;
+        }
       }
     }
 
+    if (maxInd != dataRef.n_cols)
+      changeInd = maxInd;
+
     if (!lassocond)
     {
-      if (useCholesky)
+      if (covarianceFree)
+      {
+        // Compute only the part of the Gram matrix that we need.
+        arma::vec newGramCol;
+        const double sqNorm = GramColumn(dataRef, changeInd, newGramCol);
+        CholeskyInsert(sqNorm, newGramCol);
+      }
+      else if (cholesky)
       {
         // vec newGramCol = vec(activeSet.size());
         // for (size_t i = 0; i < activeSet.size(); ++i)
@@ -284,7 +347,7 @@ double LARS::Train(const arma::mat& matX,
     arma::vec unnormalizedBetaDirection;
     double normalization;
     arma::vec betaDirection;
-    if (useCholesky)
+    if (cholesky)
     {
       // Check for singularity.
       const double lastUtriElement = matUtriCholFactor(
@@ -362,12 +425,14 @@ double LARS::Train(const arma::mat& matX,
     if ((activeSet.size() + ignoreSet.size()) < dataRef.n_cols)
     {
       // Compute correlations with direction.
+      arma::vec dirCorrs;
+      Correlations(dataRef, yHatDirection, dirCorrs);
       for (size_t ind = 0; ind < dataRef.n_cols; ind++)
       {
         if (isActive[ind] || isIgnored[ind])
           continue;
 
-        const double dirCorr = dot(dataRef.col(ind), yHatDirection);
+        const double dirCorr = dirCorrs(ind);
         const double val1 = (maxCorr - corr(ind)) / (normalization - dirCorr);
         const double val2 = (maxCorr + corr(ind)) / (normalization + dirCorr);
         if ((val1 > 0.0) && (val1 < gamma))
@@ -426,13 +491,14 @@ double LARS::Train(const arma::mat& matX,
     if (lassocond)
     {
       // Index is in position changeInd in activeSet.
-      if (useCholesky)
+      if (cholesky)
         CholeskyDelete(changeInd);
 
       Deactivate(changeInd);
     }
 
-    corr = vecXTy - trans(dataRef) * yHat;
+    Correlations(dataRef, yHat, corr);
+    corr = vecXTy - corr;
     if (elasticNet)
       corr -= lambda2 * beta;
 
@@ -461,6 +527,22 @@ double LARS::Train(const arma::mat& matX,
   return ComputeError(matX, y, !transposeData);
 }
 
+double LARS::Train(const arma::mat& matX,
+                   const arma::rowvec& y,
+                   arma::vec& beta,
+                   const bool transposeData)
+{
+  return TrainInternal(matX, y, beta, transposeData);
+}
+
+double LARS::Train(const arma::sp_mat& matX,
+                   const arma::rowvec& y,
+                   arma::vec& beta,
+                   const bool transposeData)
+{
+  return TrainInternal(matX, y, beta, transposeData);
+}
+
 double LARS::Train(const arma::mat& data,
                    const arma::rowvec& responses,
                    const bool transposeData)
@@ -469,6 +551,70 @@ double LARS::Train(const arma::mat& data,
   return Train(data, responses, beta, transposeData);
 }
 
+double LARS::Train(const arma::sp_mat& data,
+                   const arma::rowvec& responses,
+                   const bool transposeData)
+{
+  arma::vec beta;
+  return Train(data, responses, beta, transposeData);
+}
+
+template<typename MatType>
+void LARS::RegularizationPathInternal(const MatType& data,
+                                      const arma::rowvec& responses,
+                                      const arma::vec& lambdas,
+                                      arma::mat& betas,
+                                      const bool transposeData)
+{
+  if (lambdas.is_empty() || lambdas.min() <= 0.0)
+  {
+    throw std::invalid_argument("LARS::RegularizationPath(): all values of "
+        "lambda1 must be positive!");
+  }
+
+  // Run the homotopy down to the smallest lambda; every larger lambda is on
+  // the way.
+  lambda1 = lambdas.min();
+  arma::vec beta;
+  TrainInternal(data, responses, beta, transposeData);
+
+  // The path is piecewise linear in lambda1 between the knots in lambdaPath,
+  // which are decreasing.
+  betas.zeros(beta.n_elem, lambdas.n_elem);
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    const double lambda = lambdas[i];
+    if (lambda >= lambdaPath[0] || lambdaPath.size() == 1)
+      continue; // The solution is zero.
+
+    size_t k = 1;
+    while (k < lambdaPath.size() - 1 && lambdaPath[k] > lambda)
+      ++k;
+
+    const double interp = (lambdaPath[k - 1] == lambdaPath[k]) ? 1.0 :
+        (lambdaPath[k - 1] - lambda) / (lambdaPath[k - 1] - lambdaPath[k]);
+    betas.col(i) = (1 - interp) * betaPath[k - 1] + interp * betaPath[k];
+  }
+}
+
+void LARS::RegularizationPath(const arma::mat& data,
+                              const arma::rowvec& responses,
+                              const arma::vec& lambdas,
+                              arma::mat& betas,
+                              const bool transposeData)
+{
+  RegularizationPathInternal(data, responses, lambdas, betas, transposeData);
+}
+
+void LARS::RegularizationPath(const arma::sp_mat& data,
+                              const arma::rowvec& responses,
+                              const arma::vec& lambdas,
+                              arma::mat& betas,
+                              const bool transposeData)
+{
+  RegularizationPathInternal(data, responses, lambdas, betas, transposeData);
+}
+
 void LARS::Predict(const arma::mat& points,
                    arma::rowvec& predictions,
                    const bool rowMajor) const
@@ -480,6 +626,16 @@ void LARS::Predict(const arma::mat& points,
     predictions = betaPath.back().t() * points;
 }
 
+void LARS::Predict(const arma::sp_mat& points,
+                   arma::rowvec& predictions,
+                   const bool rowMajor) const
+{
+  if (rowMajor)
+    predictions = trans(points * betaPath.back());
+  else
+    predictions = betaPath.back().t() * points;
+}
+
 // Private functions.
 void LARS::Deactivate(const size_t activeVarInd)
 {
@@ -499,13 +655,28 @@ void LARS::Ignore(const size_t varInd)
   ignoreSet.push_back(varInd);
 }
 
-void LARS::ComputeYHatDirection(const arma::mat& matX,
-                                const arma::vec& betaDirection,
-                                arma::vec& yHatDirection)
+void LARS::Correlations(const arma::mat& matX,
+                        const arma::vec& v,
+                        arma::vec& correlations) const
 {
-  yHatDirection.fill(0);
-  for (size_t i = 0; i < activeSet.size(); ++i)
-    yHatDirection += betaDirection(i) * matX.col(activeSet[i]);
+  correlations = trans(matX) * v;
+}
+
+void LARS::Correlations(const arma::sp_mat& matX,
+                        const arma::vec& v,
+                        arma::vec& correlations) const
+{
+  correlations.set_size(matX.n_cols);
+
+  // Walk the compressed columns directly; each dimension is independent.
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) matX.n_cols; ++j)
+  {
+    double sum = 0.0;
+    for (size_t k = matX.col_ptrs[j]; k < matX.col_ptrs[j + 1]; ++k)
+      sum += matX.values[k] * v[matX.row_indices[k]];
+    correlations[j] = sum;
+  }
 }
 
 void LARS::InterpolateBeta()
@@ -650,3 +821,13 @@ double LARS::ComputeError(const arma::mat& matX,
     return arma::accu(arma::pow(y - betaPath.back().t() * matX, 2.0));
   }
 }
+
+double LARS::ComputeError(const arma::sp_mat& matX,
+                          const arma::rowvec& y,
+                          const bool rowMajor)
+{
+  if (rowMajor)
+    return arma::accu(arma::pow(y - trans(matX * betaPath.back()), 2.0));
+  else
+    return arma::accu(arma::pow(y - betaPath.back().t() * matX, 2.0));
+}
@@ -85,6 +85,17 @@ namespace regression {
  *   publisher={Royal Statistical Society}
  * }
  * @endcode
+ *
+ * LARS can also be trained on sparse data (arma::sp_mat).  In that case, unless
+ * a Gram matrix is given explicitly, the Gram matrix is never formed: the
+ * Cholesky factorization of the Gram matrix of the active set is always used,
+ * and it is updated with one new Gram column (computed with sparse dot
+ * products) each time a variable enters the active set and downdated with
+ * Givens rotations each time a variable leaves.  Correlations with the
+ * residual are computed with sparse matrix-vector products that are
+ * parallelized over dimensions with OpenMP.  This makes it possible to solve
+ * problems with very many (sparse) dimensions, such as text problems, where
+ * the full Gram matrix would not fit in memory.
  */
 class LARS
 {
@@ -236,6 +247,81 @@ class LARS
                const arma::rowvec& responses,
                const bool transposeData = true);
 
+  /**
+   * Run LARS on sparse data.  Unless a Gram matrix was passed to the
+   * constructor, the Gram matrix is not computed; see the class documentation.
+   * The Cholesky factorization is always used for sparse data, regardless of
+   * the value of UseCholesky().
+   *
+   * @param data Column-major sparse input data (or row-major input data if
+   *     transposeData = false).
+   * @param responses A vector of targets.
+   * @param beta Vector to store the solution (the coefficients) in.
+   * @param transposeData Set to false if the data is row-major.
+   * @return minimum cost error(||y-beta*X||2 is used to calculate error).
+   */
+  double Train(const arma::sp_mat& data,
+               const arma::rowvec& responses,
+               arma::vec& beta,
+               const bool transposeData = true);
+
+  /**
+   * Run LARS on sparse data.  Unless a Gram matrix was passed to the
+   * constructor, the Gram matrix is not computed; see the class documentation.
+   *
+   * @param data Column-major sparse input data (or row-major input data if
+   *     transposeData = false).
+   * @param responses A vector of targets.
+   * @param transposeData Should be true if the input data is column-major and
+   *     false otherwise.
+   * @return minimum cost error(||y-beta*X||2 is used to calculate error).
+   */
+  double Train(const arma::sp_mat& data,
+               const arma::rowvec& responses,
+               const bool transposeData = true);
+
+  /**
+   * Compute the LASSO (or elastic net) solution for each value of lambda1 in
+   * the given grid.  Because the LASSO solution path is piecewise linear in
+   * lambda1, the whole path is computed with a single homotopy run down to the
+   * smallest value in the grid (each knot is warm-started from the previous
+   * one), and the solution for each grid value is then interpolated exactly
+   * from the knots of the path.  After this call, the model holds the solution
+   * for the smallest value of lambda1 in the grid, and Lambda1() is set to that
+   * value.
+   *
+   * @param data Column-major input data (or row-major input data if
+   *     transposeData = false).
+   * @param responses A vector of targets.
+   * @param lambdas Grid of (positive) values of lambda1.
+   * @param betas Matrix to store the solutions in; column i is the solution for
+   *     lambdas[i].
+   * @param transposeData Set to false if the data is row-major.
+   */
+  void RegularizationPath(const arma::mat& data,
+                          const arma::rowvec& responses,
+                          const arma::vec& lambdas,
+                          arma::mat& betas,
+                          const bool transposeData = true);
+
+  /**
+   * Compute the LASSO (or elastic net) solution for each value of lambda1 in
+   * the given grid, for sparse data.  See the dense overload for details.
+   *
+   * @param data Column-major sparse input data (or row-major input data if
+   *     transposeData = false).
+   * @param responses A vector of targets.
+   * @param lambdas Grid of (positive) values of lambda1.
+   * @param betas Matrix to store the solutions in; column i is the solution for
+   *     lambdas[i].
+   * @param transposeData Set to false if the data is row-major.
+   */
+  void RegularizationPath(const arma::sp_mat& data,
+                          const arma::rowvec& responses,
+                          const arma::vec& lambdas,
+                          arma::mat& betas,
+                          const bool transposeData = true);
+
   /**
    * Predict y_i for each data point in the given data matrix using the
    * currently-trained LARS model.
@@ -249,6 +335,19 @@ class LARS
                arma::rowvec& predictions,
                const bool rowMajor = false) const;
 
+  /**
+   * Predict y_i for each data point in the given sparse data matrix using the
+   * currently-trained LARS model.
+   *
+   * @param points The data points to regress on.
+   * @param predictions y, which will contained calculated values on completion.
+   * @param rowMajor Should be true if the data points matrix is row-major and
+   *     false otherwise.
+   */
+  void Predict(const arma::sp_mat& points,
+               arma::rowvec& predictions,
+               const bool rowMajor = false) const;
+
   //! Get the L1 regularization coefficient.
   double Lambda1() const { return lambda1; }
   //! Modify the L1 regularization coefficient.
@@ -308,6 +407,21 @@ class LARS
                       const arma::rowvec& y,
                       const bool rowMajor = false);
 
+  /**
+   * Compute cost error of the given sparse data matrix using the
+   * currently-trained LARS model.
+   *
+   * @param matX Column-major sparse input data (or row-major input data if
+   *     rowMajor = true).
+   * @param y responses A vector of targets.
+   * @param rowMajor Should be true if the data points matrix is row-major and
+   *   false otherwise.
+   * @return The minimum cost error.
+   */
+  double ComputeError(const arma::sp_mat& matX,
+                      const arma::rowvec& y,
+                      const bool rowMajor = false);
+
  private:
   //! Gram matrix.
   arma::mat matGramInternal;
@@ -375,8 +489,57 @@ class LARS
    */
   void Ignore(const size_t varInd);
 
+  /**
+   * Run LARS on the given dense or sparse data.  This is the implementation of
+   * each of the Train() overloads.
+   */
+  template<typename MatType>
+  double TrainInternal(const MatType& matX,
+                       const arma::rowvec& y,
+                       arma::vec& beta,
+                       const bool transposeData);
+
+  /**
+   * Run LARS down to the smallest lambda in the grid, and interpolate the
+   * solutions for each lambda in the grid.  This is the implementation of each
+   * of the RegularizationPath() overloads.
+   */
+  template<typename MatType>
+  void RegularizationPathInternal(const MatType& data,
+                                  const arma::rowvec& responses,
+                                  const arma::vec& lambdas,
+                                  arma::mat& betas,
+                                  const bool transposeData);
+
+  /**
+   * Compute the correlation of every dimension of the row-major data matX with
+   * the given vector (that is, trans(matX) * v).
+   */
+  void Correlations(const arma::mat& matX,
+                    const arma::vec& v,
+                    arma::vec& correlations) const;
+
+  /**
+   * Compute the correlation of every dimension of the row-major sparse data
+   * matX with the given vector.  This is parallelized over dimensions.
+   */
+  void Correlations(const arma::sp_mat& matX,
+                    const arma::vec& v,
+                    arma::vec& correlations) const;
+
+  /**
+   * Compute the column of the Gram matrix for dimension varInd, restricted to
+   * the active set, without forming the Gram matrix.  The squared norm of
+   * dimension varInd is returned.
+   */
+  template<typename MatType>
+  double GramColumn(const MatType& matX,
+                    const size_t varInd,
+                    arma::vec& newGramCol) const;
+
   // compute "equiangular" direction in output space
-  void ComputeYHatDirection(const arma::mat& matX,
+  template<typename MatType>
+  void ComputeYHatDirection(const MatType& matX,
                             const arma::vec& betaDirection,
                             arma::vec& yHatDirection);
 
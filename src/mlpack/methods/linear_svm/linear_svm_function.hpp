@@ -104,7 +104,7 @@ class LinearSVMFunction
    */
   template <typename GradType>
   void Gradient(const arma::mat& parameters,
-                GradType& gradient);
+                GradType& gradient) const;
 
   /**
    * Evaluate the gradient of the hinge loss function, following
@@ -120,7 +120,27 @@ class LinearSVMFunction
   void Gradient(const arma::mat& parameters,
                 const size_t firstId,
                 GradType& gradient,
-                const size_t batchSize = 1);
+                const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the gradient of the hinge loss function on the specified
+   * datapoints, as a sparse matrix holding only the rows of the features that
+   * are nonzero in the batch (and the intercept row).  This is used by
+   * optimizers that apply sparse updates, such as HogwildSGD, which call it
+   * by name; since it is not an overload of Gradient(), other optimizers keep
+   * using the dense gradient.  The regularization is only applied to these
+   * rows, with weight 1 / batchSize for each point of the batch that has the
+   * feature.
+   *
+   * @param parameters The parameters of the SVM.
+   * @param firstId Index of the datapoint to use for the gradient evaluation.
+   * @param gradient Sparse matrix to output the gradient into.
+   * @param batchSize Size of the batch to process.
+   */
+  void SparseGradient(const arma::mat& parameters,
+                      const size_t firstId,
+                      arma::sp_mat& gradient,
+                      const size_t batchSize = 1) const;
 
   /**
    * Evaluate the gradient of the hinge loss function, following
@@ -216,7 +216,7 @@ double LinearSVMFunction<MatType>::Evaluate(
     scores = parameters.rows(0, dataset.n_rows - 1).t()
         * dataset.cols(firstId, lastId)
         + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+        batchSize);
   }
 
   arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
@@ -238,7 +238,7 @@ template <typename MatType>
 template <typename GradType>
 void LinearSVMFunction<MatType>::Gradient(
     const arma::mat& parameters,
-    GradType& gradient)
+    GradType& gradient) const
 {
   // The objective is to minimize the loss, which is evaluated as the sum
   // of all the positive elements of `margin` matrix.
@@ -304,7 +304,7 @@ void LinearSVMFunction<MatType>::Gradient(
     const arma::mat& parameters,
     const size_t firstId,
     GradType& gradient,
-    const size_t batchSize)
+    const size_t batchSize) const
 {
   const size_t lastId = firstId + batchSize - 1;
 
@@ -355,6 +355,80 @@ void LinearSVMFunction<MatType>::Gradient(
   gradient += lambda * parameters;
 }
 
+template <typename MatType>
+void LinearSVMFunction<MatType>::SparseGradient(
+    const arma::mat& parameters,
+    const size_t firstId,
+    arma::sp_mat& gradient,
+    const size_t batchSize) const
+{
+  const size_t lastId = firstId + batchSize - 1;
+
+  // Only the nonzero elements of the batch contribute to the gradient.
+  const arma::sp_mat points(dataset.cols(firstId, lastId));
+
+  // Scores for each class are evaluated.
+  arma::mat scores;
+
+  // Check intercept condition.
+  if (!fitIntercept)
+  {
+    scores = parameters.t() * points;
+  }
+  else
+  {
+    scores = parameters.rows(0, dataset.n_rows - 1).t() * points
+        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
+  }
+
+  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
+      + delta - (delta * groundTruth.cols(firstId, lastId));
+
+  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+      { val = (val > 0) ? 1: 0; });
+
+  const arma::mat difference = groundTruth.cols(firstId, lastId)
+      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+  // Each nonzero element x_ij adds x_ij * difference(c, j) to row i of every
+  // class c, and each point adds difference(c, j) to the intercept row.
+  const size_t numElements = (points.n_nonzero +
+      (fitIntercept ? batchSize : 0)) * numClasses;
+  arma::umat locations(2, numElements);
+  arma::vec values(numElements);
+
+  size_t k = 0;
+  for (arma::sp_mat::const_iterator it = points.begin(); it != points.end();
+      ++it)
+  {
+    for (size_t c = 0; c < numClasses; ++c, ++k)
+    {
+      locations(0, k) = it.row();
+      locations(1, k) = c;
+      values[k] = ((*it) * difference(c, it.col()) +
+          lambda * parameters(it.row(), c)) / batchSize;
+    }
+  }
+
+  if (fitIntercept)
+  {
+    for (size_t j = 0; j < batchSize; ++j)
+    {
+      for (size_t c = 0; c < numClasses; ++c, ++k)
+      {
+        locations(0, k) = dataset.n_rows;
+        locations(1, k) = c;
+        values[k] = (difference(c, j) +
+            lambda * parameters(dataset.n_rows, c)) / batchSize;
+      }
+    }
+  }
+
+  gradient = arma::sp_mat(true, locations, values, parameters.n_rows,
+      parameters.n_cols);
+}
+
 template <typename MatType>
 template <typename GradType>
 double LinearSVMFunction<MatType>::EvaluateWithGradient(
@@ -444,7 +518,7 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   {
     scores = parameters.rows(0, dataset.n_rows - 1).t()
         * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, dataset.n_cols);
+        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
   }
 
   arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
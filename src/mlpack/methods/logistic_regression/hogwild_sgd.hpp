@@ -0,0 +1,143 @@
+/**
+ * @file methods/logistic_regression/hogwild_sgd.hpp
+ *
+ * Definition of HogwildSGD, a lock-free parallel SGD optimizer for functions
+ * with sparse gradients.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LOGISTIC_REGRESSION_HOGWILD_SGD_HPP
+#define MLPACK_METHODS_LOGISTIC_REGRESSION_HOGWILD_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <ensmallen.hpp>
+
+namespace mlpack {
+namespace regression {
+
+/**
+ * HogwildSGD is a lock-free parallel SGD optimizer for separable functions
+ * whose per-point gradients are sparse, such as linear models trained on
+ * sparse data.  In every epoch the points are split into one contiguous shard
+ * per thread (after shuffling the visitation order), and each thread runs SGD
+ * over its shard, reading the shared parameters without locks and applying
+ * each nonzero element of its gradients with an atomic update.  When the
+ * gradients of different points rarely touch the same elements, the threads
+ * rarely interfere, and the updates behave as in serial SGD.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{recht2011hogwild,
+ *   title = {Hogwild!: A Lock-Free Approach to Parallelizing Stochastic
+ *       Gradient Descent},
+ *   author = {Recht, Benjamin and Re, Christopher and Wright, Stephen and
+ *       Niu, Feng},
+ *   booktitle = {Advances in Neural Information Processing Systems 24
+ *       (NIPS 2011)},
+ *   pages = {693--701},
+ *   year = {2011}
+ * }
+ * @endcode
+ *
+ * The function to be optimized must provide the following methods:
+ *
+ * @code
+ * size_t NumFunctions() const;
+ *
+ * // Evaluate the objective on the given batch of points.
+ * double Evaluate(const arma::mat& parameters,
+ *                 const size_t begin,
+ *                 const size_t batchSize);
+ *
+ * // Store the gradient of the objective on the given batch of points in a
+ * // sparse matrix, whose nonzero elements are the only parameters updated.
+ * void SparseGradient(const arma::mat& parameters,
+ *                     const size_t begin,
+ *                     arma::sp_mat& gradient,
+ *                     const size_t batchSize);
+ * @endcode
+ *
+ * LinearSVMFunction, LogisticRegressionFunction and SoftmaxRegressionFunction
+ * provide these methods, so LinearSVM, LogisticRegression and
+ * SoftmaxRegression can be trained with HogwildSGD.  The results depend on the
+ * number of threads and on the scheduling of the threads; use SynchronousSGD
+ * for reproducible parallel training.
+ *
+ * @tparam DecayPolicyType Step size update policy used at the start of every
+ *     epoch (for instance ens::ConstantStep or ens::ExponentialBackoff).
+ */
+template<typename DecayPolicyType = ens::ConstantStep>
+class HogwildSGD
+{
+ public:
+  /**
+   * Create the HogwildSGD optimizer with the given parameters.
+   *
+   * @param maxIterations Maximum number of epochs (0 means no limit).
+   * @param tolerance Maximum absolute tolerance to terminate the algorithm.
+   * @param shuffle If true, the points are visited in a random order in every
+   *     epoch.
+   * @param decayPolicy The step size update policy to use.
+   */
+  HogwildSGD(const size_t maxIterations = 100,
+             const double tolerance = 1e-5,
+             const bool shuffle = true,
+             const DecayPolicyType& decayPolicy = DecayPolicyType());
+
+  /**
+   * Optimize the given function with Hogwild! SGD.  The given starting point
+   * will be modified to store the finishing point of the optimization, and the
+   * final objective value is returned.  Callbacks are not supported.
+   *
+   * @param function Function to be optimized.
+   * @param iterate Starting point (will be modified).
+   * @return Objective value at the final point.
+   */
+  template<typename FunctionType, typename MatType, typename... CallbackTypes>
+  double Optimize(FunctionType& function,
+                  MatType& iterate,
+                  CallbackTypes&&... /* callbacks */);
+
+  //! Get the maximum number of epochs (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of epochs (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether or not the visitation order is shuffled.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether or not the visitation order is shuffled.
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the step size decay policy.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the step size decay policy.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+ private:
+  //! The maximum number of allowed epochs.
+  size_t maxIterations;
+  //! The tolerance for termination.
+  double tolerance;
+  //! Controls whether or not the visitation order is shuffled.
+  bool shuffle;
+  //! The step size decay policy.
+  DecayPolicyType decayPolicy;
+};
+
+} // namespace regression
+} // namespace mlpack
+
+// Include implementation.
+#include "hogwild_sgd_impl.hpp"
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file methods/logistic_regression/hogwild_sgd_impl.hpp
+ *
+ * Implementation of HogwildSGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LOGISTIC_REGRESSION_HOGWILD_SGD_IMPL_HPP
+#define MLPACK_METHODS_LOGISTIC_REGRESSION_HOGWILD_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hogwild_sgd.hpp"
+#include "parallel_objective.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace regression {
+
+template<typename DecayPolicyType>
+HogwildSGD<DecayPolicyType>::HogwildSGD(
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const DecayPolicyType& decayPolicy) :
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    shuffle(shuffle),
+    decayPolicy(decayPolicy)
+{
+  // Nothing to do.
+}
+
+template<typename DecayPolicyType>
+template<typename FunctionType, typename MatType, typename... CallbackTypes>
+double HogwildSGD<DecayPolicyType>::Optimize(
+    FunctionType& function,
+    MatType& iterate,
+    CallbackTypes&&... /* callbacks */)
+{
+  static_assert(sizeof...(CallbackTypes) == 0,
+      "HogwildSGD does not support callbacks.");
+
+  const size_t numFunctions = function.NumFunctions();
+
+  std::vector<size_t> visitationOrder(numFunctions);
+  std::iota(visitationOrder.begin(), visitationOrder.end(), 0);
+
+  double overallObjective = ParallelObjective(function, iterate);
+  double lastObjective;
+  for (size_t epoch = 1; maxIterations == 0 || epoch <= maxIterations;
+      ++epoch)
+  {
+    // Get the step size for this epoch.
+    const double stepSize = decayPolicy.StepSize(epoch);
+
+    if (shuffle) // Determine the order of visitation.
+    {
+      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
+          mlpack::math::randGen);
+    }
+
+    #pragma omp parallel
+    {
+      size_t threadId = 0;
+      size_t numThreads = 1;
+      #ifdef HAS_OPENMP
+        threadId = omp_get_thread_num();
+        numThreads = omp_get_num_threads();
+      #endif
+
+      // Each thread runs SGD over its own shard of the points.  The shared
+      // parameters are read without locks while the other threads update
+      // them.
+      const size_t shardBegin = threadId * numFunctions / numThreads;
+      const size_t shardEnd = (threadId + 1) * numFunctions / numThreads;
+      arma::sp_mat gradient;
+      for (size_t i = shardBegin; i < shardEnd; ++i)
+      {
+        function.SparseGradient(iterate, visitationOrder[i], gradient, 1);
+
+        // Only the nonzero elements of the gradient are updated, each with an
+        // atomic operation.
+        for (arma::sp_mat::const_iterator it = gradient.begin();
+            it != gradient.end(); ++it)
+        {
+          double& element = iterate(it.row(), it.col());
+          const double update = stepSize * (*it);
+
+          #pragma omp atomic
+          element -= update;
+        }
+      }
+    }
+
+    lastObjective = overallObjective;
+    overallObjective = ParallelObjective(function, iterate);
+
+    // Output current objective function.
+    Log::Info << "Hogwild SGD: epoch " << epoch << ", objective "
+        << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Log::Warn << "Hogwild SGD: converged to " << overallObjective
+          << "; terminating with failure.  Try a smaller step size?"
+          << std::endl;
+      return overallObjective;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Log::Info << "Hogwild SGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      return overallObjective;
+    }
+  }
+
+  Log::Info << "Hogwild SGD: maximum epochs (" << maxIterations
+      << ") reached; terminating optimization." << std::endl;
+
+  return overallObjective;
+}
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
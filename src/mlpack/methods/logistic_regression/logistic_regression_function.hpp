@@ -118,6 +118,29 @@ class LogisticRegressionFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Evaluate the gradient of the logistic regression log-likelihood function
+   * for the given batch size from a given point in the dataset, as a sparse
+   * matrix holding only the intercept and the features that are nonzero in
+   * the batch.  This is used by optimizers that apply sparse updates, such as
+   * HogwildSGD, which call it by name; since it is not an overload of
+   * Gradient(), other optimizers keep using the dense gradient.  The
+   * regularization is only applied to these features, with weight 1 / n for
+   * each point of the batch that has the feature, so features that are rarely
+   * nonzero are regularized less than by the dense Gradient().
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param begin Index of the starting point to use for objective function
+   *     gradient evaluation.
+   * @param gradient Sparse matrix to output gradient into.
+   * @param batchSize Number of points to be processed as a batch for objective
+   *     function gradient evaluation.
+   */
+  void SparseGradient(const arma::mat& parameters,
+                      const size_t begin,
+                      arma::sp_mat& gradient,
+                      const size_t batchSize = 1) const;
+
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
    * with the given parameters, and with respect to only one feature in the
@@ -180,6 +180,44 @@ void LogisticRegressionFunction<MatType>::Gradient(
       predictors.cols(begin, begin + batchSize - 1).t() + regularization;
 }
 
+//! Evaluate the gradient of the logistic regression objective function for a
+//! given batch size, as a sparse matrix.
+template<typename MatType>
+void LogisticRegressionFunction<MatType>::SparseGradient(
+                const arma::mat& parameters,
+                const size_t begin,
+                arma::sp_mat& gradient,
+                const size_t batchSize) const
+{
+  // Only the nonzero elements of the batch contribute to the gradient.
+  const arma::sp_mat points(predictors.cols(begin, begin + batchSize - 1));
+
+  const arma::rowvec exponents = parameters(0, 0) +
+      parameters.tail_cols(parameters.n_elem - 1) * points;
+  // Calculating the sigmoid function values.
+  const arma::rowvec diffs = 1.0 / (1.0 + arma::exp(-exponents)) -
+      arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
+      begin + batchSize - 1));
+
+  // The first element is the intercept; the element of each nonzero is added
+  // to the element of its feature.
+  arma::umat locations(2, points.n_nonzero + 1, arma::fill::zeros);
+  arma::vec values(points.n_nonzero + 1);
+  values[0] = arma::accu(diffs);
+
+  size_t i = 1;
+  for (arma::sp_mat::const_iterator it = points.begin(); it != points.end();
+      ++it, ++i)
+  {
+    locations(1, i) = it.row() + 1;
+    values[i] = diffs[it.col()] * (*it) +
+        lambda * parameters(0, it.row() + 1) / predictors.n_cols;
+  }
+
+  gradient = arma::sp_mat(true, locations, values, parameters.n_rows,
+      parameters.n_cols);
+}
+
 /**
  * Evaluate the partial gradient of the logistic regression objective
  * function with respect to the individual features in the parameter.
@@ -0,0 +1,58 @@
+/**
+ * @file methods/logistic_regression/parallel_objective.hpp
+ *
+ * Evaluation of a separable objective over all points with OpenMP.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LOGISTIC_REGRESSION_PARALLEL_OBJECTIVE_HPP
+#define MLPACK_METHODS_LOGISTIC_REGRESSION_PARALLEL_OBJECTIVE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace regression {
+
+/**
+ * Evaluate a separable objective over all of its points, as the sum of its
+ * values on consecutive batches of the given size.  The batches are evaluated
+ * in parallel, and their values are added in order, so that the result does
+ * not depend on the number of threads.
+ *
+ * @param function Function to evaluate; it must provide NumFunctions() and
+ *     Evaluate(parameters, begin, batchSize).
+ * @param parameters Parameters to evaluate the function at.
+ * @param batchSize Number of points evaluated by each call to Evaluate().
+ * @return The sum of the objective over all batches.
+ */
+template<typename FunctionType, typename MatType>
+double ParallelObjective(FunctionType& function,
+                         const MatType& parameters,
+                         const size_t batchSize = 1024)
+{
+  const size_t numFunctions = function.NumFunctions();
+  const size_t numBatches = (numFunctions + batchSize - 1) / batchSize;
+
+  arma::vec objectives(numBatches);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBatches; ++b)
+  {
+    const size_t begin = b * batchSize;
+    objectives[b] = function.Evaluate(parameters, begin,
+        std::min(batchSize, numFunctions - begin));
+  }
+
+  double objective = 0.0;
+  for (size_t b = 0; b < numBatches; ++b)
+    objective += objectives[b];
+
+  return objective;
+}
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
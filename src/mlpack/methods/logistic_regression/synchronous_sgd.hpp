@@ -0,0 +1,147 @@
+/**
+ * @file methods/logistic_regression/synchronous_sgd.hpp
+ *
+ * Definition of SynchronousSGD, a parallel mini-batch SGD optimizer whose
+ * results do not depend on the number of threads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LOGISTIC_REGRESSION_SYNCHRONOUS_SGD_HPP
+#define MLPACK_METHODS_LOGISTIC_REGRESSION_SYNCHRONOUS_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <ensmallen.hpp>
+
+namespace mlpack {
+namespace regression {
+
+/**
+ * SynchronousSGD is a synchronous data-parallel mini-batch SGD optimizer for
+ * separable functions, meant for dense data.  Each step takes the next
+ * numChunks mini-batches of batchSize points, computes the gradient of each
+ * mini-batch in parallel, and steps along the mean of these gradients.  The
+ * gradients are added in the order of the mini-batches, so the result of
+ * every step, and of the whole optimization, does not depend on the number of
+ * threads or on their scheduling.
+ *
+ * Each mini-batch gradient has the same scale as the gradient used by
+ * ens::SGD with the same batch size, so a step size that works with ens::SGD
+ * works with SynchronousSGD, with numChunks times as many points per step.
+ *
+ * The function to be optimized must provide the following methods:
+ *
+ * @code
+ * size_t NumFunctions() const;
+ * void Shuffle();
+ *
+ * // Evaluate the objective on the given batch of points.
+ * double Evaluate(const arma::mat& parameters,
+ *                 const size_t begin,
+ *                 const size_t batchSize);
+ *
+ * // Store the gradient of the objective on the given batch of points.
+ * void Gradient(const arma::mat& parameters,
+ *               const size_t begin,
+ *               arma::mat& gradient,
+ *               const size_t batchSize);
+ * @endcode
+ *
+ * Evaluate() and Gradient() are called concurrently, so they must not modify
+ * the function.
+ *
+ * @tparam DecayPolicyType Step size update policy used at the start of every
+ *     epoch (for instance ens::ConstantStep or ens::ExponentialBackoff).
+ */
+template<typename DecayPolicyType = ens::ConstantStep>
+class SynchronousSGD
+{
+ public:
+  /**
+   * Create the SynchronousSGD optimizer with the given parameters.
+   *
+   * @param batchSize Number of points in each mini-batch.
+   * @param numChunks Number of mini-batches in each step; 0 means the number
+   *     of threads.  Set it explicitly to get the same results with any
+   *     number of threads.
+   * @param maxIterations Maximum number of epochs (0 means no limit).
+   * @param tolerance Maximum absolute tolerance to terminate the algorithm.
+   * @param shuffle If true, the function is shuffled before every epoch.
+   * @param decayPolicy The step size update policy to use.
+   */
+  SynchronousSGD(const size_t batchSize = 32,
+                 const size_t numChunks = 0,
+                 const size_t maxIterations = 100,
+                 const double tolerance = 1e-5,
+                 const bool shuffle = true,
+                 const DecayPolicyType& decayPolicy = DecayPolicyType());
+
+  /**
+   * Optimize the given function with synchronous parallel SGD.  The given
+   * starting point will be modified to store the finishing point of the
+   * optimization, and the final objective value is returned.  Callbacks are
+   * not supported.
+   *
+   * @param function Function to be optimized.
+   * @param iterate Starting point (will be modified).
+   * @return Objective value at the final point.
+   */
+  template<typename FunctionType, typename MatType, typename... CallbackTypes>
+  double Optimize(FunctionType& function,
+                  MatType& iterate,
+                  CallbackTypes&&... /* callbacks */);
+
+  //! Get the number of points in each mini-batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each mini-batch.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the number of mini-batches in each step (0 means one per thread).
+  size_t NumChunks() const { return numChunks; }
+  //! Modify the number of mini-batches in each step (0 means one per thread).
+  size_t& NumChunks() { return numChunks; }
+
+  //! Get the maximum number of epochs (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of epochs (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether or not the function is shuffled before every epoch.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether or not the function is shuffled before every epoch.
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the step size decay policy.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the step size decay policy.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+ private:
+  //! The number of points in each mini-batch.
+  size_t batchSize;
+  //! The number of mini-batches in each step.
+  size_t numChunks;
+  //! The maximum number of allowed epochs.
+  size_t maxIterations;
+  //! The tolerance for termination.
+  double tolerance;
+  //! Controls whether or not the function is shuffled before every epoch.
+  bool shuffle;
+  //! The step size decay policy.
+  DecayPolicyType decayPolicy;
+};
+
+} // namespace regression
+} // namespace mlpack
+
+// Include implementation.
+#include "synchronous_sgd_impl.hpp"
+
+#endif
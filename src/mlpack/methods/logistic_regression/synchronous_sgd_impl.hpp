@@ -0,0 +1,144 @@
+/**
+ * @file methods/logistic_regression/synchronous_sgd_impl.hpp
+ *
+ * Implementation of SynchronousSGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LOGISTIC_REGRESSION_SYNCHRONOUS_SGD_IMPL_HPP
+#define MLPACK_METHODS_LOGISTIC_REGRESSION_SYNCHRONOUS_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "synchronous_sgd.hpp"
+#include "parallel_objective.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace regression {
+
+template<typename DecayPolicyType>
+SynchronousSGD<DecayPolicyType>::SynchronousSGD(
+    const size_t batchSize,
+    const size_t numChunks,
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const DecayPolicyType& decayPolicy) :
+    batchSize(batchSize),
+    numChunks(numChunks),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    shuffle(shuffle),
+    decayPolicy(decayPolicy)
+{
+  // Nothing to do.
+}
+
+template<typename DecayPolicyType>
+template<typename FunctionType, typename MatType, typename... CallbackTypes>
+double SynchronousSGD<DecayPolicyType>::Optimize(
+    FunctionType& function,
+    MatType& iterate,
+    CallbackTypes&&... /* callbacks */)
+{
+  static_assert(sizeof...(CallbackTypes) == 0,
+      "SynchronousSGD does not support callbacks.");
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("SynchronousSGD::Optimize(): the batch size "
+        "must be positive!");
+  }
+
+  const size_t numFunctions = function.NumFunctions();
+
+  size_t chunks = numChunks;
+  if (chunks == 0)
+  {
+    chunks = 1;
+    #ifdef HAS_OPENMP
+      chunks = omp_get_max_threads();
+    #endif
+  }
+
+  // The gradient of each mini-batch of a step is stored separately, so that
+  // they can be added in a fixed order.
+  std::vector<arma::mat> gradients(chunks);
+
+  double overallObjective = ParallelObjective(function, iterate);
+  double lastObjective;
+  for (size_t epoch = 1; maxIterations == 0 || epoch <= maxIterations;
+      ++epoch)
+  {
+    // Get the step size for this epoch.
+    const double stepSize = decayPolicy.StepSize(epoch);
+
+    if (shuffle)
+      function.Shuffle();
+
+    for (size_t begin = 0; begin < numFunctions; begin += chunks * batchSize)
+    {
+      // The last step of an epoch may hold fewer points.
+      const size_t stepChunks = std::min(chunks,
+          (numFunctions - begin + batchSize - 1) / batchSize);
+
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t c = 0; c < (omp_size_t) stepChunks; ++c)
+      {
+        const size_t chunkBegin = begin + c * batchSize;
+        function.Gradient(iterate, chunkBegin, gradients[c],
+            std::min(batchSize, numFunctions - chunkBegin));
+      }
+
+      // Each element is reduced by one thread, over the mini-batches in order.
+      const double scale = stepSize / stepChunks;
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t j = 0; j < (omp_size_t) iterate.n_elem; ++j)
+      {
+        double sum = gradients[0][j];
+        for (size_t c = 1; c < stepChunks; ++c)
+          sum += gradients[c][j];
+
+        iterate[j] -= scale * sum;
+      }
+    }
+
+    lastObjective = overallObjective;
+    overallObjective = ParallelObjective(function, iterate);
+
+    // Output current objective function.
+    Log::Info << "Synchronous SGD: epoch " << epoch << ", objective "
+        << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Log::Warn << "Synchronous SGD: converged to " << overallObjective
+          << "; terminating with failure.  Try a smaller step size?"
+          << std::endl;
+      return overallObjective;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Log::Info << "Synchronous SGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      return overallObjective;
+    }
+  }
+
+  Log::Info << "Synchronous SGD: maximum epochs (" << maxIterations
+      << ") reached; terminating optimization." << std::endl;
+
+  return overallObjective;
+}
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
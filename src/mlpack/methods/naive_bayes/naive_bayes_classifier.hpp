@@ -108,6 +108,12 @@ class NaiveBayesClassifier
    * classes, either re-initialize or call Means(), Variances(), and
    * Probabilities() individually to set them to the right size.
    *
+   * If mlpack is compiled with OpenMP, the dataset is split into one
+   * contiguous shard per thread.  Each thread accumulates its own sufficient
+   * statistics (counts, means, and sums of squared deviations), and the shards
+   * are then combined in thread order with Chan's parallel variance formula, so
+   * results are deterministic for a fixed number of threads.
+   *
    * @param data The dataset to train on.
    * @param labels The labels for the dataset.
    * @param numClasses The numbe of classes in the dataset.
@@ -120,6 +126,20 @@ class NaiveBayesClassifier
              const size_t numClasses,
              const bool incremental = true);
 
+  /**
+   * Merge another Naive Bayes classifier into this one.  The other model must
+   * have the same dimensionality and number of classes as this model; it is
+   * typically a model that was trained on a different shard of the same
+   * dataset.  After merging, this model is equivalent (up to floating-point
+   * error) to a model trained on the union of both shards.  The merge uses
+   * Chan's parallel variance formula and the number of training points seen by
+   * each model, so both models should have been trained (or deserialized) with
+   * this class.
+   *
+   * @param other Model to merge into this one.
+   */
+  void Merge(const NaiveBayesClassifier& other);
+
   /**
    * Train the Naive Bayes classifier on the given point.  This will use the
    * incremental algorithm for updating the model parameters.  The data must be
@@ -214,6 +234,11 @@ class NaiveBayesClassifier
   //! Modify the prior probabilities for each class.
   ModelMatType& Probabilities() { return probabilities; }
 
+  //! Get the number of points the model has been trained on.
+  size_t TrainingPoints() const { return trainingPoints; }
+  //! Modify the number of points the model has been trained on.
+  size_t& TrainingPoints() { return trainingPoints; }
+
   //! Serialize the classifier.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -230,10 +255,68 @@ class NaiveBayesClassifier
   //! Small value to prevent log of zero.
   double epsilon;
 
+  /**
+   * Compute the number of points, the sample mean, and the sum of squared
+   * deviations from the mean (M2) of every class for the given dataset.  Each
+   * thread handles a contiguous shard of the data, and the per-thread results
+   * are merged with MergeStatistics().
+   *
+   * @param data Set of points to compute statistics for.
+   * @param labels Labels of the points.
+   * @param numClasses Number of classes.
+   * @param counts Vector to store the number of points in each class in.
+   * @param batchMeans Matrix to store the mean of each class in.
+   * @param batchM2 Matrix to store the sum of squared deviations in.
+   */
+  template<typename MatType>
+  static void BatchStatistics(const MatType& data,
+                              const arma::Row<size_t>& labels,
+                              const size_t numClasses,
+                              arma::vec& counts,
+                              ModelMatType& batchMeans,
+                              ModelMatType& batchM2);
+
+  /**
+   * Merge the sufficient statistics of a second set of points into the first,
+   * using Chan's parallel variance formula for each class.
+   *
+   * @param counts Number of points in each class of the first set.
+   * @param batchMeans Means of each class of the first set.
+   * @param batchM2 Sums of squared deviations of the first set.
+   * @param otherCounts Number of points in each class of the second set.
+   * @param otherMeans Means of each class of the second set.
+   * @param otherM2 Sums of squared deviations of the second set.
+   */
+  static void MergeStatistics(arma::vec& counts,
+                              ModelMatType& batchMeans,
+                              ModelMatType& batchM2,
+                              const arma::vec& otherCounts,
+                              const ModelMatType& otherMeans,
+                              const ModelMatType& otherM2);
+
+  /**
+   * Recover the number of points and the sum of squared deviations of every
+   * class from the current (normalized) model.
+   *
+   * @param counts Vector to store the number of points in each class in.
+   * @param m2 Matrix to store the sum of squared deviations in.
+   */
+  void ModelStatistics(arma::vec& counts, ModelMatType& m2) const;
+
+  /**
+   * Set the model parameters from the given sufficient statistics.
+   *
+   * @param counts Number of points in each class.
+   * @param m2 Sums of squared deviations of each class.
+   */
+  void SetModel(const arma::vec& counts, const ModelMatType& m2);
+
   /**
    * Compute the unnormalized posterior log probability of given points (log
    * likelihood). Results are returned as arma::mat, and each column represents
-   * a point, each row represents log likelihood of a class.
+   * a point, each row represents log likelihood of a class.  The squared
+   * Mahalanobis distance to each (diagonal) Gaussian is expanded so that the
+   * whole batch is scored with two matrix multiplications.
    *
    * @param data Set of points to compute posterior log probability for.
    * @param logLikelihoods Matrix to store log likelihoods in.
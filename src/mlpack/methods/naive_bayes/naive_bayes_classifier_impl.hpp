@@ -22,6 +22,10 @@
 // In case it hasn't been included already.
 #include "naive_bayes_classifier.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace naive_bayes {
 
@@ -105,74 +109,195 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     }
   }
 
-  // Calculate the class probabilities as well as the sample mean and variance
-  // for each of the features with respect to each of the labels.
+  // Calculate the number of points, the sample mean, and the sum of squared
+  // deviations for each of the features with respect to each of the labels.
+  // This is done in parallel with one shard of the data per thread.
+  arma::vec counts;
+  ModelMatType batchMeans, batchM2;
+  BatchStatistics(data, labels, numClasses, counts, batchMeans, batchM2);
+
   if (incremental)
   {
-    // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
-    probabilities *= trainingPoints;
+    // Use the current model as a starting point, and merge the statistics of
+    // the new data into it.
+    arma::vec modelCounts;
+    ModelMatType m2;
+    ModelStatistics(modelCounts, m2);
+    MergeStatistics(modelCounts, means, m2, counts, batchMeans, batchM2);
+    SetModel(modelCounts, m2);
+    trainingPoints += data.n_cols;
+  }
+  else
+  {
+    // Ignore the current model entirely.
+    means = std::move(batchMeans);
+    SetModel(counts, batchM2);
+    trainingPoints = data.n_cols;
+  }
+}
 
-    for (size_t j = 0; j < data.n_cols; ++j)
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::Merge(
+    const NaiveBayesClassifier& other)
+{
+  if (other.Means().n_rows != means.n_rows ||
+      other.Means().n_cols != means.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "NaiveBayesClassifier::Merge(): cannot merge a model with "
+        << other.Means().n_rows << " dimensions and " << other.Means().n_cols
+        << " classes into a model with " << means.n_rows << " dimensions and "
+        << means.n_cols << " classes!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::vec counts, otherCounts;
+  ModelMatType m2, otherM2;
+  ModelStatistics(counts, m2);
+  other.ModelStatistics(otherCounts, otherM2);
+
+  // The other model's variances include its own epsilon, which has already
+  // been removed by ModelStatistics().
+  MergeStatistics(counts, means, m2, otherCounts, other.Means(), otherM2);
+  SetModel(counts, m2);
+  trainingPoints += other.TrainingPoints();
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::BatchStatistics(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::vec& counts,
+    ModelMatType& batchMeans,
+    ModelMatType& batchM2)
+{
+  counts.zeros(numClasses);
+  batchMeans.zeros(data.n_rows, numClasses);
+  batchM2.zeros(data.n_rows, numClasses);
+
+  #ifdef HAS_OPENMP
+    const size_t numThreads = (size_t) omp_get_max_threads();
+  #else
+    const size_t numThreads = 1;
+  #endif
+
+  std::vector<arma::vec> threadCounts(numThreads);
+  std::vector<ModelMatType> threadMeans(numThreads);
+  std::vector<ModelMatType> threadM2(numThreads);
+
+  #pragma omp parallel
+  {
+    size_t threadId = 0;
+    #ifdef HAS_OPENMP
+      threadId = omp_get_thread_num();
+    #endif
+
+    arma::vec& localCounts = threadCounts[threadId];
+    ModelMatType& localMeans = threadMeans[threadId];
+    ModelMatType& localM2 = threadM2[threadId];
+    localCounts.zeros(numClasses);
+    localMeans.zeros(data.n_rows, numClasses);
+    localM2.zeros(data.n_rows, numClasses);
+
+    // A static schedule gives each thread one contiguous shard of the data.
+    // Each shard is accumulated with Welford's algorithm.
+    #pragma omp for schedule(static)
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
     {
       const size_t label = labels[j];
-      ++probabilities[label];
+      ++localCounts[label];
 
-      arma::vec delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
+      arma::Col<ElemType> delta = data.col(j) - localMeans.col(label);
+      localMeans.col(label) += delta / localCounts[label];
+      localM2.col(label) += delta % (data.col(j) - localMeans.col(label));
     }
+  }
 
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
+  // Combine the shards in thread order, so that the result does not depend on
+  // which thread finished first.
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    if (threadCounts[t].n_elem == numClasses)
     {
-      if (probabilities[i] > 2)
-        variances.col(i) /= (probabilities[i] - 1);
+      MergeStatistics(counts, batchMeans, batchM2, threadCounts[t],
+          threadMeans[t], threadM2[t]);
     }
   }
-  else
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::MergeStatistics(
+    arma::vec& counts,
+    ModelMatType& batchMeans,
+    ModelMatType& batchM2,
+    const arma::vec& otherCounts,
+    const ModelMatType& otherMeans,
+    const ModelMatType& otherM2)
+{
+  for (size_t i = 0; i < counts.n_elem; ++i)
   {
-    // Set all parameters to zero.
-    probabilities.zeros();
-    means.zeros();
-    variances.zeros();
-
-    // Don't use incremental algorithm.  This is a two-pass algorithm.  It is
-    // possible to calculate the means and variances using a faster one-pass
-    // algorithm but there are some precision and stability issues.  If this is
-    // too slow, it's an option to use the faster algorithm by default and then
-    // have this (and the incremental algorithm) be other options.
-
-    // Calculate the means.
-    for (size_t j = 0; j < data.n_cols; ++j)
+    if (otherCounts[i] == 0.0)
+      continue;
+
+    if (counts[i] == 0.0)
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
-      means.col(label) += data.col(j);
+      batchMeans.col(i) = otherMeans.col(i);
+      batchM2.col(i) = otherM2.col(i);
+      counts[i] = otherCounts[i];
+      continue;
     }
 
-    // Normalize means.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] != 0.0)
-        means.col(i) /= probabilities[i];
+    // Chan et al.'s formula for combining the means and variances of two sets.
+    const double n = counts[i] + otherCounts[i];
+    arma::Col<ElemType> delta = otherMeans.col(i) - batchMeans.col(i);
+    batchMeans.col(i) += delta * ElemType(otherCounts[i] / n);
+    batchM2.col(i) += otherM2.col(i) +
+        arma::square(delta) * ElemType(counts[i] * otherCounts[i] / n);
+    counts[i] = n;
+  }
+}
 
-    // Calculate variances.
-    for (size_t j = 0; j < data.n_cols; ++j)
-    {
-      const size_t label = labels[j];
-      variances.col(label) += square(data.col(j) - means.col(label));
-    }
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::ModelStatistics(
+    arma::vec& counts,
+    ModelMatType& m2) const
+{
+  // Probabilities are stored normalized, so de-normalize them.
+  counts = arma::round(arma::conv_to<arma::vec>::from(probabilities) *
+      trainingPoints);
 
-    // Normalize variances.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] > 1)
-        variances.col(i) /= (probabilities[i] - 1);
+  // Remove the epsilon that was added to the variances, and de-normalize them.
+  m2 = variances - epsilon;
+  for (size_t i = 0; i < counts.n_elem; ++i)
+  {
+    if (counts[i] > 1)
+      m2.col(i) *= ElemType(counts[i] - 1);
+    else
+      m2.col(i).zeros();
   }
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::SetModel(
+    const arma::vec& counts,
+    const ModelMatType& m2)
+{
+  // Normalize variances.
+  variances = m2;
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    if (counts[i] > 1)
+      variances.col(i) /= ElemType(counts[i] - 1);
 
   // Add epsilon to prevent log of zero.
   variances += epsilon;
 
-  probabilities /= data.n_cols;
-  trainingPoints += data.n_cols;
+  const double totalPoints = arma::accu(counts);
+  if (totalPoints > 0)
+    probabilities = arma::conv_to<ModelMatType>::from(counts / totalPoints);
+  else
+    probabilities.zeros(counts.n_elem);
 }
 
 template<typename ModelMatType>
@@ -184,17 +309,27 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  // We must use the incremental algorithm here.
+  // We must use the incremental algorithm here.  The variances hold epsilon
+  // (see SetModel()), so it is removed before the update and added back
+  // afterwards, just like for the batch algorithm.
   probabilities *= trainingPoints;
   probabilities[label]++;
 
   arma::vec delta = point - means.col(label);
   means.col(label) += delta / probabilities[label];
   if (probabilities[label] > 2)
+  {
+    variances.col(label) -= epsilon;
     variances.col(label) *= (probabilities[label] - 2);
+  }
+  else
+  {
+    variances.col(label).zeros();
+  }
   variances.col(label) += (delta % (point - means.col(label)));
   if (probabilities[label] > 1)
     variances.col(label) /= probabilities[label] - 1;
+  variances.col(label) += epsilon;
 
   trainingPoints++;
   probabilities /= trainingPoints;
@@ -210,24 +345,31 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
-
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
-
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
-  {
-    // This is an adaptation of gmm::phi() for the case where the covariance is
-    // a diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
-        arma::accu(arma::log(variances.col(i))) + exponents);
-  }
+  // This is an adaptation of gmm::phi() for the case where the covariance is
+  // a diagonal matrix.  The exponent of each class is expanded as
+  //
+  //   -0.5 * sum_d (x_d - mu_d)^2 / var_d =
+  //       sum_d x_d (mu_d / var_d) - 0.5 * sum_d x_d^2 / var_d
+  //       - 0.5 * sum_d mu_d^2 / var_d
+  //
+  // so that the joint log likelihood of every point for each of the classes
+  // can be computed for the whole batch with two matrix multiplications.  The
+  // terms of the expansion cancel catastrophically when a feature has a large
+  // mean and a small variance, so the points and the means are first centered
+  // on the mean of the class means; the exponent does not change.
+  const arma::Col<ElemType> offset = arma::mean(means, 1);
+  const ModelMatType centeredMeans = means.each_col() - offset;
+  const ModelMatType centeredData = data.each_col() - offset;
+
+  const ModelMatType invVar = 1.0 / variances;
+  const ModelMatType classConstants = arma::log(probabilities) +
+      (data.n_rows / -2.0 * log(2 * M_PI)) -
+      0.5 * arma::sum(arma::log(variances), 0).t() -
+      0.5 * arma::sum(arma::square(centeredMeans) % invVar, 0).t();
+
+  logLikelihoods = (centeredMeans % invVar).t() * centeredData -
+      0.5 * (invVar.t() * arma::square(centeredData));
+  logLikelihoods.each_col() += classConstants.col(0);
 }
 
 template<typename ModelMatType>
@@ -291,17 +433,11 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  predictions.set_size(data.n_cols);
-
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    arma::uword maxIndex = 0;
-    logLikelihoods.unsafe_col(i).max(maxIndex);
-    predictions[i] = maxIndex;
-  }
+  predictions = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(logLikelihoods, 0));
 }
 
 template<typename ModelMatType>
@@ -319,32 +455,25 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  predictions.set_size(data.n_cols);
-
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  predictionProbs.set_size(arma::size(logLikelihoods));
-  double maxValue, logProbX;
-  for (size_t j = 0; j < data.n_cols; ++j)
-  {
-    // The LogLikelihood() gives us the unnormalized log likelihood which is
-    // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
-    // Besides, to prevent underflow in log of sum of exp of x operation (where
-    // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
-    maxValue = arma::max(logLikelihoods.col(j));
-    logProbX = log(arma::accu(exp(logLikelihoods.col(j) -
-        maxValue))) + maxValue;
-    predictionProbs.col(j) = arma::exp(logLikelihoods.col(j) - logProbX);
-  }
+  // The LogLikelihood() gives us the unnormalized log likelihood which is
+  // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
+  // Besides, to prevent underflow in log of sum of exp of x operation (where x
+  // is a small negative value), we use logsumexp(x - max(x)) + max(x).  This is
+  // done for all points at once.
+  const arma::Row<ElemType> maxValues = arma::max(logLikelihoods, 0);
+  predictionProbs = logLikelihoods;
+  predictionProbs.each_row() -= maxValues;
+  const arma::Row<ElemType> logSumExp = arma::log(arma::sum(
+      arma::exp(predictionProbs), 0));
+  predictionProbs.each_row() -= logSumExp;
+  predictionProbs = arma::exp(predictionProbs);
 
   // Now calculate maximum probabilities for each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    arma::uword maxIndex = 0;
-    logLikelihoods.unsafe_col(i).max(maxIndex);
-    predictions[i] = maxIndex;
-  }
+  predictions = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(logLikelihoods, 0));
 }
 
 template<typename ModelMatType>
@@ -356,6 +485,8 @@ void NaiveBayesClassifier<ModelMatType>::serialize(
   ar(CEREAL_NVP(means));
   ar(CEREAL_NVP(variances));
   ar(CEREAL_NVP(probabilities));
+  ar(CEREAL_NVP(trainingPoints));
+  ar(CEREAL_NVP(epsilon));
 }
 
 } // namespace naive_bayes
@@ -36,7 +36,8 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 class LeafSizeNSWrapper;
 
 //! NeighborSearchMode represents the different neighbor search modes available.
@@ -211,6 +212,38 @@ class NeighborSearch
    */
   void Train(Tree referenceTree);
 
+  /**
+   * Insert the given points into the reference set and the reference tree.
+   * The inserted points get the indices following the last point of the
+   * reference set, and the indices of the points already in the reference set
+   * do not change.  The reference set grows geometrically, so inserting
+   * points does not copy the whole reference set every time.
+   *
+   * This is only possible for tree types that support updates (see
+   * tree::IsDynamicTree, which holds for the RectangleTree family).  A
+   * std::invalid_argument is thrown for other tree types and in naive mode.
+   *
+   * @param points Points to insert.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Delete the reference points with the given indices from the reference
+   * tree, so that they are never returned as neighbors again.  The points stay
+   * in the reference set, so the indices of the other points do not change.
+   * A monochromatic search (without a query set) does not search for the
+   * neighbors of deleted points: in every search mode, their columns of the
+   * results hold neighbor index size_t(-1) and the worst possible distance.
+   * Deleting a point that has already been deleted does nothing.
+   *
+   * This is only possible for tree types that support updates (see
+   * tree::IsDynamicTree).  A std::invalid_argument is thrown for other tree
+   * types, in naive mode, and for indices outside of the reference set.
+   *
+   * @param indices Indices of the reference points to delete.
+   */
+  void Delete(const arma::Col<size_t>& indices);
+
   /**
    * For each point in the query set, compute the nearest neighbors and store
    * the output in the given matrices.  The matrices will be set to the size of
@@ -363,9 +396,21 @@ class NeighborSearch
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  //! Memory holding the reference set after points have been inserted; the
+  //! dataset of the reference tree is then a view of it.  It holds space for
+  //! more points than the reference set, so that most insertions don't copy.
+  std::vector<typename MatType::elem_type> referenceStorage;
+
+  //! Append the given points to the dataset of the reference tree.
+  void AppendReferencePoints(const MatType& points);
+
+  //! Mark the reference points that were deleted from the reference tree.
+  //! deleted is left empty if no points were deleted.
+  void DeletedPoints(std::vector<bool>& deleted) const;
+
   //! The NSModel class should have access to internal members.
   friend class LeafSizeNSWrapper<SortPolicy, TreeType, DualTreeTraversalType,
-      SingleTreeTraversalType>;
+      SingleTreeTraversalType, MatType>;
 }; // class NeighborSearch
 
 } // namespace neighbor
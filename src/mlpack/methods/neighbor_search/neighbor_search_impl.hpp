@@ -17,6 +17,7 @@
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
+#include <mlpack/core/tree/is_dynamic_tree.hpp>
 
 namespace mlpack {
 namespace neighbor {
@@ -45,6 +46,59 @@ TreeType* BuildTree(
   return new TreeType(std::forward<MatType>(dataset));
 }
 
+//! Insert the points [begin, end) of the dataset into a tree that supports it.
+template<typename TreeType>
+void InsertTreePoints(
+    TreeType& tree,
+    const size_t begin,
+    const size_t end,
+    const typename std::enable_if_t<
+        tree::IsDynamicTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  for (size_t i = begin; i < end; ++i)
+    tree.InsertPoint(i);
+}
+
+//! Trees that do not support updates can't take new points.
+template<typename TreeType>
+void InsertTreePoints(
+    TreeType& /* tree */,
+    const size_t /* begin */,
+    const size_t /* end */,
+    const typename std::enable_if_t<
+        !tree::IsDynamicTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  throw std::invalid_argument("cannot insert points into a tree type that "
+      "does not support updates");
+}
+
+//! Delete a point from a tree that supports it.
+template<typename TreeType>
+bool DeleteTreePoint(
+    TreeType& tree,
+    const size_t point,
+    const typename std::enable_if_t<
+        tree::IsDynamicTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  return tree.DeletePoint(point);
+}
+
+//! Trees that do not support updates can't delete points.
+template<typename TreeType>
+bool DeleteTreePoint(
+    TreeType& /* tree */,
+    const size_t /* point */,
+    const typename std::enable_if_t<
+        !tree::IsDynamicTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  throw std::invalid_argument("cannot delete points from a tree type that "
+      "does not support updates");
+}
+
 // Construct the object.
 template<typename SortPolicy,
          typename MetricType,
@@ -129,7 +183,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
   // Build the tree on the empty dataset, if necessary.
   if (mode != NAIVE_MODE)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
   }
@@ -179,9 +233,11 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(other.treeNeedsReset)
+    treeNeedsReset(other.treeNeedsReset),
+    referenceStorage(std::move(other.referenceStorage))
 {
   // Clear the other model.
+  other.referenceStorage.clear();
   other.referenceTree = BuildTree<Tree>(std::move(MatType()),
       other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
@@ -223,6 +279,10 @@ NeighborSearch<SortPolicy,
   else
     delete referenceSet;
 
+  // The copied tree holds its own copy of the reference set.
+  referenceStorage.clear();
+  referenceStorage.shrink_to_fit();
+
   oldFromNewReferences = other.oldFromNewReferences;
   referenceTree = other.referenceTree ? new Tree(*other.referenceTree) : NULL;
   referenceSet = other.referenceTree ? &referenceTree->Dataset() :
@@ -269,6 +329,7 @@ NeighborSearch<SortPolicy,
   oldFromNewReferences = std::move(other.oldFromNewReferences);
   referenceTree = other.referenceTree;
   referenceSet = other.referenceSet;
+  referenceStorage = std::move(other.referenceStorage);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
   metric = other.metric;
@@ -280,7 +341,8 @@ NeighborSearch<SortPolicy,
   if (!other.referenceTree)
     delete other.referenceSet;
 
-  other.referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+  other.referenceStorage.clear();
+  other.referenceTree = BuildTree<Tree>(std::move(MatType()),
       other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
@@ -331,6 +393,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(MatType referenceSetIn)
     delete referenceSet;
   }
 
+  // The old reference set isn't needed anymore.
+  referenceStorage.clear();
+  referenceStorage.shrink_to_fit();
+
   // We may need to rebuild the tree.
   if (searchMode != NAIVE_MODE)
   {
@@ -369,10 +435,183 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
     delete this->referenceSet;
   }
 
+  // The old reference set isn't needed anymore.
+  referenceStorage.clear();
+  referenceStorage.shrink_to_fit();
+
   this->referenceTree = new Tree(std::move(referenceTree));
   this->referenceSet = &this->referenceTree->Dataset();
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Insert(const MatType& points)
+{
+  if (searchMode == NAIVE_MODE)
+    throw std::invalid_argument("cannot insert points when naive search "
+        "(without trees) is used");
+
+  if (!tree::IsDynamicTree<Tree>::value)
+    throw std::invalid_argument("cannot insert points into a tree type that "
+        "does not support updates");
+
+  if (points.n_cols == 0)
+    return;
+
+  // A tree without any points doesn't have a dimensionality yet, so just build
+  // a new one.
+  if (referenceSet->n_cols == 0)
+  {
+    Train(points);
+    return;
+  }
+
+  if (points.n_rows != referenceSet->n_rows)
+  {
+    std::ostringstream oss;
+    oss << "dimensionality of points to insert (" << points.n_rows << ") does "
+        << "not match dimensionality of reference set (" << referenceSet->n_rows
+        << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t oldCount = referenceSet->n_cols;
+  AppendReferencePoints(points);
+  InsertTreePoints(*referenceTree, oldCount, referenceSet->n_cols);
+
+  // New nodes get fresh statistics, but nodes that were split or copied may
+  // hold stale bounds; these are only read by the monochromatic dual-tree
+  // search, which resets them first.
+  treeNeedsReset = true;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Delete(
+    const arma::Col<size_t>& indices)
+{
+  if (searchMode == NAIVE_MODE)
+    throw std::invalid_argument("cannot delete points when naive search "
+        "(without trees) is used");
+
+  if (!tree::IsDynamicTree<Tree>::value)
+    throw std::invalid_argument("cannot delete points from a tree type that "
+        "does not support updates");
+
+  // Check all the indices before the tree is modified.
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    if (indices[i] >= referenceSet->n_cols)
+    {
+      std::ostringstream oss;
+      oss << "cannot delete point " << indices[i] << ": there are only "
+          << referenceSet->n_cols << " points in the reference set";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  // Points that were already deleted aren't in the tree anymore, so the tree
+  // just won't find them.
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    DeleteTreePoint(*referenceTree, indices[i]);
+
+  // Nodes that were merged may hold stale bounds.
+  treeNeedsReset = true;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::AppendReferencePoints(
+    const MatType& points)
+{
+  static_assert(arma::is_Mat<MatType>::value, "points can only be inserted "
+      "into dense reference sets");
+
+  MatType& dataset = referenceTree->Dataset();
+  const size_t dim = dataset.n_rows;
+  const size_t oldCount = dataset.n_cols;
+  const size_t newCount = oldCount + points.n_cols;
+
+  // If the reference set isn't held in referenceStorage yet, or there is no
+  // space left, move it to new storage with room for twice as many points.
+  // The old storage must stay alive until the dataset points to the new one.
+  std::vector<typename MatType::elem_type> oldStorage;
+  if (dataset.memptr() != referenceStorage.data() ||
+      referenceStorage.size() < dim * newCount)
+  {
+    std::vector<typename MatType::elem_type> storage(
+        dim * std::max(2 * oldCount, newCount));
+    std::copy(dataset.memptr(), dataset.memptr() + dataset.n_elem,
+        storage.begin());
+    oldStorage.swap(referenceStorage);
+    referenceStorage.swap(storage);
+  }
+
+  std::copy(points.memptr(), points.memptr() + points.n_elem,
+      referenceStorage.begin() + dataset.n_elem);
+
+  // Moving a matrix that uses auxiliary memory into the dataset makes the
+  // dataset use that memory, without copying it.
+  dataset = MatType(referenceStorage.data(), dim, newCount, false, false);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::DeletedPoints(
+    std::vector<bool>& deleted) const
+{
+  deleted.clear();
+
+  // Only dynamic trees can lose points, and if none were lost there is
+  // nothing to mark.
+  if (!tree::IsDynamicTree<Tree>::value || searchMode == NAIVE_MODE ||
+      referenceTree->NumDescendants() == referenceSet->n_cols)
+    return;
+
+  deleted.assign(referenceSet->n_cols, true);
+  std::stack<const Tree*> nodes;
+  nodes.push(referenceTree);
+  while (!nodes.empty())
+  {
+    const Tree* node = nodes.top();
+    nodes.pop();
+
+    for (size_t i = 0; i < node->NumPoints(); ++i)
+      deleted[node->Point(i)] = false;
+
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      nodes.push(&node->Child(i));
+  }
+}
+
 /**
  * Computes the best neighbors and stores them in resultingNeighbors and
  * distances.
@@ -677,18 +916,24 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     arma::Mat<size_t>& neighbors,
     arma::mat& distances)
 {
-  if (k > referenceSet->n_cols)
+  // Deleted points are neither searched for nor returned as neighbors.
+  std::vector<bool> deleted;
+  DeletedPoints(deleted);
+  const size_t numPoints = referenceSet->n_cols -
+      std::count(deleted.begin(), deleted.end(), true);
+
+  if (k > numPoints)
   {
     std::stringstream ss;
     ss << "Requested value of k (" << k << ") is greater than the number of "
-        << "points in the reference set (" << referenceSet->n_cols << ")";
+        << "points in the reference set (" << numPoints << ")";
     throw std::invalid_argument(ss.str());
   }
-  if (k == referenceSet->n_cols)
+  if (k == numPoints)
   {
     std::stringstream ss;
     ss << "Requested value of k (" << k << ") is equal to the number of "
-        << "points in the reference set (" << referenceSet->n_cols << ") and "
+        << "points in the reference set (" << numPoints << ") and "
         << "no query set has been provided.";
     throw std::invalid_argument(ss.str());
   }
@@ -733,9 +978,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the traverser.
       SingleTreeTraversalType<RuleType> traverser(rules);
 
-      // Now have it traverse for each point.
+      // Now have it traverse for each point that is still in the tree.
       for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        if (deleted.empty() || !deleted[i])
+          traverser.Traverse(i, *referenceTree);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -802,9 +1048,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the traverser.
       tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
 
-      // Now have it traverse for each point.
+      // Now have it traverse for each point that is still in the tree.
       for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        if (deleted.empty() || !deleted[i])
+          traverser.Traverse(i, *referenceTree);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -951,6 +1198,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
 
       referenceTree = NULL;
       oldFromNewReferences.clear();
+      referenceStorage.clear();
+      referenceStorage.shrink_to_fit();
     }
   }
   else
@@ -961,6 +1210,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
       delete referenceTree;
     }
 
+    // The loaded tree holds its own reference set.
+    if (cereal::is_loading<Archive>())
+    {
+      referenceStorage.clear();
+      referenceStorage.shrink_to_fit();
+    }
+
     ar(CEREAL_POINTER(referenceTree));
     ar(CEREAL_NVP(oldFromNewReferences));
 
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/base_case_block.hpp>
 
 #include <queue>
 
@@ -73,6 +74,23 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the distances between the query points [queryBegin, queryBegin +
+   * queryCount) and the reference points [referenceBegin, referenceBegin +
+   * referenceCount) at once, so that BaseCase() does not need to evaluate the
+   * metric for those pairs.  This is called by traversals whose leaves hold
+   * contiguous points.
+   *
+   * @param queryBegin Index of the first query point.
+   * @param queryCount Number of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void PrepareBaseCases(const size_t queryBegin,
+                        const size_t queryCount,
+                        const size_t referenceBegin,
+                        const size_t referenceCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -205,6 +223,9 @@ class NeighborSearchRules
   //! The last base case result.
   double lastBaseCase;
 
+  //! Distances between the points of the current pair of leaves.
+  tree::BaseCaseBlock<MetricType, typename TreeType::Mat> block;
+
   //! The number of base cases that have been performed.
   size_t baseCases;
   //! The number of scores that have been performed.
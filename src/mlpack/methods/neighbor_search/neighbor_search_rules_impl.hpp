@@ -93,8 +93,12 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return lastBaseCase;
 
-  double distance = metric.Evaluate(querySet.col(queryIndex),
-                                    referenceSet.col(referenceIndex));
+  double distance;
+  if (!block.Distance(queryIndex, referenceIndex, distance))
+  {
+    distance = metric.Evaluate(querySet.col(queryIndex),
+                               referenceSet.col(referenceIndex));
+  }
   ++baseCases;
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
@@ -107,6 +111,17 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+PrepareBaseCases(const size_t queryBegin,
+                 const size_t queryCount,
+                 const size_t referenceBegin,
+                 const size_t referenceCount)
+{
+  block.Compute(querySet, queryBegin, queryCount, referenceSet, referenceBegin,
+      referenceCount);
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
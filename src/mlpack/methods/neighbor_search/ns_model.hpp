@@ -31,7 +31,10 @@ namespace neighbor {
  * supported by NSModel.  All NeighborSearch type wrappers inherit from this
  * class, allowing a simple interface via inheritance for all the different
  * types we want to support.
+ *
+ * @tparam MatType Type of data held by the wrapped NeighborSearch object.
  */
+template<typename MatType>
 class NSWrapperBase
 {
  public:
@@ -47,7 +50,7 @@ class NSWrapperBase
   virtual ~NSWrapperBase() { }
 
   //! Return a reference to the dataset.
-  virtual const arma::mat& Dataset() const = 0;
+  virtual const MatType& Dataset() const = 0;
 
   //! Get the search mode.
   virtual NeighborSearchMode SearchMode() const = 0;
@@ -61,7 +64,7 @@ class NSWrapperBase
 
   //! Train the NeighborSearch model with the given parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize,
                      const double tau,
                      const double rho) = 0;
@@ -69,7 +72,7 @@ class NSWrapperBase
   //! Perform bichromatic neighbor search (i.e. search with a separate query
   //! set).
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -82,10 +85,19 @@ class NSWrapperBase
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances) = 0;
+
+  //! Insert the given points into the reference set.
+  virtual void Insert(util::Timers& timers, MatType&& points) = 0;
+
+  //! Delete the reference points with the given indices.
+  virtual void Delete(util::Timers& timers,
+                      const arma::Col<size_t>& indices) = 0;
 };
 
 /**
- * NSWrapper is a wrapper class for most NeighborSearch types.
+ * NSWrapper is a wrapper class for most NeighborSearch types.  The default
+ * traversal types are those of trees on arma::mat, so they must be given when
+ * MatType is not arma::mat.
  */
 template<typename SortPolicy,
          template<typename TreeMetricType,
@@ -98,8 +110,9 @@ template<typename SortPolicy,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<metric::EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
-class NSWrapper : public NSWrapperBase
+                      arma::mat>::template SingleTreeTraverser,
+         typename MatType = arma::mat>
+class NSWrapper : public NSWrapperBase<MatType>
 {
  public:
   //! Construct the NSWrapper object, initializing the internally-held
@@ -119,7 +132,7 @@ class NSWrapper : public NSWrapperBase
   virtual NSWrapper* Clone() const { return new NSWrapper(*this); }
 
   //! Get a reference to the reference set.
-  const arma::mat& Dataset() const { return ns.ReferenceSet(); }
+  const MatType& Dataset() const { return ns.ReferenceSet(); }
 
   //! Get the search mode.
   NeighborSearchMode SearchMode() const { return ns.SearchMode(); }
@@ -134,7 +147,7 @@ class NSWrapper : public NSWrapperBase
   //! Train the model with the given options.  For NSWrapper, we ignore the
   //! extra parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t /* leafSize */,
                      const double /* tau */,
                      const double /* rho */);
@@ -142,7 +155,7 @@ class NSWrapper : public NSWrapperBase
   //! Perform bichromatic neighbor search (i.e. search with a separate query
   //! set).  For NSWrapper, we ignore the extra parameters.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -156,6 +169,14 @@ class NSWrapper : public NSWrapperBase
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances);
 
+  //! Insert the given points into the reference set.  This throws if the tree
+  //! type does not support updates.
+  virtual void Insert(util::Timers& timers, MatType&& points);
+
+  //! Delete the reference points with the given indices.  This throws if the
+  //! tree type does not support updates.
+  virtual void Delete(util::Timers& timers, const arma::Col<size_t>& indices);
+
   //! Serialize the NeighborSearch model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -167,7 +188,7 @@ class NSWrapper : public NSWrapperBase
   // Convenience typedef for the neighbor search type held by this class.
   typedef NeighborSearch<SortPolicy,
                          metric::EuclideanDistance,
-                         arma::mat,
+                         MatType,
                          TreeType,
                          DualTreeTraversalType,
                          SingleTreeTraversalType> NSType;
@@ -192,12 +213,14 @@ template<typename SortPolicy,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<metric::EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
+                      arma::mat>::template SingleTreeTraverser,
+         typename MatType = arma::mat>
 class LeafSizeNSWrapper :
     public NSWrapper<SortPolicy,
                      TreeType,
                      DualTreeTraversalType,
-                     SingleTreeTraversalType>
+                     SingleTreeTraversalType,
+                     MatType>
 {
  public:
   //! Construct the LeafSizeNSWrapper by delegating to the NSWrapper
@@ -207,7 +230,8 @@ class LeafSizeNSWrapper :
       NSWrapper<SortPolicy,
                 TreeType,
                 DualTreeTraversalType,
-                SingleTreeTraversalType>(searchMode, epsilon)
+                SingleTreeTraversalType,
+                MatType>(searchMode, epsilon)
   {
     // Nothing to do.
   }
@@ -224,7 +248,7 @@ class LeafSizeNSWrapper :
   //! Train a model with the given parameters.  This overload uses leafSize but
   //! ignores the other parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize,
                      const double /* tau */,
                      const double /* rho */);
@@ -232,7 +256,7 @@ class LeafSizeNSWrapper :
   //! Perform bichromatic search (e.g. search with a separate query set).  This
   //! overload uses the leaf size, but ignores the other parameters.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -250,24 +274,26 @@ class LeafSizeNSWrapper :
   using NSWrapper<SortPolicy,
                   TreeType,
                   DualTreeTraversalType,
-                  SingleTreeTraversalType>::ns;
+                  SingleTreeTraversalType,
+                  MatType>::ns;
 };
 
 /**
  * The SpillNSWrapper class wraps the NeighborSearch class when the spill tree
  * is used.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class SpillNSWrapper :
     public NSWrapper<
         SortPolicy,
         tree::SPTree,
         tree::SPTree<metric::EuclideanDistance,
                      NeighborSearchStat<SortPolicy>,
-                     arma::mat>::template DefeatistDualTreeTraverser,
+                     MatType>::template DefeatistDualTreeTraverser,
         tree::SPTree<metric::EuclideanDistance,
                      NeighborSearchStat<SortPolicy>,
-                     arma::mat>::template DefeatistSingleTreeTraverser>
+                     MatType>::template DefeatistSingleTreeTraverser,
+        MatType>
 {
  public:
   //! Construct the SpillNSWrapper.
@@ -278,10 +304,11 @@ class SpillNSWrapper :
           tree::SPTree,
           tree::SPTree<metric::EuclideanDistance,
                        NeighborSearchStat<SortPolicy>,
-                       arma::mat>::template DefeatistDualTreeTraverser,
+                       MatType>::template DefeatistDualTreeTraverser,
           tree::SPTree<metric::EuclideanDistance,
                        NeighborSearchStat<SortPolicy>,
-                       arma::mat>::template DefeatistSingleTreeTraverser>(
+                       MatType>::template DefeatistSingleTreeTraverser,
+          MatType>(
           searchMode, epsilon)
   {
     // Nothing to do.
@@ -295,7 +322,7 @@ class SpillNSWrapper :
 
   //! Train the model using the given parameters.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize,
                      const double tau,
                      const double rho);
@@ -303,7 +330,7 @@ class SpillNSWrapper :
   //! Perform bichromatic search (i.e. search with a different query set) using
   //! the given parameters.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -323,10 +350,11 @@ class SpillNSWrapper :
       tree::SPTree,
       tree::SPTree<metric::EuclideanDistance,
                    NeighborSearchStat<SortPolicy>,
-                   arma::mat>::template DefeatistDualTreeTraverser,
+                   MatType>::template DefeatistDualTreeTraverser,
       tree::SPTree<metric::EuclideanDistance,
                    NeighborSearchStat<SortPolicy>,
-                   arma::mat>::template DefeatistSingleTreeTraverser>::ns;
+                   MatType>::template DefeatistSingleTreeTraverser,
+      MatType>::ns;
 };
 
 /**
@@ -337,9 +365,17 @@ class SpillNSWrapper :
  * flexibility as the NeighborSearch class.  So if you are using it outside of
  * mlpack_knn and mlpack_kfn, be aware that it is limited!
  *
+ * The model can hold either double-precision (arma::mat) or single-precision
+ * (arma::fmat) data; single-precision models take half the memory and
+ * bandwidth.  Distances are always returned in double precision, but they are
+ * computed in single precision.  If more accurate distances are needed, use
+ * the NeighborSearch class directly with metric::LMetric<2, true, double>,
+ * which sums the terms of each distance in double precision.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType Type of data to search; arma::mat or arma::fmat.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class NSModel
 {
  public:
@@ -370,7 +406,7 @@ class NSModel
   //! If true, random projections are used.
   bool randomBasis;
   //! This is the random projection matrix; only used if randomBasis is true.
-  arma::mat q;
+  MatType q;
 
   size_t leafSize;
   double tau;
@@ -380,7 +416,37 @@ class NSModel
    * nSearch holds an instance of the NeighborSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
    */
-  NSWrapperBase* nSearch;
+  NSWrapperBase<MatType>* nSearch;
+
+  //! The NSWrapper for the given tree type, with the default traversers of
+  //! that tree type on MatType.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  using NSWrapperType = NSWrapper<SortPolicy,
+      TreeType,
+      TreeType<metric::EuclideanDistance,
+               NeighborSearchStat<SortPolicy>,
+               MatType>::template DualTreeTraverser,
+      TreeType<metric::EuclideanDistance,
+               NeighborSearchStat<SortPolicy>,
+               MatType>::template SingleTreeTraverser,
+      MatType>;
+
+  //! The LeafSizeNSWrapper for the given tree type, with the default
+  //! traversers of that tree type on MatType.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  using LeafSizeNSWrapperType = LeafSizeNSWrapper<SortPolicy,
+      TreeType,
+      TreeType<metric::EuclideanDistance,
+               NeighborSearchStat<SortPolicy>,
+               MatType>::template DualTreeTraverser,
+      TreeType<metric::EuclideanDistance,
+               NeighborSearchStat<SortPolicy>,
+               MatType>::template SingleTreeTraverser,
+      MatType>;
 
  public:
   /**
@@ -429,7 +495,7 @@ class NSModel
   void serialize(Archive& ar, const uint32_t /* version */);
 
   //! Expose the dataset.
-  const arma::mat& Dataset() const;
+  const MatType& Dataset() const;
 
   //! Expose SearchMode.
   NeighborSearchMode SearchMode() const;
@@ -465,13 +531,13 @@ class NSModel
 
   //! Build the reference tree.
   void BuildModel(util::Timers& timers,
-                  arma::mat&& referenceSet,
+                  MatType&& referenceSet,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
   //! Perform neighbor search.  The query set will be reordered.
   void Search(util::Timers& timers,
-              arma::mat&& querySet,
+              MatType&& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
@@ -482,6 +548,22 @@ class NSModel
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Insert the given points into the reference set; they get the indices
+   * following the last reference point.  Only the R tree variants support
+   * this; std::invalid_argument is thrown for the other tree types and in
+   * naive mode.
+   */
+  void Insert(util::Timers& timers, MatType&& points);
+
+  /**
+   * Delete the reference points with the given indices, so that they are not
+   * returned as neighbors anymore.  The indices of the other points do not
+   * change.  Only the R tree variants support this; std::invalid_argument is
+   * thrown for the other tree types and in naive mode.
+   */
+  void Delete(util::Timers& timers, const arma::Col<size_t>& indices);
+
   //! Return a string representation of the current tree type.
   std::string TreeName() const;
 };
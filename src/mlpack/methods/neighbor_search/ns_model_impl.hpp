@@ -28,11 +28,13 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
 >::Train(util::Timers& timers,
-         arma::mat&& referenceSet,
+         MatType&& referenceSet,
          const size_t /* leafSize */,
          const double /* tau */,
          const double /* rho */)
@@ -53,11 +55,13 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
 >::Search(util::Timers& timers,
-          arma::mat&& querySet,
+          MatType&& querySet,
           const size_t k,
           arma::Mat<size_t>& neighbors,
           arma::mat& distances,
@@ -90,9 +94,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
 >::Search(util::Timers& timers,
           const size_t k,
           arma::Mat<size_t>& neighbors,
@@ -103,6 +109,42 @@ void NSWrapper<
   timers.Stop("computing_neighbors");
 }
 
+//! Insert points into the reference set.
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
+void NSWrapper<
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
+>::Insert(util::Timers& timers, MatType&& points)
+{
+  timers.Start("updating_tree");
+  ns.Insert(points);
+  timers.Stop("updating_tree");
+}
+
+//! Delete points from the reference set.
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
+void NSWrapper<
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
+>::Delete(util::Timers& timers, const arma::Col<size_t>& indices)
+{
+  timers.Start("updating_tree");
+  ns.Delete(indices);
+  timers.Stop("updating_tree");
+}
+
 //! Train a model with the given parameters.  This overload uses leafSize but
 //! ignores the other parameters.
 template<typename SortPolicy,
@@ -110,11 +152,13 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
 >::Train(util::Timers& timers,
-         arma::mat&& referenceSet,
+         MatType&& referenceSet,
          const size_t leafSize,
          const double /* tau */,
          const double /* rho */)
@@ -143,11 +187,13 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
 >::Search(util::Timers& timers,
-          arma::mat&& querySet,
+          MatType&& querySet,
           const size_t k,
           arma::Mat<size_t>& neighbors,
           arma::mat& distances,
@@ -190,12 +236,12 @@ void LeafSizeNSWrapper<
 }
 
 //! Train the model using the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Train(util::Timers& timers,
-                                       arma::mat&& referenceSet,
-                                       const size_t leafSize,
-                                       const double tau,
-                                       const double rho)
+template<typename SortPolicy, typename MatType>
+void SpillNSWrapper<SortPolicy, MatType>::Train(util::Timers& timers,
+                                                MatType&& referenceSet,
+                                                const size_t leafSize,
+                                                const double tau,
+                                                const double rho)
 {
   timers.Start("tree_building");
   typename decltype(ns)::Tree tree(std::move(referenceSet), tau, leafSize,
@@ -207,14 +253,14 @@ void SpillNSWrapper<SortPolicy>::Train(util::Timers& timers,
 
 //! Perform bichromatic search (i.e. search with a different query set) using
 //! the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
-                                        arma::mat&& querySet,
-                                        const size_t k,
-                                        arma::Mat<size_t>& neighbors,
-                                        arma::mat& distances,
-                                        const size_t leafSize,
-                                        const double rho)
+template<typename SortPolicy, typename MatType>
+void SpillNSWrapper<SortPolicy, MatType>::Search(util::Timers& timers,
+                                                 MatType&& querySet,
+                                                 const size_t k,
+                                                 arma::Mat<size_t>& neighbors,
+                                                 arma::mat& distances,
+                                                 const size_t leafSize,
+                                                 const double rho)
 {
   if (ns.SearchMode() == DUAL_TREE_MODE)
   {
@@ -241,8 +287,8 @@ void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
  */
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(TreeTypes treeType, bool randomBasis) :
     treeType(treeType),
     randomBasis(randomBasis),
     leafSize(20),
@@ -253,8 +299,8 @@ NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(const NSModel& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(const NSModel& other) :
     treeType(other.treeType),
     randomBasis(other.randomBasis),
     q(other.q),
@@ -266,8 +312,8 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(NSModel&& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(NSModel&& other) :
     treeType(other.treeType),
     randomBasis(other.randomBasis),
     q(std::move(other.q)),
@@ -285,8 +331,9 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.nSearch = NULL;
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>& NSModel<SortPolicy, MatType>::operator=(
+    const NSModel& other)
 {
   if (this != &other)
   {
@@ -304,8 +351,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
   return *this;
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>& NSModel<SortPolicy, MatType>::operator=(
+    NSModel&& other)
 {
   if (this != &other)
   {
@@ -332,16 +380,17 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
 }
 
 //! Clean memory, if necessary.
-template<typename SortPolicy>
-NSModel<SortPolicy>::~NSModel()
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::~NSModel()
 {
   delete nSearch;
 }
 
 //! Serialize the kNN model.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<typename Archive>
-void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
+void NSModel<SortPolicy, MatType>::serialize(Archive& ar,
+                                             const uint32_t /* version */)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(randomBasis));
@@ -359,111 +408,106 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   {
     case KD_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::KDTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy,
-                         tree::KDTree>&>(*nSearch);
+        LeafSizeNSWrapperType<tree::KDTree>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapperType<tree::KDTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case COVER_TREE:
       {
-        NSWrapper<SortPolicy, tree::StandardCoverTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy,
-                                   tree::StandardCoverTree>&>(*nSearch);
+        NSWrapperType<tree::StandardCoverTree>& typedSearch =
+            dynamic_cast<NSWrapperType<tree::StandardCoverTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_TREE:
       {
-        NSWrapper<SortPolicy, tree::RTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RTree>&>(*nSearch);
+        NSWrapperType<tree::RTree>& typedSearch =
+            dynamic_cast<NSWrapperType<tree::RTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_STAR_TREE:
       {
-        NSWrapper<SortPolicy, tree::RStarTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RStarTree>&>(*nSearch);
+        NSWrapperType<tree::RStarTree>& typedSearch =
+            dynamic_cast<NSWrapperType<tree::RStarTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case BALL_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::BallTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy,
-                                           tree::BallTree>&>(*nSearch);
+        LeafSizeNSWrapperType<tree::BallTree>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapperType<tree::BallTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case X_TREE:
       {
-        NSWrapper<SortPolicy, tree::XTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::XTree>&>(*nSearch);
+        NSWrapperType<tree::XTree>& typedSearch =
+            dynamic_cast<NSWrapperType<tree::XTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case HILBERT_R_TREE:
       {
-        NSWrapper<SortPolicy, tree::HilbertRTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::HilbertRTree>&>(*nSearch);
+        NSWrapperType<tree::HilbertRTree>& typedSearch =
+            dynamic_cast<NSWrapperType<tree::HilbertRTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_PLUS_TREE:
       {
-        NSWrapper<SortPolicy, tree::RPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RPlusTree>&>(*nSearch);
+        NSWrapperType<tree::RPlusTree>& typedSearch =
+            dynamic_cast<NSWrapperType<tree::RPlusTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_PLUS_PLUS_TREE:
       {
-        NSWrapper<SortPolicy, tree::RPlusPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RPlusPlusTree>&>(*nSearch);
+        NSWrapperType<tree::RPlusPlusTree>& typedSearch =
+            dynamic_cast<NSWrapperType<tree::RPlusPlusTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case SPILL_TREE:
       {
-        SpillNSWrapper<SortPolicy>& typedSearch =
-            dynamic_cast<SpillNSWrapper<SortPolicy>&>(*nSearch);
+        SpillNSWrapper<SortPolicy, MatType>& typedSearch =
+            dynamic_cast<SpillNSWrapper<SortPolicy, MatType>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case VP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::VPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, tree::VPTree>&>(*nSearch);
+        LeafSizeNSWrapperType<tree::VPTree>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapperType<tree::VPTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case RP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::RPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, tree::RPTree>&>(*nSearch);
+        LeafSizeNSWrapperType<tree::RPTree>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapperType<tree::RPTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case MAX_RP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::MaxRPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, tree::MaxRPTree>&>(
-            *nSearch);
+        LeafSizeNSWrapperType<tree::MaxRPTree>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapperType<tree::MaxRPTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case UB_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::UBTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, tree::UBTree>&>(*nSearch);
+        LeafSizeNSWrapperType<tree::UBTree>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapperType<tree::UBTree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case OCTREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::Octree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy,
-                                           tree::Octree>&>(*nSearch);
+        LeafSizeNSWrapperType<tree::Octree>& typedSearch =
+            dynamic_cast<LeafSizeNSWrapperType<tree::Octree>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
@@ -471,42 +515,43 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
 }
 
 //! Expose the dataset.
-template<typename SortPolicy>
-const arma::mat& NSModel<SortPolicy>::Dataset() const
+template<typename SortPolicy, typename MatType>
+const MatType& NSModel<SortPolicy, MatType>::Dataset() const
 {
   return nSearch->Dataset();
 }
 
 //! Access the search mode.
-template<typename SortPolicy>
-NeighborSearchMode NSModel<SortPolicy>::SearchMode() const
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode NSModel<SortPolicy, MatType>::SearchMode() const
 {
   return nSearch->SearchMode();
 }
 
 //! Modify the search mode.
-template<typename SortPolicy>
-NeighborSearchMode& NSModel<SortPolicy>::SearchMode()
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode& NSModel<SortPolicy, MatType>::SearchMode()
 {
   return nSearch->SearchMode();
 }
 
-template<typename SortPolicy>
-double NSModel<SortPolicy>::Epsilon() const
+template<typename SortPolicy, typename MatType>
+double NSModel<SortPolicy, MatType>::Epsilon() const
 {
   return nSearch->Epsilon();
 }
 
-template<typename SortPolicy>
-double& NSModel<SortPolicy>::Epsilon()
+template<typename SortPolicy, typename MatType>
+double& NSModel<SortPolicy, MatType>::Epsilon()
 {
   return nSearch->Epsilon();
 }
 
 //! Initialize a model given the tree type.  (No training happens here.)
-template<typename SortPolicy>
-void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
-                                          const double epsilon)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::InitializeModel(
+    const NeighborSearchMode searchMode,
+    const double epsilon)
 {
   // Clear existing memory.
   if (nSearch)
@@ -515,69 +560,60 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
   switch (treeType)
   {
     case KD_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::KDTree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapperType<tree::KDTree>(searchMode, epsilon);
       break;
     case COVER_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::StandardCoverTree>(searchMode,
-          epsilon);
+      nSearch = new NSWrapperType<tree::StandardCoverTree>(searchMode, epsilon);
       break;
     case R_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RTree>(searchMode, epsilon);
+      nSearch = new NSWrapperType<tree::RTree>(searchMode, epsilon);
       break;
     case R_STAR_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RStarTree>(searchMode, epsilon);
+      nSearch = new NSWrapperType<tree::RStarTree>(searchMode, epsilon);
       break;
     case BALL_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::BallTree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapperType<tree::BallTree>(searchMode, epsilon);
       break;
     case X_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::XTree>(searchMode, epsilon);
+      nSearch = new NSWrapperType<tree::XTree>(searchMode, epsilon);
       break;
     case HILBERT_R_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::HilbertRTree>(searchMode,
-          epsilon);
+      nSearch = new NSWrapperType<tree::HilbertRTree>(searchMode, epsilon);
       break;
     case R_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RPlusTree>(searchMode, epsilon);
+      nSearch = new NSWrapperType<tree::RPlusTree>(searchMode, epsilon);
       break;
     case R_PLUS_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RPlusPlusTree>(searchMode,
-          epsilon);
+      nSearch = new NSWrapperType<tree::RPlusPlusTree>(searchMode, epsilon);
+      break;
+    case SPILL_TREE:
+      nSearch = new SpillNSWrapper<SortPolicy, MatType>(searchMode, epsilon);
       break;
     case VP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::VPTree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapperType<tree::VPTree>(searchMode, epsilon);
       break;
     case RP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::RPTree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapperType<tree::RPTree>(searchMode, epsilon);
       break;
     case MAX_RP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::MaxRPTree>(searchMode,
-          epsilon);
-      break;
-    case SPILL_TREE:
-      nSearch = new SpillNSWrapper<SortPolicy>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapperType<tree::MaxRPTree>(searchMode, epsilon);
       break;
     case UB_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::UBTree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapperType<tree::UBTree>(searchMode, epsilon);
       break;
     case OCTREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::Octree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapperType<tree::Octree>(searchMode, epsilon);
       break;
   }
 }
 
 //! Build the reference tree.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
-                                     arma::mat&& referenceSet,
-                                     const NeighborSearchMode searchMode,
-                                     const double epsilon)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::BuildModel(
+    util::Timers& timers,
+    MatType&& referenceSet,
+    const NeighborSearchMode searchMode,
+    const double epsilon)
 {
   // Initialize random basis if necessary.
   if (randomBasis)
@@ -588,11 +624,11 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
     {
       // [Q, R] = qr(randn(d, d));
       // Q = Q * diag(sign(diag(R)));
-      arma::mat r;
-      if (arma::qr(q, r, arma::randn<arma::mat>(referenceSet.n_rows,
+      MatType r;
+      if (arma::qr(q, r, arma::randn<MatType>(referenceSet.n_rows,
               referenceSet.n_rows)))
       {
-        arma::vec rDiag(r.n_rows);
+        arma::Col<typename MatType::elem_type> rDiag(r.n_rows);
         for (size_t i = 0; i < rDiag.n_elem; ++i)
         {
           if (r(i, i) < 0)
@@ -626,12 +662,12 @@ void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
 }
 
 //! Perform neighbor search.  The query set will be reordered.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(util::Timers& timers,
-                                 arma::mat&& querySet,
-                                 const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(util::Timers& timers,
+                                          MatType&& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances)
 {
   // We may need to map the query set randomly.
   if (randomBasis)
@@ -665,11 +701,11 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
 }
 
 //! Perform neighbor search.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(util::Timers& timers,
-                                 const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(util::Timers& timers,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances)
 {
   Log::Info << "Searching for " << k << " neighbors with ";
 
@@ -697,9 +733,39 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
   nSearch->Search(timers, k, neighbors, distances);
 }
 
+//! Insert points into the reference set.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Insert(util::Timers& timers,
+                                          MatType&& points)
+{
+  // The new points must be projected onto the same basis as the others.
+  if (randomBasis)
+  {
+    timers.Start("applying_random_basis");
+    points = q * points;
+    timers.Stop("applying_random_basis");
+  }
+
+  Log::Info << "Inserting " << points.n_cols << " points into the "
+      << TreeName() << "..." << std::endl;
+
+  nSearch->Insert(timers, std::move(points));
+}
+
+//! Delete points from the reference set.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Delete(util::Timers& timers,
+                                          const arma::Col<size_t>& indices)
+{
+  Log::Info << "Deleting " << indices.n_elem << " points from the "
+      << TreeName() << "..." << std::endl;
+
+  nSearch->Delete(timers, indices);
+}
+
 //! Get the name of the tree type.
-template<typename SortPolicy>
-std::string NSModel<SortPolicy>::TreeName() const
+template<typename SortPolicy, typename MatType>
+std::string NSModel<SortPolicy, MatType>::TreeName() const
 {
   switch (treeType)
   {
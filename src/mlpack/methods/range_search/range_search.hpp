@@ -24,7 +24,8 @@ namespace range /** Range-search routines. */ {
 //! Forward declaration.
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         typename MatType>
 class LeafSizeRSWrapper;
 
 /**
@@ -319,7 +320,7 @@ class RangeSearch
   size_t scores;
 
   //! For access to mappings when building models.
-  friend class LeafSizeRSWrapper<TreeType>;
+  friend class LeafSizeRSWrapper<TreeType, MatType>;
 };
 
 } // namespace range
@@ -108,7 +108,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
   // Build the tree on the empty dataset, if necessary.
   if (!naive)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
     treeOwner = true;
@@ -154,7 +154,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
 {
   // Clear other object.
   other.referenceTree =
-      BuildTree<Tree>(std::move(arma::mat()), other.oldFromNewReferences);
+      BuildTree<Tree>(std::move(MatType()), other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.treeOwner = true;
   other.naive = false;
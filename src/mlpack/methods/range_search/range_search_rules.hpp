@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/base_case_block.hpp>
 
 namespace mlpack {
 namespace range {
@@ -41,8 +42,8 @@ class RangeSearchRules
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
    */
-  RangeSearchRules(const arma::mat& referenceSet,
-                   const arma::mat& querySet,
+  RangeSearchRules(const typename TreeType::Mat& referenceSet,
+                   const typename TreeType::Mat& querySet,
                    const math::Range& range,
                    std::vector<std::vector<size_t> >& neighbors,
                    std::vector<std::vector<double> >& distances,
@@ -57,6 +58,23 @@ class RangeSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the distances between the query points [queryBegin, queryBegin +
+   * queryCount) and the reference points [referenceBegin, referenceBegin +
+   * referenceCount) at once, so that BaseCase() does not need to evaluate the
+   * metric for those pairs.  This is called by traversals whose leaves hold
+   * contiguous points.
+   *
+   * @param queryBegin Index of the first query point.
+   * @param queryCount Number of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void PrepareBaseCases(const size_t queryBegin,
+                        const size_t queryCount,
+                        const size_t referenceBegin,
+                        const size_t referenceCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -123,10 +141,10 @@ class RangeSearchRules
 
  private:
   //! The reference set.
-  const arma::mat& referenceSet;
+  const typename TreeType::Mat& referenceSet;
 
   //! The query set.
-  const arma::mat& querySet;
+  const typename TreeType::Mat& querySet;
 
   //! The range of distances for which we are searching.
   const math::Range& range;
@@ -148,6 +166,9 @@ class RangeSearchRules
   //! The last reference index.
   size_t lastReferenceIndex;
 
+  //! Distances between the points of the current pair of leaves.
+  tree::BaseCaseBlock<MetricType, typename TreeType::Mat> block;
+
   //! Add all the points in the given node to the results for the given query
   //! point.  If the base case has already been calculated, we make sure to not
   //! add that to the results twice.
@@ -20,8 +20,8 @@ namespace range {
 
 template<typename MetricType, typename TreeType>
 RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
-    const arma::mat& referenceSet,
-    const arma::mat& querySet,
+    const typename TreeType::Mat& referenceSet,
+    const typename TreeType::Mat& querySet,
     const math::Range& range,
     std::vector<std::vector<size_t> >& neighbors,
     std::vector<std::vector<double> >& distances,
@@ -58,8 +58,12 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return 0.0; // No value to return... this shouldn't do anything bad.
 
-  const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
-      referenceSet.unsafe_col(referenceIndex));
+  double distance;
+  if (!block.Distance(queryIndex, referenceIndex, distance))
+  {
+    distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
+        referenceSet.unsafe_col(referenceIndex));
+  }
   ++baseCases;
 
   // Update last indices, so we don't accidentally perform a base case twice.
@@ -75,6 +79,17 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename MetricType, typename TreeType>
+void RangeSearchRules<MetricType, TreeType>::PrepareBaseCases(
+    const size_t queryBegin,
+    const size_t queryCount,
+    const size_t referenceBegin,
+    const size_t referenceCount)
+{
+  block.Compute(querySet, queryBegin, queryCount, referenceSet, referenceBegin,
+      referenceCount);
+}
+
 //! Single-tree scoring function.
 template<typename MetricType, typename TreeType>
 double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
@@ -30,7 +30,10 @@ namespace range {
  * supported by RSModel.  All RangeSearch type wrappers inherit from this class,
  * allowing a simple interface via inheritance for all the different types we
  * want to support.
+ *
+ * @tparam MatType Type of data held by the wrapped RangeSearch object.
  */
+template<typename MatType>
 class RSWrapperBase
 {
  public:
@@ -46,7 +49,7 @@ class RSWrapperBase
   virtual ~RSWrapperBase() { }
 
   //! Get the dataset.
-  virtual const arma::mat& Dataset() const = 0;
+  virtual const MatType& Dataset() const = 0;
 
   //! Get whether single-tree search is being used.
   virtual bool SingleMode() const = 0;
@@ -60,13 +63,13 @@ class RSWrapperBase
 
   //! Train the model (build the reference tree if needed).
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize) = 0;
 
   //! Perform bichromatic range search (i.e. a search with a separate query
   //! set).
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const math::Range& range,
                       std::vector<std::vector<size_t>>& neighbors,
                       std::vector<std::vector<double>>& distances,
@@ -85,8 +88,9 @@ class RSWrapperBase
  */
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-class RSWrapper : public RSWrapperBase
+                  typename TreeMatType> class TreeType,
+         typename MatType = arma::mat>
+class RSWrapper : public RSWrapperBase<MatType>
 {
  public:
   //! Create the RSWrapper object.
@@ -104,7 +108,7 @@ class RSWrapper : public RSWrapperBase
   virtual ~RSWrapper() { }
 
   //! Get the dataset.
-  const arma::mat& Dataset() const { return rs.ReferenceSet(); }
+  const MatType& Dataset() const { return rs.ReferenceSet(); }
 
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return rs.SingleMode(); }
@@ -119,13 +123,13 @@ class RSWrapper : public RSWrapperBase
   //! Train the model (build the reference tree if needed).  This ignores the
   //! leaf size.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t /* leafSize */);
 
   //! Perform bichromatic range search (i.e. a search with a separate query
   //! set).  This ignores the leaf size.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const math::Range& range,
                       std::vector<std::vector<size_t>>& neighbors,
                       std::vector<std::vector<double>>& distances,
@@ -146,7 +150,7 @@ class RSWrapper : public RSWrapperBase
   }
 
  protected:
-  typedef RangeSearch<metric::EuclideanDistance, arma::mat, TreeType> RSType;
+  typedef RangeSearch<metric::EuclideanDistance, MatType, TreeType> RSType;
 
   //! The instantiated RangeSearch object that we are wrapping.
   RSType rs;
@@ -159,14 +163,15 @@ class RSWrapper : public RSWrapperBase
  */
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-class LeafSizeRSWrapper : public RSWrapper<TreeType>
+                  typename TreeMatType> class TreeType,
+         typename MatType = arma::mat>
+class LeafSizeRSWrapper : public RSWrapper<TreeType, MatType>
 {
  public:
   //! Construct the LeafSizeRSWrapper by delegating to the RSWrapper
   //! constructor.
   LeafSizeRSWrapper(const bool singleMode, const bool naive) :
-      RSWrapper<TreeType>(singleMode, naive)
+      RSWrapper<TreeType, MatType>(singleMode, naive)
   {
     // Nothing else to do.
   }
@@ -182,13 +187,13 @@ class LeafSizeRSWrapper : public RSWrapper<TreeType>
 
   //! Train a model with the given parameters.  This overload uses leafSize.
   virtual void Train(util::Timers& timers,
-                     arma::mat&& referenceSet,
+                     MatType&& referenceSet,
                      const size_t leafSize);
 
   //! Perform bichromatic search (e.g. search with a separate query set).  This
   //! overload takes the leaf size into account when building the query tree.
   virtual void Search(util::Timers& timers,
-                      arma::mat&& querySet,
+                      MatType&& querySet,
                       const math::Range& range,
                       std::vector<std::vector<size_t>>& neighbors,
                       std::vector<std::vector<double>>& distances,
@@ -202,7 +207,7 @@ class LeafSizeRSWrapper : public RSWrapper<TreeType>
   }
 
  protected:
-  using RSWrapper<TreeType>::rs;
+  using RSWrapper<TreeType, MatType>::rs;
 };
 
 /**
@@ -210,8 +215,15 @@ class LeafSizeRSWrapper : public RSWrapper<TreeType>
  * abstracting away the TreeType parameter and allowing it to be specified at
  * runtime.  This class is written for the sake of the `range_search` binding,
  * but is not necessarily restricted to that usage.
+ *
+ * The model can hold either double-precision (arma::mat) or single-precision
+ * (arma::fmat) data; the RSModel typedef below is the double-precision model
+ * used by the binding.  Distances are always returned in double precision.
+ *
+ * @tparam MatType Type of data to search; arma::mat or arma::fmat.
  */
-class RSModel
+template<typename MatType = arma::mat>
+class RSModelType
 {
  public:
   enum TreeTypes
@@ -239,48 +251,48 @@ class RSModel
    * @param treeType Type of tree to use.
    * @param randomBasis Whether or not to use a random basis.
    */
-  RSModel(const TreeTypes treeType = TreeTypes::KD_TREE,
-          const bool randomBasis = false);
+  RSModelType(const TreeTypes treeType = TreeTypes::KD_TREE,
+              const bool randomBasis = false);
 
   /**
    * Copy the given RSModel.
    *
    * @param other RSModel to copy.
    */
-  RSModel(const RSModel& other);
+  RSModelType(const RSModelType& other);
 
   /**
    * Take ownership of the given RSModel.
    *
    * @param other RSModel to take ownership of.
    */
-  RSModel(RSModel&& other);
+  RSModelType(RSModelType&& other);
 
   /**
    * Copy the given RSModel.
    *
    * @param other RSModel to copy.
    */
-  RSModel& operator=(const RSModel& other);
+  RSModelType& operator=(const RSModelType& other);
 
   /**
    * Take ownership of the given RSModel's data.
    *
    * @param other RSModel to copy.
    */
-  RSModel& operator=(RSModel&& other);
+  RSModelType& operator=(RSModelType&& other);
 
   /**
    * Clean memory, if necessary.
    */
-  ~RSModel();
+  ~RSModelType();
 
   //! Serialize the range search model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
 
   //! Expose the dataset.
-  const arma::mat& Dataset() const { return rSearch->Dataset(); }
+  const MatType& Dataset() const { return rSearch->Dataset(); }
 
   //! Get whether the model is in single-tree search mode.
   bool SingleMode() const { return rSearch->SingleMode(); }
@@ -323,7 +335,7 @@ class RSModel
    * @param singleMode Whether single-tree search should be used.
    */
   void BuildModel(util::Timers& timers,
-                  arma::mat&& referenceSet,
+                  MatType&& referenceSet,
                   const size_t leafSize,
                   const bool naive,
                   const bool singleMode);
@@ -339,7 +351,7 @@ class RSModel
    * @param distances Output: distances of neighbors.
    */
   void Search(util::Timers& timers,
-              arma::mat&& querySet,
+              MatType&& querySet,
               const math::Range& range,
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
@@ -368,13 +380,13 @@ class RSModel
   //! If true, we randomly project the data into a new basis before search.
   bool randomBasis;
   //! Random projection matrix.
-  arma::mat q;
+  MatType q;
 
   /**
    * rSearch holds an instance of the RangeSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
    */
-  RSWrapperBase* rSearch;
+  RSWrapperBase<MatType>* rSearch;
 
   /**
    * Return a string representing the name of the tree.  This is used for
@@ -388,10 +400,13 @@ class RSModel
   void CleanMemory();
 };
 
+//! The double-precision range search model used by the binding.
+typedef RSModelType<arma::mat> RSModel;
+
 } // namespace range
 } // namespace mlpack
 
-// Include implementation (of serialize() and templated wrapper classes).
+// Include implementation.
 #include "rs_model_impl.hpp"
 
 #endif
@@ -2,7 +2,7 @@
  * @file methods/range_search/rs_model_impl.hpp
  * @author Ryan Curtin
  *
- * Implementation of serialize() and inline functions for RSModel.
+ * Implementation of RSModelType and the RangeSearch wrapper classes.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -22,10 +22,11 @@ namespace range {
 
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RSWrapper<TreeType>::Train(util::Timers& timers,
-                                arma::mat&& referenceSet,
-                                const size_t /* leafSize */)
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void RSWrapper<TreeType, MatType>::Train(util::Timers& timers,
+                                         MatType&& referenceSet,
+                                         const size_t /* leafSize */)
 {
   if (!Naive())
     timers.Start("tree_building");
@@ -37,13 +38,15 @@ void RSWrapper<TreeType>::Train(util::Timers& timers,
 
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RSWrapper<TreeType>::Search(util::Timers& timers,
-                                 arma::mat&& querySet,
-                                 const math::Range& range,
-                                 std::vector<std::vector<size_t>>& neighbors,
-                                 std::vector<std::vector<double>>& distances,
-                                 const size_t /* leafSize */)
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void RSWrapper<TreeType, MatType>::Search(
+    util::Timers& timers,
+    MatType&& querySet,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances,
+    const size_t /* leafSize */)
 {
   if (!Naive() && !SingleMode())
   {
@@ -66,11 +69,13 @@ void RSWrapper<TreeType>::Search(util::Timers& timers,
 
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RSWrapper<TreeType>::Search(util::Timers& timers,
-                                 const math::Range& range,
-                                 std::vector<std::vector<size_t>>& neighbors,
-                                 std::vector<std::vector<double>>& distances)
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void RSWrapper<TreeType, MatType>::Search(
+    util::Timers& timers,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
 {
   timers.Start("computing_neighbors");
   rs.Search(range, neighbors, distances);
@@ -79,10 +84,11 @@ void RSWrapper<TreeType>::Search(util::Timers& timers,
 
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void LeafSizeRSWrapper<TreeType>::Train(util::Timers& timers,
-                                        arma::mat&& referenceSet,
-                                        const size_t leafSize)
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void LeafSizeRSWrapper<TreeType, MatType>::Train(util::Timers& timers,
+                                                 MatType&& referenceSet,
+                                                 const size_t leafSize)
 {
   if (rs.Naive())
   {
@@ -107,10 +113,11 @@ void LeafSizeRSWrapper<TreeType>::Train(util::Timers& timers,
 
 template<template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void LeafSizeRSWrapper<TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         typename MatType>
+void LeafSizeRSWrapper<TreeType, MatType>::Search(
     util::Timers& timers,
-    arma::mat&& querySet,
+    MatType&& querySet,
     const math::Range& range,
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<double>>& distances,
@@ -152,8 +159,9 @@ void LeafSizeRSWrapper<TreeType>::Search(
 }
 
 // Serialize the model.
+template<typename MatType>
 template<typename Archive>
-void RSModel::serialize(Archive& ar, const uint32_t /* version */)
+void RSModelType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(randomBasis));
@@ -168,114 +176,405 @@ void RSModel::serialize(Archive& ar, const uint32_t /* version */)
   {
     case KD_TREE:
       {
-        LeafSizeRSWrapper<tree::KDTree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<tree::KDTree>&>(*rSearch);
+        LeafSizeRSWrapper<tree::KDTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeRSWrapper<tree::KDTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case COVER_TREE:
       {
-        RSWrapper<tree::StandardCoverTree>& typedSearch =
-            dynamic_cast<RSWrapper<tree::StandardCoverTree>&>(*rSearch);
+        RSWrapper<tree::StandardCoverTree, MatType>& typedSearch =
+            dynamic_cast<RSWrapper<tree::StandardCoverTree, MatType>&>(
+            *rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case R_TREE:
       {
-        RSWrapper<tree::RTree>& typedSearch =
-            dynamic_cast<RSWrapper<tree::RTree>&>(*rSearch);
+        RSWrapper<tree::RTree, MatType>& typedSearch =
+            dynamic_cast<RSWrapper<tree::RTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case R_STAR_TREE:
       {
-        RSWrapper<tree::RStarTree>& typedSearch =
-            dynamic_cast<RSWrapper<tree::RStarTree>&>(*rSearch);
+        RSWrapper<tree::RStarTree, MatType>& typedSearch =
+            dynamic_cast<RSWrapper<tree::RStarTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case BALL_TREE:
       {
-        LeafSizeRSWrapper<tree::BallTree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<tree::BallTree>&>(*rSearch);
+        LeafSizeRSWrapper<tree::BallTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeRSWrapper<tree::BallTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case X_TREE:
       {
-        RSWrapper<tree::XTree>& typedSearch =
-            dynamic_cast<RSWrapper<tree::XTree>&>(*rSearch);
+        RSWrapper<tree::XTree, MatType>& typedSearch =
+            dynamic_cast<RSWrapper<tree::XTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case HILBERT_R_TREE:
       {
-        RSWrapper<tree::HilbertRTree>& typedSearch =
-            dynamic_cast<RSWrapper<tree::HilbertRTree>&>(*rSearch);
+        RSWrapper<tree::HilbertRTree, MatType>& typedSearch =
+            dynamic_cast<RSWrapper<tree::HilbertRTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case R_PLUS_TREE:
       {
-        RSWrapper<tree::RPlusTree>& typedSearch =
-            dynamic_cast<RSWrapper<tree::RPlusTree>&>(*rSearch);
+        RSWrapper<tree::RPlusTree, MatType>& typedSearch =
+            dynamic_cast<RSWrapper<tree::RPlusTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case R_PLUS_PLUS_TREE:
       {
-        RSWrapper<tree::RPlusPlusTree>& typedSearch =
-            dynamic_cast<RSWrapper<tree::RPlusPlusTree>&>(*rSearch);
+        RSWrapper<tree::RPlusPlusTree, MatType>& typedSearch =
+            dynamic_cast<RSWrapper<tree::RPlusPlusTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case VP_TREE:
       {
-        LeafSizeRSWrapper<tree::VPTree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<tree::VPTree>&>(*rSearch);
+        LeafSizeRSWrapper<tree::VPTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeRSWrapper<tree::VPTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case RP_TREE:
       {
-        LeafSizeRSWrapper<tree::RPTree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<tree::RPTree>&>(*rSearch);
+        LeafSizeRSWrapper<tree::RPTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeRSWrapper<tree::RPTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
 
     case MAX_RP_TREE:
       {
-        LeafSizeRSWrapper<tree::MaxRPTree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<tree::MaxRPTree>&>(*rSearch);
+        LeafSizeRSWrapper<tree::MaxRPTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeRSWrapper<tree::MaxRPTree, MatType>&>(
+            *rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case UB_TREE:
       {
-        LeafSizeRSWrapper<tree::UBTree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<tree::UBTree>&>(*rSearch);
+        LeafSizeRSWrapper<tree::UBTree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeRSWrapper<tree::UBTree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case OCTREE:
       {
-        LeafSizeRSWrapper<tree::Octree>& typedSearch =
-            dynamic_cast<LeafSizeRSWrapper<tree::Octree>&>(*rSearch);
+        LeafSizeRSWrapper<tree::Octree, MatType>& typedSearch =
+            dynamic_cast<LeafSizeRSWrapper<tree::Octree, MatType>&>(*rSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
   }
 }
 
+/**
+ * Initialize the RSModel with the given tree type and whether or not a random
+ * basis should be used.
+ */
+template<typename MatType>
+RSModelType<MatType>::RSModelType(TreeTypes treeType, bool randomBasis) :
+    treeType(treeType),
+    leafSize(0),
+    randomBasis(randomBasis),
+    rSearch(NULL)
+{
+  // Nothing to do.
+}
+
+// Copy constructor.
+template<typename MatType>
+RSModelType<MatType>::RSModelType(const RSModelType& other) :
+    treeType(other.treeType),
+    leafSize(other.leafSize),
+    randomBasis(other.randomBasis),
+    q(other.q),
+    rSearch(other.rSearch->Clone())
+{
+  // Nothing to do.
+}
+
+// Move constructor.
+template<typename MatType>
+RSModelType<MatType>::RSModelType(RSModelType&& other) :
+    treeType(other.treeType),
+    leafSize(other.leafSize),
+    randomBasis(other.randomBasis),
+    q(std::move(other.q)),
+    rSearch(std::move(other.rSearch))
+{
+  // Reset other model.
+  other.treeType = TreeTypes::KD_TREE;
+  other.leafSize = 0;
+  other.randomBasis = false;
+  other.rSearch = NULL;
+}
+
+// Copy operator.
+template<typename MatType>
+RSModelType<MatType>& RSModelType<MatType>::operator=(const RSModelType& other)
+{
+  if (this != &other)
+  {
+    delete rSearch;
+
+    treeType = other.treeType;
+    leafSize = other.leafSize;
+    randomBasis = other.randomBasis;
+    q = other.q;
+    rSearch = other.rSearch->Clone();
+  }
+
+  return *this;
+}
+
+// Move operator.
+template<typename MatType>
+RSModelType<MatType>& RSModelType<MatType>::operator=(RSModelType&& other)
+{
+  if (this != &other)
+  {
+    delete rSearch;
+
+    treeType = other.treeType;
+    leafSize = other.leafSize;
+    randomBasis = other.randomBasis;
+    q = std::move(other.q);
+    rSearch = std::move(other.rSearch);
+
+    other.treeType = TreeTypes::KD_TREE;
+    other.leafSize = 0;
+    other.randomBasis = false;
+    other.rSearch = NULL;
+  }
+
+  return *this;
+}
+
+// Clean memory, if necessary.
+template<typename MatType>
+RSModelType<MatType>::~RSModelType()
+{
+  delete rSearch;
+}
+
+template<typename MatType>
+void RSModelType<MatType>::InitializeModel(const bool naive,
+                                           const bool singleMode)
+{
+  // Clean memory, if necessary.
+  delete rSearch;
+
+  switch (treeType)
+  {
+    case KD_TREE:
+      rSearch = new LeafSizeRSWrapper<tree::KDTree, MatType>(naive, singleMode);
+      break;
+
+    case COVER_TREE:
+      rSearch = new RSWrapper<tree::StandardCoverTree, MatType>(naive,
+          singleMode);
+      break;
+
+    case R_TREE:
+      rSearch = new RSWrapper<tree::RTree, MatType>(naive, singleMode);
+      break;
+
+    case R_STAR_TREE:
+      rSearch = new RSWrapper<tree::RStarTree, MatType>(naive, singleMode);
+      break;
+
+    case BALL_TREE:
+      rSearch = new LeafSizeRSWrapper<tree::BallTree, MatType>(naive,
+          singleMode);
+      break;
+
+    case X_TREE:
+      rSearch = new RSWrapper<tree::XTree, MatType>(naive, singleMode);
+      break;
+
+    case HILBERT_R_TREE:
+      rSearch = new RSWrapper<tree::HilbertRTree, MatType>(naive, singleMode);
+      break;
+
+    case R_PLUS_TREE:
+      rSearch = new RSWrapper<tree::RPlusTree, MatType>(naive, singleMode);
+      break;
+
+    case R_PLUS_PLUS_TREE:
+      rSearch = new RSWrapper<tree::RPlusPlusTree, MatType>(naive, singleMode);
+      break;
+
+    case VP_TREE:
+      rSearch = new LeafSizeRSWrapper<tree::VPTree, MatType>(naive, singleMode);
+      break;
+
+    case RP_TREE:
+      rSearch = new LeafSizeRSWrapper<tree::RPTree, MatType>(naive, singleMode);
+      break;
+
+    case MAX_RP_TREE:
+      rSearch = new LeafSizeRSWrapper<tree::MaxRPTree, MatType>(naive,
+          singleMode);
+      break;
+
+    case UB_TREE:
+      rSearch = new LeafSizeRSWrapper<tree::UBTree, MatType>(naive, singleMode);
+      break;
+
+    case OCTREE:
+      rSearch = new LeafSizeRSWrapper<tree::Octree, MatType>(naive, singleMode);
+      break;
+  }
+}
+
+template<typename MatType>
+void RSModelType<MatType>::BuildModel(util::Timers& timers,
+                                      MatType&& referenceSet,
+                                      const size_t leafSize,
+                                      const bool naive,
+                                      const bool singleMode)
+{
+  // Initialize random basis if necessary.
+  if (randomBasis)
+  {
+    timers.Start("computing_random_basis");
+    Log::Info << "Creating random basis..." << std::endl;
+    arma::mat basis;
+    math::RandomBasis(basis, referenceSet.n_rows);
+    q = arma::conv_to<MatType>::from(basis);
+
+    // Do we need to modify the reference set?
+    if (randomBasis)
+      referenceSet = q * referenceSet;
+    timers.Stop("computing_random_basis");
+  }
+
+  this->leafSize = leafSize;
+
+  if (!naive)
+    Log::Info << "Building reference tree..." << std::endl;
+
+  InitializeModel(naive, singleMode);
+
+  rSearch->Train(timers, std::move(referenceSet), leafSize);
+
+  if (!naive)
+    Log::Info << "Tree built." << std::endl;
+}
+
+// Perform range search.
+template<typename MatType>
+void RSModelType<MatType>::Search(util::Timers& timers,
+                                  MatType&& querySet,
+                                  const math::Range& range,
+                                  std::vector<std::vector<size_t>>& neighbors,
+                                  std::vector<std::vector<double>>& distances)
+{
+  // We may need to map the query set randomly.
+  if (randomBasis)
+  {
+    timers.Start("applying_random_basis");
+    querySet = q * querySet;
+    timers.Stop("applying_random_basis");
+  }
+
+  Log::Info << "Search for points in the range [" << range.Lo() << ", "
+      << range.Hi() << "] with ";
+  if (!Naive() && !SingleMode())
+    Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
+  else if (!Naive())
+    Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
+  else
+    Log::Info << "brute-force (naive) search..." << std::endl;
+
+  rSearch->Search(timers, std::move(querySet), range, neighbors, distances,
+      leafSize);
+}
+
+// Perform range search (monochromatic case).
+template<typename MatType>
+void RSModelType<MatType>::Search(util::Timers& timers,
+                                  const math::Range& range,
+                                  std::vector<std::vector<size_t>>& neighbors,
+                                  std::vector<std::vector<double>>& distances)
+{
+  Log::Info << "Search for points in the range [" << range.Lo() << ", "
+      << range.Hi() << "] with ";
+  if (!Naive() && !SingleMode())
+    Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
+  else if (!Naive())
+    Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
+  else
+    Log::Info << "brute-force (naive) search..." << std::endl;
+
+  rSearch->Search(timers, range, neighbors, distances);
+}
+
+// Get the name of the tree type.
+template<typename MatType>
+std::string RSModelType<MatType>::TreeName() const
+{
+  switch (treeType)
+  {
+    case KD_TREE:
+      return "kd-tree";
+    case COVER_TREE:
+      return "cover tree";
+    case R_TREE:
+      return "R tree";
+    case R_STAR_TREE:
+      return "R* tree";
+    case BALL_TREE:
+      return "ball tree";
+    case X_TREE:
+      return "X tree";
+    case HILBERT_R_TREE:
+      return "Hilbert R tree";
+    case R_PLUS_TREE:
+      return "R+ tree";
+    case R_PLUS_PLUS_TREE:
+      return "R++ tree";
+    case VP_TREE:
+      return "vantage point tree";
+    case RP_TREE:
+      return "random projection tree (mean split)";
+    case MAX_RP_TREE:
+      return "random projection tree (max split)";
+    case UB_TREE:
+      return "UB tree";
+    case OCTREE:
+      return "octree";
+    default:
+      return "unknown tree";
+  }
+}
+
+// Clean memory.
+template<typename MatType>
+void RSModelType<MatType>::CleanMemory()
+{
+  delete rSearch;
+}
+
 } // namespace range
 } // namespace mlpack
 
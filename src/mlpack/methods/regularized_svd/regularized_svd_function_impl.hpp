@@ -150,6 +150,85 @@ void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void RegularizedSVDFunction<MatType>::UpdateRating(
+    arma::mat& parameters,
+    const size_t i,
+    const double stepSize,
+    arma::mat& /* sharedUpdate */) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, i);
+  const size_t item = data(1, i) + numUsers;
+  double* userVec = parameters.colptr(user);
+  double* itemVec = parameters.colptr(item);
+
+  // Prediction error for the example.
+  double ratingError = data(2, i);
+  for (size_t k = 0; k < rank; ++k)
+    ratingError -= userVec[k] * itemVec[k];
+
+  // Both columns are updated with the old values of the other one, as in
+  // Gradient().
+  for (size_t k = 0; k < rank; ++k)
+  {
+    const double userValue = userVec[k];
+    const double itemValue = itemVec[k];
+    userVec[k] -= 2 * stepSize * (lambda * userValue - ratingError * itemValue);
+    itemVec[k] -= 2 * stepSize * (lambda * itemValue - ratingError * userValue);
+  }
+}
+
+template <typename MatType>
+void RegularizedSVDFunction<MatType>::SparseGradient(
+    const arma::mat& parameters,
+    const size_t start,
+    arma::uvec& columns,
+    arma::mat& deltas,
+    const size_t batchSize) const
+{
+  columns.set_size(2 * batchSize);
+  deltas.set_size(rank, 2 * batchSize);
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t user = data(0, start + i);
+    const size_t item = data(1, start + i) + numUsers;
+    const double* userVec = parameters.colptr(user);
+    const double* itemVec = parameters.colptr(item);
+
+    // Prediction error for the example.
+    double ratingError = data(2, start + i);
+    for (size_t k = 0; k < rank; ++k)
+      ratingError -= userVec[k] * itemVec[k];
+
+    // The same terms as in Gradient().
+    columns[2 * i] = user;
+    columns[2 * i + 1] = item;
+    double* userDelta = deltas.colptr(2 * i);
+    double* itemDelta = deltas.colptr(2 * i + 1);
+    for (size_t k = 0; k < rank; ++k)
+    {
+      userDelta[k] = 2 * (lambda * userVec[k] - ratingError * itemVec[k]);
+      itemDelta[k] = 2 * (lambda * itemVec[k] - ratingError * userVec[k]);
+    }
+  }
+}
+
+template <typename MatType>
+void RegularizedSVDFunction<MatType>::GradientColumns(
+    const size_t start,
+    arma::uvec& columns,
+    const size_t batchSize) const
+{
+  columns.set_size(2 * batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    columns[2 * i] = data(0, start + i);
+    columns[2 * i + 1] = data(1, start + i) + numUsers;
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
 
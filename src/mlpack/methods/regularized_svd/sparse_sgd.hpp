@@ -0,0 +1,163 @@
+/**
+ * @file methods/regularized_svd/sparse_sgd.hpp
+ *
+ * Definition of SparseSGD, an SGD optimizer that only updates the parameter
+ * columns touched by each step, applying L2 weight decay lazily.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_SPARSE_SGD_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_SPARSE_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <ensmallen.hpp>
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * SparseSGD is a mini-batch SGD optimizer for functions whose batch gradients
+ * only touch a few columns of the parameters, such as the user and item
+ * columns of a matrix factorization, or the columns of the nonzero features
+ * of a linear model.  Instead of a dense gradient, the function returns a list
+ * of (column index, delta) pairs, and each step only updates those columns, so
+ * the cost of a step is proportional to the number of touched columns times
+ * the number of rows (the rank of a factorization), and not to the total
+ * number of parameters.
+ *
+ * The function may also have an L2 penalty that adds lambda * parameters to
+ * the gradient of every batch, which would make every step dense.  This weight
+ * decay is applied lazily instead: the optimizer remembers the step at which
+ * each column was last updated, and when a column is touched again, it is
+ * first scaled by (1 - stepSize * lambda) once for every step it missed.  The
+ * result is the same as with dense SGD steps.  At the end of every epoch all
+ * columns are brought up to date.
+ *
+ * The function to be optimized must provide the following methods:
+ *
+ * @code
+ * size_t NumFunctions() const;
+ * void Shuffle();
+ *
+ * // Evaluate the objective on the given batch of points.
+ * double Evaluate(const arma::mat& parameters,
+ *                 const size_t begin,
+ *                 const size_t batchSize) const;
+ *
+ * // Store the gradient of the given batch of points, without the weight
+ * // decay, as pairs: deltas.col(k) is added to column columns[k] of the
+ * // gradient.  A column may appear more than once.
+ * void SparseGradient(const arma::mat& parameters,
+ *                     const size_t begin,
+ *                     arma::uvec& columns,
+ *                     arma::mat& deltas,
+ *                     const size_t batchSize) const;
+ *
+ * // Store the columns that SparseGradient() reads for the given batch of
+ * // points, so they can be brought up to date first.  This is only called if
+ * // WeightDecay() is not zero.
+ * void GradientColumns(const size_t begin,
+ *                      arma::uvec& columns,
+ *                      const size_t batchSize) const;
+ *
+ * // The L2 weight decay lambda; 0 if the function has none.
+ * double WeightDecay() const;
+ * @endcode
+ *
+ * RegularizedSVDFunction, BiasSVDFunction, SVDPlusPlusFunction and
+ * SoftmaxRegressionFunction provide these methods.
+ *
+ * @tparam DecayPolicyType Step size update policy used at the start of every
+ *     epoch (for instance ens::ConstantStep or ens::ExponentialBackoff).
+ */
+template<typename DecayPolicyType = ens::ConstantStep>
+class SparseSGD
+{
+ public:
+  /**
+   * Create the SparseSGD optimizer with the given parameters.
+   *
+   * @param batchSize Number of points in each step.
+   * @param maxIterations Maximum number of epochs (0 means no limit).
+   * @param tolerance Maximum absolute tolerance to terminate the algorithm.
+   * @param shuffle If true, the function is shuffled before every epoch.
+   * @param decayPolicy The step size update policy to use.
+   */
+  SparseSGD(const size_t batchSize = 1,
+            const size_t maxIterations = 100,
+            const double tolerance = 1e-5,
+            const bool shuffle = true,
+            const DecayPolicyType& decayPolicy = DecayPolicyType());
+
+  /**
+   * Optimize the given function with sparse SGD.  The given starting point
+   * will be modified to store the finishing point of the optimization, and the
+   * final objective value is returned.  Callbacks are not supported.
+   *
+   * @param function Function to be optimized.
+   * @param iterate Starting point (will be modified).
+   * @return Objective value at the final point.
+   */
+  template<typename FunctionType, typename... CallbackTypes>
+  double Optimize(FunctionType& function,
+                  arma::mat& iterate,
+                  CallbackTypes&&... /* callbacks */);
+
+  //! Get the number of points in each step.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each step.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the maximum number of epochs (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of epochs (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether or not the function is shuffled before every epoch.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether or not the function is shuffled before every epoch.
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the step size decay policy.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the step size decay policy.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+ private:
+  /**
+   * Apply the weight decay that the given column missed until the given step,
+   * and record that it is up to date.
+   */
+  static void CatchUp(arma::mat& iterate,
+                      std::vector<size_t>& lastStep,
+                      const size_t column,
+                      const size_t step,
+                      const double decay);
+
+  //! The number of points in each step.
+  size_t batchSize;
+  //! The maximum number of allowed epochs.
+  size_t maxIterations;
+  //! The tolerance for termination.
+  double tolerance;
+  //! Controls whether or not the function is shuffled before every epoch.
+  bool shuffle;
+  //! The step size decay policy.
+  DecayPolicyType decayPolicy;
+};
+
+} // namespace svd
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_sgd_impl.hpp"
+
+#endif
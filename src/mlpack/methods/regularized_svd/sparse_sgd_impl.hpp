@@ -0,0 +1,166 @@
+/**
+ * @file methods/regularized_svd/sparse_sgd_impl.hpp
+ *
+ * Implementation of SparseSGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_SPARSE_SGD_IMPL_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_SPARSE_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sparse_sgd.hpp"
+#include <mlpack/methods/logistic_regression/parallel_objective.hpp>
+
+namespace mlpack {
+namespace svd {
+
+template<typename DecayPolicyType>
+SparseSGD<DecayPolicyType>::SparseSGD(
+    const size_t batchSize,
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const DecayPolicyType& decayPolicy) :
+    batchSize(batchSize),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    shuffle(shuffle),
+    decayPolicy(decayPolicy)
+{
+  // Nothing to do.
+}
+
+template<typename DecayPolicyType>
+template<typename FunctionType, typename... CallbackTypes>
+double SparseSGD<DecayPolicyType>::Optimize(
+    FunctionType& function,
+    arma::mat& iterate,
+    CallbackTypes&&... /* callbacks */)
+{
+  static_assert(sizeof...(CallbackTypes) == 0,
+      "SparseSGD does not support callbacks.");
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("SparseSGD::Optimize(): the batch size must "
+        "be positive!");
+  }
+
+  const size_t numFunctions = function.NumFunctions();
+  const double weightDecay = function.WeightDecay();
+
+  // The step at which each column was last brought up to date, counted from
+  // the start of the epoch.
+  std::vector<size_t> lastStep(iterate.n_cols, 0);
+  arma::uvec columns;
+  arma::mat deltas;
+
+  double overallObjective = regression::ParallelObjective(function, iterate);
+  double lastObjective;
+  for (size_t epoch = 1; maxIterations == 0 || epoch <= maxIterations;
+      ++epoch)
+  {
+    // Get the step size for this epoch.
+    const double stepSize = decayPolicy.StepSize(epoch);
+    const double decay = 1.0 - stepSize * weightDecay;
+
+    if (shuffle)
+      function.Shuffle();
+
+    size_t step = 0;
+    for (size_t begin = 0; begin < numFunctions; begin += batchSize, ++step)
+    {
+      const size_t effectiveBatchSize = std::min(batchSize,
+          numFunctions - begin);
+
+      // The columns the gradient reads must hold their current values.
+      if (weightDecay != 0.0)
+      {
+        function.GradientColumns(begin, columns, effectiveBatchSize);
+        for (size_t k = 0; k < columns.n_elem; ++k)
+          CatchUp(iterate, lastStep, columns[k], step, decay);
+      }
+
+      function.SparseGradient(iterate, begin, columns, deltas,
+          effectiveBatchSize);
+
+      // The weight decay of this step is applied to each touched column before
+      // its first delta.
+      for (size_t k = 0; k < columns.n_elem; ++k)
+      {
+        if (weightDecay != 0.0)
+          CatchUp(iterate, lastStep, columns[k], step + 1, decay);
+
+        double* column = iterate.colptr(columns[k]);
+        const double* delta = deltas.colptr(k);
+        for (size_t r = 0; r < iterate.n_rows; ++r)
+          column[r] -= stepSize * delta[r];
+      }
+    }
+
+    // Bring every column up to date, since the step size may change in the
+    // next epoch.
+    if (weightDecay != 0.0)
+    {
+      for (size_t c = 0; c < iterate.n_cols; ++c)
+      {
+        CatchUp(iterate, lastStep, c, step, decay);
+        lastStep[c] = 0;
+      }
+    }
+
+    lastObjective = overallObjective;
+    overallObjective = regression::ParallelObjective(function, iterate);
+
+    // Output current objective function.
+    Log::Info << "Sparse SGD: epoch " << epoch << ", objective "
+        << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Log::Warn << "Sparse SGD: converged to " << overallObjective
+          << "; terminating with failure.  Try a smaller step size?"
+          << std::endl;
+      return overallObjective;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Log::Info << "Sparse SGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      return overallObjective;
+    }
+  }
+
+  Log::Info << "Sparse SGD: maximum epochs (" << maxIterations
+      << ") reached; terminating optimization." << std::endl;
+
+  return overallObjective;
+}
+
+template<typename DecayPolicyType>
+void SparseSGD<DecayPolicyType>::CatchUp(arma::mat& iterate,
+                                         std::vector<size_t>& lastStep,
+                                         const size_t column,
+                                         const size_t step,
+                                         const double decay)
+{
+  if (lastStep[column] >= step)
+    return;
+
+  const double scale = std::pow(decay, (double) (step - lastStep[column]));
+  double* values = iterate.colptr(column);
+  for (size_t r = 0; r < iterate.n_rows; ++r)
+    values[r] *= scale;
+
+  lastStep[column] = step;
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,180 @@
+/**
+ * @file methods/regularized_svd/stratified_sgd.hpp
+ *
+ * Definition of StratifiedSGD, a parallel SGD optimizer for matrix
+ * factorization that partitions the ratings into blocks of users and items and
+ * updates non-conflicting blocks concurrently.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <ensmallen.hpp>
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * StratifiedSGD is a parallel SGD optimizer for the matrix factorization
+ * functions (RegularizedSVDFunction, BiasSVDFunction and SVDPlusPlusFunction),
+ * in the style of DSGD and FPSGD.  The users and the items are each split into
+ * p groups at random, which splits the ratings into a p x p grid of blocks.
+ * Two blocks that share neither a group of users nor a group of items update
+ * disjoint parameter columns, so each epoch is run as p strata of p such
+ * blocks, and the blocks of a stratum are updated by the threads concurrently.
+ * Because no two threads ever touch the same columns, every update is applied
+ * in place, without atomics and without allocating memory.
+ *
+ * For more information, see the following papers:
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title = {Large-scale matrix factorization with distributed stochastic
+ *       gradient descent},
+ *   author = {Gemulla, Rainer and Nijkamp, Erik and Haas, Peter J. and
+ *       Sismanis, Yannis},
+ *   booktitle = {Proceedings of the 17th ACM SIGKDD International Conference
+ *       on Knowledge Discovery and Data Mining (KDD '11)},
+ *   pages = {69--77},
+ *   year = {2011}
+ * }
+ *
+ * @article{chin2015fast,
+ *   title = {A fast parallel stochastic gradient method for matrix
+ *       factorization in shared memory systems},
+ *   author = {Chin, Wei-Sheng and Zhuang, Yong and Juan, Yu-Chin and Lin,
+ *       Chih-Jen},
+ *   journal = {ACM Transactions on Intelligent Systems and Technology},
+ *   volume = {6},
+ *   number = {1},
+ *   pages = {2:1--2:24},
+ *   year = {2015}
+ * }
+ * @endcode
+ *
+ * As in FPSGD, the grid has more blocks than there are threads (by default
+ * twice as many groups as threads), and the blocks of each stratum are handed
+ * to the threads dynamically, so that a thread that finishes a small block
+ * early can take another one.
+ *
+ * The function to be optimized must provide the following methods:
+ *
+ * @code
+ * // The ratings, with the user, item and rating of rating i in column i.
+ * const arma::mat& Dataset() const;
+ * size_t NumFunctions() const;
+ * size_t NumUsers() const;
+ * size_t NumItems() const;
+ *
+ * // Evaluate the cost of rating i.
+ * double Evaluate(const arma::mat& parameters, const size_t i) const;
+ *
+ * // Take a step of the given size along the negative gradient of the cost of
+ * // rating i, in place.  Only the columns of the user and the item of the
+ * // rating may be modified directly; updates to the last NumSharedColumns()
+ * // columns, which any rating may touch, must be added to sharedUpdate.
+ * void UpdateRating(arma::mat& parameters,
+ *                   const size_t i,
+ *                   const double stepSize,
+ *                   arma::mat& sharedUpdate) const;
+ *
+ * // The number of columns at the end of the parameters that any rating may
+ * // update.
+ * size_t NumSharedColumns() const;
+ * @endcode
+ *
+ * Each thread holds its own sharedUpdate matrix; the updates of all threads
+ * are added to the shared columns at the end of every stratum.
+ *
+ * @tparam DecayPolicyType Step size update policy used at the end of every
+ *     epoch (for instance ens::ConstantStep or ens::ExponentialBackoff).
+ */
+template<typename DecayPolicyType = ens::ConstantStep>
+class StratifiedSGD
+{
+ public:
+  /**
+   * Create the StratifiedSGD optimizer with the given parameters.
+   *
+   * @param maxIterations Maximum number of epochs (0 means no limit).
+   * @param numBlocks Number of groups the users and the items are each split
+   *     into; 0 means twice the number of threads.
+   * @param tolerance Maximum absolute tolerance to terminate the algorithm.
+   * @param shuffle If true, the strata and the ratings of each block are
+   *     visited in a random order in every epoch.
+   * @param decayPolicy The step size update policy to use.
+   */
+  StratifiedSGD(const size_t maxIterations = 100,
+                const size_t numBlocks = 0,
+                const double tolerance = 1e-5,
+                const bool shuffle = true,
+                const DecayPolicyType& decayPolicy = DecayPolicyType());
+
+  /**
+   * Optimize the given function with stratified parallel SGD.  The given
+   * starting point will be modified to store the finishing point of the
+   * optimization, and the final objective value is returned.
+   *
+   * @param function Function to be optimized.
+   * @param iterate Starting point (will be modified).
+   * @return Objective value at the final point.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function, arma::mat& iterate);
+
+  //! Get the maximum number of epochs (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of epochs (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of groups of users and items.
+  size_t NumBlocks() const { return numBlocks; }
+  //! Modify the number of groups of users and items.
+  size_t& NumBlocks() { return numBlocks; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether or not the visitation order is shuffled.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether or not the visitation order is shuffled.
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the step size decay policy.
+  const DecayPolicyType& DecayPolicy() const { return decayPolicy; }
+  //! Modify the step size decay policy.
+  DecayPolicyType& DecayPolicy() { return decayPolicy; }
+
+ private:
+  //! Compute the objective over all ratings.
+  template<typename FunctionType>
+  static double Objective(const FunctionType& function,
+                          const arma::mat& iterate);
+
+  //! The maximum number of allowed epochs.
+  size_t maxIterations;
+  //! The number of groups of users and items.
+  size_t numBlocks;
+  //! The tolerance for termination.
+  double tolerance;
+  //! Controls whether or not the visitation order is shuffled.
+  bool shuffle;
+  //! The step size decay policy.
+  DecayPolicyType decayPolicy;
+};
+
+} // namespace svd
+} // namespace mlpack
+
+// Include implementation.
+#include "stratified_sgd_impl.hpp"
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file methods/regularized_svd/stratified_sgd_impl.hpp
+ *
+ * Implementation of StratifiedSGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_IMPL_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stratified_sgd.hpp"
+
+namespace mlpack {
+namespace svd {
+
+template<typename DecayPolicyType>
+StratifiedSGD<DecayPolicyType>::StratifiedSGD(
+    const size_t maxIterations,
+    const size_t numBlocks,
+    const double tolerance,
+    const bool shuffle,
+    const DecayPolicyType& decayPolicy) :
+    maxIterations(maxIterations),
+    numBlocks(numBlocks),
+    tolerance(tolerance),
+    shuffle(shuffle),
+    decayPolicy(decayPolicy)
+{
+  // Nothing to do.
+}
+
+template<typename DecayPolicyType>
+template<typename FunctionType>
+double StratifiedSGD<DecayPolicyType>::Optimize(FunctionType& function,
+                                                arma::mat& iterate)
+{
+  const arma::mat& data = function.Dataset();
+  const size_t numRatings = function.NumFunctions();
+  const size_t numUsers = function.NumUsers();
+  const size_t numItems = function.NumItems();
+
+  size_t numThreads = 1;
+  #ifdef HAS_OPENMP
+    numThreads = omp_get_max_threads();
+  #endif
+
+  // There can't be more groups than users or items.
+  size_t blocks = (numBlocks == 0) ? 2 * numThreads : numBlocks;
+  blocks = std::max((size_t) 1, std::min(blocks, std::min(numUsers,
+      numItems)));
+
+  // Assign the users and the items to groups at random, so that the blocks
+  // hold similar numbers of ratings even if the ratings are sorted.
+  const arma::uvec userOrder = arma::randperm<arma::uvec>(numUsers);
+  const arma::uvec itemOrder = arma::randperm<arma::uvec>(numItems);
+  std::vector<size_t> userGroup(numUsers), itemGroup(numItems);
+  for (size_t u = 0; u < numUsers; ++u)
+    userGroup[userOrder[u]] = u * blocks / numUsers;
+  for (size_t v = 0; v < numItems; ++v)
+    itemGroup[itemOrder[v]] = v * blocks / numItems;
+
+  // Sort the ratings by block with a counting sort; the ratings of block
+  // (userGroup, itemGroup) are ratings[blockStarts[b]] to
+  // ratings[blockStarts[b + 1] - 1], with b = userGroup * blocks + itemGroup.
+  std::vector<size_t> blockOf(numRatings);
+  std::vector<size_t> blockStarts(blocks * blocks + 1, 0);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    blockOf[i] = userGroup[(size_t) data(0, i)] * blocks +
+        itemGroup[(size_t) data(1, i)];
+    ++blockStarts[blockOf[i] + 1];
+  }
+  std::partial_sum(blockStarts.begin(), blockStarts.end(),
+      blockStarts.begin());
+
+  std::vector<size_t> ratings(numRatings);
+  std::vector<size_t> positions(blockStarts.begin(), blockStarts.end() - 1);
+  for (size_t i = 0; i < numRatings; ++i)
+    ratings[positions[blockOf[i]]++] = i;
+  blockOf.clear();
+  blockOf.shrink_to_fit();
+
+  // Each thread collects its updates to the shared columns separately.
+  const size_t numShared = function.NumSharedColumns();
+  const size_t sharedStart = iterate.n_cols - numShared;
+  std::vector<arma::mat> sharedUpdates(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+    sharedUpdates[t].zeros(iterate.n_rows, numShared);
+
+  // Stratum s holds the blocks (g, (g + s) % blocks) for every group g.
+  std::vector<size_t> strata(blocks);
+  std::iota(strata.begin(), strata.end(), 0);
+
+  double overallObjective = Objective(function, iterate);
+  double lastObjective;
+  for (size_t epoch = 1; maxIterations == 0 || epoch <= maxIterations;
+      ++epoch)
+  {
+    // Get the step size for this epoch.
+    const double stepSize = decayPolicy.StepSize(epoch);
+
+    if (shuffle) // Determine the order of visitation.
+    {
+      std::shuffle(strata.begin(), strata.end(), mlpack::math::randGen);
+      for (size_t b = 0; b < blocks * blocks; ++b)
+      {
+        std::shuffle(ratings.begin() + blockStarts[b],
+            ratings.begin() + blockStarts[b + 1], mlpack::math::randGen);
+      }
+    }
+
+    for (size_t s = 0; s < blocks; ++s)
+    {
+      // The blocks of a stratum don't share any users or items, so they can
+      // be updated concurrently.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t g = 0; g < (omp_size_t) blocks; ++g)
+      {
+        size_t threadId = 0;
+        #ifdef HAS_OPENMP
+          threadId = omp_get_thread_num();
+        #endif
+
+        const size_t b = g * blocks + (g + strata[s]) % blocks;
+        for (size_t r = blockStarts[b]; r < blockStarts[b + 1]; ++r)
+        {
+          function.UpdateRating(iterate, ratings[r], stepSize,
+              sharedUpdates[threadId]);
+        }
+      }
+
+      // Apply the updates to the shared columns.
+      if (numShared > 0)
+      {
+        #pragma omp parallel for
+        for (omp_size_t c = 0; c < (omp_size_t) numShared; ++c)
+        {
+          for (size_t t = 0; t < numThreads; ++t)
+          {
+            iterate.col(sharedStart + c) += sharedUpdates[t].col(c);
+            sharedUpdates[t].col(c).zeros();
+          }
+        }
+      }
+    }
+
+    lastObjective = overallObjective;
+    overallObjective = Objective(function, iterate);
+
+    // Output current objective function.
+    Log::Info << "Stratified SGD: epoch " << epoch << ", objective "
+        << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Log::Warn << "Stratified SGD: converged to " << overallObjective
+          << "; terminating with failure.  Try a smaller step size?"
+          << std::endl;
+      return overallObjective;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Log::Info << "Stratified SGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      return overallObjective;
+    }
+  }
+
+  Log::Info << "Stratified SGD: maximum epochs (" << maxIterations
+      << ") reached; terminating optimization." << std::endl;
+
+  return overallObjective;
+}
+
+template<typename DecayPolicyType>
+template<typename FunctionType>
+double StratifiedSGD<DecayPolicyType>::Objective(const FunctionType& function,
+                                                 const arma::mat& iterate)
+{
+  double objective = 0.0;
+  #pragma omp parallel for reduction(+:objective)
+  for (omp_size_t i = 0; i < (omp_size_t) function.NumFunctions(); ++i)
+    objective += function.Evaluate(iterate, i);
+
+  return objective;
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,7 @@
 #include "worker/one_step_q_learning_worker.hpp"
 #include "worker/one_step_sarsa_worker.hpp"
 #include "worker/n_step_q_learning_worker.hpp"
+#include "worker/shared_target_parameters.hpp"
 #include "training_config.hpp"
 
 namespace mlpack {
@@ -41,6 +42,12 @@ namespace rl {
  * }
  * @endcode
  *
+ * The workers run on all OpenMP threads without locks: they update the
+ * parameters of the shared learning network in place, as in Hogwild!, and
+ * read the target network from a double-buffered snapshot (see
+ * SharedTargetParameters).  Each worker keeps its own copies of the networks,
+ * its own gradients and its own optimizer state.
+ *
  * @tparam WorkerType The type of the worker.
  * @tparam EnvironmentType The type of reinforcement learning task.
  * @tparam NetworkType The type of the network model.
@@ -113,6 +120,9 @@ class AsyncLearning
   //! Modify the environment.
   const EnvironmentType& Environment() const { return environment; }
 
+  //! Get the number of training steps taken by the last call to Train().
+  size_t TotalSteps() const { return totalSteps; }
+
  private:
   //! Locally-stored hyper-parameters.
   TrainingConfig config;
@@ -128,6 +138,9 @@ class AsyncLearning
 
   //! Locally-stored task.
   EnvironmentType environment;
+
+  //! The number of training steps taken by the last call to Train().
+  size_t totalSteps;
 };
 
 /**
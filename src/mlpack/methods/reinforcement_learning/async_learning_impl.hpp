@@ -14,7 +14,8 @@
 #define MLPACK_METHODS_RL_ASYNC_LEARNING_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
-#include "queue"
+#include <atomic>
+#include <thread>
 
 namespace mlpack {
 namespace rl {
@@ -42,7 +43,8 @@ AsyncLearning<
     learningNetwork(std::move(network)),
     policy(std::move(policy)),
     updater(std::move(updater)),
-    environment(std::move(environment))
+    environment(std::move(environment)),
+    totalSteps(0)
 { /* Nothing to do here. */ };
 
 template <
@@ -68,10 +70,10 @@ void AsyncLearning<
   NetworkType learningNetwork = std::move(this->learningNetwork);
   if (learningNetwork.Parameters().is_empty())
     learningNetwork.ResetParameters();
-  NetworkType targetNetwork = learningNetwork;
-  size_t totalSteps = 0;
+  SharedTargetParameters targetParameters(learningNetwork.Parameters());
+  std::atomic<size_t> totalSteps(0);
   PolicyType policy = this->policy;
-  bool stop = false;
+  std::atomic<bool> stop(false);
 
   // Set up worker pool, worker 0 will be deterministic for evaluation.
   std::vector<WorkerType> workers;
@@ -80,10 +82,10 @@ void AsyncLearning<
     workers.push_back(WorkerType(updater, environment, config, !i));
     workers.back().Initialize(learningNetwork);
   }
-  // Set up task queue corresponding to worker pool.
-  std::queue<size_t> tasks;
-  for (size_t i = 0; i <= config.NumWorkers(); ++i)
-    tasks.push(i);
+  // Mark which workers are currently being stepped by a thread.
+  std::vector<std::atomic<bool>> busy(workers.size());
+  for (size_t i = 0; i < busy.size(); ++i)
+    busy[i] = false;
 
   /**
    * Compute the number of threads for the for-loop. In general, we should use
@@ -95,8 +97,14 @@ void AsyncLearning<
   numThreads++;
   Log::Debug << numThreads << " threads will be used in total." << std::endl;
 
-  #pragma omp parallel for shared(stop, workers, tasks, learningNetwork, \
-      targetNetwork, totalSteps, policy)
+  /**
+   * The threads share nothing but the parameters of the learning network,
+   * which the workers update in place without locks (Hogwild), the snapshot
+   * of the target network and the step counter.  Each worker holds its own
+   * networks, gradients and optimizer state.
+   */
+  #pragma omp parallel for shared(stop, workers, busy, learningNetwork, \
+      targetParameters, totalSteps, policy)
   for (omp_size_t i = 0; i < numThreads; ++i)
   {
     #pragma omp critical
@@ -106,37 +114,42 @@ void AsyncLearning<
             " started." << std::endl;
       #endif
     }
-    size_t task = std::numeric_limits<size_t>::max();
+
+    // Each thread starts at a different worker, and then steps the next
+    // worker that no other thread is stepping.  If every worker is busy, the
+    // thread yields before looking again.
+    size_t task = i % workers.size();
+    size_t skipped = 0;
     while (!stop)
     {
-      // Assign task to current thread from queue.
-      #pragma omp critical
+      if (busy[task].exchange(true, std::memory_order_acquire))
       {
-        if (task != std::numeric_limits<size_t>::max())
-          tasks.push(task);
-
-        if (!tasks.empty())
+        task = (task + 1) % workers.size();
+        if (++skipped == workers.size())
         {
-          task = tasks.front();
-          tasks.pop();
+          skipped = 0;
+          std::this_thread::yield();
         }
-      };
-
-      // This may happen when threads are more than workers.
-      if (task == std::numeric_limits<size_t>::max())
         continue;
+      }
+      skipped = 0;
 
       // Get corresponding worker.
       WorkerType& worker = workers[task];
       double episodeReturn;
-      if (worker.Step(learningNetwork, targetNetwork, totalSteps,
+      if (worker.Step(learningNetwork, targetParameters, totalSteps,
           policy, episodeReturn) && !task)
       {
         stop = measure(episodeReturn);
       }
+
+      busy[task].store(false, std::memory_order_release);
+      task = (task + 1) % workers.size();
     }
   }
 
+  this->totalSteps = totalSteps;
+
   // Write back the learning network.
   this->learningNetwork = std::move(learningNetwork);
 };
@@ -192,6 +192,66 @@ class Acrobot
     return -1;
   };
 
+  /**
+   * Dynamics of a batch of Acrobot instances, as used by
+   * VectorizedEnvironment.  Each column of states is the state of one
+   * instance.  The batch is transposed so that each state variable is one
+   * contiguous vector, and all instances are advanced at once with
+   * element-wise operations.
+   *
+   * @param states The current states, one per column.
+   * @param actions The action of each instance.
+   * @param stepsPerformed The number of steps each instance has performed; it
+   *     is incremented.
+   * @param rewards The reward of each instance.
+   * @param nextStates The next states, one per column.
+   * @param isTerminal Whether each next state is terminal.
+   */
+  void BatchSample(const arma::mat& states,
+                   const std::vector<Action>& actions,
+                   arma::urowvec& stepsPerformed,
+                   arma::rowvec& rewards,
+                   arma::mat& nextStates,
+                   arma::irowvec& isTerminal) const
+  {
+    const size_t n = states.n_cols;
+    stepsPerformed += 1;
+
+    // The noise of the torque is drawn instance by instance, in order.
+    arma::vec torque(n);
+    for (size_t i = 0; i < n; ++i)
+      torque[i] = Torque(actions[i]);
+
+    const arma::mat s = states.t();
+    const arma::mat k1 = BatchDsdt(s, torque);
+    const arma::mat k2 = BatchDsdt(s + dt * k1 / 2, torque);
+    const arma::mat k3 = BatchDsdt(s + dt * k2 / 2, torque);
+    const arma::mat k4 = BatchDsdt(s + dt * k3, torque);
+    arma::mat next = s + dt * (k1 + 2 * k2 + 2 * k3 + k4) / 6;
+
+    //! The value of angular velocity is bounded in min and max value.
+    next.col(2) = arma::clamp(next.col(2), -maxVel1, maxVel1);
+    next.col(3) = arma::clamp(next.col(3), -maxVel2, maxVel2);
+
+    rewards.set_size(n);
+    isTerminal.set_size(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      next(i, 0) = Wrap(next(i, 0), -M_PI, M_PI);
+      next(i, 1) = Wrap(next(i, 1), -M_PI, M_PI);
+
+      // Check if the episode has terminated.
+      const bool timeUp = (maxSteps != 0 && stepsPerformed[i] >= maxSteps);
+      isTerminal[i] = timeUp ||
+          -std::cos(next(i, 0)) - std::cos(next(i, 0) + next(i, 1)) > 1.0;
+
+      // Do not reward the agent if time ran out.
+      rewards[i] = timeUp ? 0.0 : (isTerminal[i] ? doneReward : -1.0);
+    }
+
+    nextStates = next.t();
+  }
+
   /**
    * Dynamics of the Acrobot System. To get reward and next state based on
    * current state and current action. This function calls the Sample function
@@ -286,6 +346,53 @@ class Acrobot
     return values;
   };
 
+  /**
+   * The ordinary differential equations of Dsdt() for a batch of states, one
+   * per row (theta1, theta2, angular velocity 1, angular velocity 2).
+   *
+   * @param state The current states, one per row.
+   * @param torque The torque applied to each instance.
+   */
+  arma::mat BatchDsdt(const arma::mat& state, const arma::vec& torque) const
+  {
+    const double m1 = linkMass1;
+    const double m2 = linkMass2;
+    const double l1 = linkLength1;
+    const double lc1 = linkCom1;
+    const double lc2 = linkCom2;
+    const double I1 = linkMoi;
+    const double I2 = linkMoi;
+    const double g = gravity;
+
+    arma::mat values(state.n_rows, 4);
+    values.col(0) = state.col(2);
+    values.col(1) = state.col(3);
+
+    const arma::vec cosTheta2 = arma::cos(state.col(1));
+    const arma::vec sinTheta2 = arma::sin(state.col(1));
+
+    const arma::vec d1 = m1 * std::pow(lc1, 2) + m2 * (std::pow(l1, 2) +
+        std::pow(lc2, 2) + 2 * l1 * lc2 * cosTheta2) + I1 + I2;
+
+    const arma::vec d2 = m2 * (std::pow(lc2, 2) + l1 * lc2 * cosTheta2) + I2;
+
+    const arma::vec phi2 = m2 * lc2 * g * arma::cos(state.col(0) +
+        state.col(1) - M_PI / 2.);
+
+    const arma::vec phi1 = - m2 * l1 * lc2 * arma::square(values.col(1)) %
+        sinTheta2 - 2 * m2 * l1 * lc2 * values.col(1) % values.col(0) %
+        sinTheta2 + (m1 * lc1 +  m2 * l1) * g *
+        arma::cos(state.col(0) - M_PI / 2) + phi2;
+
+    values.col(3) = (torque + d2 / d1 % phi1 - m2 * l1 * lc2 *
+        arma::square(values.col(0)) % sinTheta2 - phi2) / (m2 *
+        std::pow(lc2, 2) + I2 - arma::square(d2) / d1);
+
+    values.col(2) = -(d2 % values.col(3) + phi1) / d1;
+
+    return values;
+  }
+
   /**
    * Wrap funtion is required to truncate the angle value from -180 to 180.
    * This function will make sure that value will always be between minimum
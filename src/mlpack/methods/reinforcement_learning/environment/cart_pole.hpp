@@ -185,6 +185,66 @@ class CartPole
     return 1.0;
   }
 
+  /**
+   * Dynamics of a batch of Cart Pole instances, as used by
+   * VectorizedEnvironment.  Each column of states is the state of one
+   * instance.  The batch is transposed so that each state variable is one
+   * contiguous vector, and all instances are advanced at once with
+   * element-wise operations.
+   *
+   * @param states The current states, one per column.
+   * @param actions The action of each instance.
+   * @param stepsPerformed The number of steps each instance has performed; it
+   *     is incremented.
+   * @param rewards The reward of each instance.
+   * @param nextStates The next states, one per column.
+   * @param isTerminal Whether each next state is terminal.
+   */
+  void BatchSample(const arma::mat& states,
+                   const std::vector<Action>& actions,
+                   arma::urowvec& stepsPerformed,
+                   arma::rowvec& rewards,
+                   arma::mat& nextStates,
+                   arma::irowvec& isTerminal) const
+  {
+    const size_t n = states.n_cols;
+    stepsPerformed += 1;
+
+    const arma::mat s = states.t();
+    arma::vec force(n);
+    for (size_t i = 0; i < n; ++i)
+      force[i] = actions[i].action ? forceMag : -forceMag;
+
+    // Calculate acceleration.
+    const arma::vec cosTheta = arma::cos(s.col(2));
+    const arma::vec sinTheta = arma::sin(s.col(2));
+    const arma::vec temp = (force + poleMassLength * arma::square(s.col(3)) %
+        sinTheta) / totalMass;
+    const arma::vec thetaAcc = (gravity * sinTheta - cosTheta % temp) /
+        (length * (4.0 / 3.0 - massPole * arma::square(cosTheta) / totalMass));
+    const arma::vec xAcc = temp - poleMassLength * thetaAcc % cosTheta /
+        totalMass;
+
+    // Update states.
+    arma::mat next(n, 4);
+    next.col(0) = s.col(0) + tau * s.col(1);
+    next.col(1) = s.col(1) + tau * xAcc;
+    next.col(2) = s.col(2) + tau * s.col(3);
+    next.col(3) = s.col(3) + tau * thetaAcc;
+    nextStates = next.t();
+
+    // Check if the episodes have terminated.
+    rewards.set_size(n);
+    isTerminal.set_size(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      const bool timeUp = (maxSteps != 0 && stepsPerformed[i] >= maxSteps);
+      isTerminal[i] = timeUp || std::abs(next(i, 0)) > xThreshold ||
+          std::abs(next(i, 2)) > thetaThresholdRadians;
+      rewards[i] = timeUp ? doneReward : 1.0;
+    }
+  }
+
   /**
    * Dynamics of Cart Pole. Get reward based on current state and current
    * action.
@@ -164,6 +164,64 @@ class MountainCar
     return -1;
   }
 
+  /**
+   * Dynamics of a batch of Mountain Car instances, as used by
+   * VectorizedEnvironment.  Each column of states is the state of one
+   * instance.  The batch is transposed so that each state variable is one
+   * contiguous vector, and all instances are advanced at once with
+   * element-wise operations.
+   *
+   * @param states The current states, one per column.
+   * @param actions The action of each instance.
+   * @param stepsPerformed The number of steps each instance has performed; it
+   *     is incremented.
+   * @param rewards The reward of each instance.
+   * @param nextStates The next states, one per column.
+   * @param isTerminal Whether each next state is terminal.
+   */
+  void BatchSample(const arma::mat& states,
+                   const std::vector<Action>& actions,
+                   arma::urowvec& stepsPerformed,
+                   arma::rowvec& rewards,
+                   arma::mat& nextStates,
+                   arma::irowvec& isTerminal) const
+  {
+    const size_t n = states.n_cols;
+    stepsPerformed += 1;
+
+    const arma::mat s = states.t();
+    arma::vec direction(n);
+    for (size_t i = 0; i < n; ++i)
+      direction[i] = double(actions[i].action) - 1.0;
+
+    // Calculate acceleration.
+    arma::vec velocity = arma::clamp(s.col(1) + 0.001 * direction - 0.0025 *
+        arma::cos(3 * s.col(0)), velocityMin, velocityMax);
+
+    // Update states.
+    const arma::vec position = arma::clamp(s.col(0) + velocity, positionMin,
+        positionMax);
+
+    rewards.set_size(n);
+    isTerminal.set_size(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (position[i] == positionMin && velocity[i] < 0)
+        velocity[i] = 0.0;
+
+      // Check if the episode has terminated.
+      const bool timeUp = (maxSteps != 0 && stepsPerformed[i] >= maxSteps);
+      isTerminal[i] = timeUp || position[i] >= positionGoal;
+
+      // Do not reward the agent if time ran out.
+      rewards[i] = timeUp ? 0.0 : (isTerminal[i] ? doneReward : -1.0);
+    }
+
+    nextStates.set_size(2, n);
+    nextStates.row(0) = position.t();
+    nextStates.row(1) = velocity.t();
+  }
+
   /**
    * Dynamics of Mountain Car. Get reward based on current state and current
    * action.
@@ -67,7 +67,7 @@ class Pendulum
     double& AngularVelocity() { return data[2]; }
 
     //! Encode the state to a column vector.
-    const arma::colvec& Encode() { return data; }
+    const arma::colvec& Encode() const { return data; }
 
     //! Updates the theta transformations in data.
     void SetState()
@@ -175,6 +175,71 @@ class Pendulum
     return -costs;
   }
 
+  /**
+   * Dynamics of a batch of Pendulum instances, as used by
+   * VectorizedEnvironment.  Each column of states is the state of one
+   * instance.  The batch is transposed so that each state variable is one
+   * contiguous vector, and all instances are advanced at once with
+   * element-wise operations.
+   *
+   * @param states The current states, one per column.
+   * @param actions The action of each instance.
+   * @param stepsPerformed The number of steps each instance has performed; it
+   *     is incremented.
+   * @param rewards The reward of each instance.
+   * @param nextStates The next states, one per column.
+   * @param isTerminal Whether each next state is terminal.
+   */
+  void BatchSample(const arma::mat& states,
+                   const std::vector<Action>& actions,
+                   arma::urowvec& stepsPerformed,
+                   arma::rowvec& rewards,
+                   arma::mat& nextStates,
+                   arma::irowvec& isTerminal) const
+  {
+    const size_t n = states.n_cols;
+    stepsPerformed += 1;
+
+    // Define constants which specify our pendulum.
+    const double gravity = 10.0;
+    const double mass = 1.0;
+    const double length = 1.0;
+
+    // The encoded states hold sin(theta) and cos(theta).
+    const arma::mat s = states.t();
+    const arma::vec theta = arma::atan2(s.col(0), s.col(1));
+    const arma::vec angularVelocity = s.col(2);
+
+    // Get action and clip the values between max and min limits.
+    arma::vec torque(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      torque[i] = math::ClampRange(actions[i].action[0], -maxTorque,
+          maxTorque);
+    }
+
+    // Calculate costs of taking this action in the current state.  theta is
+    // already in [-pi, pi].
+    rewards = -(arma::square(theta) + 0.1 * arma::square(angularVelocity) +
+        0.001 * arma::square(torque)).t();
+
+    // Calculate new state values and assign to the next state.
+    const arma::vec newAngularVelocity = angularVelocity + (-3.0 * gravity /
+        (2 * length) * arma::sin(theta + M_PI) + 3.0 / (mass *
+        std::pow(length, 2)) * torque) * dt;
+    const arma::vec nextTheta = theta + newAngularVelocity * dt;
+
+    nextStates.set_size(3, n);
+    nextStates.row(0) = arma::sin(nextTheta).t();
+    nextStates.row(1) = arma::cos(nextTheta).t();
+    nextStates.row(2) = arma::clamp(newAngularVelocity, -maxAngularVelocity,
+        maxAngularVelocity).t();
+
+    isTerminal.set_size(n);
+    for (size_t i = 0; i < n; ++i)
+      isTerminal[i] = (maxSteps != 0 && stepsPerformed[i] >= maxSteps);
+  }
+
   /**
    * Dynamics of Pendulum. Get reward based on current state and current action
    *
@@ -0,0 +1,257 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_environment.hpp
+ *
+ * Definition of VectorizedEnvironment, a wrapper that steps several copies of
+ * an environment in lockstep.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * VectorizedEnvironment steps N copies of an environment in lockstep.  The
+ * states of all copies are kept as the columns of one matrix, so that an agent
+ * can select the actions of all copies with a single forward pass of its
+ * network, and store all transitions at once.  Whenever a copy reaches a
+ * terminal state it is reset, so every call to Step() advances every copy by
+ * one step.
+ *
+ * If the environment provides batched dynamics, all copies are advanced with
+ * one call to
+ *
+ * @code
+ * void BatchSample(const arma::mat& states,
+ *                  const std::vector<Action>& actions,
+ *                  arma::urowvec& stepsPerformed,
+ *                  arma::rowvec& rewards,
+ *                  arma::mat& nextStates,
+ *                  arma::irowvec& isTerminal) const;
+ * @endcode
+ *
+ * which CartPole, MountainCar, Acrobot and Pendulum implement with
+ * element-wise operations over the whole batch.  Otherwise each copy is
+ * advanced with its own Sample() call; this also supports environments with
+ * vector rewards, such as FTN, whose rewards are then returned as the columns
+ * of a matrix.
+ *
+ * @code
+ * VectorizedEnvironment<CartPole> environments(64);
+ * environments.Reset();
+ * for (size_t t = 0; t < 1000; ++t)
+ * {
+ *   std::vector<CartPole::Action> actions = ...;  // From States().
+ *   arma::rowvec rewards;
+ *   arma::mat nextStates;
+ *   arma::irowvec isTerminal;
+ *   environments.Step(actions, rewards, nextStates, isTerminal);
+ * }
+ * @endcode
+ *
+ * @tparam EnvironmentType The environment to step.
+ */
+template<typename EnvironmentType>
+class VectorizedEnvironment
+{
+ public:
+  //! Convenient typedef for state.
+  using State = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using Action = typename EnvironmentType::Action;
+
+  //! The type of the reward of one step of the environment.
+  using RewardType = typename std::decay<decltype(
+      std::declval<EnvironmentType&>().Sample(std::declval<const State&>(),
+          std::declval<const Action&>(), std::declval<State&>()))>::type;
+
+  //! The type holding the rewards of all copies: one column per copy.
+  using RewardsType = typename std::conditional<
+      std::is_arithmetic<RewardType>::value, arma::rowvec, arma::mat>::type;
+
+  /**
+   * Create the given number of copies of the given environment.  Reset() must
+   * be called before the first call to Step().
+   *
+   * @param numEnvironments The number of copies to step in lockstep.
+   * @param environment The environment to copy.
+   */
+  VectorizedEnvironment(
+      const size_t numEnvironments,
+      const EnvironmentType& environment = EnvironmentType()) :
+      environments(numEnvironments, environment),
+      stateObjects(numEnvironments),
+      stepsPerformed(numEnvironments, arma::fill::zeros)
+  {
+    if (numEnvironments == 0)
+    {
+      throw std::invalid_argument("VectorizedEnvironment: the number of "
+          "environments must be positive!");
+    }
+  }
+
+  /**
+   * Start a new episode in every copy.  States() then holds the initial
+   * states.
+   */
+  void Reset()
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+      Reset(i);
+  }
+
+  /**
+   * Start a new episode in the given copy, for instance when its episode is
+   * cut off before reaching a terminal state.
+   *
+   * @param i Index of the copy.
+   */
+  void Reset(const size_t i)
+  {
+    stateObjects[i] = environments[i].InitialSample();
+    const arma::colvec& encoded = stateObjects[i].Data();
+    if (states.n_cols != environments.size())
+      states.set_size(encoded.n_elem, environments.size());
+
+    states.col(i) = encoded;
+    stepsPerformed[i] = 0;
+  }
+
+  /**
+   * Advance every copy by one step with the given actions.  Copies whose next
+   * state is terminal are reset afterwards, so States() holds the states the
+   * copies continue from, which differ from nextStates for those copies.
+   *
+   * @param actions The action of each copy.
+   * @param rewards The reward of each copy (one column per copy).
+   * @param nextStates The encoded next state of each copy.
+   * @param isTerminal Whether the next state of each copy is terminal.
+   */
+  void Step(const std::vector<Action>& actions,
+            RewardsType& rewards,
+            arma::mat& nextStates,
+            arma::irowvec& isTerminal)
+  {
+    if (actions.size() != environments.size())
+    {
+      std::ostringstream oss;
+      oss << "VectorizedEnvironment::Step(): expected " << environments.size()
+          << " actions, but got " << actions.size() << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    StepHelper(actions, rewards, nextStates, isTerminal);
+
+    // Start a new episode in the copies that are done.
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      if (isTerminal[i])
+        Reset(i);
+    }
+  }
+
+  //! Get the encoded states of all copies, one per column.
+  const arma::mat& States() const { return states; }
+
+  //! Get the number of steps each copy has performed in its episode.
+  const arma::urowvec& StepsPerformed() const { return stepsPerformed; }
+
+  //! Get the number of copies.
+  size_t NumEnvironments() const { return environments.size(); }
+
+  //! Get the copies of the environment.
+  const std::vector<EnvironmentType>& Environments() const
+  {
+    return environments;
+  }
+  //! Modify the copies of the environment.
+  std::vector<EnvironmentType>& Environments() { return environments; }
+
+ private:
+  HAS_MEM_FUNC(BatchSample, HasBatchSample);
+
+  //! The signature of batched dynamics.
+  typedef void (EnvironmentType::*BatchSampleSignature)(const arma::mat&,
+      const std::vector<Action>&, arma::urowvec&, arma::rowvec&, arma::mat&,
+      arma::irowvec&) const;
+
+  //! Advance all copies at once with the batched dynamics.
+  template<typename EnvType = EnvironmentType>
+  void StepHelper(const std::vector<Action>& actions,
+                  arma::rowvec& rewards,
+                  arma::mat& nextStates,
+                  arma::irowvec& isTerminal,
+                  const typename std::enable_if<HasBatchSample<EnvType,
+                      BatchSampleSignature>::value>::type* = 0)
+  {
+    environments[0].BatchSample(states, actions, stepsPerformed, rewards,
+        nextStates, isTerminal);
+    states = nextStates;
+  }
+
+  //! Advance each copy with its own call to Sample().
+  template<typename EnvType = EnvironmentType>
+  void StepHelper(const std::vector<Action>& actions,
+                  RewardsType& rewards,
+                  arma::mat& nextStates,
+                  arma::irowvec& isTerminal,
+                  const typename std::enable_if<!HasBatchSample<EnvType,
+                      BatchSampleSignature>::value>::type* = 0)
+  {
+    nextStates.set_size(states.n_rows, environments.size());
+    isTerminal.set_size(environments.size());
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      State nextState;
+      const RewardType reward = environments[i].Sample(stateObjects[i],
+          actions[i], nextState);
+      SetReward(rewards, i, reward);
+
+      isTerminal[i] = environments[i].IsTerminal(nextState);
+      stateObjects[i] = nextState;
+      nextStates.col(i) = stateObjects[i].Data();
+      stepsPerformed[i] = environments[i].StepsPerformed();
+    }
+    states = nextStates;
+  }
+
+  //! Store a scalar reward.
+  void SetReward(arma::rowvec& rewards, const size_t i, const double reward)
+  {
+    if (rewards.n_elem != environments.size())
+      rewards.set_size(environments.size());
+    rewards[i] = reward;
+  }
+
+  //! Store a vector reward.
+  void SetReward(arma::mat& rewards, const size_t i, const arma::vec& reward)
+  {
+    if (rewards.n_cols != environments.size() ||
+        rewards.n_rows != reward.n_elem)
+      rewards.set_size(reward.n_elem, environments.size());
+    rewards.col(i) = reward;
+  }
+
+  //! The copies of the environment.
+  std::vector<EnvironmentType> environments;
+  //! The current state of each copy (used without batched dynamics).
+  std::vector<State> stateObjects;
+  //! The encoded current states, one per column.
+  arma::mat states;
+  //! The number of steps each copy has performed in its episode.
+  arma::urowvec stepsPerformed;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
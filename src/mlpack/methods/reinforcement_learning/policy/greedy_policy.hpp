@@ -84,6 +84,29 @@ class GreedyPolicy
     return action;
   }
 
+  /**
+   * Sample an action for each column of the given action values, such as the
+   * action values of all copies of a VectorizedEnvironment computed with one
+   * forward pass.
+   *
+   * @param actionValues Values for each action, one column per state.
+   * @param deterministic Always select the actions greedily.
+   * @param isNoisy Specifies whether the network used is noisy.
+   * @return Sampled actions.
+   */
+  std::vector<ActionType> BatchSample(const arma::mat& actionValues,
+                                      bool deterministic = false,
+                                      const bool isNoisy = false)
+  {
+    std::vector<ActionType> actions(actionValues.n_cols);
+    for (size_t i = 0; i < actionValues.n_cols; ++i)
+    {
+      const arma::colvec actionValue = actionValues.col(i);
+      actions[i] = Sample(actionValue, deterministic, isNoisy);
+    }
+    return actions;
+  }
+
   /**
    * Exploration probability will anneal at each step.
    */
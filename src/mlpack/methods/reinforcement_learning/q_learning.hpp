@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <ensmallen.hpp>
 
+#include "environment/vectorized_environment.hpp"
 #include "replay/random_replay.hpp"
 #include "replay/prioritized_replay.hpp"
 #include "training_config.hpp"
@@ -111,6 +112,27 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Advance all copies of the given vectorized environment by the given number
+   * of steps.  At every step the actions of all copies are selected with one
+   * forward pass of the learning network, and all transitions are stored in
+   * the replay at once with BatchStore(); copies that finish an episode are
+   * reset by the environment.  Episodes are also cut off after StepLimit()
+   * steps, unless it is 0.  The agent is then trained once per step (not
+   * once per transition), and the target network is synchronized whenever
+   * the total number of steps crosses a multiple of the sync interval.  The
+   * policy is annealed once per transition, as in Episode().
+   *
+   * The returns of running episodes are kept between calls, so episodes may
+   * span several calls.
+   *
+   * @param environments The copies of the environment, after Reset().
+   * @param numSteps Number of steps to advance all copies by.
+   * @return Returns of the episodes that finished during the call.
+   */
+  std::vector<double> Step(VectorizedEnvironment<EnvironmentType>& environments,
+                           const size_t numSteps = 1);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -147,6 +169,14 @@ class QLearning
    */
   arma::Col<size_t> BestAction(const arma::mat& actionValues);
 
+  //! Update the learning network from a sample of the replay, without
+  //! synchronizing the target network or annealing the policy.
+  void LearnFromReplay();
+
+  //! Update the categorical learning network from a sample of the replay,
+  //! without synchronizing the target network or annealing the policy.
+  void LearnCategoricalFromReplay();
+
   //! Locally-stored hyper-parameters.
   TrainingConfig& config;
 
@@ -182,6 +212,16 @@ class QLearning
 
   //! Locally-stored flag indicating training mode or test mode.
   bool deterministic;
+
+  //! Returns of the running episodes of each copy, used by Step().
+  arma::rowvec runningReturns;
+
+  //! Batches sampled from the replay, reused across updates.
+  arma::mat sampledStates;
+  std::vector<ActionType> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::mat sampledNextStates;
+  arma::irowvec sampledTerminals;
 };
 
 } // namespace rl
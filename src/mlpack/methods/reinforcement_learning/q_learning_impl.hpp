@@ -132,17 +132,62 @@ void QLearning<
   ReplayType
 >::TrainAgent()
 {
-  // Start experience replay.
+  LearnFromReplay();
 
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  std::vector<ActionType> sampledActions;
-  arma::rowvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::irowvec isTerminal;
+  // Update target network.
+  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+    targetNetwork.Parameters() = learningNetwork.Parameters();
+
+  if (totalSteps > config.ExplorationSteps())
+    policy.Anneal();
+}
+
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::TrainCategoricalAgent()
+{
+  LearnCategoricalFromReplay();
+
+  // Update target network.
+  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+    targetNetwork.Parameters() = learningNetwork.Parameters();
+
+  if (totalSteps > config.ExplorationSteps())
+    policy.Anneal();
+}
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::LearnFromReplay()
+{
+  // Start experience replay.
+
+  // Sample from previous experience, into batches that are reused across
+  // calls.
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
-      sampledNextStates, isTerminal);
+      sampledNextStates, sampledTerminals);
 
   // Compute action value for next state with target network.
   arma::mat nextActionValues;
@@ -175,7 +220,7 @@ void QLearning<
   for (size_t i = 0; i < sampledNextStates.n_cols; ++i)
   {
     target(sampledActions[i].action, i) = sampledRewards(i) + discount *
-        nextActionValues(bestActions(i), i) * (1 - isTerminal[i]);
+        nextActionValues(bestActions(i), i) * (1 - sampledTerminals[i]);
   }
 
   // Learn from experience.
@@ -196,12 +241,6 @@ void QLearning<
     learningNetwork.ResetNoise();
     targetNetwork.ResetNoise();
   }
-  // Update target network.
-  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
-    targetNetwork.Parameters() = learningNetwork.Parameters();
-
-  if (totalSteps > config.ExplorationSteps())
-    policy.Anneal();
 }
 
 template <
@@ -217,19 +256,14 @@ void QLearning<
   UpdaterType,
   BehaviorPolicyType,
   ReplayType
->::TrainCategoricalAgent()
+>::LearnCategoricalFromReplay()
 {
   // Start experience replay.
 
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  std::vector<ActionType> sampledActions;
-  arma::rowvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::irowvec isTerminal;
-
+  // Sample from previous experience, into batches that are reused across
+  // calls.
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
-      sampledNextStates, isTerminal);
+      sampledNextStates, sampledTerminals);
 
   size_t atomSize = config.AtomSize();
   arma::colvec support = arma::linspace<arma::colvec>(config.VMin(),
@@ -263,7 +297,7 @@ void QLearning<
   }
 
   arma::mat tZ = (arma::conv_to<arma::mat>::from(config.Discount() *
-      (support * (1 - isTerminal))).each_row() + sampledRewards);
+      (support * (1 - sampledTerminals))).each_row() + sampledRewards);
   tZ = arma::clamp(tZ, config.VMin(), config.VMax());
   arma::mat b = (tZ - config.VMin()) / (config.VMax() - config.VMin()) *
       (atomSize - 1);
@@ -307,12 +341,6 @@ void QLearning<
     learningNetwork.ResetNoise();
     targetNetwork.ResetNoise();
   }
-  // Update target network.
-  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
-    targetNetwork.Parameters() = learningNetwork.Parameters();
-
-  if (totalSteps > config.ExplorationSteps())
-    policy.Anneal();
 }
 
 template <
@@ -387,6 +415,85 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+std::vector<double> QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::Step(VectorizedEnvironment<EnvironmentType>& environments,
+        const size_t numSteps)
+{
+  const size_t numEnvironments = environments.NumEnvironments();
+  if (runningReturns.n_elem != numEnvironments)
+    runningReturns.zeros(numEnvironments);
+
+  std::vector<double> episodeReturns;
+  arma::mat actionValues, nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  for (size_t step = 0; step < numSteps; ++step)
+  {
+    // Select the actions of all copies with one forward pass.
+    const arma::mat states = environments.States();
+    learningNetwork.Predict(states, actionValues);
+    const std::vector<ActionType> actions = policy.BatchSample(actionValues,
+        deterministic, config.NoisyQLearning());
+
+    environments.Step(actions, rewards, nextStates, isTerminal);
+    replayMethod.BatchStore(states, actions, rewards, nextStates, isTerminal);
+
+    runningReturns += rewards;
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      // Episodes that reach the step limit are cut off, but their last
+      // transition is not terminal.
+      const bool cutOff = !isTerminal[i] && config.StepLimit() &&
+          environments.StepsPerformed()[i] >= config.StepLimit();
+      if (isTerminal[i] || cutOff)
+      {
+        episodeReturns.push_back(runningReturns[i]);
+        runningReturns[i] = 0.0;
+      }
+      if (cutOff)
+        environments.Reset(i);
+    }
+
+    const size_t previousSteps = totalSteps;
+    totalSteps += numEnvironments;
+    if (deterministic || totalSteps < config.ExplorationSteps())
+      continue;
+
+    if (config.IsCategorical())
+      LearnCategoricalFromReplay();
+    else
+      LearnFromReplay();
+
+    // Synchronize the target network if a multiple of the sync interval was
+    // crossed during this step.
+    const size_t interval = config.TargetNetworkSyncInterval();
+    const size_t nextSync = (previousSteps / interval + 1) * interval;
+    if (nextSync <= totalSteps)
+      targetNetwork.Parameters() = learningNetwork.Parameters();
+
+    // Anneal the policy once for each transition, at the step count it would
+    // have had in Episode().
+    for (size_t steps = previousSteps + 1; steps <= totalSteps; ++steps)
+    {
+      if (steps > config.ExplorationSteps())
+        policy.Anneal();
+    }
+  }
+  return episodeReturns;
+}
+
 } // namespace rl
 } // namespace mlpack
 
@@ -228,8 +228,9 @@ class PrioritizedReplay
     BetaAnneal();
 
     sampledStates = states.cols(sampledIndices);
+    sampledActions.resize(sampledIndices.n_rows);
     for (size_t t = 0; t < sampledIndices.n_rows; t ++)
-      sampledActions.push_back(actions[sampledIndices[t]]);
+      sampledActions[t] = actions[sampledIndices[t]];
     sampledRewards = rewards.elem(sampledIndices).t();
     sampledNextStates = nextStates.cols(sampledIndices);
     isTerminal = this->isTerminal.elem(sampledIndices).t();
@@ -237,7 +238,7 @@ class PrioritizedReplay
     // Calculate the weights of sampled transitions.
 
     size_t numSample = full ? capacity : position;
-    weights = arma::rowvec(sampledIndices.n_rows);
+    weights.set_size(sampledIndices.n_rows);
 
     for (size_t i = 0; i < sampledIndices.n_rows; ++i)
     {
@@ -140,6 +140,59 @@ class RandomReplay
     }
   }
 
+  /**
+   * Store a batch of one-step experiences, one per column, such as the
+   * transitions of all copies of a VectorizedEnvironment.  The batch is copied
+   * into the memory a block of columns at a time.  Throws
+   * std::invalid_argument if the replay uses n-step transitions.
+   *
+   * @param batchStates Given states.
+   * @param batchActions Given actions.
+   * @param batchRewards Given rewards.
+   * @param batchNextStates Given next states.
+   * @param batchIsEnd Whether each next state is a terminal state.
+   */
+  void BatchStore(const arma::mat& batchStates,
+                  const std::vector<ActionType>& batchActions,
+                  const arma::rowvec& batchRewards,
+                  const arma::mat& batchNextStates,
+                  const arma::irowvec& batchIsEnd)
+  {
+    if (nSteps != 1)
+    {
+      throw std::invalid_argument("RandomReplay::BatchStore(): only one-step "
+          "transitions can be stored in a batch!");
+    }
+
+    size_t stored = 0;
+    while (stored < batchStates.n_cols)
+    {
+      // Copy as many columns as fit before the end of the memory.
+      const size_t count = std::min(batchStates.n_cols - stored,
+          capacity - position);
+      const size_t last = stored + count - 1;
+
+      states.cols(position, position + count - 1) =
+          batchStates.cols(stored, last);
+      std::copy(batchActions.begin() + stored,
+          batchActions.begin() + stored + count, actions.begin() + position);
+      rewards.subvec(position, position + count - 1) =
+          batchRewards.subvec(stored, last);
+      nextStates.cols(position, position + count - 1) =
+          batchNextStates.cols(stored, last);
+      isTerminal.subvec(position, position + count - 1) =
+          batchIsEnd.subvec(stored, last);
+
+      stored += count;
+      position += count;
+      if (position == capacity)
+      {
+        full = true;
+        position = 0;
+      }
+    }
+  }
+
   /**
    * Get the reward, next state and terminal boolean for nth step.
    *
@@ -191,8 +244,9 @@ class RandomReplay
         batchSize, arma::distr_param(0, upperBound - 1));
 
     sampledStates = states.cols(sampledIndices);
+    sampledActions.resize(sampledIndices.n_rows);
     for (size_t t = 0; t < sampledIndices.n_rows; t ++)
-      sampledActions.push_back(actions[sampledIndices[t]]);
+      sampledActions[t] = actions[sampledIndices[t]];
     sampledRewards = rewards.elem(sampledIndices).t();
     sampledNextStates = nextStates.cols(sampledIndices);
     isTerminal = this->isTerminal.elem(sampledIndices).t();
@@ -0,0 +1,358 @@
+/**
+ * @file methods/reinforcement_learning/replay/ring_replay.hpp
+ *
+ * This file is an implementation of random experience replay on a ring buffer
+ * of states, where next states are not stored separately.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_RING_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_RING_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of random experience replay that stores the states of an
+ * episode as consecutive slots of a ring buffer.  The next state of a
+ * transition is the state in the slot after it, so consecutive transitions of
+ * an episode share their states and the memory holds about half as many
+ * states as RandomReplay.  When a stored transition does not continue from
+ * the previous one (for instance at the start of a new episode), the next
+ * state of the previous transition stays in its own slot and the new
+ * transition starts in the following slot.
+ *
+ * N-step returns are accumulated as the transitions are stored: each new
+ * reward is added, discounted, to the transitions of the last n steps, and a
+ * transition becomes available for sampling once it spans n steps or its
+ * episode ends.  The next state of an n-step transition is the state n slots
+ * later (or the terminal state).  Incomplete n-step transitions of an episode
+ * that is cut off without reaching a terminal state are dropped.
+ *
+ * Sample() gathers the sampled columns directly into the given matrices,
+ * prefetching the columns a few samples ahead.  If the matrices already have
+ * the right size (as when the same matrices are passed to every call), no
+ * memory is allocated.
+ *
+ * RingReplay can be used in place of RandomReplay, except with
+ * QLearning::Step() and SAC::Step(), which store interleaved transitions of
+ * several environments with BatchStore().
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class RingReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  RingReplay():
+      batchSize(0),
+      capacity(0),
+      nSteps(0),
+      position(0),
+      usedSlots(0),
+      continues(false),
+      pendingCount(0),
+      size(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of ring buffer experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of states; at most
+   *     capacity - 1 transitions are held.
+   * @param nSteps Number of steps to look in the future.
+   * @param dimension The dimension of an encoded state.
+   */
+  RingReplay(const size_t batchSize,
+             const size_t capacity,
+             const size_t nSteps = 1,
+             const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      capacity(capacity),
+      nSteps(nSteps),
+      position(0),
+      usedSlots(0),
+      continues(false),
+      pendingCount(0),
+      size(0),
+      states(dimension, capacity),
+      actions(capacity),
+      rewards(capacity),
+      isTerminal(capacity),
+      offsets(capacity),
+      valid(capacity, 0)
+  {
+    if (nSteps == 0 || capacity < nSteps + 2)
+    {
+      throw std::invalid_argument("RingReplay::RingReplay(): nSteps must be "
+          "positive, and the capacity must be at least nSteps + 2!");
+    }
+  }
+
+  /**
+   * Store the given experience.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(const StateType& state,
+             const ActionType& action,
+             const double reward,
+             const StateType& nextState,
+             const bool isEnd,
+             const double& discount)
+  {
+    const arma::colvec& encoded = state.Encode();
+
+    // Reuse the next state of the previous transition if this transition
+    // continues from it.
+    if (!continues || !std::equal(encoded.begin(), encoded.end(),
+        states.colptr(position)))
+    {
+      if (continues)
+      {
+        // The previous episode was cut off: keep its last next state, and
+        // drop its transitions that can no longer span nSteps steps.
+        pendingCount = 0;
+        position = NextSlot(position);
+      }
+      WriteState(position, encoded);
+    }
+
+    actions[position] = action;
+    rewards[position] = 0.0;
+    isTerminal[position] = 0;
+    offsets[position] = 0;
+    ++pendingCount;
+
+    // Add the reward to every transition of the last nSteps steps.
+    double weight = 1.0;
+    size_t slot = position;
+    for (size_t i = 0; i < pendingCount; ++i)
+    {
+      rewards[slot] += weight * reward;
+      ++offsets[slot];
+      weight *= discount;
+      slot = (slot == 0) ? capacity - 1 : slot - 1;
+    }
+
+    const size_t current = position;
+    position = NextSlot(position);
+    WriteState(position, nextState.Encode());
+    continues = true;
+
+    if (isEnd)
+    {
+      // All remaining transitions of the episode are complete.
+      slot = current;
+      for (size_t i = 0; i < pendingCount; ++i)
+      {
+        isTerminal[slot] = 1;
+        Validate(slot);
+        slot = (slot == 0) ? capacity - 1 : slot - 1;
+      }
+      pendingCount = 0;
+    }
+    else if (pendingCount == nSteps)
+    {
+      // The oldest transition now spans nSteps steps.
+      Validate((current + capacity - (nSteps - 1)) % capacity);
+      --pendingCount;
+    }
+  }
+
+  /**
+   * Sample some experiences.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& isTerminal)
+  {
+    if (size == 0)
+    {
+      throw std::runtime_error("RingReplay::Sample(): no complete transitions "
+          "have been stored!");
+    }
+
+    // Draw the slots first, so that the columns can be prefetched ahead of
+    // the gather.  Slots that hold no complete transition are redrawn.
+    sampledSlots.set_size(batchSize);
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      size_t slot;
+      do
+      {
+        slot = math::RandInt(usedSlots);
+      } while (!valid[slot]);
+      sampledSlots[i] = slot;
+    }
+
+    const size_t dimension = states.n_rows;
+    sampledStates.set_size(dimension, batchSize);
+    sampledNextStates.set_size(dimension, batchSize);
+    sampledActions.resize(batchSize);
+    sampledRewards.set_size(batchSize);
+    isTerminal.set_size(batchSize);
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      if (i + prefetchDistance < batchSize)
+      {
+        const size_t ahead = sampledSlots[i + prefetchDistance];
+        Prefetch(states.colptr(ahead));
+        Prefetch(states.colptr((ahead + offsets[ahead]) % capacity));
+      }
+
+      const size_t slot = sampledSlots[i];
+      const size_t nextSlot = (slot + offsets[slot]) % capacity;
+      std::copy(states.colptr(slot), states.colptr(slot) + dimension,
+          sampledStates.colptr(i));
+      std::copy(states.colptr(nextSlot), states.colptr(nextSlot) + dimension,
+          sampledNextStates.colptr(i));
+      sampledActions[i] = actions[slot];
+      sampledRewards[i] = rewards[slot];
+      isTerminal[i] = this->isTerminal[slot];
+    }
+  }
+
+  /**
+   * Get the number of transitions in the memory that can be sampled.
+   *
+   * @return Actual used memory size
+   */
+  const size_t& Size() const { return size; }
+
+  /**
+   * Update the priorities of transitions and Update the gradients.
+   *
+   * @param * (target) The learned value
+   * @param * (sampledActions) Agent's sampled action
+   * @param * (nextActionValues) Agent's next action
+   * @param * (gradients) The model's gradients
+   */
+  void Update(arma::mat /* target */,
+              std::vector<ActionType> /* sampledActions */,
+              arma::mat /* nextActionValues */,
+              arma::mat& /* gradients */)
+  {
+    /* Do nothing for ring replay. */
+  }
+
+  //! Get the number of steps for n-step agent.
+  const size_t& NSteps() const { return nSteps; }
+
+ private:
+  //! Get the slot after the given slot.
+  size_t NextSlot(const size_t slot) const
+  {
+    return (slot + 1 == capacity) ? 0 : slot + 1;
+  }
+
+  //! Write an encoded state into the given slot, dropping the transition that
+  //! started there.
+  void WriteState(const size_t slot, const arma::colvec& encoded)
+  {
+    if (valid[slot])
+    {
+      valid[slot] = 0;
+      --size;
+    }
+    std::copy(encoded.begin(), encoded.end(), states.colptr(slot));
+    usedSlots = std::max(usedSlots, slot + 1);
+  }
+
+  //! Make the transition in the given slot available for sampling.
+  void Validate(const size_t slot)
+  {
+    valid[slot] = 1;
+    ++size;
+  }
+
+  //! Hint the processor to load the given memory into the cache.
+  static void Prefetch(const double* address)
+  {
+    #if defined(__GNUC__)
+    __builtin_prefetch(address);
+    #else
+    (void) address;
+    #endif
+  }
+
+  //! How many samples ahead columns are prefetched.
+  static constexpr size_t prefetchDistance = 4;
+
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Locally-stored total memory limit, in states.
+  size_t capacity;
+
+  //! Locally-stored number of steps to look into the future.
+  size_t nSteps;
+
+  //! The slot holding the latest next state.
+  size_t position;
+
+  //! The number of slots that have been written so far.
+  size_t usedSlots;
+
+  //! Whether the latest next state may be the state of the next transition.
+  bool continues;
+
+  //! The number of latest transitions that don't span nSteps steps yet.
+  size_t pendingCount;
+
+  //! The number of transitions that can be sampled.
+  size_t size;
+
+  //! Locally-stored encoded states, one per slot.
+  arma::mat states;
+
+  //! Locally-stored actions of the transition starting at each slot.
+  std::vector<ActionType> actions;
+
+  //! Locally-stored (n-step) rewards of the transition starting at each slot.
+  arma::rowvec rewards;
+
+  //! Locally-stored termination information of each transition.
+  arma::irowvec isTerminal;
+
+  //! The number of slots between each state and its next state.
+  std::vector<size_t> offsets;
+
+  //! Whether the transition starting at each slot can be sampled.
+  std::vector<char> valid;
+
+  //! The slots of the latest sample.
+  arma::Col<size_t> sampledSlots;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <ensmallen.hpp>
 
+#include "environment/vectorized_environment.hpp"
 #include "replay/random_replay.hpp"
 #include <mlpack/methods/ann/activation_functions/tanh_function.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
@@ -122,6 +123,24 @@ class SAC
    */
   double Episode();
 
+  /**
+   * Advance all copies of the given vectorized environment by the given number
+   * of steps.  At every step the actions of all copies are computed with one
+   * forward pass of the policy network, and all transitions are stored in the
+   * replay at once with BatchStore(); copies that finish an episode are reset
+   * by the environment.  The networks are then updated UpdateInterval() times
+   * per step (not per transition), and the target networks are softly updated
+   * whenever the total number of steps crosses a multiple of the sync
+   * interval.  As in Episode(), episodes are cut off after StepLimit() steps,
+   * unless it is 0.
+   *
+   * @param environments The copies of the environment, after Reset().
+   * @param numSteps Number of steps to advance all copies by.
+   * @return Returns of the episodes that finished during the call.
+   */
+  std::vector<double> Step(VectorizedEnvironment<EnvironmentType>& environments,
+                           const size_t numSteps = 1);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -142,6 +161,10 @@ class SAC
 
 
  private:
+  //! Update the Q and policy networks from a sample of the replay, without
+  //! updating the target networks.
+  void LearnFromReplay();
+
   //! Locally-stored hyper-parameters.
   TrainingConfig& config;
 
@@ -188,6 +211,16 @@ class SAC
   //! Locally-stored flag indicating training mode or test mode.
   bool deterministic;
 
+  //! Returns of the running episodes of each copy, used by Step().
+  arma::rowvec runningReturns;
+
+  //! Batches sampled from the replay, reused across updates.
+  arma::mat sampledStates;
+  std::vector<ActionType> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::mat sampledNextStates;
+  arma::irowvec sampledTerminals;
+
   //! Locally-stored loss function.
   mlpack::ann::MeanSquaredError<> lossFunction;
 };
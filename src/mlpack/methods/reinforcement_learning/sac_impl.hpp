@@ -157,15 +157,32 @@ void SAC<
   ReplayType
 >::Update()
 {
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  std::vector<ActionType> sampledActions;
-  arma::rowvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::irowvec isTerminal;
+  LearnFromReplay();
+
+  // Update target network
+  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
+    SoftUpdate(config.Rho());
+}
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::LearnFromReplay()
+{
+  // Sample from previous experience, into batches that are reused across
+  // calls.
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
-      sampledNextStates, isTerminal);
+      sampledNextStates, sampledTerminals);
 
   // Critic network update.
 
@@ -178,8 +195,8 @@ void SAC<
   arma::rowvec Q1, Q2;
   targetQ1Network.Predict(targetQInput, Q1);
   targetQ2Network.Predict(targetQInput, Q2);
-  arma::rowvec nextQ = sampledRewards + config.Discount() * ((1 - isTerminal)
-      % arma::min(Q1, Q2));
+  arma::rowvec nextQ = sampledRewards + config.Discount() *
+      ((1 - sampledTerminals) % arma::min(Q1, Q2));
 
   arma::mat sampledActionValues(action.size, sampledActions.size());
   for (size_t i = 0; i < sampledActions.size(); i++)
@@ -269,10 +286,6 @@ void SAC<
   policyNetworkUpdatePolicy->Update(policyNetwork.Parameters(),
       config.StepSize(), gradient);
   #endif
-
-  // Update target network
-  if (totalSteps % config.TargetNetworkSyncInterval() == 0)
-    SoftUpdate(config.Rho());
 }
 
 template <
@@ -357,6 +370,87 @@ double SAC<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+std::vector<double> SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::Step(VectorizedEnvironment<EnvironmentType>& environments,
+        const size_t numSteps)
+{
+  const size_t numEnvironments = environments.NumEnvironments();
+  if (runningReturns.n_elem != numEnvironments)
+    runningReturns.zeros(numEnvironments);
+
+  std::vector<double> episodeReturns;
+  std::vector<ActionType> actions(numEnvironments);
+  arma::mat outputActions, nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  for (size_t step = 0; step < numSteps; ++step)
+  {
+    // Get the actions of all copies with one forward pass.
+    const arma::mat states = environments.States();
+    policyNetwork.Predict(states, outputActions);
+
+    if (!deterministic)
+    {
+      arma::mat noise = arma::randn<arma::mat>(arma::size(outputActions)) * 0.1;
+      noise = arma::clamp(noise, -0.25, 0.25);
+      outputActions += noise;
+    }
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      actions[i].action = arma::conv_to<std::vector<double>>::from(
+          outputActions.col(i));
+    }
+
+    environments.Step(actions, rewards, nextStates, isTerminal);
+    replayMethod.BatchStore(states, actions, rewards, nextStates, isTerminal);
+
+    runningReturns += rewards;
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      // Episodes that reach the step limit are cut off as in Episode(), but
+      // their last transition is not terminal.
+      const bool cutOff = !isTerminal[i] && config.StepLimit() &&
+          environments.StepsPerformed()[i] >= config.StepLimit();
+      if (isTerminal[i] || cutOff)
+      {
+        episodeReturns.push_back(runningReturns[i]);
+        runningReturns[i] = 0.0;
+      }
+      if (cutOff)
+        environments.Reset(i);
+    }
+
+    const size_t previousSteps = totalSteps;
+    totalSteps += numEnvironments;
+    if (deterministic || totalSteps < config.ExplorationSteps())
+      continue;
+
+    // Softly update the target networks after each update if a multiple of
+    // the sync interval was crossed during this step.
+    const size_t interval = config.TargetNetworkSyncInterval();
+    const bool sync = ((previousSteps / interval + 1) * interval <= totalSteps);
+    for (size_t i = 0; i < config.UpdateInterval(); i++)
+    {
+      LearnFromReplay();
+      if (sync)
+        SoftUpdate(config.Rho());
+    }
+  }
+  return episodeReturns;
+}
+
 } // namespace rl
 } // namespace mlpack
 #endif
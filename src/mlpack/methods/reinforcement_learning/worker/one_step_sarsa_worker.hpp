@@ -15,6 +15,7 @@
 
 #include <ensmallen.hpp>
 #include <mlpack/methods/reinforcement_learning/training_config.hpp>
+#include "shared_target_parameters.hpp"
 
 namespace mlpack {
 namespace rl {
@@ -62,7 +63,8 @@ class OneStepSarsaWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetVersion(0)
   { Reset(); }
 
   /**
@@ -83,6 +85,8 @@ class OneStepSarsaWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      targetNetwork(other.targetNetwork),
+      targetVersion(other.targetVersion),
       state(other.state),
       action(other.action)
   {
@@ -114,6 +118,8 @@ class OneStepSarsaWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      targetNetwork(std::move(other.targetNetwork)),
+      targetVersion(std::move(other.targetVersion)),
       state(std::move(other.state)),
       action(std::move(other.action))
   {
@@ -150,6 +156,8 @@ class OneStepSarsaWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    targetNetwork = other.targetNetwork;
+    targetVersion = other.targetVersion;
     state = other.state;
     action = other.action;
 
@@ -188,6 +196,8 @@ class OneStepSarsaWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    targetNetwork = std::move(other.targetNetwork);
+    targetVersion = std::move(other.targetVersion);
     state = std::move(other.state);
     action = std::move(other.action);
 
@@ -233,13 +243,17 @@ class OneStepSarsaWorker
 
     // Build local network.
     network = learningNetwork;
+
+    // Build local target network; it starts from the first snapshot.
+    targetNetwork = learningNetwork;
+    targetVersion = 0;
   }
 
   /**
    * The agent will execute one step.
    *
    * @param learningNetwork The shared learning network.
-   * @param targetNetwork The shared target network.
+   * @param targetParameters The shared snapshot of the target network.
    * @param totalSteps The shared counter for total steps.
    * @param policy The shared behavior policy.
    * @param totalReward This will be the episode return if the episode ends
@@ -247,8 +261,8 @@ class OneStepSarsaWorker
    * @return Indicate whether current episode ends after this step.
    */
   bool Step(NetworkType& learningNetwork,
-            NetworkType& targetNetwork,
-            size_t& totalSteps,
+            SharedTargetParameters& targetParameters,
+            std::atomic<size_t>& totalSteps,
             PolicyType& policy,
             double& totalReward)
   {
@@ -278,7 +292,7 @@ class OneStepSarsaWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        network.Parameters() = learningNetwork.Parameters();
         return true;
       }
       state = nextState;
@@ -286,14 +300,17 @@ class OneStepSarsaWorker
       return false;
     }
 
-    #pragma omp atomic
-    totalSteps++;
+    const size_t currentSteps = ++totalSteps;
 
     pending[pendingIndex++] =
         std::make_tuple(state, action, reward, nextState, nextAction);
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
+      // Copy the latest snapshot of the target network, if it has changed.
+      if (targetParameters.Version() != targetVersion)
+        targetVersion = targetParameters.Read(targetNetwork.Parameters());
+
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
@@ -303,11 +320,7 @@ class OneStepSarsaWorker
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        targetNetwork.Predict(std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = 0;
         if (!(terminal && i == pending.size() - 1))
           targetActionValue = actionValue[std::get<4>(transition).action];
@@ -333,7 +346,8 @@ class OneStepSarsaWorker
           { return std::min(std::max(gradient, -config.GradientLimit()),
           config.GradientLimit()); });
 
-      // Perform async update of the global network.
+      // Perform async update of the global network, in place and without
+      // locks (Hogwild).
       #if ENS_VERSION_MAJOR == 1
       updater.Update(learningNetwork.Parameters(), config.StepSize(),
           totalGradients);
@@ -343,17 +357,14 @@ class OneStepSarsaWorker
       #endif
 
       // Sync the local network with the global network.
-      network = learningNetwork;
+      network.Parameters() = learningNetwork.Parameters();
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
-    if (totalSteps % config.TargetNetworkSyncInterval() == 0)
-    {
-      #pragma omp critical
-      { targetNetwork = learningNetwork; }
-    }
+    // Publish a new snapshot of the target network.
+    if (currentSteps % config.TargetNetworkSyncInterval() == 0)
+      targetParameters.Publish(learningNetwork.Parameters());
 
     policy.Anneal();
 
@@ -412,6 +423,12 @@ class OneStepSarsaWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local copy of the target network of the worker.
+  NetworkType targetNetwork;
+
+  //! Version of the snapshot held by the local target network.
+  size_t targetVersion;
+
   //! Current state of the agent.
   StateType state;
 
@@ -0,0 +1,139 @@
+/**
+ * @file methods/reinforcement_learning/worker/shared_target_parameters.hpp
+ *
+ * Definition of SharedTargetParameters, a double-buffered snapshot of the
+ * target network parameters shared by asynchronous workers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_WORKER_SHARED_TARGET_PARAMETERS_HPP
+#define MLPACK_METHODS_RL_WORKER_SHARED_TARGET_PARAMETERS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+#include <memory>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * SharedTargetParameters holds the parameters of the target network shared by
+ * the workers of AsyncLearning, without locks.  Two buffers are kept: a new
+ * snapshot is written into the buffer that is not the latest one, and is then
+ * published by atomically incrementing the version, which selects the buffer.
+ * Each worker keeps its own copy of the target network and only copies the
+ * latest snapshot into it when the version has changed.
+ *
+ * Only one snapshot is written at a time; a call to Publish() that overlaps
+ * another one is skipped, since the snapshot being written is just as recent.
+ * A reader that was too slow to finish copying a snapshot before the buffer
+ * was reused (which takes two newer snapshots) simply copies again.  Since a
+ * buffer may be written while a slow reader copies it, the elements of the
+ * buffers are atomics, copied one at a time with relaxed loads and stores
+ * (which are plain moves on common hardware).
+ */
+class SharedTargetParameters
+{
+ public:
+  /**
+   * Create the shared snapshot, initialized with the given parameters.
+   *
+   * @param parameters Initial parameters of the target network.
+   */
+  SharedTargetParameters(const arma::mat& parameters) :
+      nRows(parameters.n_rows),
+      nCols(parameters.n_cols),
+      version(0),
+      started(0),
+      publishing(false)
+  {
+    for (size_t b = 0; b < 2; ++b)
+    {
+      buffers[b].reset(new std::atomic<double>[parameters.n_elem]);
+      Store(parameters, buffers[b].get());
+    }
+  }
+
+  /**
+   * Publish a new snapshot of the given parameters.
+   *
+   * @param parameters Parameters of the learning network.
+   * @return false if another snapshot was being written, and this one was
+   *     skipped.
+   */
+  bool Publish(const arma::mat& parameters)
+  {
+    if (publishing.exchange(true, std::memory_order_acquire))
+      return false;
+
+    const size_t next = version.load(std::memory_order_relaxed) + 1;
+    started.store(next, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Store(parameters, buffers[next % 2].get());
+
+    version.store(next, std::memory_order_release);
+    publishing.store(false, std::memory_order_release);
+    return true;
+  }
+
+  //! Get the version of the latest snapshot.
+  size_t Version() const { return version.load(std::memory_order_acquire); }
+
+  /**
+   * Copy the latest snapshot into the given parameters.  If the parameters
+   * already have the right size (as those of a network do), they are copied in
+   * place.
+   *
+   * @param parameters Parameters to copy the snapshot into.
+   * @return The version of the copied snapshot.
+   */
+  size_t Read(arma::mat& parameters) const
+  {
+    parameters.set_size(nRows, nCols);
+    double* out = parameters.memptr();
+    while (true)
+    {
+      const size_t current = version.load(std::memory_order_acquire);
+      const std::atomic<double>* buffer = buffers[current % 2].get();
+      for (size_t i = 0; i < parameters.n_elem; ++i)
+        out[i] = buffer[i].load(std::memory_order_relaxed);
+
+      // The buffer is only rewritten once a snapshot two versions newer has
+      // been started.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (started.load(std::memory_order_relaxed) <= current + 1)
+        return current;
+    }
+  }
+
+ private:
+  //! Store the given parameters into the given buffer.
+  static void Store(const arma::mat& parameters, std::atomic<double>* buffer)
+  {
+    const double* in = parameters.memptr();
+    for (size_t i = 0; i < parameters.n_elem; ++i)
+      buffer[i].store(in[i], std::memory_order_relaxed);
+  }
+
+  //! The number of rows of the parameters.
+  size_t nRows;
+  //! The number of columns of the parameters.
+  size_t nCols;
+  //! The two snapshots.
+  std::unique_ptr<std::atomic<double>[]> buffers[2];
+  //! The version of the latest complete snapshot.
+  std::atomic<size_t> version;
+  //! The version of the latest snapshot whose writing has started.
+  std::atomic<size_t> started;
+  //! Whether a snapshot is being written.
+  std::atomic<bool> publishing;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -231,7 +231,7 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
 
   logLikelihood = arma::accu(groundTruth.cols(start, start + batchSize - 1) %
       arma::log(probabilities)) / batchSize;
-  weightDecay = 0.5 * lambda * arma::accu(parameters * parameters);
+  weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
 
   return -logLikelihood + weightDecay;
 }
@@ -301,6 +301,120 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
   }
 }
 
+void SoftmaxRegressionFunction::SparseGradient(const arma::mat& parameters,
+                                               const size_t start,
+                                               arma::sp_mat& gradient,
+                                               const size_t batchSize) const
+{
+  arma::mat probabilities;
+  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
+
+  const arma::mat inner = probabilities - groundTruth.cols(start, start +
+      batchSize - 1);
+
+  // Only the nonzero elements of the batch contribute to the gradient: each
+  // element x_ij adds inner(c, j) * x_ij to column i of every class c.
+  const arma::sp_mat points(data.cols(start, start + batchSize - 1));
+  const size_t offset = fitIntercept ? 1 : 0;
+  const size_t numElements = (points.n_nonzero +
+      (fitIntercept ? batchSize : 0)) * numClasses;
+  arma::umat locations(2, numElements);
+  arma::vec values(numElements);
+
+  size_t k = 0;
+  for (arma::sp_mat::const_iterator it = points.begin(); it != points.end();
+      ++it)
+  {
+    for (size_t c = 0; c < numClasses; ++c, ++k)
+    {
+      locations(0, k) = c;
+      locations(1, k) = it.row() + offset;
+      values[k] = (inner(c, it.col()) * (*it) +
+          lambda * parameters(c, it.row() + offset)) / batchSize;
+    }
+  }
+
+  // Treating the intercept term parameters.col(0) seperately.
+  if (fitIntercept)
+  {
+    for (size_t j = 0; j < batchSize; ++j)
+    {
+      for (size_t c = 0; c < numClasses; ++c, ++k)
+      {
+        locations(0, k) = c;
+        locations(1, k) = 0;
+        values[k] = (inner(c, j) + lambda * parameters(c, 0)) / batchSize;
+      }
+    }
+  }
+
+  gradient = arma::sp_mat(true, locations, values, parameters.n_rows,
+      parameters.n_cols);
+}
+
+void SoftmaxRegressionFunction::SparseGradient(const arma::mat& parameters,
+                                               const size_t start,
+                                               arma::uvec& columns,
+                                               arma::mat& deltas,
+                                               const size_t batchSize) const
+{
+  // Only the nonzero features of the batch are used to compute the class
+  // probabilities, so that stale columns are never read.
+  const arma::sp_mat points(data.cols(start, start + batchSize - 1));
+  const size_t offset = fitIntercept ? 1 : 0;
+  arma::mat hypothesis(numClasses, batchSize);
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    if (fitIntercept)
+      hypothesis.col(j) = parameters.col(0);
+    else
+      hypothesis.col(j).zeros();
+  }
+  for (arma::sp_mat::const_iterator it = points.begin(); it != points.end();
+      ++it)
+  {
+    hypothesis.col(it.col()) += (*it) * parameters.col(it.row() + offset);
+  }
+  hypothesis = arma::exp(hypothesis);
+  const arma::mat inner = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
+      numClasses, 1) - groundTruth.cols(start, start + batchSize - 1);
+
+  // Each element x_ij adds inner(:, j) * x_ij / batchSize to column i.
+  const size_t numDeltas = points.n_nonzero + (fitIntercept ? batchSize : 0);
+  columns.set_size(numDeltas);
+  deltas.set_size(numClasses, numDeltas);
+
+  size_t k = 0;
+  for (arma::sp_mat::const_iterator it = points.begin(); it != points.end();
+      ++it, ++k)
+  {
+    columns[k] = it.row() + offset;
+    deltas.col(k) = inner.col(it.col()) * ((*it) / batchSize);
+  }
+
+  // Treating the intercept term parameters.col(0) seperately.
+  if (fitIntercept)
+  {
+    for (size_t j = 0; j < batchSize; ++j, ++k)
+    {
+      columns[k] = 0;
+      deltas.col(k) = inner.col(j) / batchSize;
+    }
+  }
+}
+
+void SoftmaxRegressionFunction::GradientColumns(const size_t start,
+                                                arma::uvec& columns,
+                                                const size_t batchSize) const
+{
+  const arma::uvec features = arma::find(arma::any(
+      data.cols(start, start + batchSize - 1), 1));
+  if (fitIntercept)
+    columns = arma::join_cols(arma::zeros<arma::uvec>(1), features + 1);
+  else
+    columns = features;
+}
+
 void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
                                                 const size_t j,
                                                 arma::sp_mat& gradient) const
@@ -150,6 +150,63 @@ class SoftmaxRegressionFunction
                 arma::mat& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Evaluate the gradient of the objective function on a subset of the data,
+   * as a sparse matrix holding only the columns of the features that are
+   * nonzero in the subset (and the intercept column).  This is used by
+   * optimizers that apply sparse updates, such as HogwildSGD, which call it
+   * by name; since it is not an overload of Gradient(), other optimizers keep
+   * using the dense gradient.  The regularization is only applied to these
+   * columns, with weight 1 / batchSize for each point of the subset that has
+   * the feature.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param gradient Sparse matrix to store gradient into.
+   * @param batchSize Number of data points to evaluate gradient for.
+   */
+  void SparseGradient(const arma::mat& parameters,
+                      const size_t start,
+                      arma::sp_mat& gradient,
+                      const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the gradient of the log likelihood on a subset of the data, as a
+   * list of column updates: deltas.col(k) is added to column columns[k] of the
+   * gradient.  Each nonzero feature of each point gives one delta, and each
+   * point gives one delta for the intercept column, so the cost is
+   * proportional to the number of nonzero features.  A column may appear more
+   * than once.  The L2 regularization (WeightDecay()) is not included; it is
+   * applied lazily by SparseSGD.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param columns Indices of the parameter columns to update.
+   * @param deltas Gradient of each of the given columns.
+   * @param batchSize Number of data points to evaluate gradient for.
+   */
+  void SparseGradient(const arma::mat& parameters,
+                      const size_t start,
+                      arma::uvec& columns,
+                      arma::mat& deltas,
+                      const size_t batchSize = 1) const;
+
+  /**
+   * Store the parameter columns that the gradient of a subset of the data
+   * depends on: the columns of the features that are nonzero in the subset,
+   * and the intercept column.
+   *
+   * @param start First index of the data points to use.
+   * @param columns Indices of the parameter columns.
+   * @param batchSize Number of data points.
+   */
+  void GradientColumns(const size_t start,
+                       arma::uvec& columns,
+                       const size_t batchSize = 1) const;
+
+  //! Return the L2 weight decay applied to every parameter (lambda).
+  double WeightDecay() const { return lambda; }
+
   /**
    * Evaluates the gradient values of the objective function given the current
    * set of parameters for a single feature indexed by j.
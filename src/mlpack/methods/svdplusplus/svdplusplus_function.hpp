@@ -103,6 +103,66 @@ class SVDPlusPlusFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Take a step of the given size along the negative gradient of the cost of
+   * one rating, in place.  Only the columns of the user and the item of the
+   * rating are modified directly; the update of the implicit item vectors,
+   * which belong to no user or item of the rating, is added to sharedUpdate
+   * instead.  This is used by StratifiedSGD.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param i Index of the rating.
+   * @param stepSize Step size.
+   * @param sharedUpdate Updates of the implicit item vectors (the last
+   *     NumSharedColumns() columns of the parameters).
+   */
+  void UpdateRating(arma::mat& parameters,
+                    const size_t i,
+                    const double stepSize,
+                    arma::mat& sharedUpdate) const;
+
+  /**
+   * Evaluate the gradient of the cost function over a batch of ratings as a
+   * list of column updates: deltas.col(k) is the gradient of column
+   * columns[k].  Each rating gives one delta for its user, one for its item
+   * and one for each implicit item vector of the user, so the cost is
+   * proportional to the rank times the number of implicit items of the user,
+   * and not to the number of parameters.  A column may appear more than once.
+   * This is used by SparseSGD.
+   *
+   * @param parameters Parameters(user/item matrices and item implicit matrix)
+   *     of the decomposition.
+   * @param start The first index of the training examples to use.
+   * @param columns Indices of the parameter columns to update.
+   * @param deltas Gradient of each of the given columns.
+   * @param batchSize Size of batch to calculate gradient for.
+   */
+  void SparseGradient(const arma::mat& parameters,
+                      const size_t start,
+                      arma::uvec& columns,
+                      arma::mat& deltas,
+                      const size_t batchSize = 1) const;
+
+  /**
+   * Store the parameter columns that the gradient of a batch of ratings
+   * depends on: the user and the item column of each rating, and the implicit
+   * item vectors of the user.
+   *
+   * @param start The first index of the training examples to use.
+   * @param columns Indices of the parameter columns.
+   * @param batchSize Size of the batch.
+   */
+  void GradientColumns(const size_t start,
+                       arma::uvec& columns,
+                       const size_t batchSize = 1) const;
+
+  /**
+   * Return the weight decay that applies to every parameter at every step.
+   * This is 0, since the regularization of a column is only part of the
+   * gradients of the ratings that involve it.
+   */
+  double WeightDecay() const { return 0.0; }
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
@@ -127,6 +187,10 @@ class SVDPlusPlusFunction
   //! Return the rank used for the factorization.
   size_t Rank() const { return rank; }
 
+  //! Return the number of parameter columns that any rating may update (the
+  //! implicit item vectors).
+  size_t NumSharedColumns() const { return numItems; }
+
  private:
   //! Rating data.  This will be an alias until Shuffle() is called.
   MatType data;
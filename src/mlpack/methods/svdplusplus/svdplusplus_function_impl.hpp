@@ -285,6 +285,172 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::UpdateRating(
+    arma::mat& parameters,
+    const size_t i,
+    const double stepSize,
+    arma::mat& sharedUpdate) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, i);
+  const size_t item = data(1, i) + numUsers;
+  const size_t implicitStart = numUsers + numItems;
+  double* userVec = parameters.colptr(user);
+  double* itemVec = parameters.colptr(item);
+
+  // The implicit item vectors are not modified until all updates of the
+  // stratum are done, so the user vector u(i) + sum(y(k)) / sqrt(|N(i)|) is
+  // never formed explicitly; its product with the item vector is computed from
+  // the parts instead.
+  const size_t implicitCount = implicitData.col_ptrs[user + 1] -
+      implicitData.col_ptrs[user];
+  const double implicitScale = (implicitCount == 0) ? 0.0 :
+      1.0 / std::sqrt((double) implicitCount);
+
+  // Prediction error for the example; the biases are held in row 'rank'.
+  double ratingError = data(2, i) - userVec[rank] - itemVec[rank];
+  for (size_t k = 0; k < rank; ++k)
+    ratingError -= userVec[k] * itemVec[k];
+  arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+  arma::sp_mat::const_iterator itEnd = implicitData.end_col(user);
+  for (; it != itEnd; ++it)
+  {
+    const double* implicitVec = parameters.colptr(implicitStart + it.row());
+    for (size_t k = 0; k < rank; ++k)
+      ratingError -= implicitScale * implicitVec[k] * itemVec[k];
+  }
+
+  // The update of the implicit item vectors uses the old item vector.
+  for (it = implicitData.begin_col(user); it != itEnd; ++it)
+  {
+    const double* implicitVec = parameters.colptr(implicitStart + it.row());
+    double* implicitUpdate = sharedUpdate.colptr(it.row());
+    for (size_t k = 0; k < rank; ++k)
+    {
+      implicitUpdate[k] -= 2 * stepSize * (lambda / implicitCount *
+          implicitVec[k] - ratingError * implicitScale * itemVec[k]);
+    }
+  }
+
+  // The item vector moves along the full user vector; add the part of the
+  // implicit item vectors afterwards.
+  for (size_t k = 0; k < rank; ++k)
+  {
+    const double userValue = userVec[k];
+    const double itemValue = itemVec[k];
+    userVec[k] -= 2 * stepSize * (lambda * userValue - ratingError * itemValue);
+    itemVec[k] -= 2 * stepSize * (lambda * itemValue - ratingError * userValue);
+  }
+  for (it = implicitData.begin_col(user); it != itEnd; ++it)
+  {
+    const double* implicitVec = parameters.colptr(implicitStart + it.row());
+    for (size_t k = 0; k < rank; ++k)
+      itemVec[k] += 2 * stepSize * ratingError * implicitScale * implicitVec[k];
+  }
+  userVec[rank] -= 2 * stepSize * (lambda * userVec[rank] - ratingError);
+  itemVec[rank] -= 2 * stepSize * (lambda * itemVec[rank] - ratingError);
+}
+
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::SparseGradient(
+    const arma::mat& parameters,
+    const size_t start,
+    arma::uvec& columns,
+    arma::mat& deltas,
+    const size_t batchSize) const
+{
+  GradientColumns(start, columns, batchSize);
+  deltas.set_size(rank + 1, columns.n_elem);
+
+  const size_t implicitStart = numUsers + numItems;
+  arma::vec userVec(rank);
+  size_t k = 0;
+  for (size_t i = start; i < start + batchSize; ++i)
+  {
+    // Indices for accessing the the correct parameter columns.
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const double* itemVec = parameters.colptr(item);
+
+    // The user vector is u(i) + sum(y(k)) / sqrt(|N(i)|), as in Gradient().
+    const size_t implicitCount = implicitData.col_ptrs[user + 1] -
+        implicitData.col_ptrs[user];
+    const double implicitScale = (implicitCount == 0) ? 0.0 :
+        1.0 / std::sqrt((double) implicitCount);
+    userVec.zeros();
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator itEnd = implicitData.end_col(user);
+    for (; it != itEnd; ++it)
+    {
+      const double* implicitVec = parameters.colptr(implicitStart + it.row());
+      for (size_t j = 0; j < rank; ++j)
+        userVec[j] += implicitScale * implicitVec[j];
+    }
+    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    // Prediction error for the example; the biases are held in row 'rank'.
+    double ratingError = data(2, i) - parameters(rank, user) - itemVec[rank];
+    for (size_t j = 0; j < rank; ++j)
+      ratingError -= userVec[j] * itemVec[j];
+
+    // GradientColumns() lists the user, the item, and then the implicit item
+    // vectors of the user.
+    const double* userParams = parameters.colptr(user);
+    double* userDelta = deltas.colptr(k++);
+    double* itemDelta = deltas.colptr(k++);
+    for (size_t j = 0; j < rank; ++j)
+    {
+      userDelta[j] = 2 * (lambda * userParams[j] - ratingError * itemVec[j]);
+      itemDelta[j] = 2 * (lambda * itemVec[j] - ratingError * userVec[j]);
+    }
+    userDelta[rank] = 2 * (lambda * userParams[rank] - ratingError);
+    itemDelta[rank] = 2 * (lambda * itemVec[rank] - ratingError);
+
+    for (it = implicitData.begin_col(user); it != itEnd; ++it)
+    {
+      // Note that implicitCount != 0 if this loop is actually executed.
+      const double* implicitVec = parameters.colptr(implicitStart + it.row());
+      double* implicitDelta = deltas.colptr(k++);
+      for (size_t j = 0; j < rank; ++j)
+      {
+        implicitDelta[j] = 2.0 * (lambda / implicitCount * implicitVec[j] -
+            ratingError * implicitScale * itemVec[j]);
+      }
+      implicitDelta[rank] = 0.0;
+    }
+  }
+}
+
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::GradientColumns(
+    const size_t start,
+    arma::uvec& columns,
+    const size_t batchSize) const
+{
+  size_t numColumns = 0;
+  for (size_t i = start; i < start + batchSize; ++i)
+  {
+    const size_t user = data(0, i);
+    numColumns += 2 + implicitData.col_ptrs[user + 1] -
+        implicitData.col_ptrs[user];
+  }
+
+  const size_t implicitStart = numUsers + numItems;
+  columns.set_size(numColumns);
+  size_t k = 0;
+  for (size_t i = start; i < start + batchSize; ++i)
+  {
+    const size_t user = data(0, i);
+    columns[k++] = user;
+    columns[k++] = data(1, i) + numUsers;
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator itEnd = implicitData.end_col(user);
+    for (; it != itEnd; ++it)
+      columns[k++] = implicitStart + it.row();
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
 
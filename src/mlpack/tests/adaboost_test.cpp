@@ -891,3 +891,106 @@ TEST_CASE("ID3DecisionStumpSerializationTest", "[AdaBoostTest]")
             abBinary.WeakLearner(i).SplitDimension());
   }
 }
+
+/**
+ * Run AdaBoost with presorted decision stumps on the UCI Iris dataset, and
+ * check that the Hamming loss bound holds and that boosting does not do worse
+ * than a single stump.
+ */
+TEST_CASE("PresortedDecisionStumpIris", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Cannot load test dataset iris.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load labels for iris_labels.txt");
+
+  const size_t numClasses = 3;
+  arma::Row<size_t> labelsvec = labels.row(0);
+  PresortedDecisionStump<InformationGain> ds(inputData, labelsvec, numClasses,
+      6);
+
+  arma::Row<size_t> dsPrediction;
+  ds.Classify(inputData, dsPrediction);
+  const double weakLearnerErrorRate =
+      (double) arma::accu(labels != dsPrediction) / labels.n_cols;
+
+  AdaBoost<PresortedDecisionStump<InformationGain>> a(1e-10);
+  double ztProduct = a.Train(inputData, labelsvec, numClasses, ds, 50, 1e-10);
+
+  arma::Row<size_t> predictedLabels;
+  arma::mat probabilities;
+  a.Classify(inputData, predictedLabels, probabilities);
+
+  const double error =
+      (double) arma::accu(labels != predictedLabels) / labels.n_cols;
+
+  REQUIRE(std::isfinite(ztProduct) == true);
+  REQUIRE(error <= ztProduct);
+  REQUIRE(error <= weakLearnerErrorRate + 0.03);
+
+  // Every column of the probabilities should sum to 1.
+  for (size_t i = 0; i < probabilities.n_cols; ++i)
+    REQUIRE(arma::accu(probabilities.col(i)) == Approx(1.0).epsilon(1e-7));
+}
+
+/**
+ * Make sure that a presorted decision stump finds the same split whether or not
+ * its sort cache was built for a different dataset.
+ */
+TEST_CASE("PresortedDecisionStumpCacheTest", "[AdaBoostTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 300);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = (data(2, i) > 0.4) ? 1 : 0;
+
+  PresortedDecisionStump<> stump(data, labels, 2);
+  REQUIRE(stump.SplitDimension() == 2);
+  REQUIRE(stump.SplitValue() == Approx(0.4).epsilon(0.05));
+
+  // Change the data in place, so the cached sort order is stale.
+  data = arma::randu<arma::mat>(4, 300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = (data(1, i) > 0.6) ? 1 : 0;
+
+  arma::rowvec weights(300, arma::fill::ones);
+  PresortedDecisionStump<> stump2(stump, data, labels, 2, weights);
+  REQUIRE(stump2.SplitDimension() == 1);
+  REQUIRE(stump2.SplitValue() == Approx(0.6).epsilon(0.05));
+
+  arma::Row<size_t> predictions;
+  stump2.Classify(data, predictions);
+  REQUIRE(arma::accu(predictions != labels) == 0);
+}
+
+/**
+ * Make sure that a stump that was moved from can still be trained.
+ */
+TEST_CASE("PresortedDecisionStumpMovedFromTest", "[AdaBoostTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 300);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = (data(2, i) > 0.4) ? 1 : 0;
+  arma::rowvec weights(300, arma::fill::ones);
+
+  PresortedDecisionStump<> stump(data, labels, 2);
+  PresortedDecisionStump<> moved(std::move(stump));
+  REQUIRE(moved.SplitDimension() == 2);
+
+  stump.Train(data, labels, 2, weights);
+  REQUIRE(stump.SplitDimension() == 2);
+  REQUIRE(stump.SplitValue() == Approx(0.4).epsilon(0.05));
+
+  // The same goes for move assignment.
+  PresortedDecisionStump<> assigned;
+  assigned = std::move(stump);
+  REQUIRE(assigned.SplitDimension() == 2);
+
+  stump.Train(data, labels, 2, weights);
+  REQUIRE(stump.SplitDimension() == 2);
+  REQUIRE(stump.SplitValue() == Approx(0.4).epsilon(0.05));
+}
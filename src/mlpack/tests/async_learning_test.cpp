@@ -247,3 +247,71 @@ TEST_CASE("NStepQLearningTest", "[AsyncLearningTest]")
   agent.Train(measure);
   Log::Debug << "Total test episodes: " << testEpisodes << std::endl;
 }
+
+/**
+ * Report how many training steps per second async one step Q-learning takes in
+ * Cart Pole with 1 to 64 threads.  This is a benchmark rather than a test, so
+ * it is hidden; run it with
+ *
+ *   mlpack_test "[AsyncLearningBenchmark]"
+ */
+TEST_CASE("AsyncLearningScalingBenchmark", "[.][AsyncLearningBenchmark]")
+{
+  #ifdef HAS_OPENMP
+    const size_t maxThreads = 64;
+    const size_t prevNumThreads = omp_get_max_threads();
+  #else
+    const size_t maxThreads = 1;
+  #endif
+
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    #ifdef HAS_OPENMP
+      omp_set_num_threads(threads);
+    #endif
+
+    // Set up the network.
+    FFN<MeanSquaredError<>, GaussianInitialization> model(MeanSquaredError<>(),
+        GaussianInitialization(0, 0.001));
+    model.Add<Linear>(20);
+    model.Add<ReLULayer>();
+    model.Add<Linear>(20);
+    model.Add<ReLULayer>();
+    model.Add<Linear>(2);
+
+    // Set up the policy.
+    GreedyPolicy<CartPole> policy(0.7, 5000, 0.1);
+
+    // Use one worker per thread, in addition to the evaluation worker.
+    TrainingConfig config;
+    config.StepSize() = 0.0001;
+    config.Discount() = 0.99;
+    config.NumWorkers() = threads;
+    config.UpdateInterval() = 6;
+    config.StepLimit() = 200;
+    config.TargetNetworkSyncInterval() = 200;
+
+    OneStepQLearning<
+        CartPole, decltype(model), ens::VanillaUpdate, decltype(policy)>
+        agent(std::move(config), std::move(model), std::move(policy));
+
+    // Train for about two seconds.
+    arma::wall_clock timer;
+    timer.tic();
+    auto measure = [&timer](double /* reward */)
+    {
+      return timer.toc() > 2.0;
+    };
+
+    agent.Train(measure);
+    const double seconds = timer.toc();
+
+    std::cout << threads << " threads: " << agent.TotalSteps() / seconds
+        << " steps/second." << std::endl;
+    REQUIRE(agent.TotalSteps() > 0);
+  }
+
+  #ifdef HAS_OPENMP
+    omp_set_num_threads(prevNumThreads);
+  #endif
+}
@@ -12,6 +12,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/bias_svd/bias_svd.hpp>
+#include <mlpack/methods/regularized_svd/stratified_sgd.hpp>
 
 #include <ensmallen.hpp>
 
@@ -299,6 +300,99 @@ TEST_CASE("BiasSVDFunctionOptimize", "[BiasSVDTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Make sure that the column updates of SparseGradient() add up to the
+// gradient of the same batch.
+TEST_CASE("BiasSVDFunctionSparseGradient", "[BiasSVDTest]")
+{
+  arma::mat data = arma::randu(3, 200);
+  data.row(0) = floor(data.row(0) * 20);
+  data.row(1) = floor(data.row(1) * 30);
+  BiasSVDFunction<arma::mat> biasSVDFunc(data, 5, 0.1);
+  REQUIRE(biasSVDFunc.WeightDecay() == 0.0);
+
+  const arma::mat parameters = biasSVDFunc.GetInitialPoint();
+  arma::uvec columns;
+  arma::mat deltas;
+  for (size_t i = 0; i < 200; i += 20)
+  {
+    arma::mat gradient;
+    biasSVDFunc.Gradient(parameters, i, gradient, 20);
+    biasSVDFunc.SparseGradient(parameters, i, columns, deltas, 20);
+    REQUIRE(deltas.n_rows == parameters.n_rows);
+
+    arma::mat sparseGradient(arma::size(gradient), arma::fill::zeros);
+    for (size_t k = 0; k < columns.n_elem; ++k)
+      sparseGradient.col(columns[k]) += deltas.col(k);
+    for (size_t j = 0; j < gradient.n_elem; ++j)
+      REQUIRE(sparseGradient[j] == Approx(gradient[j]).margin(1e-10));
+  }
+}
+
+// Test Bias SVD with stratified parallel SGD.
+TEST_CASE("BiasSVDFunctionStratifiedOptimize", "[BiasSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 100;
+  const size_t rank = 10;
+  const double alpha = 0.01;
+  const double lambda = 0.01;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank + 1, numUsers + numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const double userBias = parameters(rank, user);
+    const double itemBias = parameters(rank, item);
+    data(2, i) = userBias + itemBias +
+        arma::dot(parameters.col(user).subvec(0, rank - 1),
+                  parameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Make the Bias SVD function and the optimizer.
+  BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
+  StratifiedSGD<ens::ConstantStep> optimizer(0, 0, 1e-5, true,
+      ens::ConstantStep(alpha));
+
+  // Obtain optimized parameters after training.
+  arma::mat optParameters = arma::randu(rank + 1, numUsers + numItems);
+  optimizer.Optimize(biasSVDFunc, optParameters);
+
+  // Get predicted ratings from optimized parameters.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const double userBias = optParameters(rank, user);
+    const double itemBias = optParameters(rank, item);
+    predictedData(0, i) = userBias + itemBias +
+        arma::dot(optParameters.col(user).subvec(0, rank - 1),
+                  optParameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef HAS_OPENMP
@@ -15,6 +15,7 @@
 #include <mlpack/methods/cf/cf.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/implicit_als_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_complete_method.hpp>
@@ -34,6 +35,7 @@
 #include <mlpack/methods/cf/interpolation_policies/regression_interpolation.hpp>
 
 #include <iostream>
+#include <thread>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -477,6 +479,10 @@ void Serialization()
   CheckMatrices(c.Decomposition().H(), cXml.Decomposition().H(),
       cBinary.Decomposition().H(), cText.Decomposition().H());
 
+  // The neighborhood index is rebuilt from the decomposition.
+  CheckMatrices(c.UserIndex().ReferenceSet(), cXml.UserIndex().ReferenceSet(),
+      cBinary.UserIndex().ReferenceSet(), cText.UserIndex().ReferenceSet());
+
   REQUIRE(c.CleanedData().n_rows == cXml.CleanedData().n_rows);
   REQUIRE(c.CleanedData().n_rows == cBinary.CleanedData().n_rows);
   REQUIRE(c.CleanedData().n_rows == cText.CleanedData().n_rows);
@@ -589,6 +595,15 @@ TEST_CASE("CFGetRecommendationsAllUsersSVDPPTest", "[CFTest]")
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for implicit ALS.
+ */
+TEST_CASE("CFGetRecommendationsAllUsersImplicitALSTest", "[CFTest]")
+{
+  GetRecommendationsAllUsers<ImplicitALSPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
@@ -1007,6 +1022,14 @@ TEST_CASE("SerializationNMFTest", "[CFTest]")
   Serialization<NMFPolicy>();
 }
 
+/**
+ * Ensure we can load and save the CF model using implicit ALS.
+ */
+TEST_CASE("SerializationImplicitALSTest", "[CFTest]")
+{
+  Serialization<ImplicitALSPolicy>();
+}
+
 /**
  * Ensure we can load and save the CF model using SVD Complete Incremental.
  */
@@ -1237,3 +1260,316 @@ TEST_CASE("CFPredictRegressionInterpolation", "[CFTest]")
             EuclideanSearch,
             RegressionInterpolation>(2.2);
 }
+
+/**
+ * Make sure that the neighborhood index built by Train() finds the same
+ * neighborhoods as the decomposition policy.
+ */
+TEST_CASE("CFNeighborhoodIndexTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<NMFPolicy> c(dataset, NMFPolicy(), 5, 5, 30);
+  REQUIRE(c.UserIndex().NumUsers() == c.CleanedData().n_cols);
+
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t>>(0,
+      c.CleanedData().n_cols - 1, c.CleanedData().n_cols);
+
+  arma::Mat<size_t> neighborhood, indexNeighborhood;
+  arma::mat similarities, indexSimilarities;
+  c.Decomposition().GetNeighborhood<CosineSearch>(users, 5, neighborhood,
+      similarities);
+  c.UserIndex().Search<CosineSearch>(users, 5, indexNeighborhood,
+      indexSimilarities);
+
+  CheckMatrices(similarities, indexSimilarities);
+
+  // A second search reuses the search structure.
+  c.UserIndex().Search<CosineSearch>(users, 5, indexNeighborhood,
+      indexSimilarities);
+  CheckMatrices(similarities, indexSimilarities);
+}
+
+// A decomposition whose user factors can be modified directly.
+class UserFactorsPolicy
+{
+ public:
+  void GetUserFactors(arma::mat& factors) const { factors = h; }
+
+  arma::mat h;
+};
+
+/**
+ * Make sure that the neighborhood index gives the right neighborhoods after
+ * some users change and some users are added.
+ */
+TEST_CASE("NeighborhoodIndexUpdateTest", "[CFTest]")
+{
+  UserFactorsPolicy policy;
+  policy.h = arma::randu(4, 200);
+
+  NeighborhoodIndex index;
+  index.Build(policy);
+
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t>>(0, 199, 200);
+  arma::Mat<size_t> neighborhood;
+  arma::mat similarities;
+  index.Search<EuclideanSearch>(users, 5, neighborhood, similarities);
+
+  // Change a few users and add a few more.
+  arma::Col<size_t> changed = { 3, 17, 50, 51, 120, 199 };
+  for (size_t i = 0; i < changed.n_elem; ++i)
+    policy.h.col(changed[i]) = arma::randu<arma::vec>(4);
+  policy.h = arma::join_rows(policy.h, arma::randu(4, 5));
+  index.Update(policy, changed);
+  REQUIRE(index.NumUsers() == 205);
+
+  users = arma::linspace<arma::Col<size_t>>(0, 204, 205);
+  index.Search<EuclideanSearch>(users, 5, neighborhood, similarities);
+
+  // Compare against a search with all the current factors.
+  arma::Mat<size_t> trueNeighborhood;
+  arma::mat trueSimilarities;
+  EuclideanSearch search(policy.h);
+  search.Search(policy.h, 5, trueNeighborhood, trueSimilarities);
+
+  CheckMatrices(trueNeighborhood, neighborhood);
+  CheckMatrices(trueSimilarities, similarities);
+
+  // With users still pending, asking for every user as a neighbor must give
+  // every user once, and asking for more must fail.
+  index.Search<EuclideanSearch>(users, 205, neighborhood, similarities);
+  REQUIRE(neighborhood.n_rows == 205);
+  for (size_t i = 0; i < neighborhood.n_cols; ++i)
+  {
+    const arma::Col<size_t> sorted = arma::sort(neighborhood.col(i));
+    REQUIRE(arma::all(sorted == users));
+  }
+  REQUIRE_THROWS_AS(index.Search<EuclideanSearch>(users, 206, neighborhood,
+      similarities), std::invalid_argument);
+}
+
+/**
+ * Make sure that searches of the neighborhood index from several threads at
+ * once give the same neighborhoods as a single search, both before and after
+ * some users have changed.
+ */
+TEST_CASE("NeighborhoodIndexConcurrentSearchTest", "[CFTest]")
+{
+  UserFactorsPolicy policy;
+  policy.h = arma::randu(4, 300);
+
+  NeighborhoodIndex index;
+  index.Build(policy);
+
+  const arma::Col<size_t> users = arma::linspace<arma::Col<size_t>>(0, 299,
+      300);
+  const size_t numThreads = 8;
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    // In the second pass, a few users are pending, so each search also
+    // searches them separately and merges the results.
+    if (pass == 1)
+    {
+      arma::Col<size_t> changed = { 5, 42, 250 };
+      for (size_t i = 0; i < changed.n_elem; ++i)
+        policy.h.col(changed[i]) = arma::randu<arma::vec>(4);
+      index.Update(policy, changed);
+    }
+
+    arma::Mat<size_t> trueNeighborhood;
+    arma::mat trueSimilarities;
+    EuclideanSearch search(policy.h);
+    search.Search(policy.h, 7, trueNeighborhood, trueSimilarities);
+
+    // In the first pass, the search structure is built by whichever thread
+    // gets there first.
+    std::vector<arma::Mat<size_t>> neighborhoods(numThreads);
+    std::vector<arma::mat> similarities(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      threads.push_back(std::thread([&, t]()
+      {
+        for (size_t i = 0; i < 5; ++i)
+        {
+          index.Search<EuclideanSearch>(users, 7, neighborhoods[t],
+              similarities[t]);
+        }
+      }));
+    }
+
+    for (size_t t = 0; t < numThreads; ++t)
+      threads[t].join();
+
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      CheckMatrices(trueNeighborhood, neighborhoods[t]);
+      CheckMatrices(trueSimilarities, similarities[t]);
+    }
+  }
+}
+
+/**
+ * Make sure that recommendations computed from several threads at once with
+ * the same model are the same as those computed from a single thread.
+ */
+TEST_CASE("CFConcurrentRecommendationsTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<NMFPolicy> c(dataset, NMFPolicy(), 5, 5, 30);
+  CFType<NMFPolicy> copy(c);
+
+  arma::Mat<size_t> recommendations;
+  copy.GetRecommendations(10, recommendations);
+
+  const size_t numThreads = 4;
+  std::vector<arma::Mat<size_t>> threadRecommendations(numThreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread([&, t]()
+    {
+      c.GetRecommendations(10, threadRecommendations[t]);
+    }));
+  }
+
+  for (size_t t = 0; t < numThreads; ++t)
+    threads[t].join();
+
+  for (size_t t = 0; t < numThreads; ++t)
+    CheckMatrices(recommendations, threadRecommendations[t]);
+}
+
+/**
+ * Make sure that the batched recommendations are the un-rated items with the
+ * highest predicted ratings.
+ */
+template<typename DecompositionPolicy,
+         typename NormalizationType = NoNormalization>
+void GetRecommendationsMatchPredict()
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<DecompositionPolicy, NormalizationType> c(dataset,
+      DecompositionPolicy(), 5, 5, 30);
+  const arma::sp_mat& cleanedData = c.CleanedData();
+
+  const size_t numUsers = 20;
+  const size_t numRecs = 10;
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t>>(0,
+      numUsers - 1, numUsers);
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations, users);
+
+  REQUIRE(recommendations.n_rows == numRecs);
+  REQUIRE(recommendations.n_cols == numUsers);
+
+  // Predict the rating of every item for each user.
+  arma::Mat<size_t> combinations(2, cleanedData.n_rows);
+  combinations.row(1) = arma::linspace<arma::Row<size_t>>(0,
+      cleanedData.n_rows - 1, cleanedData.n_rows);
+  for (size_t i = 0; i < numUsers; ++i)
+  {
+    combinations.row(0).fill(i);
+    arma::vec predictions;
+    c.Predict(combinations, predictions);
+
+    std::vector<double> unrated;
+    for (size_t j = 0; j < cleanedData.n_rows; ++j)
+    {
+      if (cleanedData(j, i) == 0.0)
+        unrated.push_back(predictions[j]);
+    }
+    std::sort(unrated.begin(), unrated.end(), std::greater<double>());
+
+    for (size_t p = 0; p < numRecs; ++p)
+    {
+      REQUIRE(cleanedData(recommendations(p, i), i) == 0.0);
+      REQUIRE(predictions[recommendations(p, i)] ==
+          Approx(unrated[p]).epsilon(1e-5));
+    }
+  }
+}
+
+/**
+ * Make sure that batched recommendations are right for a factorization with
+ * biases and a per-item normalization.
+ */
+TEST_CASE("CFGetRecommendationsMatchPredictBiasSVDTest", "[CFTest]")
+{
+  GetRecommendationsMatchPredict<BiasSVDPolicy, ItemMeanNormalization>();
+}
+
+/**
+ * Make sure that batched recommendations are right for SVD++, whose user
+ * vectors include implicit feedback.
+ */
+TEST_CASE("CFGetRecommendationsMatchPredictSVDPPTest", "[CFTest]")
+{
+  GetRecommendationsMatchPredict<SVDPlusPlusPolicy>();
+}
+
+/**
+ * Make sure that implicit ALS recovers two groups of users that interact with
+ * two disjoint groups of items: every user should prefer the items of its own
+ * group that it hasn't interacted with over the items of the other group.
+ */
+TEST_CASE("ImplicitALSGroupPreferenceTest", "[CFTest]")
+{
+  const size_t numUsers = 40;
+  const size_t numItems = 60;
+
+  // Each user interacts with a random half of the items of its group, a random
+  // number of times.
+  std::vector<double> entries;
+  for (size_t u = 0; u < numUsers; ++u)
+  {
+    const size_t group = (u < numUsers / 2) ? 0 : 1;
+    for (size_t i = group * numItems / 2; i < (group + 1) * numItems / 2; ++i)
+    {
+      if (math::Random() < 0.5)
+      {
+        entries.push_back(u);
+        entries.push_back(i);
+        entries.push_back(math::RandInt(1, 6));
+      }
+    }
+  }
+  arma::mat dataset(entries.data(), 3, entries.size() / 3);
+
+  ImplicitALSPolicy decomposition(10.0, 0.1, 3);
+  CFType<ImplicitALSPolicy> c(dataset, decomposition, 5, 2, 20, 1e-5, true);
+
+  const arma::sp_mat& cleanedData = c.CleanedData();
+  for (size_t u = 0; u < cleanedData.n_cols; ++u)
+  {
+    const size_t group = (u < numUsers / 2) ? 0 : 1;
+    double ownPreference = 0.0, otherPreference = 0.0;
+    size_t ownItems = 0, otherItems = 0;
+    for (size_t i = 0; i < cleanedData.n_rows; ++i)
+    {
+      const double rating = c.Decomposition().GetRating(u, i);
+      if (i / (numItems / 2) != group)
+      {
+        otherPreference += rating;
+        ++otherItems;
+      }
+      else if (cleanedData(i, u) == 0.0)
+      {
+        ownPreference += rating;
+        ++ownItems;
+      }
+    }
+
+    if (ownItems > 0 && otherItems > 0)
+      REQUIRE(ownPreference / ownItems > otherPreference / otherItems);
+  }
+}
@@ -14,6 +14,8 @@
 
 #include <mlpack/methods/ann/layer/layer_types.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/loss_functions/mean_absolute_percentage_error.hpp>
+#include <mlpack/methods/ann/regularizer/lregularizer.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
 
 #include <ensmallen.hpp>
@@ -987,6 +989,154 @@ TEST_CASE("PartialForwardTest", "[FeedForwardNetworkTest]")
   CheckMatrices(output, arma::ones(10, 1) * 20);
 }
 
+/**
+ * Make sure that the inference-only pass used by Predict() gives the same
+ * results as a full forward pass, for networks that start and end with
+ * element-wise layers.
+ */
+TEST_CASE("FFNPredictInferenceTest", "[FeedForwardNetworkTest]")
+{
+  FFN<MeanSquaredError> model;
+  model.Add<ReLU>();
+  model.Add<Linear>(20);
+  model.Add<ReLU>();
+  model.Add<Sigmoid>();
+  model.Add<Linear>(15);
+  model.Add<TanH>();
+  model.Add<Linear>(5);
+  model.Add<LeakyReLU>();
+  model.Add<Sigmoid>();
+
+  model.Reset(10);
+
+  arma::mat input = arma::randn(10, 100);
+  arma::mat forwardOutput, predictOutput;
+  model.Forward(input, forwardOutput);
+
+  // Use a batch size that does not divide the number of points, so that the
+  // inference buffers are resized.
+  model.Predict(input, predictOutput, 32);
+
+  CheckMatrices(forwardOutput, predictOutput);
+
+  // A network that is only one element-wise layer should also work.
+  FFN<MeanSquaredError> model2;
+  model2.Add<ReLU>();
+  model2.Reset(10);
+  model2.Predict(input, predictOutput);
+  CheckMatrices(arma::clamp(input, 0, DBL_MAX), predictOutput);
+}
+
+/**
+ * Make sure that splitting each batch across replicas of the network gives the
+ * same objective and gradient as processing the batch in one pass, and that
+ * the result is the same every time for a given number of replicas.
+ */
+TEST_CASE("FFNReplicaGradientTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data = arma::randn(10, 64);
+  arma::mat responses = arma::randn(3, 64);
+
+  // Try both sum and mean reduction.
+  for (size_t i = 0; i < 2; ++i)
+  {
+    FFN<MeanSquaredError> model(MeanSquaredError(i == 0));
+    model.Add<Linear>(8);
+    model.Add<Sigmoid>();
+    model.Add<Linear>(3);
+
+    model.Reset(10);
+    model.ResetData(data, responses);
+
+    arma::mat gradient;
+    const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+        gradient, 64);
+
+    const size_t replicas[] = { 2, 3, 5, 100 };
+    for (size_t r = 0; r < 4; ++r)
+    {
+      model.Replicas() = replicas[r];
+
+      arma::mat replicaGradient, replicaGradient2;
+      const double replicaObjective = model.EvaluateWithGradient(
+          model.Parameters(), 0, replicaGradient, 64);
+      const double replicaObjective2 = model.EvaluateWithGradient(
+          model.Parameters(), 0, replicaGradient2, 64);
+
+      REQUIRE(replicaObjective == Approx(objective).epsilon(1e-7));
+      CheckMatrices(gradient, replicaGradient);
+
+      REQUIRE(replicaObjective == replicaObjective2);
+      REQUIRE(arma::accu(replicaGradient != replicaGradient2) == 0);
+    }
+  }
+}
+
+/**
+ * Make sure that the weight regularizer of a layer is counted once when each
+ * batch is split across replicas of the network.
+ */
+TEST_CASE("FFNReplicaRegularizerTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data = arma::randn(10, 64);
+  arma::mat responses = arma::randn(3, 64);
+
+  // Try both sum and mean reduction.
+  for (size_t i = 0; i < 2; ++i)
+  {
+    FFN<MeanSquaredError> model(MeanSquaredError(i == 0));
+    model.Add<LinearType<arma::mat, L2Regularizer>>(8, L2Regularizer(0.5));
+    model.Add<Sigmoid>();
+    model.Add<LinearType<arma::mat, L2Regularizer>>(3, L2Regularizer(0.5));
+
+    model.Reset(10);
+    model.ResetData(data, responses);
+
+    arma::mat gradient;
+    const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+        gradient, 64);
+
+    const size_t replicas[] = { 2, 3, 7 };
+    for (size_t r = 0; r < 3; ++r)
+    {
+      model.Replicas() = replicas[r];
+
+      arma::mat replicaGradient;
+      const double replicaObjective = model.EvaluateWithGradient(
+          model.Parameters(), 0, replicaGradient, 64);
+
+      REQUIRE(replicaObjective == Approx(objective).epsilon(1e-7));
+      CheckMatrices(gradient, replicaGradient);
+    }
+  }
+}
+
+/**
+ * Make sure that a network whose output layer does not say how it reduces over
+ * the batch cannot be split across replicas.
+ */
+TEST_CASE("FFNReplicaNoReductionTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data = arma::randn(10, 64);
+  arma::mat responses = arma::randu(3, 64) + 1.0;
+
+  FFN<MeanAbsolutePercentageError> model;
+  model.Add<Linear>(3);
+
+  model.Reset(10);
+  model.ResetData(data, responses);
+
+  arma::mat gradient;
+  model.EvaluateWithGradient(model.Parameters(), 0, gradient, 64);
+
+  model.Replicas() = 4;
+  REQUIRE_THROWS_AS(model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 64), std::invalid_argument);
+
+  // A batch of a single point is never split.
+  model.EvaluateWithGradient(model.Parameters(), 0, gradient, 1);
+}
+
 /**
  * Test that FFN::Train() returns finite objective value.
  */
@@ -1526,3 +1526,54 @@ TEST_CASE("HoeffdingTreeEmptyConstructorTrainTest", "[HoeffdingTreeTest]")
   REQUIRE_NOTHROW(ht.Train(data, labels, false, true, 2));
   REQUIRE_NOTHROW(ht.Train(data2, info, labels2, false, 3));
 }
+
+/**
+ * Make sure that training on a whole dataset in streaming mode gives the same
+ * tree as training on one point at a time, and that batch classification gives
+ * the same results as classifying one point at a time.
+ */
+TEST_CASE("HoeffdingTreeStreamingEquivalenceTest", "[HoeffdingTreeTest]")
+{
+  // Generate data with one categorical dimension.
+  arma::mat dataset(4, 12000);
+  arma::Row<size_t> labels(12000);
+  data::DatasetInfo info(4);
+  info.MapString<size_t>("cat0", 3);
+  info.MapString<size_t>("cat1", 3);
+  info.MapString<size_t>("cat2", 3);
+  for (size_t i = 0; i < 12000; ++i)
+  {
+    const size_t label = mlpack::math::RandInt(3);
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random() + 0.5 * label;
+    dataset(2, i) = mlpack::math::Random() - 0.3 * label;
+    dataset(3, i) = (mlpack::math::Random() < 0.7) ? label :
+        mlpack::math::RandInt(3);
+    labels[i] = label;
+  }
+
+  HoeffdingTree<> pointTree(info, 3, 0.95, 5000, 100, 100);
+  for (size_t i = 0; i < 12000; ++i)
+    pointTree.Train(dataset.col(i), labels[i]);
+
+  HoeffdingTree<> streamTree(info, 3, 0.95, 5000, 100, 100);
+  streamTree.Train(dataset, labels, false);
+
+  REQUIRE(pointTree.NumChildren() > 0);
+  REQUIRE(pointTree.NumDescendants() == streamTree.NumDescendants());
+  REQUIRE(pointTree.SplitDimension() == streamTree.SplitDimension());
+
+  arma::Row<size_t> predictions;
+  arma::rowvec probabilities;
+  streamTree.Classify(dataset, predictions, probabilities);
+  REQUIRE(predictions.n_elem == 12000);
+  REQUIRE(probabilities.n_elem == 12000);
+  for (size_t i = 0; i < 12000; ++i)
+  {
+    size_t prediction;
+    double probability;
+    pointTree.Classify(dataset.col(i), prediction, probability);
+    REQUIRE(predictions[i] == prediction);
+    REQUIRE(probabilities[i] == Approx(probability).epsilon(1e-10));
+  }
+}
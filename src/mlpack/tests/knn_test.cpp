@@ -718,6 +718,88 @@ TEST_CASE("KNNDualTreeVsNaive2", "[KNNTest]")
   }
 }
 
+/**
+ * Make sure that a tree loaded from an index file gives the same results as the
+ * tree it was saved from, even though it was saved with another statistic.
+ */
+TEST_CASE("KNNTreeIndexFileTest", "[KNNTest]")
+{
+  arma::mat dataset(5, 2000, arma::fill::randu);
+  arma::mat querySet(5, 300, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(dataset,
+      oldFromNew);
+  TreeIndexFile<KNN::Tree>::Save("knn_index.bin", tree, oldFromNew);
+
+  KNN knn(dataset);
+  arma::Mat<size_t> neighbors, loadedNeighbors;
+  arma::mat distances, loadedDistances;
+  knn.Search(querySet, 10, neighbors, distances);
+
+  {
+    TreeIndexFile<KNN::Tree> index("knn_index.bin");
+    const std::vector<size_t> loadedOldFromNew = index.OldFromNew();
+    REQUIRE(loadedOldFromNew == oldFromNew);
+
+    // The search object must be destroyed before the index.
+    KNN::Tree* referenceTree = index.LoadTree();
+    KNN loadedKnn(std::move(*referenceTree));
+    delete referenceTree;
+    loadedKnn.Search(querySet, 10, loadedNeighbors, loadedDistances);
+
+    // The results of the loaded tree refer to the points in tree order.
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(loadedOldFromNew[loadedNeighbors[i]] == neighbors[i]);
+      REQUIRE(loadedDistances[i] == Approx(distances[i]).epsilon(1e-7));
+    }
+  }
+
+  remove("knn_index.bin");
+}
+
+/**
+ * Test the dual-tree nearest-neighbors method with the naive method on
+ * high-dimensional data, where the base cases of each pair of leaves are
+ * computed in blocks.
+ */
+TEST_CASE("KNNHighDimensionalDualTreeVsNaive", "[KNNTest]")
+{
+  arma::mat dataset(80, 1000, arma::fill::randu);
+  arma::mat querySet(80, 200, arma::fill::randu);
+  // A query point that is also a reference point must be at distance zero.
+  querySet.col(10) = dataset.col(500);
+
+  KNN knn(dataset);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree, neighborsNaive;
+  arma::mat distancesTree, distancesNaive;
+
+  // Test both the monochromatic and the bichromatic search.
+  knn.Search(10, neighborsTree, distancesTree);
+  naive.Search(10, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree[i] == neighborsNaive[i]);
+    REQUIRE(distancesTree[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  knn.Search(querySet, 10, neighborsTree, distancesTree);
+  naive.Search(querySet, 10, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree[i] == neighborsNaive[i]);
+    REQUIRE(distancesTree[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  REQUIRE(neighborsTree(0, 10) == 500);
+  REQUIRE(distancesTree(0, 10) == 0.0);
+}
+
 /**
  * Test the single-tree nearest-neighbors method with the naive method.  This
  * uses only a reference dataset.
@@ -1061,6 +1143,180 @@ TEST_CASE("SparseKNNCoverTreeTest", "[KNNTest]")
 }
 */
 
+/**
+ * Insert points into and delete points from the reference tree of an R*-tree
+ * search, and make sure that the results are the same as those of a search on
+ * the points that are left.
+ */
+TEST_CASE("KNNDynamicRStarTreeTest", "[KNNTest]")
+{
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      RStarTree> KNNType;
+
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::mat querySet(3, 100, arma::fill::randu);
+
+  // Start with a few points, and insert the others one at a time and then all
+  // at once.
+  KNNType knn(arma::mat(dataset.cols(0, 99)));
+  for (size_t i = 100; i < 200; ++i)
+    knn.Insert(arma::mat(dataset.col(i)));
+  knn.Insert(arma::mat(dataset.cols(200, 999)));
+
+  REQUIRE(knn.ReferenceSet().n_cols == 1000);
+  REQUIRE(knn.ReferenceTree().NumDescendants() == 1000);
+  CheckMatrices(knn.ReferenceSet(), dataset);
+
+  // Delete every third point.  Deleting points twice does nothing.
+  arma::Col<size_t> deleted = arma::regspace<arma::Col<size_t>>(0, 3, 999);
+  knn.Delete(deleted);
+  knn.Delete(deleted.subvec(0, 9));
+  REQUIRE(knn.ReferenceTree().NumDescendants() == 1000 - deleted.n_elem);
+
+  arma::uvec remaining(1000 - deleted.n_elem);
+  for (size_t i = 0, j = 0; i < 1000; ++i)
+    if (i % 3 != 0)
+      remaining[j++] = i;
+
+  KNN naive(dataset.cols(remaining), NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors, neighbors;
+  arma::mat naiveDistances, distances;
+  naive.Search(querySet, 5, naiveNeighbors, naiveDistances);
+
+  const NeighborSearchMode modes[] = { SINGLE_TREE_MODE, DUAL_TREE_MODE };
+  for (const NeighborSearchMode mode : modes)
+  {
+    knn.SearchMode() = mode;
+    knn.Search(querySet, 5, neighbors, distances);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(neighbors[i] == remaining[naiveNeighbors[i]]);
+      REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+    }
+  }
+
+  REQUIRE_THROWS_AS(knn.Delete(arma::Col<size_t>({ 1000 })),
+      std::invalid_argument);
+
+  // kd-trees can't be updated.
+  KNN kdKnn(dataset);
+  REQUIRE_THROWS_AS(kdKnn.Insert(querySet), std::invalid_argument);
+  REQUIRE_THROWS_AS(kdKnn.Delete(deleted), std::invalid_argument);
+}
+
+/**
+ * Make sure that a monochromatic search after points were deleted doesn't
+ * search for the neighbors of the deleted points, in any search mode.
+ */
+TEST_CASE("KNNDynamicMonochromaticDeleteTest", "[KNNTest]")
+{
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      RStarTree> KNNType;
+
+  arma::mat dataset(3, 500, arma::fill::randu);
+  KNNType knn(dataset);
+
+  // Delete every fourth point.
+  arma::Col<size_t> deleted = arma::regspace<arma::Col<size_t>>(0, 4, 499);
+  knn.Delete(deleted);
+
+  arma::uvec remaining(500 - deleted.n_elem);
+  for (size_t i = 0, j = 0; i < 500; ++i)
+    if (i % 4 != 0)
+      remaining[j++] = i;
+
+  KNN naive(dataset.cols(remaining), NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors, neighbors;
+  arma::mat naiveDistances, distances;
+  naive.Search(5, naiveNeighbors, naiveDistances);
+
+  const NeighborSearchMode modes[] = { SINGLE_TREE_MODE, DUAL_TREE_MODE,
+      GREEDY_SINGLE_TREE_MODE };
+  for (const NeighborSearchMode mode : modes)
+  {
+    knn.SearchMode() = mode;
+    knn.Search(5, neighbors, distances);
+
+    REQUIRE(neighbors.n_cols == 500);
+    REQUIRE(distances.n_cols == 500);
+
+    for (size_t i = 0; i < deleted.n_elem; ++i)
+    {
+      for (size_t j = 0; j < 5; ++j)
+      {
+        REQUIRE(neighbors(j, deleted[i]) == size_t() - 1);
+        REQUIRE(distances(j, deleted[i]) == DBL_MAX);
+      }
+    }
+
+    // The greedy search is approximate, so only check that it returns
+    // remaining points.
+    for (size_t i = 0; i < remaining.n_elem; ++i)
+    {
+      for (size_t j = 0; j < 5; ++j)
+      {
+        if (mode == GREEDY_SINGLE_TREE_MODE)
+        {
+          REQUIRE(neighbors(j, remaining[i]) % 4 != 0);
+          continue;
+        }
+
+        REQUIRE(neighbors(j, remaining[i]) ==
+            remaining[naiveNeighbors(j, i)]);
+        REQUIRE(distances(j, remaining[i]) ==
+            Approx(naiveDistances(j, i)).epsilon(1e-7));
+      }
+    }
+  }
+
+  // Only the remaining points can be neighbors.
+  REQUIRE_THROWS_AS(knn.Search(remaining.n_elem, neighbors, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that points can be inserted into and deleted from an NSModel.
+ */
+TEST_CASE("KNNModelInsertDeleteTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat queryData = arma::randu<arma::mat>(5, 30);
+  arma::mat referenceData = arma::randu<arma::mat>(5, 300);
+
+  KNNModel model(KNNModel::TreeTypes::R_TREE, false);
+  model.BuildModel(timers, arma::mat(referenceData.cols(0, 199)),
+      DUAL_TREE_MODE);
+  model.Insert(timers, arma::mat(referenceData.cols(200, 299)));
+  model.Delete(timers, arma::Col<size_t>({ 0, 10, 250 }));
+  REQUIRE(model.Dataset().n_cols == 300);
+
+  arma::uvec remaining(297);
+  for (size_t i = 0, j = 0; i < 300; ++i)
+    if (i != 0 && i != 10 && i != 250)
+      remaining[j++] = i;
+
+  KNN naive(referenceData.cols(remaining), NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors, neighbors;
+  arma::mat naiveDistances, distances;
+  naive.Search(queryData, 3, naiveNeighbors, naiveDistances);
+  model.Search(timers, arma::mat(queryData), 3, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == remaining[naiveNeighbors[i]]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+  }
+
+  // Models with kd-trees can't be updated.
+  KNNModel kdModel(KNNModel::TreeTypes::KD_TREE, false);
+  kdModel.BuildModel(timers, arma::mat(referenceData), DUAL_TREE_MODE);
+  REQUIRE_THROWS_AS(kdModel.Insert(timers, arma::mat(queryData)),
+      std::invalid_argument);
+}
+
 TEST_CASE("KNNModelTest", "[KNNTest]")
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1153,6 +1409,55 @@ TEST_CASE("KNNModelTest", "[KNNTest]")
   }
 }
 
+/**
+ * Make sure that an NSModel built on single-precision data returns the same
+ * neighbors as a search on the same data in double precision, for every tree
+ * type.
+ */
+TEST_CASE("KNNFloatModelTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort, arma::fmat> KNNFloatModel;
+  util::Timers timers;
+
+  arma::fmat queryData = arma::randu<arma::fmat>(10, 50);
+  arma::fmat referenceData = arma::randu<arma::fmat>(10, 200);
+
+  // Get a baseline on the same points in double precision.
+  KNN knn(arma::conv_to<arma::mat>::from(referenceData));
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(arma::conv_to<arma::mat>::from(queryData), 3, baselineNeighbors,
+      baselineDistances);
+
+  for (size_t t = KNNFloatModel::KD_TREE; t <= KNNFloatModel::OCTREE; ++t)
+  {
+    // Spill trees don't return exact results.
+    if (t == KNNFloatModel::SPILL_TREE)
+      continue;
+
+    KNNFloatModel model((KNNFloatModel::TreeTypes) t, false);
+    model.LeafSize() = 20;
+    model.BuildModel(timers, arma::fmat(referenceData), DUAL_TREE_MODE);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    model.Search(timers, arma::fmat(queryData), 3, neighbors, distances);
+
+    REQUIRE(neighbors.n_rows == 3);
+    REQUIRE(neighbors.n_cols == 50);
+    for (size_t i = 0; i < distances.n_elem; ++i)
+    {
+      // Neighbors at nearly the same distance may be ordered differently in
+      // single precision, so check the distances instead of the indices.
+      REQUIRE(distances[i] == Approx(baselineDistances[i]).epsilon(1e-5));
+      const double distance = EuclideanDistance::Evaluate(
+          arma::conv_to<arma::vec>::from(queryData.col(i / 3)),
+          arma::conv_to<arma::vec>::from(referenceData.col(neighbors[i])));
+      REQUIRE(distance == Approx(baselineDistances[i]).epsilon(1e-5));
+    }
+  }
+}
+
 TEST_CASE("KNNModelMonochromaticTest", "[KNNTest]")
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -469,3 +469,73 @@ TEST_CASE("LARSCopyConstructorTest", "[LARSTest]")
   // The output of both models should be the same.
   CheckMatrices(predictions, predictionsFromCopiedModel);
 }
+
+// Make sure that training on sparse data without a Gram matrix gives the same
+// model as training on the equivalent dense data.
+TEST_CASE("LARSSparseCovarianceFreeTest", "[LARSTest]")
+{
+  arma::sp_mat sparseX;
+  sparseX.sprandu(40, 200, 0.2);
+  arma::mat X(sparseX);
+  arma::vec beta = arma::randn(40);
+  arma::rowvec y = beta.t() * X;
+
+  const double lambda1 = 0.5 * arma::abs(X * y.t()).max();
+  for (size_t i = 0; i < 2; ++i)
+  {
+    const double lambda2 = (i == 0) ? 0.0 : 0.1;
+    LARS denseLars(true, lambda1, lambda2);
+    LARS sparseLars(false, lambda1, lambda2);
+
+    arma::vec denseBeta, sparseBeta;
+    denseLars.Train(X, y, denseBeta);
+    sparseLars.Train(sparseX, y, sparseBeta);
+
+    CheckMatrices(denseBeta, sparseBeta, 1e-5);
+    REQUIRE(denseLars.ActiveSet() == sparseLars.ActiveSet());
+
+    arma::vec errCorr = (X * trans(X) + lambda2 * arma::eye(40, 40)) *
+        sparseBeta - X * y.t();
+    LARSVerifyCorrectness(sparseBeta, errCorr, lambda1);
+
+    arma::rowvec densePredictions, sparsePredictions;
+    denseLars.Predict(X, densePredictions);
+    sparseLars.Predict(sparseX, sparsePredictions);
+    CheckMatrices(densePredictions, sparsePredictions, 1e-5);
+  }
+}
+
+// Make sure that every solution along a regularization path is the same as the
+// solution found by training with that lambda.
+TEST_CASE("LARSRegularizationPathTest", "[LARSTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 100, 10);
+
+  const double maxCorr = arma::abs(X * y.t()).max();
+  arma::vec lambdas = { 2.0 * maxCorr, 0.8 * maxCorr, 0.3 * maxCorr,
+      0.5 * maxCorr, 0.05 * maxCorr };
+
+  LARS pathLars(true);
+  arma::mat betas;
+  pathLars.RegularizationPath(X, y, lambdas, betas);
+
+  REQUIRE(betas.n_rows == 10);
+  REQUIRE(betas.n_cols == lambdas.n_elem);
+  REQUIRE(arma::accu(arma::abs(betas.col(0))) == 0.0);
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    LARS lars(true, lambdas[i]);
+    arma::vec beta;
+    lars.Train(X, y, beta);
+
+    CheckMatrices(beta, arma::vec(betas.col(i)), 1e-5);
+  }
+
+  // Negative lambdas are not allowed.
+  lambdas[2] = -1.0;
+  REQUIRE_THROWS_AS(pathLars.RegularizationPath(X, y, lambdas, betas),
+      std::invalid_argument);
+}
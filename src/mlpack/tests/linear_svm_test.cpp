@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/linear_svm/linear_svm.hpp>
+#include <mlpack/methods/logistic_regression/hogwild_sgd.hpp>
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
@@ -892,6 +893,97 @@ TEST_CASE("LinearSVMSparseLBFGSTest", "[LinearSVMTest]")
   }
 }
 
+/**
+ * Make sure the sparse gradient matches the dense gradient when every element
+ * of the batch is nonzero, with and without the intercept.
+ */
+TEST_CASE("LinearSVMFunctionSparseGradient", "[LinearSVMTest]")
+{
+  const size_t points = 50;
+  const size_t inputSize = 5;
+  const size_t numClasses = 4;
+
+  arma::mat data(inputSize, points, arma::fill::randu);
+  data += 0.1;
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+
+  for (size_t fitIntercept = 0; fitIntercept < 2; ++fitIntercept)
+  {
+    LinearSVMFunction<> svmf(data, labels, numClasses, 0.5, 1.0,
+        fitIntercept == 1);
+    arma::mat parameters(inputSize + fitIntercept, numClasses,
+        arma::fill::randn);
+
+    arma::mat gradient;
+    arma::sp_mat sparseGradient;
+    for (size_t k = 0; k < points; k += 10)
+    {
+      svmf.Gradient(parameters, k, gradient, 10);
+      svmf.SparseGradient(parameters, k, sparseGradient, 10);
+
+      const arma::mat converted(sparseGradient);
+      REQUIRE(converted.n_rows == gradient.n_rows);
+      REQUIRE(converted.n_cols == gradient.n_cols);
+      for (size_t j = 0; j < gradient.n_elem; ++j)
+        REQUIRE(converted[j] == Approx(gradient[j]).epsilon(1e-7));
+    }
+  }
+
+  // Zero one feature of one point; the row of that feature must be empty, and
+  // only the other features and the intercept may hold elements.
+  data(2, 4) = 0.0;
+  const arma::sp_mat sparseData(data);
+  LinearSVMFunction<arma::sp_mat> sparseSvmf(sparseData, labels, numClasses,
+      0.5, 1.0, true);
+  const arma::mat parameters(inputSize + 1, numClasses, arma::fill::randn);
+  arma::sp_mat sparseGradient;
+  sparseSvmf.SparseGradient(parameters, 4, sparseGradient, 1);
+  REQUIRE(sparseGradient.n_nonzero == inputSize * numClasses);
+  for (size_t c = 0; c < numClasses; ++c)
+    REQUIRE(sparseGradient(2, c) == 0.0);
+}
+
+/**
+ * Train a linear svm on sparse data with Hogwild! SGD on a two-Gaussian
+ * dataset.
+ */
+TEST_CASE("LinearSVMHogwildSGDTwoClasses", "[LinearSVMTest]")
+{
+  const size_t points = 500;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.5;
+  const double delta = 1.0;
+
+  // Generate two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+  const arma::sp_mat sparseData(data);
+
+  regression::HogwildSGD<> optimizer(50);
+  LinearSVM<arma::sp_mat> lsvm(sparseData, labels, numClasses, lambda, delta,
+      false, optimizer);
+
+  // Compare training accuracy to 1.
+  const double acc = lsvm.ComputeAccuracy(sparseData, labels);
+  REQUIRE(acc == Approx(1.0).epsilon(0.02));
+}
+
 /**
  * Test training of linear svm for multiple classes on a complex gaussian
  * dataset using L-BFGS optimizer.
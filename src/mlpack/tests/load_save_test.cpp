@@ -2504,3 +2504,128 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Make sure that loading a large transposed CSV into a DatasetInfo, which is
+ * done in parallel, gives the same matrix and the same mappings as the serial
+ * parser.  The serial result is obtained by loading the same data written
+ * non-transposed.
+ */
+TEST_CASE("ParallelCategoricalCSVMatchesSerialTest", "[LoadSaveTest]")
+{
+  const size_t numPoints = 20000;
+  const size_t numDims = 6;
+  const char* colors[] = { "red", "green", "\"dark, blue\"", "yellow" };
+
+  // Dimension 0 is numeric, dimension 1 is categorical, dimension 2 is numeric
+  // except for one point near the end of the file, dimension 3 mixes numbers
+  // and strings, dimension 4 has many distinct strings, and dimension 5 has
+  // quoted strings with delimiters in them.
+  std::vector<std::vector<std::string>> tokens(numDims,
+      std::vector<std::string>(numPoints));
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    tokens[0][i] = std::to_string(math::Random(-10.0, 10.0));
+    tokens[1][i] = (math::Random() < 0.5) ? "yes" : "no";
+    tokens[2][i] = (i == numPoints - 10) ? "missing" :
+        std::to_string(math::RandInt(100));
+    tokens[3][i] = (math::Random() < 0.5) ? std::to_string(math::RandInt(5)) :
+        "n" + std::to_string(math::RandInt(5));
+    tokens[4][i] = "id" + std::to_string(math::RandInt(numPoints));
+    tokens[5][i] = colors[math::RandInt(4)];
+  }
+
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    for (size_t d = 0; d < numDims; ++d)
+      f << tokens[d][i] << ((d == numDims - 1) ? "\n" : ", ");
+  }
+  f.close();
+
+  f.open("test_nt.csv", fstream::out);
+  for (size_t d = 0; d < numDims; ++d)
+  {
+    for (size_t i = 0; i < numPoints; ++i)
+      f << tokens[d][i] << ((i == numPoints - 1) ? "\n" : ", ");
+  }
+  f.close();
+
+  arma::mat dataset, serialDataset;
+  DatasetInfo info, serialInfo;
+  REQUIRE(data::Load("test.csv", dataset, info, false, true));
+  REQUIRE(data::Load("test_nt.csv", serialDataset, serialInfo, false, false));
+
+  REQUIRE(dataset.n_rows == numDims);
+  REQUIRE(dataset.n_cols == numPoints);
+  REQUIRE(arma::approx_equal(dataset, serialDataset, "absdiff", 0.0));
+
+  REQUIRE(info.Dimensionality() == numDims);
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.Type(2) == Datatype::categorical);
+  REQUIRE(info.Type(3) == Datatype::categorical);
+  REQUIRE(info.Type(4) == Datatype::categorical);
+  REQUIRE(info.Type(5) == Datatype::categorical);
+  REQUIRE(info.NumMappings(5) == 4);
+
+  for (size_t d = 0; d < numDims; ++d)
+  {
+    REQUIRE(info.Type(d) == serialInfo.Type(d));
+    REQUIRE(info.NumMappings(d) == serialInfo.NumMappings(d));
+    for (size_t m = 0; m < info.NumMappings(d); ++m)
+      REQUIRE(info.UnmapString(m, d) == serialInfo.UnmapString(m, d));
+  }
+
+  remove("test.csv");
+  remove("test_nt.csv");
+}
+
+/**
+ * Make sure that the parallel parser rejects a line with the wrong number of
+ * dimensions, even far into the file.
+ */
+TEST_CASE("ParallelCategoricalCSVWrongDimensionsTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < 10000; ++i)
+    f << i << ", " << (i % 3) << ", a" << i % 7 << endl;
+  f << "1, 2" << endl;
+  f << "3, 4, a" << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.csv", dataset, info, false, true) == false);
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure that the parallel parser rejects blank and whitespace-only lines
+ * in the middle of the file, like the serial parser.
+ */
+TEST_CASE("ParallelCategoricalCSVBlankLineTest", "[LoadSaveTest]")
+{
+  const char* blankLines[] = { "", "  \t " };
+  for (const char* blankLine : blankLines)
+  {
+    fstream f;
+    f.open("test.csv", fstream::out);
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      f << i << ", " << (i % 3) << ", a" << i % 7 << endl;
+      if (i == 5000)
+        f << blankLine << endl;
+    }
+    f.close();
+
+    arma::mat dataset;
+    DatasetInfo info;
+    REQUIRE(data::Load("test.csv", dataset, info, false, true) == false);
+  }
+
+  remove("test.csv");
+}
@@ -11,7 +11,9 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/logistic_regression/hogwild_sgd.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
+#include <mlpack/methods/logistic_regression/synchronous_sgd.hpp>
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
@@ -835,6 +837,127 @@ TEST_CASE("LogisticRegressionSparseSGDTest", "[LogisticRegressionTest]")
         Approx(lrSparse.Parameters()[i]).epsilon(1e-5));
 }
 
+/**
+ * Make sure the sparse gradient matches the dense gradient when every element
+ * of the batch is nonzero, and only holds the nonzero features otherwise.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseGradient",
+          "[LogisticRegressionTest]")
+{
+  arma::mat data(5, 20, arma::fill::randu);
+  data += 0.1;
+  arma::Row<size_t> responses(20);
+  for (size_t i = 0; i < 20; ++i)
+    responses[i] = i % 2;
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.5);
+  const arma::mat parameters(1, 6, arma::fill::randn);
+
+  arma::mat gradient;
+  arma::sp_mat sparseGradient;
+  lrf.Gradient(parameters, 3, gradient, 7);
+  lrf.SparseGradient(parameters, 3, sparseGradient, 7);
+
+  const arma::mat converted(sparseGradient);
+  REQUIRE(converted.n_rows == gradient.n_rows);
+  REQUIRE(converted.n_cols == gradient.n_cols);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(converted[i] == Approx(gradient[i]).epsilon(1e-7));
+
+  // Zero one feature of one point; its gradient element must be empty.
+  data(2, 4) = 0.0;
+  LogisticRegressionFunction<arma::sp_mat> sparseLrf(arma::sp_mat(data),
+      responses, 0.5);
+  sparseLrf.SparseGradient(parameters, 4, sparseGradient, 1);
+  REQUIRE(sparseGradient.n_nonzero == 5);
+  REQUIRE(arma::mat(sparseGradient)(0, 3) == 0.0);
+}
+
+/**
+ * Train sparse logistic regression with Hogwild! SGD on a two-Gaussian dataset.
+ */
+TEST_CASE("LogisticRegressionHogwildSGDTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+  const arma::sp_mat sparseData(data);
+
+  LogisticRegression<arma::sp_mat> lr(data.n_rows, 0.5);
+  HogwildSGD<> hogwild(20);
+  lr.Train(sparseData, responses, hogwild);
+
+  // Ensure that the error is close to zero.
+  const double acc = lr.ComputeAccuracy(sparseData, responses);
+  REQUIRE(acc == Approx(100.0).epsilon(0.01)); // 1% error tolerance.
+}
+
+/**
+ * Train logistic regression with synchronous parallel SGD, and make sure that
+ * training again from the same seed with a different number of threads gives
+ * the same model.
+ */
+TEST_CASE("LogisticRegressionSynchronousSGDTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  SynchronousSGD<> sgd(32, 4, 20);
+
+  math::RandomSeed(12);
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  lr.Train(data, responses, sgd);
+
+  // The mini-batch gradients are summed in a fixed order, so the number of
+  // threads must not change the result.
+  #ifdef HAS_OPENMP
+    const size_t prevNumThreads = omp_get_max_threads();
+    omp_set_num_threads(prevNumThreads > 1 ? 1 : 3);
+  #endif
+
+  math::RandomSeed(12);
+  LogisticRegression<> lr2(data.n_rows, 0.5);
+  lr2.Train(data, responses, sgd);
+
+  #ifdef HAS_OPENMP
+    omp_set_num_threads(prevNumThreads);
+  #endif
+
+  const double acc = lr.ComputeAccuracy(data, responses);
+  REQUIRE(acc == Approx(100.0).epsilon(0.01)); // 1% error tolerance.
+
+  REQUIRE(lr.Parameters().n_elem == lr2.Parameters().n_elem);
+  for (size_t i = 0; i < lr.Parameters().n_elem; ++i)
+    REQUIRE(lr.Parameters()[i] == lr2.Parameters()[i]);
+}
+
 /**
  * Test multi-point classification (Classify()).
  */
@@ -141,7 +141,7 @@ TEST_CASE_METHOD(CFTestFixture, "CFNeighborhoodBoundTest",
 /**
  * Ensure algorithm is one of { "NMF", "BatchSVD",
  * "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
- * "BiasSVD", "SVDPP" }.
+ * "BiasSVD", "SVDPP", "ImplicitALS" }.
  */
 TEST_CASE_METHOD(CFTestFixture, "CFAlgorithmBoundTest",
                 "[CFMainTest][BindingTests]")
@@ -166,7 +166,7 @@ TEST_CASE_METHOD(CFTestFixture, "CFModelReuseTest",
 {
   std::string algorithms[] = { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "BiasSVD", "SVDPP" };
+      "BiasSVD", "SVDPP", "ImplicitALS" };
 
   mat dataset;
   data::Load("GroupLensSmall.csv", dataset);
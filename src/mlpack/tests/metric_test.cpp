@@ -97,6 +97,104 @@ TEST_CASE("LINFMetricTest", "[MetricTest]")
       Approx(lMetric.Evaluate(a2, b2)).epsilon(1e-7));
 }
 
+/**
+ * Make sure that LMetric::EvaluateBlock() gives the same distances as
+ * Evaluate() for every pair of points.
+ */
+template<typename MetricType>
+void CheckEvaluateBlock(const size_t dimensionality,
+                        const bool expandNorms = false)
+{
+  arma::mat a(dimensionality, 30, arma::fill::randn);
+  arma::mat b(dimensionality, 20, arma::fill::randn);
+  // Identical points must have a distance of zero.
+  b.col(3) = a.col(7);
+
+  arma::mat distances;
+  MetricType::EvaluateBlock(a, b, distances, expandNorms);
+
+  REQUIRE(distances.n_rows == a.n_cols);
+  REQUIRE(distances.n_cols == b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      // The identical pair is checked below.
+      if (i == 7 && j == 3)
+        continue;
+
+      REQUIRE(distances(i, j) ==
+          Approx(MetricType::Evaluate(a.col(i), b.col(j))).epsilon(1e-7));
+    }
+  }
+
+  // The norm expansion leaves some rounding error; otherwise the distance must
+  // be exact.
+  if (expandNorms)
+    REQUIRE(distances(7, 3) == Approx(0.0).margin(1e-5));
+  else
+    REQUIRE(distances(7, 3) == 0.0);
+}
+
+/**
+ * Test the block evaluation of the L-metrics, with both the direct kernel and
+ * (for Euclidean distances, when asked for) the matrix multiplication.
+ */
+TEST_CASE("LMetricEvaluateBlockTest", "[MetricTest]")
+{
+  for (const size_t dimensionality : { 5, 100 })
+  {
+    CheckEvaluateBlock<ManhattanDistance>(dimensionality);
+    CheckEvaluateBlock<SquaredEuclideanDistance>(dimensionality);
+    CheckEvaluateBlock<EuclideanDistance>(dimensionality);
+    CheckEvaluateBlock<LMetric<3, true>>(dimensionality);
+    CheckEvaluateBlock<LMetric<4, false>>(dimensionality);
+    CheckEvaluateBlock<ChebyshevDistance>(dimensionality);
+  }
+
+  CheckEvaluateBlock<SquaredEuclideanDistance>(100, true);
+  CheckEvaluateBlock<EuclideanDistance>(100, true);
+}
+
+/**
+ * Make sure that an LMetric that sums in double precision gives the distances
+ * between single-precision points as computed in double precision, and that it
+ * gives the usual distances between double-precision points.
+ */
+TEST_CASE("LMetricAccumulationTypeTest", "[MetricTest]")
+{
+  // One large difference makes the small terms round away when the sum is done
+  // in float.
+  arma::fmat a(1000, 6, arma::fill::randu);
+  arma::fmat b(1000, 4, arma::fill::randu);
+  a.row(0) += 1000.0f;
+  const arma::mat ad = arma::conv_to<arma::mat>::from(a);
+  const arma::mat bd = arma::conv_to<arma::mat>::from(b);
+
+  typedef LMetric<2, false, double> AccumulatedDistance;
+
+  arma::fmat distances;
+  AccumulatedDistance::EvaluateBlock(a, b, distances);
+  arma::mat exactDistances;
+  SquaredEuclideanDistance::EvaluateBlock(ad, bd, exactDistances);
+
+  REQUIRE(distances.n_rows == a.n_cols);
+  REQUIRE(distances.n_cols == b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      const float exact = (float) SquaredEuclideanDistance::Evaluate(
+          ad.col(i), bd.col(j));
+      REQUIRE(AccumulatedDistance::Evaluate(a.col(i), b.col(j)) ==
+          Approx(exact).epsilon(1e-7));
+      REQUIRE(distances(i, j) == Approx(exact).epsilon(1e-7));
+      REQUIRE(AccumulatedDistance::Evaluate(ad.col(i), bd.col(j)) ==
+          Approx(exactDistances(i, j)).epsilon(1e-10));
+    }
+  }
+}
+
 /**
  * Simple test for IoU metric.
  */
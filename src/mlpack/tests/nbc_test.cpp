@@ -12,6 +12,7 @@
 #include <mlpack/methods/naive_bayes/naive_bayes_classifier.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 using namespace naive_bayes;
@@ -398,3 +399,186 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * Make sure that merging two models trained on separate shards of a dataset
+ * gives the same model as training on the whole dataset.
+ */
+TEST_CASE("NaiveBayesClassifierMergeTest", "[NBCTest]")
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  if (!data::Load(trainFilename, trainData))
+    FAIL("Cannot load dataset");
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  const size_t half = trainData.n_cols / 2;
+  NaiveBayesClassifier<> nbc(trainData, labels, classes);
+  NaiveBayesClassifier<> nbcFirst(trainData.cols(0, half - 1),
+      labels.subvec(0, half - 1), classes);
+  NaiveBayesClassifier<> nbcSecond(trainData.cols(half, trainData.n_cols - 1),
+      labels.subvec(half, trainData.n_cols - 1), classes);
+
+  nbcFirst.Merge(nbcSecond);
+
+  REQUIRE(nbcFirst.TrainingPoints() == trainData.n_cols);
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+  {
+    if (std::abs(nbc.Means()[i]) < 1e-5)
+      REQUIRE(nbcFirst.Means()[i] == Approx(0.0).margin(1e-5));
+    else
+      REQUIRE(nbc.Means()[i] == Approx(nbcFirst.Means()[i]).epsilon(1e-7));
+  }
+
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+  {
+    if (std::abs(nbc.Variances()[i]) < 1e-5)
+      REQUIRE(nbcFirst.Variances()[i] == Approx(0.0).margin(1e-5));
+    else
+    {
+      REQUIRE(nbc.Variances()[i] ==
+          Approx(nbcFirst.Variances()[i]).epsilon(1e-7));
+    }
+  }
+
+  for (size_t i = 0; i < nbc.Probabilities().n_elem; ++i)
+  {
+    REQUIRE(nbc.Probabilities()[i] ==
+        Approx(nbcFirst.Probabilities()[i]).epsilon(1e-7));
+  }
+
+  // Models with a different number of classes cannot be merged.
+  NaiveBayesClassifier<> nbcWrong(trainData.n_rows, classes + 1);
+  REQUIRE_THROWS_AS(nbc.Merge(nbcWrong), std::invalid_argument);
+}
+
+/**
+ * Make sure that incrementally training on a second batch after the first
+ * gives the same model as training on both batches at once.
+ */
+TEST_CASE("NaiveBayesClassifierBatchIncrementalTest", "[NBCTest]")
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  if (!data::Load(trainFilename, trainData))
+    FAIL("Cannot load dataset");
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  const size_t half = trainData.n_cols / 2;
+  NaiveBayesClassifier<> nbc(trainData, labels, classes);
+  NaiveBayesClassifier<> nbcTrain(trainData.n_rows, classes);
+  nbcTrain.Train(trainData.cols(0, half - 1), labels.subvec(0, half - 1),
+      classes);
+  nbcTrain.Train(trainData.cols(half, trainData.n_cols - 1),
+      labels.subvec(half, trainData.n_cols - 1), classes);
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+    REQUIRE(nbc.Means()[i] == Approx(nbcTrain.Means()[i]).margin(1e-7));
+
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+  {
+    REQUIRE(nbc.Variances()[i] ==
+        Approx(nbcTrain.Variances()[i]).margin(1e-7));
+  }
+
+  // The predictions of both models should match.
+  arma::Row<size_t> predictions, trainPredictions;
+  nbc.Classify(trainData, predictions);
+  nbcTrain.Classify(trainData, trainPredictions);
+  CheckMatrices(predictions, trainPredictions);
+}
+
+/**
+ * Make sure that a model trained point by point can be trained further with a
+ * batch, even when epsilon is large: both training paths must add epsilon to
+ * the variances in the same way.
+ */
+TEST_CASE("NaiveBayesClassifierPointThenBatchTest", "[NBCTest]")
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  if (!data::Load(trainFilename, trainData))
+    FAIL("Cannot load dataset");
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  const size_t half = trainData.n_cols / 2;
+  NaiveBayesClassifier<> nbc(trainData, labels, classes, false, 0.1);
+  NaiveBayesClassifier<> nbcTrain(trainData.n_rows, classes, 0.1);
+  for (size_t i = 0; i < half; ++i)
+    nbcTrain.Train(trainData.col(i), labels[i]);
+  nbcTrain.Train(trainData.cols(half, trainData.n_cols - 1),
+      labels.subvec(half, trainData.n_cols - 1), classes);
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+    REQUIRE(nbc.Means()[i] == Approx(nbcTrain.Means()[i]).margin(1e-7));
+
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+  {
+    REQUIRE(nbc.Variances()[i] ==
+        Approx(nbcTrain.Variances()[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that the batched log likelihood stays accurate when a feature has
+ * a large mean and a small variance.
+ */
+TEST_CASE("NaiveBayesClassifierLargeOffsetTest", "[NBCTest]")
+{
+  // The two classes differ by four standard deviations in the first feature,
+  // which is offset by 1e8.
+  const size_t points = 1000;
+  arma::mat data(2, points, arma::fill::randn);
+  data *= 0.1;
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = i % 2;
+    data(0, i) += 1e8 + ((i % 2 == 0) ? -0.2 : 0.2);
+  }
+
+  NaiveBayesClassifier<> nbc(data, labels, 2);
+
+  // Compute the predictions directly from the model.
+  arma::Row<size_t> predictions;
+  nbc.Classify(data, predictions);
+  for (size_t i = 0; i < points; ++i)
+  {
+    arma::vec scores(2);
+    for (size_t c = 0; c < 2; ++c)
+    {
+      scores[c] = std::log(nbc.Probabilities()[c]) -
+          0.5 * arma::accu(arma::log(nbc.Variances().col(c))) -
+          0.5 * arma::accu(arma::square(data.col(i) - nbc.Means().col(c)) /
+          nbc.Variances().col(c));
+    }
+
+    // Skip points that are (almost) on the decision boundary.
+    if (std::abs(scores[0] - scores[1]) < 1e-3)
+      continue;
+
+    REQUIRE(predictions[i] == scores.index_max());
+  }
+}
@@ -13,6 +13,7 @@
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 #include <mlpack/core/data/one_hot_encoding.hpp>
+#include <mlpack/core/data/feature_hashing.hpp>
 
 using namespace mlpack;
 using namespace mlpack::data;
@@ -230,3 +231,103 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Make sure that the sparse one hot encoding is the same as the dense one.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat matrix = arma::randi<arma::mat>(5, 200, arma::distr_param(0, 6));
+  matrix.row(1) *= 0.5;
+  arma::Col<size_t> indices("0 2 4");
+
+  arma::mat dense;
+  arma::sp_mat sparse;
+  data::OneHotEncoding(matrix, indices, dense);
+  data::OneHotEncoding(matrix, indices, sparse);
+
+  REQUIRE(sparse.n_rows == dense.n_rows);
+  REQUIRE(sparse.n_cols == dense.n_cols);
+  REQUIRE(sparse.n_nonzero == (size_t) arma::accu(dense != 0));
+  REQUIRE(arma::approx_equal(arma::mat(sparse), dense, "absdiff", 1e-12));
+}
+
+/**
+ * Make sure that loading a sparse matrix with a DatasetInfo gives the same
+ * result as loading a dense matrix and one hot encoding it.
+ */
+TEST_CASE("OneHotEncodingSparseLoadTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2, hello, 0" << endl;
+  f << "3, 0, goodbye, 1" << endl;
+  f << "5, 6, coffee, 0" << endl;
+  f << "0, 8, confusion, 2" << endl;
+  f << "9, 10, hello, 1" << endl;
+  f << "11, 12, confusion, 0" << endl;
+  f << "13, 14, confusion, 2" << endl;
+  f.close();
+
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test.csv", matrix, info))
+    FAIL("Cannot load dataset test.csv");
+  arma::mat dense;
+  data::OneHotEncoding(matrix, dense, info);
+
+  arma::sp_mat sparse;
+  DatasetInfo sparseInfo;
+  if (!data::Load("test.csv", sparse, sparseInfo))
+    FAIL("Cannot load dataset test.csv");
+
+  REQUIRE(sparseInfo.Dimensionality() == 4);
+  REQUIRE(sparseInfo.Type(2) == Datatype::categorical);
+  REQUIRE(sparseInfo.NumMappings(2) == 4);
+  REQUIRE(sparse.n_rows == dense.n_rows);
+  REQUIRE(sparse.n_cols == 7);
+  REQUIRE(arma::approx_equal(arma::mat(sparse), dense, "absdiff", 1e-12));
+
+  remove("test.csv");
+}
+
+/**
+ * Check the shape of the output of feature hashing, and that each hashed
+ * dimension adds exactly one to its point when signs are not alternated.
+ */
+TEST_CASE("FeatureHashingTest", "[OneHotEncodingTest]")
+{
+  arma::mat matrix = arma::randi<arma::mat>(6, 300,
+      arma::distr_param(1, 1000));
+  arma::Col<size_t> indices("1 3 4");
+
+  arma::sp_mat output;
+  data::FeatureHashing(matrix, indices, 16, output, false);
+
+  REQUIRE(output.n_rows == 3 + 16);
+  REQUIRE(output.n_cols == 300);
+
+  // The dimensions that are not encoded are copied in order.
+  arma::mat denseOutput(output);
+  REQUIRE(arma::approx_equal(denseOutput.row(0), matrix.row(0), "absdiff",
+      1e-12));
+  REQUIRE(arma::approx_equal(denseOutput.row(1), matrix.row(2), "absdiff",
+      1e-12));
+  REQUIRE(arma::approx_equal(denseOutput.row(2), matrix.row(5), "absdiff",
+      1e-12));
+
+  // Each encoded dimension adds one to some hashed row.
+  arma::rowvec sums = arma::sum(denseOutput.rows(3, 18), 0);
+  for (size_t i = 0; i < sums.n_elem; ++i)
+    REQUIRE(sums[i] == Approx(3.0));
+
+  // Equal values are hashed to the same rows, with signs or without.
+  arma::mat copy = matrix;
+  copy.col(1) = copy.col(0);
+  arma::sp_mat signedOutput;
+  data::FeatureHashing(copy, indices, 16, signedOutput);
+  REQUIRE(arma::approx_equal(arma::mat(signedOutput.col(0)),
+      arma::mat(signedOutput.col(1)), "absdiff", 1e-12));
+  REQUIRE(arma::accu(arma::abs(arma::mat(signedOutput.rows(3, 18)))) <=
+      3 * 300);
+}
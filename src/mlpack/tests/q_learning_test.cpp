@@ -29,6 +29,7 @@
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/cart_pole.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/double_pole_cart.hpp>
+#include <mlpack/methods/reinforcement_learning/environment/vectorized_environment.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
 #include <mlpack/methods/reinforcement_learning/training_config.hpp>
 
@@ -123,6 +124,99 @@ TEST_CASE("CartPoleWithDQN", "[QLearningTest]")
   REQUIRE(converged);
 }
 
+//! Test DQN in Cart Pole task, with several copies stepped in lockstep.
+TEST_CASE("VectorizedCartPoleWithDQN", "[QLearningTest]")
+{
+  // Set up the network.
+  SimpleDQN<> network(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  // Setting all training hyperparameters.
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  // Step eight copies of the task until the average return of the last 50
+  // episodes is high enough.
+  VectorizedEnvironment<CartPole> environments(8);
+  environments.Reset();
+
+  bool converged = false;
+  std::vector<double> returnList;
+  for (size_t step = 0; step < 5000 && !converged; ++step)
+  {
+    for (const double episodeReturn : agent.Step(environments))
+      returnList.push_back(episodeReturn);
+
+    if (returnList.size() > 50)
+    {
+      returnList.erase(returnList.begin(),
+          returnList.begin() + (returnList.size() - 50));
+    }
+
+    const double averageReturn = std::accumulate(returnList.begin(),
+        returnList.end(), 0.0) / std::max<size_t>(returnList.size(), 1);
+    converged = (returnList.size() == 50 && averageReturn > 40);
+  }
+
+  // Every transition is counted.
+  REQUIRE(agent.TotalSteps() % 8 == 0);
+  REQUIRE(converged);
+}
+
+/**
+ * Make sure that stepping copies in lockstep anneals the policy once per
+ * transition past the exploration steps, like Episode(), and cuts off
+ * episodes at the step limit.
+ */
+TEST_CASE("VectorizedDQNAnnealAndStepLimit", "[QLearningTest]")
+{
+  SimpleDQN<> network(4, 16, 16, 2);
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.StepLimit() = 5;
+  config.DoubleQLearning() = false;
+
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  VectorizedEnvironment<CartPole> environments(8);
+  environments.Reset();
+
+  size_t numEpisodes = 0;
+  for (size_t step = 0; step < 30; ++step)
+  {
+    numEpisodes += agent.Step(environments).size();
+    REQUIRE(arma::all(environments.StepsPerformed() < 5));
+  }
+
+  // Every episode lasts at most five steps.
+  REQUIRE(agent.TotalSteps() == 240);
+  REQUIRE(numEpisodes >= 8 * 6);
+
+  // Transitions 101 to 240 each anneal the policy once.
+  GreedyPolicy<CartPole> expectedPolicy(1.0, 1000, 0.1, 0.99);
+  for (size_t i = 0; i < 140; ++i)
+    expectedPolicy.Anneal();
+  REQUIRE(policy.Epsilon() == Approx(expectedPolicy.Epsilon()).epsilon(1e-7));
+}
+
 //! Test DQN in Cart Pole task with Prioritized Replay.
 TEST_CASE("CartPoleWithDQNPrioritizedReplay", "[QLearningTest]")
 {
@@ -591,3 +685,56 @@ TEST_CASE("SACForMultipleActions", "[QLearningTest]")
   // If the agent is able to reach till this point of the test, it is assured
   // that the agent can handle multiple actions in continuous space.
 }
+
+/**
+ * Step SAC on several copies of Pendulum in lockstep, and make sure that every
+ * transition is counted and episodes are cut off at the step limit.
+ */
+TEST_CASE("VectorizedPendulumWithSAC", "[QLearningTest]")
+{
+  RandomReplay<Pendulum> replayMethod(32, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.001;
+  config.TargetNetworkSyncInterval() = 1;
+  config.UpdateInterval() = 3;
+  config.ExplorationSteps() = 32;
+  config.StepLimit() = 20;
+
+  FFN<EmptyLoss<>, GaussianInitialization>
+      policyNetwork(EmptyLoss<>(), GaussianInitialization(0, 0.1));
+  policyNetwork.Add(new Linear<>(3, 32));
+  policyNetwork.Add(new ReLULayer<>());
+  policyNetwork.Add(new Linear<>(32, 1));
+  policyNetwork.Add(new TanHLayer<>());
+
+  FFN<EmptyLoss<>, GaussianInitialization>
+      qNetwork(EmptyLoss<>(), GaussianInitialization(0, 0.1));
+  qNetwork.Add(new Linear<>(3 + 1, 32));
+  qNetwork.Add(new ReLULayer<>());
+  qNetwork.Add(new Linear<>(32, 1));
+
+  SAC<Pendulum, decltype(qNetwork), decltype(policyNetwork), AdamUpdate>
+      agent(config, qNetwork, policyNetwork, replayMethod);
+
+  VectorizedEnvironment<Pendulum> environments(4);
+  environments.Reset();
+
+  const arma::mat initialParameters = policyNetwork.Parameters();
+  std::vector<double> returns = agent.Step(environments, 50);
+
+  REQUIRE(agent.TotalSteps() == 200);
+  // Each copy finished two episodes of 20 steps and is halfway through the
+  // third.
+  REQUIRE(returns.size() == 8);
+  REQUIRE(arma::all(environments.StepsPerformed() == 10));
+  for (const double episodeReturn : returns)
+  {
+    REQUIRE(std::isfinite(episodeReturn));
+    REQUIRE(episodeReturn <= 0.0);
+  }
+
+  // The networks were trained.
+  REQUIRE(arma::accu(arma::abs(policyNetwork.Parameters() -
+      initialParameters)) > 0.0);
+}
@@ -1355,6 +1355,71 @@ TEST_CASE("RSModelTest", "[RangeSearchTest]")
   }
 }
 
+/**
+ * Make sure that an RSModel built on single-precision data finds the same
+ * points as a search on the same data in double precision.
+ */
+TEST_CASE("RSFloatModelTest", "[RangeSearchTest]")
+{
+  typedef RSModelType<arma::fmat> RSFloatModel;
+  util::Timers timers;
+
+  arma::fmat queryData = arma::randu<arma::fmat>(10, 50);
+  arma::fmat referenceData = arma::randu<arma::fmat>(10, 200);
+  const math::Range range(0.7, 1.1);
+
+  // Get a baseline on the same points in double precision.
+  RangeSearch<> rs(arma::conv_to<arma::mat>::from(referenceData));
+  vector<vector<size_t>> baselineNeighbors;
+  vector<vector<double>> baselineDistances;
+  rs.Search(arma::conv_to<arma::mat>::from(queryData), range,
+      baselineNeighbors, baselineDistances);
+
+  for (size_t t = RSFloatModel::KD_TREE; t <= RSFloatModel::OCTREE; ++t)
+  {
+    RSFloatModel model((RSFloatModel::TreeTypes) t, false);
+    model.BuildModel(timers, arma::fmat(referenceData), 5, false, false);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    model.Search(timers, arma::fmat(queryData), range, neighbors, distances);
+
+    REQUIRE(neighbors.size() == baselineNeighbors.size());
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      // Every result must be a baseline result, unless it lies so close to
+      // the edge of the range that single precision may place it inside.
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+      {
+        const vector<size_t>::const_iterator it = std::find(
+            baselineNeighbors[i].begin(), baselineNeighbors[i].end(),
+            neighbors[i][j]);
+        if (it == baselineNeighbors[i].end())
+        {
+          REQUIRE(std::min(std::abs(distances[i][j] - range.Lo()),
+              std::abs(distances[i][j] - range.Hi())) < 1e-5);
+          continue;
+        }
+
+        const size_t index = it - baselineNeighbors[i].begin();
+        REQUIRE(distances[i][j] ==
+            Approx(baselineDistances[i][index]).epsilon(1e-5));
+      }
+
+      // And every baseline result must be found, with the same exception.
+      for (size_t j = 0; j < baselineNeighbors[i].size(); ++j)
+      {
+        if (std::find(neighbors[i].begin(), neighbors[i].end(),
+            baselineNeighbors[i][j]) == neighbors[i].end())
+        {
+          REQUIRE(std::min(std::abs(baselineDistances[i][j] - range.Lo()),
+              std::abs(baselineDistances[i][j] - range.Hi())) < 1e-5);
+        }
+      }
+    }
+  }
+}
+
 TEST_CASE("RSModelMonochromaticTest", "[RangeSearchTest]")
 {
   // Ensure that we can build an RSModel and get correct results.
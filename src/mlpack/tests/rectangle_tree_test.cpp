@@ -1359,3 +1359,126 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Count the leaves under (and including) the given node.
+ */
+template<typename TreeType>
+size_t CountLeaves(const TreeType& tree)
+{
+  if (tree.IsLeaf())
+    return 1;
+
+  size_t numLeaves = 0;
+  for (size_t i = 0; i < tree.NumChildren(); ++i)
+    numLeaves += CountLeaves(tree.Child(i));
+
+  return numLeaves;
+}
+
+/**
+ * Bulk-load a tree, make sure that it is valid and that its leaves are full,
+ * and then insert more points into it and make sure that nearest neighbor
+ * search still gives the same results as a naive search.
+ */
+template<template<typename, typename, typename> class TreeType>
+void CheckBulkLoad()
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> Tree;
+
+  const int numIter = 50;
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  Tree tree(dataset, 20, 6, 5, 2, 0, true);
+
+  REQUIRE(tree.NumDescendants() == 1000);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckFills(tree);
+  CheckNumDescendants(tree);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+
+  // Every leaf should be full.
+  REQUIRE(CountLeaves(tree) == 50);
+
+  // Now insert points, as in the PointDynamicAdd test.
+  tree.Dataset().reshape(8, 1000 + numIter);
+  dataset.reshape(8, 1000 + numIter);
+  arma::mat tmpData;
+  tmpData.randu(8, numIter);
+  for (int i = 0; i < numIter; ++i)
+  {
+    tree.Dataset().col(1000 + i) = tmpData.col(i);
+    dataset.col(1000 + i) = tmpData.col(i);
+    tree.InsertPoint(1000 + i);
+  }
+
+  REQUIRE(tree.NumDescendants() == 1000 + numIter);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+
+  arma::Mat<size_t> neighbors1, neighbors2;
+  arma::mat distances1, distances2;
+
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      TreeType> knn1(std::move(tree), SINGLE_TREE_MODE);
+  knn1.Search(5, neighbors1, distances1);
+
+  KNN knn2(dataset, NAIVE_MODE);
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(distances1[i] == distances2[i]);
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+  }
+}
+
+// Make sure that bulk-loaded R, R*, X and Hilbert R trees are valid and can be
+// grown afterwards.
+TEST_CASE("RectangleTreeBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  CheckBulkLoad<RTree>();
+  CheckBulkLoad<RStarTree>();
+  CheckBulkLoad<XTree>();
+  CheckBulkLoad<HilbertRTree>();
+}
+
+// Make sure that the Hilbert values of a bulk-loaded Hilbert R tree are in sync
+// with its points, before and after insertion.
+TEST_CASE("HilbertRTreeBulkLoadOrderingTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef HilbertRTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> TreeType;
+  TreeType tree(dataset, 20, 6, 5, 2, 0, true);
+
+  CheckHilbertValue(tree);
+  CheckDiscreteHilbertValueSync(tree);
+  CheckHilbertOrdering(tree);
+
+  tree.Dataset().reshape(8, 1100);
+  tree.Dataset().cols(1000, 1099).randu();
+  for (size_t i = 1000; i < 1100; ++i)
+    tree.InsertPoint(i);
+
+  CheckHilbertValue(tree);
+  CheckDiscreteHilbertValueSync(tree);
+  CheckHilbertOrdering(tree);
+  CheckContainment(tree);
+  CheckNumDescendants(tree);
+
+  // A copy of a bulk-loaded tree should be valid too.
+  TreeType copy(tree);
+  CheckHilbertValue(copy);
+  CheckDiscreteHilbertValueSync(copy);
+  CheckHilbertOrdering(copy);
+}
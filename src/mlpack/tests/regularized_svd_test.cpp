@@ -11,6 +11,8 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/regularized_svd/regularized_svd.hpp>
+#include <mlpack/methods/regularized_svd/sparse_sgd.hpp>
+#include <mlpack/methods/regularized_svd/stratified_sgd.hpp>
 
 #include <ensmallen.hpp>
 
@@ -249,6 +251,172 @@ TEST_CASE("RegularizedSVDFunctionOptimize", "[RegularizedSVDTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Make sure that UpdateRating() takes the same step as the gradient of one
+// rating.
+TEST_CASE("RegularizedSVDFunctionUpdateRating", "[RegularizedSVDTest]")
+{
+  arma::mat data = arma::randu(3, 200);
+  data.row(0) = floor(data.row(0) * 20);
+  data.row(1) = floor(data.row(1) * 30);
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, 5, 0.1);
+
+  arma::mat parameters = rSVDFunc.GetInitialPoint();
+  arma::mat sharedUpdate;
+  REQUIRE(rSVDFunc.NumSharedColumns() == 0);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::mat gradient;
+    rSVDFunc.Gradient(parameters, i, gradient, 1);
+    const arma::mat expected = parameters - 0.05 * gradient;
+
+    rSVDFunc.UpdateRating(parameters, i, 0.05, sharedUpdate);
+    for (size_t j = 0; j < parameters.n_elem; ++j)
+      REQUIRE(parameters[j] == Approx(expected[j]).epsilon(1e-10));
+  }
+}
+
+// Test Regularized SVD with stratified parallel SGD.
+TEST_CASE("RegularizedSVDFunctionOptimizeStratifiedSGD",
+          "[RegularizedSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 100;
+  const size_t rank = 10;
+  const double alpha = 0.01;
+  const double lambda = 0.01;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank, numUsers + numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    data(2, i) = arma::dot(parameters.col(data(0, i)),
+                           parameters.col(numUsers + data(1, i)));
+  }
+
+  // Make the Reg SVD function and the optimizer, with more blocks than there
+  // are threads.
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
+  StratifiedSGD<ConstantStep> optimizer(0, 7, 1e-5, true,
+      ConstantStep(alpha));
+
+  // Obtain optimized parameters after training.
+  arma::mat optParameters = arma::randu(rank, numUsers + numItems);
+  optimizer.Optimize(rSVDFunc, optParameters);
+
+  // Get predicted ratings from optimized parameters.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    predictedData(0, i) = arma::dot(optParameters.col(data(0, i)),
+                                    optParameters.col(numUsers + data(1, i)));
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
+
+// Make sure that the column updates of SparseGradient() add up to the
+// gradient of the same batch.
+TEST_CASE("RegularizedSVDFunctionSparseGradient", "[RegularizedSVDTest]")
+{
+  arma::mat data = arma::randu(3, 200);
+  data.row(0) = floor(data.row(0) * 20);
+  data.row(1) = floor(data.row(1) * 30);
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, 5, 0.1);
+  REQUIRE(rSVDFunc.WeightDecay() == 0.0);
+
+  const arma::mat parameters = rSVDFunc.GetInitialPoint();
+  arma::uvec columns, gradientColumns;
+  arma::mat deltas;
+  for (size_t i = 0; i < 200; i += 20)
+  {
+    arma::mat gradient;
+    rSVDFunc.Gradient(parameters, i, gradient, 20);
+    rSVDFunc.SparseGradient(parameters, i, columns, deltas, 20);
+    rSVDFunc.GradientColumns(i, gradientColumns, 20);
+    REQUIRE(deltas.n_rows == parameters.n_rows);
+    REQUIRE(arma::all(columns == gradientColumns));
+
+    arma::mat sparseGradient(arma::size(gradient), arma::fill::zeros);
+    for (size_t k = 0; k < columns.n_elem; ++k)
+      sparseGradient.col(columns[k]) += deltas.col(k);
+    for (size_t j = 0; j < gradient.n_elem; ++j)
+      REQUIRE(sparseGradient[j] == Approx(gradient[j]).margin(1e-10));
+  }
+}
+
+// Test Regularized SVD with sparse SGD.
+TEST_CASE("RegularizedSVDFunctionOptimizeSparseSGD", "[RegularizedSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 100;
+  const size_t rank = 10;
+  const double alpha = 0.01;
+  const double lambda = 0.01;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank, numUsers + numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    data(2, i) = arma::dot(parameters.col(data(0, i)),
+                           parameters.col(numUsers + data(1, i)));
+  }
+
+  // Make the Reg SVD function and the optimizer.
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
+  SparseSGD<ConstantStep> optimizer(1, 0, 1e-5, true,
+      ConstantStep(alpha));
+
+  // Obtain optimized parameters after training.
+  arma::mat optParameters = arma::randu(rank, numUsers + numItems);
+  optimizer.Optimize(rSVDFunc, optParameters);
+
+  // Get predicted ratings from optimized parameters.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    predictedData(0, i) = arma::dot(optParameters.col(data(0, i)),
+                                    optParameters.col(numUsers + data(1, i)));
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef HAS_OPENMP
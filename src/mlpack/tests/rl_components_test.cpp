@@ -20,8 +20,11 @@
 #include <mlpack/methods/reinforcement_learning/environment/continuous_double_pole_cart.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/pendulum.hpp>
+#include <mlpack/methods/reinforcement_learning/environment/vectorized_environment.hpp>
 #include <mlpack/methods/reinforcement_learning/replay/random_replay.hpp>
+#include <mlpack/methods/reinforcement_learning/replay/ring_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
+#include <mlpack/methods/reinforcement_learning/worker/shared_target_parameters.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -271,6 +274,266 @@ TEST_CASE("RandomReplayTest", "[RLComponentsTest]")
   }
 }
 
+/**
+ * Store batches of transitions that wrap around the memory and check that only
+ * the most recent transitions are kept.
+ */
+TEST_CASE("RandomReplayBatchStoreTest", "[RLComponentsTest]")
+{
+  RandomReplay<CartPole> replay(5, 5);
+
+  // Transition i has every state variable and the reward set to i.
+  arma::mat states(CartPole::State::dimension, 7);
+  std::vector<CartPole::Action> actions(7);
+  for (size_t i = 0; i < 7; ++i)
+  {
+    states.col(i).fill(i);
+    actions[i].action = (i % 2 == 0) ? CartPole::Action::actions::backward :
+        CartPole::Action::actions::forward;
+  }
+  const arma::rowvec rewards = arma::regspace<arma::rowvec>(0, 6);
+  arma::irowvec isTerminal(7, arma::fill::zeros);
+
+  replay.BatchStore(states.cols(0, 2), std::vector<CartPole::Action>(
+      actions.begin(), actions.begin() + 3), rewards.subvec(0, 2),
+      states.cols(0, 2) + 1, isTerminal.subvec(0, 2));
+  REQUIRE(replay.Size() == 3);
+
+  replay.BatchStore(states.cols(3, 6), std::vector<CartPole::Action>(
+      actions.begin() + 3, actions.end()), rewards.subvec(3, 6),
+      states.cols(3, 6) + 1, isTerminal.subvec(3, 6));
+  REQUIRE(replay.Size() == 5);
+
+  arma::mat sampledStates;
+  std::vector<CartPole::Action> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::mat sampledNextStates;
+  arma::irowvec sampledTerminal;
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    replay.Sample(sampledStates, sampledActions, sampledRewards,
+        sampledNextStates, sampledTerminal);
+    for (size_t i = 0; i < sampledStates.n_cols; ++i)
+    {
+      // The first two transitions were overwritten.
+      const size_t index = sampledRewards[i];
+      REQUIRE(index >= 2);
+      CheckMatrices(sampledStates.col(i), states.col(index));
+      CheckMatrices(sampledNextStates.col(i), states.col(index) + 1);
+      REQUIRE(sampledActions[i].action == actions[index].action);
+      REQUIRE(sampledTerminal[i] == 0);
+    }
+  }
+}
+
+/**
+ * Store n-step transitions in a ring replay, and check the sampled returns and
+ * next states, including across episodes and after the memory wraps around.
+ */
+TEST_CASE("RingReplayTest", "[RLComponentsTest]")
+{
+  // The state of step t has every state variable set to t.
+  auto state = [](const double t)
+  {
+    arma::colvec data(CartPole::State::dimension);
+    data.fill(t);
+    return CartPole::State(data);
+  };
+  CartPole::Action action;
+  action.action = CartPole::Action::actions::forward;
+
+  RingReplay<CartPole> replay(32, 20, 3);
+
+  // An episode of five steps, with reward t + 1 at step t.
+  for (size_t t = 0; t < 5; ++t)
+    replay.Store(state(t), action, t + 1, state(t + 1), t == 4, 0.9);
+  REQUIRE(replay.Size() == 5);
+
+  // A second episode that is cut off: the last two transitions can't span
+  // three steps and are dropped.
+  for (size_t t = 100; t < 104; ++t)
+    replay.Store(state(t), action, 1.0, state(t + 1), false, 0.9);
+  REQUIRE(replay.Size() == 7);
+
+  arma::mat sampledStates, sampledNextStates;
+  std::vector<CartPole::Action> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::irowvec sampledTerminal;
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    replay.Sample(sampledStates, sampledActions, sampledRewards,
+        sampledNextStates, sampledTerminal);
+    REQUIRE(sampledStates.n_cols == 32);
+    REQUIRE(sampledActions.size() == 32);
+    for (size_t i = 0; i < sampledStates.n_cols; ++i)
+    {
+      const size_t t = sampledStates(0, i);
+      if (t < 5)
+      {
+        double expectedReturn = 0.0;
+        for (size_t k = std::min<size_t>(t + 3, 5); k > t; --k)
+          expectedReturn = k + 0.9 * expectedReturn;
+        REQUIRE(sampledRewards[i] == Approx(expectedReturn).epsilon(1e-7));
+        CheckMatrices(sampledNextStates.col(i),
+            state(std::min<size_t>(t + 3, 5)).Encode());
+        REQUIRE(sampledTerminal[i] == (t >= 2));
+      }
+      else
+      {
+        REQUIRE(t < 102);
+        REQUIRE(sampledRewards[i] == Approx(2.71).epsilon(1e-7));
+        CheckMatrices(sampledNextStates.col(i), state(t + 3).Encode());
+        REQUIRE(sampledTerminal[i] == 0);
+      }
+    }
+  }
+
+  // Fill the memory with one-step transitions of a long episode; only the
+  // latest ones are kept.
+  RingReplay<CartPole> ring(16, 6);
+  for (size_t t = 0; t < 40; ++t)
+  {
+    ring.Store(state(t), action, t, state(t + 1), false, 0.9);
+    REQUIRE(ring.Size() == std::min<size_t>(t + 1, 5));
+  }
+
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    ring.Sample(sampledStates, sampledActions, sampledRewards,
+        sampledNextStates, sampledTerminal);
+    for (size_t i = 0; i < sampledStates.n_cols; ++i)
+    {
+      const size_t t = sampledStates(0, i);
+      REQUIRE(t >= 35);
+      REQUIRE(sampledRewards[i] == t);
+      CheckMatrices(sampledNextStates.col(i), state(t + 1).Encode());
+    }
+  }
+}
+
+/**
+ * Step the given environment vectorized, and check that each copy follows the
+ * same dynamics as the environment stepped on its own.
+ */
+template<typename EnvironmentType,
+         typename ActionGeneratorType,
+         typename StateGeneratorType>
+void CheckVectorizedEnvironment(const EnvironmentType& environment,
+                                ActionGeneratorType randomAction,
+                                StateGeneratorType toState)
+{
+  typedef typename EnvironmentType::State State;
+  typedef typename EnvironmentType::Action Action;
+
+  const size_t numEnvironments = 16;
+  VectorizedEnvironment<EnvironmentType> environments(numEnvironments,
+      environment);
+  environments.Reset();
+
+  typename VectorizedEnvironment<EnvironmentType>::RewardsType rewards;
+  arma::mat nextStates;
+  arma::irowvec isTerminal;
+  for (size_t step = 0; step < 50; ++step)
+  {
+    const arma::mat states = environments.States();
+    std::vector<Action> actions(numEnvironments);
+    for (size_t i = 0; i < numEnvironments; ++i)
+      actions[i] = randomAction();
+
+    environments.Step(actions, rewards, nextStates, isTerminal);
+    REQUIRE(nextStates.n_cols == numEnvironments);
+
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      EnvironmentType single(environment);
+      State nextState;
+      const double reward = single.Sample(toState(states.col(i)), actions[i],
+          nextState);
+
+      CheckMatrices(nextStates.col(i), nextState.Data(), 1e-5);
+      REQUIRE(rewards[i] == Approx(reward).epsilon(1e-5));
+      REQUIRE(isTerminal[i] == single.IsTerminal(nextState));
+
+      // Finished copies continue from a new initial state.
+      if (!isTerminal[i])
+        CheckMatrices(environments.States().col(i), nextStates.col(i));
+    }
+  }
+}
+
+/**
+ * Check the batched dynamics of CartPole, MountainCar, Acrobot and Pendulum,
+ * and the per-copy stepping of ContinuousMountainCar.
+ */
+TEST_CASE("VectorizedEnvironmentTest", "[RLComponentsTest]")
+{
+  CheckVectorizedEnvironment(CartPole(0),
+      []()
+      {
+        CartPole::Action action;
+        action.action = (CartPole::Action::actions)
+            math::RandInt(CartPole::Action::size);
+        return action;
+      },
+      [](const arma::colvec& data) { return CartPole::State(data); });
+
+  CheckVectorizedEnvironment(MountainCar(0),
+      []()
+      {
+        MountainCar::Action action;
+        action.action = (MountainCar::Action::actions)
+            math::RandInt(MountainCar::Action::size);
+        return action;
+      },
+      [](const arma::colvec& data) { return MountainCar::State(data); });
+
+  CheckVectorizedEnvironment(Acrobot(0),
+      []()
+      {
+        Acrobot::Action action;
+        action.action = (Acrobot::Action::actions)
+            math::RandInt(Acrobot::Action::size);
+        return action;
+      },
+      [](const arma::colvec& data) { return Acrobot::State(data); });
+
+  CheckVectorizedEnvironment(Pendulum(0),
+      []()
+      {
+        Pendulum::Action action;
+        action.action[0] = math::Random(-2.0, 2.0);
+        return action;
+      },
+      [](const arma::colvec& data)
+      {
+        Pendulum::State state(data);
+        state.Theta() = std::atan2(data[0], data[1]);
+        return state;
+      });
+
+  CheckVectorizedEnvironment(ContinuousMountainCar(),
+      []()
+      {
+        ContinuousMountainCar::Action action;
+        action.action[0] = math::Random(-1.0, 1.0);
+        return action;
+      },
+      [](const arma::colvec& data)
+      {
+        return ContinuousMountainCar::State(data);
+      });
+
+  // The number of actions must match the number of copies.
+  VectorizedEnvironment<CartPole> environments(4);
+  environments.Reset();
+  std::vector<CartPole::Action> actions(3);
+  arma::rowvec rewards;
+  arma::mat nextStates;
+  arma::irowvec isTerminal;
+  REQUIRE_THROWS_AS(environments.Step(actions, rewards, nextStates,
+      isTerminal), std::invalid_argument);
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
@@ -286,3 +549,30 @@ TEST_CASE("GreedyPolicyTest", "[RLComponentsTest]")
   REQUIRE(actionValue[action.action] ==
       Approx(actionValue.max()).epsilon(1e-7));
 }
+
+/**
+ * Publish snapshots of target network parameters and check that the latest one
+ * is read back, in place.
+ */
+TEST_CASE("SharedTargetParametersTest", "[RLComponentsTest]")
+{
+  arma::mat parameters(10, 1, arma::fill::randu);
+  SharedTargetParameters target(parameters);
+  REQUIRE(target.Version() == 0);
+
+  arma::mat local(10, 1, arma::fill::zeros);
+  const double* localMemory = local.memptr();
+  REQUIRE(target.Read(local) == 0);
+  CheckMatrices(local, parameters);
+
+  for (size_t i = 1; i <= 3; ++i)
+  {
+    parameters.randu();
+    REQUIRE(target.Publish(parameters));
+    REQUIRE(target.Version() == i);
+
+    REQUIRE(target.Read(local) == i);
+    CheckMatrices(local, parameters);
+    REQUIRE(local.memptr() == localMemory);
+  }
+}
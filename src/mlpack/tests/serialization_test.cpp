@@ -31,6 +31,7 @@
 #include <mlpack/methods/perceptron/perceptron.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/ns_model.hpp>
 #include <mlpack/methods/softmax_regression/softmax_regression.hpp>
 #include <mlpack/methods/det/dtree.hpp>
 #include <mlpack/methods/naive_bayes/naive_bayes_classifier.hpp>
@@ -653,6 +654,38 @@ TEST_CASE("KNNTest", "[SerializationTest]")
   CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
 }
 
+TEST_CASE("KNNFloatModelTest", "[SerializationTest]")
+{
+  using neighbor::NSModel;
+  using neighbor::NearestNeighborSort;
+  typedef NSModel<NearestNeighborSort, arma::fmat> KNNFloatModel;
+  util::Timers timers;
+
+  KNNFloatModel model(KNNFloatModel::BALL_TREE, false);
+  model.BuildModel(timers, arma::randu<arma::fmat>(5, 500), DUAL_TREE_MODE);
+
+  KNNFloatModel modelXml, modelText, modelBinary;
+
+  SerializeObjectAll(model, modelXml, modelText, modelBinary);
+
+  // Now run nearest neighbor and make sure the results are the same.
+  arma::fmat querySet = arma::randu<arma::fmat>(5, 100);
+
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+
+  model.Search(timers, arma::fmat(querySet), 5, neighbors, distances);
+  modelXml.Search(timers, arma::fmat(querySet), 5, xmlNeighbors,
+      xmlDistances);
+  modelText.Search(timers, arma::fmat(querySet), 5, jsonNeighbors,
+      jsonDistances);
+  modelBinary.Search(timers, arma::fmat(querySet), 5, binaryNeighbors,
+      binaryDistances);
+
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+}
+
 TEST_CASE("SoftmaxRegressionTest", "[SerializationTest]")
 {
   using regression::SoftmaxRegression;
@@ -10,6 +10,8 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
+#include <mlpack/methods/logistic_regression/synchronous_sgd.hpp>
+#include <mlpack/methods/regularized_svd/sparse_sgd.hpp>
 #include <mlpack/methods/softmax_regression/softmax_regression.hpp>
 
 #include "catch.hpp"
@@ -220,6 +222,132 @@ TEST_CASE("SoftmaxRegressionTwoClasses", "[SoftmaxRegressionTest]")
   REQUIRE(testAcc == Approx(100.0).epsilon(0.02));
 }
 
+/**
+ * Make sure the sparse gradient matches the dense gradient when every element
+ * of the batch is nonzero, with and without the intercept.
+ */
+TEST_CASE("SoftmaxRegressionFunctionSparseGradient",
+          "[SoftmaxRegressionTest]")
+{
+  const size_t points = 50;
+  const size_t inputSize = 5;
+  const size_t numClasses = 3;
+
+  arma::mat data(inputSize, points, arma::fill::randu);
+  data += 0.1;
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+
+  for (size_t fitIntercept = 0; fitIntercept < 2; ++fitIntercept)
+  {
+    SoftmaxRegressionFunction srf(data, labels, numClasses, 0.5,
+        fitIntercept == 1);
+    const arma::mat parameters(numClasses, inputSize + fitIntercept,
+        arma::fill::randn);
+
+    arma::mat gradient;
+    arma::sp_mat sparseGradient;
+    for (size_t k = 0; k < points; k += 10)
+    {
+      srf.Gradient(parameters, k, gradient, 10);
+      srf.SparseGradient(parameters, k, sparseGradient, 10);
+
+      const arma::mat converted(sparseGradient);
+      REQUIRE(converted.n_rows == gradient.n_rows);
+      REQUIRE(converted.n_cols == gradient.n_cols);
+      for (size_t j = 0; j < gradient.n_elem; ++j)
+        REQUIRE(converted[j] == Approx(gradient[j]).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that sparse SGD with lazy weight decay takes the same steps as
+ * dense SGD on sparse data, with and without the intercept.
+ */
+TEST_CASE("SoftmaxRegressionSparseSGDLazyDecay", "[SoftmaxRegressionTest]")
+{
+  const size_t points = 50;
+  const size_t inputSize = 20;
+  const size_t numClasses = 3;
+  const double stepSize = 0.05;
+
+  const arma::mat data(arma::sprandu(inputSize, points, 0.2));
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+
+  for (size_t fitIntercept = 0; fitIntercept < 2; ++fitIntercept)
+  {
+    SoftmaxRegressionFunction srf(data, labels, numClasses, 0.1,
+        fitIntercept == 1);
+    REQUIRE(srf.WeightDecay() == 0.1);
+
+    arma::mat parameters(numClasses, inputSize + fitIntercept,
+        arma::fill::randn);
+    arma::mat expected(parameters);
+
+    // Two epochs without shuffling, so the end of the first epoch is checked
+    // too.
+    svd::SparseSGD<> sgd(1, 2, 0.0, false,
+        ens::ConstantStep(stepSize));
+    sgd.Optimize(srf, parameters);
+
+    arma::mat gradient;
+    for (size_t epoch = 0; epoch < 2; ++epoch)
+    {
+      for (size_t i = 0; i < points; ++i)
+      {
+        srf.Gradient(expected, i, gradient, 1);
+        expected -= stepSize * gradient;
+      }
+    }
+
+    for (size_t j = 0; j < parameters.n_elem; ++j)
+      REQUIRE(parameters[j] == Approx(expected[j]).margin(1e-10));
+  }
+}
+
+/**
+ * Train softmax regression with synchronous parallel SGD on a two-Gaussian
+ * dataset.
+ */
+TEST_CASE("SoftmaxRegressionSynchronousSGDTwoClasses",
+          "[SoftmaxRegressionTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.01;
+
+  // Generate two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  SynchronousSGD<> sgd(8, 4, 100, 1e-5, true,
+      ens::ConstantStep(0.1));
+  SoftmaxRegression sr(data, labels, numClasses, lambda, false, sgd);
+
+  // Compare training accuracy to 100.
+  const double acc = sr.ComputeAccuracy(data, labels);
+  REQUIRE(acc == Approx(100.0).epsilon(0.02));
+}
+
 TEST_CASE("SoftmaxRegressionFitIntercept", "[SoftmaxRegressionTest]")
 {
   // Generate a two-Gaussian dataset,
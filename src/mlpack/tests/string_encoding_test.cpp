@@ -1433,3 +1433,138 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Generate a corpus that is large enough to be split into several chunks by
+ * the parallel encoder.
+ */
+static vector<string> LargeStringEncodingInput()
+{
+  vector<string> input(1000);
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    const size_t numWords = math::RandInt(0, 30);
+    for (size_t j = 0; j < numWords; ++j)
+    {
+      // Skew the distribution of words, so that some are frequent.
+      const size_t word = math::RandInt(1, 40) * math::RandInt(1, 40);
+      input[i] += "word" + to_string(word) + (j % 3 == 0 ? ", " : " ");
+    }
+  }
+
+  return input;
+}
+
+/**
+ * Make sure that the parallel sparse Bag of Words encoder gives the same
+ * labels and values as the serial dense one, with both the default and the
+ * flat dictionary.
+ */
+TEST_CASE("ParallelSparseBagOfWordsEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> input = LargeStringEncodingInput();
+  SplitByAnyOf tokenizer(" ,.");
+
+  arma::mat expected;
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> expectedEncoder;
+  expectedEncoder.Encode(input, expected, tokenizer);
+
+  arma::sp_mat output;
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> encoder;
+  encoder.Encode(input, output, tokenizer);
+
+  CheckDictionaries(expectedEncoder.Dictionary(), encoder.Dictionary());
+  CheckMatrices(arma::mat(output), expected);
+
+  arma::sp_mat flatOutput;
+  StringEncoding<BagOfWordsEncodingPolicy, FlatStringEncodingDictionary>
+      flatEncoder;
+  flatEncoder.Encode(input, flatOutput, tokenizer);
+
+  const FlatStringEncodingDictionary& flatDictionary =
+      flatEncoder.Dictionary();
+  REQUIRE(flatDictionary.Size() == expectedEncoder.Dictionary().Size());
+  for (size_t label = 1; label <= flatDictionary.Size(); ++label)
+  {
+    REQUIRE(expectedEncoder.Dictionary().Value(flatDictionary.Token(label)) ==
+        label);
+    REQUIRE(flatDictionary.Value(flatDictionary.Token(label)) == label);
+  }
+  CheckMatrices(arma::mat(flatOutput), expected);
+
+  // Make sure the flat dictionary survives serialization.
+  FlatStringEncodingDictionary xmlDictionary, jsonDictionary, binaryDictionary;
+  SerializeObjectAll(flatDictionary, xmlDictionary, jsonDictionary,
+      binaryDictionary);
+  REQUIRE(binaryDictionary.Size() == flatDictionary.Size());
+  for (size_t label = 1; label <= flatDictionary.Size(); ++label)
+  {
+    REQUIRE(xmlDictionary.Value(flatDictionary.Token(label)) == label);
+    REQUIRE(jsonDictionary.Value(flatDictionary.Token(label)) == label);
+    REQUIRE(binaryDictionary.Value(flatDictionary.Token(label)) == label);
+  }
+}
+
+/**
+ * Make sure that the parallel sparse Tf-Idf encoder gives the same values as
+ * the serial dense one.
+ */
+TEST_CASE("ParallelSparseTfIdfEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> input = LargeStringEncodingInput();
+  SplitByAnyOf tokenizer(" ,.");
+
+  arma::mat expected;
+  TfIdfEncoding<SplitByAnyOf::TokenType> expectedEncoder(
+      TfIdfEncodingPolicy::TfTypes::SUBLINEAR_TF, false);
+  expectedEncoder.Encode(input, expected, tokenizer);
+
+  arma::sp_mat output;
+  StringEncoding<TfIdfEncodingPolicy, FlatStringEncodingDictionary> encoder(
+      TfIdfEncodingPolicy::TfTypes::SUBLINEAR_TF, false);
+  encoder.Encode(input, output, tokenizer);
+
+  REQUIRE(output.n_nonzero == (size_t) arma::accu(expected != 0));
+  CheckMatrices(arma::mat(output), expected);
+
+  // The statistics of the policy must be filled in as by the serial encoder.
+  const TfIdfEncodingPolicy& policy = encoder.EncodingPolicy();
+  const TfIdfEncodingPolicy& expectedPolicy = expectedEncoder.EncodingPolicy();
+  REQUIRE(policy.TokensFrequences() == expectedPolicy.TokensFrequences());
+  REQUIRE(policy.NumContainingStrings() ==
+      expectedPolicy.NumContainingStrings());
+  REQUIRE(policy.LinesSizes() == expectedPolicy.LinesSizes());
+}
+
+/**
+ * Test the hashing dictionary: the sparse and dense encoders must agree, the
+ * output must have one row per bin, and every token must be counted.
+ */
+TEST_CASE("HashingDictionaryBagOfWordsEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> input = LargeStringEncodingInput();
+  SplitByAnyOf tokenizer(" ,.");
+
+  StringEncoding<BagOfWordsEncodingPolicy, HashingStringEncodingDictionary>
+      encoder;
+  encoder.Dictionary().NumBins() = 64;
+
+  arma::mat expected;
+  encoder.Encode(input, expected, tokenizer);
+  arma::sp_mat output;
+  encoder.Encode(input, output, tokenizer);
+
+  REQUIRE(output.n_rows == 64);
+  REQUIRE(output.n_cols == input.size());
+  CheckMatrices(arma::mat(output), expected);
+
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    STRING_VIEW strView(input[i]);
+    size_t numTokens = 0;
+    while (!tokenizer.IsTokenEmpty(tokenizer(strView)))
+      ++numTokens;
+
+    REQUIRE(arma::accu(output.col(i)) == Approx((double) numTokens));
+  }
+}
@@ -435,6 +435,72 @@ TEST_CASE("SVDPlusPlusFunctionOptimize", "[SVDPlusPlusTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Make sure that UpdateRating() takes the same step as the gradient of one
+// rating, once the updates of the implicit item vectors are applied.
+TEST_CASE("SVDPlusPlusFunctionUpdateRating", "[SVDPlusPlusTest]")
+{
+  const size_t numUsers = 20;
+  const size_t numItems = 30;
+  arma::mat data = arma::randu(3, 200);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data(0, 199) = numUsers - 1;
+  data(1, 199) = numItems - 1;
+  arma::sp_mat implicitData = arma::sprandu(numItems, numUsers, 0.2);
+  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, implicitData, 5, 0.1);
+
+  REQUIRE(svdPPFunc.NumSharedColumns() == numItems);
+  arma::mat parameters = svdPPFunc.GetInitialPoint();
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::mat gradient;
+    svdPPFunc.Gradient(parameters, i, gradient, 1);
+    const arma::mat expected = parameters - 0.05 * gradient;
+
+    arma::mat sharedUpdate(parameters.n_rows, numItems, arma::fill::zeros);
+    svdPPFunc.UpdateRating(parameters, i, 0.05, sharedUpdate);
+    parameters.tail_cols(numItems) += sharedUpdate;
+    for (size_t j = 0; j < parameters.n_elem; ++j)
+      REQUIRE(parameters[j] == Approx(expected[j]).epsilon(1e-10));
+  }
+}
+
+// Make sure that the column updates of SparseGradient() add up to the
+// gradient of the same batch, and that they only touch the columns listed by
+// GradientColumns().
+TEST_CASE("SVDPlusPlusFunctionSparseGradient", "[SVDPlusPlusTest]")
+{
+  const size_t numUsers = 20;
+  const size_t numItems = 30;
+  arma::mat data = arma::randu(3, 200);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data(0, 199) = numUsers - 1;
+  data(1, 199) = numItems - 1;
+  arma::sp_mat implicitData = arma::sprandu(numItems, numUsers, 0.2);
+  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, implicitData, 5, 0.1);
+  REQUIRE(svdPPFunc.WeightDecay() == 0.0);
+
+  const arma::mat parameters = svdPPFunc.GetInitialPoint();
+  arma::uvec columns, gradientColumns;
+  arma::mat deltas;
+  for (size_t i = 0; i < 200; i += 20)
+  {
+    arma::mat gradient;
+    svdPPFunc.Gradient(parameters, i, gradient, 20);
+    svdPPFunc.SparseGradient(parameters, i, columns, deltas, 20);
+    svdPPFunc.GradientColumns(i, gradientColumns, 20);
+    REQUIRE(deltas.n_rows == parameters.n_rows);
+    REQUIRE(arma::all(columns == gradientColumns));
+
+    arma::mat sparseGradient(arma::size(gradient), arma::fill::zeros);
+    for (size_t k = 0; k < columns.n_elem; ++k)
+      sparseGradient.col(columns[k]) += deltas.col(k);
+    for (size_t j = 0; j < gradient.n_elem; ++j)
+      REQUIRE(sparseGradient[j] == Approx(gradient[j]).margin(1e-10));
+  }
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef HAS_OPENMP
@@ -14,6 +14,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
+#include <mlpack/core/tree/octree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
 
 #include <queue>
@@ -1040,6 +1041,76 @@ TEST_CASE("HRectBoundDiameter", "[TreeTest]")
   REQUIRE(d.Diameter() == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Compare the HRectBound distance kernels against distances between explicitly
+ * constructed points, for random bounds and points.
+ */
+template<typename MetricType>
+void CheckHRectBoundDistances()
+{
+  const size_t dim = 13;
+  for (size_t trial = 0; trial < 20; ++trial)
+  {
+    HRectBound<MetricType> a(dim), b(dim);
+    for (size_t d = 0; d < dim; ++d)
+    {
+      const double aLo = math::Random(-5.0, 5.0);
+      const double bLo = math::Random(-5.0, 5.0);
+      a[d] = Range(aLo, aLo + math::Random(0.0, 3.0));
+      b[d] = Range(bLo, bLo + math::Random(0.0, 3.0));
+    }
+
+    arma::vec point(dim, arma::fill::randu);
+    point = 10.0 * point - 5.0;
+
+    // The closest point of a to the point, and the furthest corner of a.
+    // Between the bounds, the smallest and largest difference in each
+    // dimension.
+    arma::vec closest(dim), furthest(dim), minGap(dim), maxGap(dim);
+    for (size_t d = 0; d < dim; ++d)
+    {
+      closest[d] = std::min(std::max(point[d], a[d].Lo()), a[d].Hi());
+      furthest[d] = (point[d] - a[d].Lo() > a[d].Hi() - point[d]) ?
+          a[d].Lo() : a[d].Hi();
+      minGap[d] = std::max(std::max(b[d].Lo() - a[d].Hi(),
+          a[d].Lo() - b[d].Hi()), 0.0);
+      maxGap[d] = std::max(b[d].Hi() - a[d].Lo(), a[d].Hi() - b[d].Lo());
+    }
+
+    const arma::vec zero(dim, arma::fill::zeros);
+    const double minPoint = MetricType::Evaluate(point, closest);
+    const double maxPoint = MetricType::Evaluate(point, furthest);
+    const double minBound = MetricType::Evaluate(minGap, zero);
+    const double maxBound = MetricType::Evaluate(maxGap, zero);
+
+    REQUIRE(a.MinDistance(point) == Approx(minPoint).epsilon(1e-7));
+    REQUIRE(a.MaxDistance(point) == Approx(maxPoint).epsilon(1e-7));
+    REQUIRE(a.MinDistance(b) == Approx(minBound).epsilon(1e-7));
+    REQUIRE(a.MaxDistance(b) == Approx(maxBound).epsilon(1e-7));
+
+    const Range pointRange = a.RangeDistance(point);
+    REQUIRE(pointRange.Lo() == Approx(minPoint).epsilon(1e-7));
+    REQUIRE(pointRange.Hi() == Approx(maxPoint).epsilon(1e-7));
+
+    const Range boundRange = a.RangeDistance(b);
+    REQUIRE(boundRange.Lo() == Approx(minBound).epsilon(1e-7));
+    REQUIRE(boundRange.Hi() == Approx(maxBound).epsilon(1e-7));
+  }
+}
+
+/**
+ * Ensure that the HRectBound distances are right for the L1, L2 and
+ * L-infinity metrics, with and without the root.
+ */
+TEST_CASE("HRectBoundLMetricDistances", "[TreeTest]")
+{
+  CheckHRectBoundDistances<ManhattanDistance>();
+  CheckHRectBoundDistances<SquaredEuclideanDistance>();
+  CheckHRectBoundDistances<EuclideanDistance>();
+  CheckHRectBoundDistances<LMetric<3, true>>();
+  CheckHRectBoundDistances<ChebyshevDistance>();
+}
+
 /**
  * It seems as though Bill has stumbled across a bug where
  * BinarySpaceTree<>::count() returns something different than
@@ -1665,6 +1736,120 @@ TEST_CASE("BallTreeTest", "[TreeTest]")
   }
 }
 
+/**
+ * Save a ball tree to an index file, load it again, and make sure that the
+ * loaded tree is identical.  Also make sure that invalid files are rejected.
+ */
+TEST_CASE("TreeIndexFileTest", "[TreeTest]")
+{
+  typedef BallTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> KDTreeType;
+
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew, 10);
+
+  TreeIndexFile<TreeType>::Save("tree_index.bin", tree, oldFromNew);
+
+  {
+    TreeIndexFile<TreeType> index("tree_index.bin");
+    REQUIRE(index.Dimensionality() == 4);
+    REQUIRE(index.NumPoints() == 1000);
+    REQUIRE(index.OldFromNew() == oldFromNew);
+
+    // The loaded tree must be destroyed before the index.
+    std::unique_ptr<TreeType> loaded(index.LoadTree());
+    CheckMatrices(loaded->Dataset(), tree.Dataset());
+
+    size_t numNodes = 0;
+    std::stack<std::pair<TreeType*, TreeType*>> stack;
+    stack.push(std::make_pair(&tree, loaded.get()));
+    while (!stack.empty())
+    {
+      TreeType* a = stack.top().first;
+      TreeType* b = stack.top().second;
+      stack.pop();
+      ++numNodes;
+
+      REQUIRE(a->Begin() == b->Begin());
+      REQUIRE(a->Count() == b->Count());
+      REQUIRE(a->IsLeaf() == b->IsLeaf());
+      REQUIRE(&b->Dataset() == &loaded->Dataset());
+      REQUIRE(a->ParentDistance() == b->ParentDistance());
+      REQUIRE(a->FurthestDescendantDistance() ==
+          b->FurthestDescendantDistance());
+      REQUIRE(a->Bound().Radius() == b->Bound().Radius());
+      CheckMatrices(a->Bound().Center(), b->Bound().Center());
+
+      if (!a->IsLeaf())
+      {
+        REQUIRE(b->Left()->Parent() == b);
+        REQUIRE(b->Right()->Parent() == b);
+        stack.push(std::make_pair(a->Left(), b->Left()));
+        stack.push(std::make_pair(a->Right(), b->Right()));
+      }
+    }
+
+    REQUIRE(index.NumNodes() == numNodes);
+  }
+
+  // A kd-tree can't be loaded from the index of a ball tree.
+  REQUIRE_THROWS_AS(TreeIndexFile<KDTreeType>("tree_index.bin"),
+      std::runtime_error);
+
+  // Nor can a ball tree whose node table doesn't split the points correctly.
+  // The offset of the node table is the seventh 64-bit field of the header,
+  // and each node holds (begin, count, left, right).
+  std::vector<char> contents;
+  {
+    std::ifstream in("tree_index.bin", std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+  }
+  uint64_t nodesOffset;
+  std::memcpy(&nodesOffset, contents.data() + 72, sizeof(uint64_t));
+  auto corrupt = [&](const size_t node, const size_t field,
+      const uint64_t value)
+  {
+    std::vector<char> corrupted(contents);
+    std::memcpy(corrupted.data() + nodesOffset +
+        (4 * node + field) * sizeof(uint64_t), &value, sizeof(uint64_t));
+    std::ofstream out("tree_index.bin", std::ios::binary);
+    out.write(corrupted.data(), corrupted.size());
+  };
+
+  uint64_t root[4];
+  std::memcpy(root, contents.data() + nodesOffset, sizeof(root));
+
+  // A root with only a left child.
+  corrupt(0, 3, 0);
+  REQUIRE_THROWS_AS(TreeIndexFile<TreeType>("tree_index.bin"),
+      std::runtime_error);
+
+  // A left child that doesn't hold all the points before the right child.
+  uint64_t leftCount;
+  std::memcpy(&leftCount, contents.data() + nodesOffset +
+      (4 * root[2] + 1) * sizeof(uint64_t), sizeof(uint64_t));
+  corrupt(root[2], 1, leftCount - 1);
+  REQUIRE_THROWS_AS(TreeIndexFile<TreeType>("tree_index.bin"),
+      std::runtime_error);
+
+  // A root that doesn't hold every point.
+  corrupt(0, 0, 1);
+  REQUIRE_THROWS_AS(TreeIndexFile<TreeType>("tree_index.bin"),
+      std::runtime_error);
+
+  // Nor from a file that is not an index at all.
+  {
+    std::ofstream out("tree_index.bin");
+    out << "This is not a tree index file.";
+  }
+  REQUIRE_THROWS_AS(TreeIndexFile<TreeType>("tree_index.bin"),
+      std::runtime_error);
+
+  remove("tree_index.bin");
+}
+
 /**
  * Ensure that we can build a ball tree with a custom instantiated metric type.
  */
@@ -2287,3 +2472,79 @@ TEST_CASE("CoverTreeDescendantTest", "[TreeTest]")
   // using the recursive function above.
   CheckDescendants(&tree);
 }
+
+/**
+ * Make sure that the parallel partition gives exactly the same order as the
+ * serial partition.
+ */
+TEST_CASE("ParallelPerformSplitTest", "[TreeTest]")
+{
+  typedef MeanSplit<HRectBound<EuclideanDistance>, arma::mat> SplitType;
+
+  arma::mat dataset(3, 5000, arma::fill::randu);
+  SplitType::SplitInfo splitInfo;
+  splitInfo.splitDimension = 1;
+  splitInfo.splitVal = 0.3;
+
+  // Split a range in the middle of the dataset both ways.
+  arma::mat serialData(dataset), parallelData(dataset);
+  std::vector<size_t> serialOldFromNew(5000), parallelOldFromNew(5000);
+  for (size_t i = 0; i < 5000; ++i)
+    serialOldFromNew[i] = parallelOldFromNew[i] = i;
+
+  const size_t serialCol = split::PerformSplit<arma::mat, SplitType>(
+      serialData, 100, 4000, splitInfo, serialOldFromNew);
+  const size_t parallelCol = split::ParallelPerformSplit<arma::mat, SplitType>(
+      parallelData, 100, 4000, splitInfo, &parallelOldFromNew);
+
+  REQUIRE(serialCol == parallelCol);
+  CheckMatrices(serialData, parallelData);
+  for (size_t i = 0; i < 5000; ++i)
+    REQUIRE(serialOldFromNew[i] == parallelOldFromNew[i]);
+}
+
+// Check that two trees have the same structure.
+template<typename TreeType>
+void CheckSameTree(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.NumDescendants() == b.NumDescendants());
+  if (a.NumDescendants() > 0)
+    REQUIRE(a.Descendant(0) == b.Descendant(0));
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameTree(a.Child(i), b.Child(i));
+}
+
+/**
+ * Make sure that building a kd-tree and an octree in parallel gives the same
+ * tree and mappings as building them on one thread.
+ */
+TEST_CASE("ParallelTreeBuildTest", "[TreeTest]")
+{
+  arma::mat dataset(3, 100000, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew, serialOldFromNew;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(dataset,
+      oldFromNew);
+  Octree<EuclideanDistance, EmptyStatistic, arma::mat> octree(dataset);
+
+  #ifdef HAS_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> serialTree(dataset,
+      serialOldFromNew);
+  Octree<EuclideanDistance, EmptyStatistic, arma::mat> serialOctree(dataset);
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  CheckSameTree(tree, serialTree);
+  CheckMatrices(tree.Dataset(), serialTree.Dataset());
+  REQUIRE(oldFromNew.size() == serialOldFromNew.size());
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    REQUIRE(oldFromNew[i] == serialOldFromNew[i]);
+
+  CheckSameTree(octree, serialOctree);
+  CheckMatrices(octree.Dataset(), serialOctree.Dataset());
+}